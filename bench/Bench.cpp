@@ -0,0 +1,192 @@
+/**
+ * @file Bench.cpp
+ * @brief Implementation of the benchmark harness
+ *
+ * Allocations are counted by replacing the global operator new; spawned
+ * processes are read from the "subprocess.spawns" counter every backend
+ * increments before it forks.
+ */
+
+#include "Bench.hpp"
+#include "core/Json.hpp"
+#include "core/Metrics.hpp"
+#include <algorithm> // for std::sort
+#include <atomic>    // for std::atomic
+#include <cstdlib>   // for std::malloc, std::free
+#include <ctime>     // for std::time, std::gmtime, std::strftime
+#include <iomanip>   // for std::setprecision
+#include <new>       // for std::bad_alloc
+#include <sstream>   // for std::ostringstream
+#include <thread>    // for std::thread::hardware_concurrency
+
+namespace
+{
+    std::atomic<std::uint64_t> allocation_count{0};
+
+    void *counted_alloc(std::size_t size)
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        if (void *p = std::malloc(size ? size : 1))
+        {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    return counted_alloc(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return counted_alloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace Bench
+{
+    namespace
+    {
+        std::vector<Case> &registry()
+        {
+            static std::vector<Case> instance;
+            return instance;
+        }
+
+        /**
+         * @brief Value at a quantile of sorted samples
+         */
+        double quantile(const std::vector<double> &sorted, double q)
+        {
+            if (sorted.empty())
+            {
+                return 0;
+            }
+            std::size_t index = static_cast<std::size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+    } // namespace
+
+    void add(Case c)
+    {
+        registry().push_back(std::move(c));
+    }
+
+    const std::vector<Case> &cases()
+    {
+        return registry();
+    }
+
+    std::uint64_t allocations()
+    {
+        return allocation_count.load(std::memory_order_relaxed);
+    }
+
+    Result run(const Case &c, std::size_t size, const Options &options)
+    {
+        static const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+        using Clock = std::chrono::steady_clock;
+
+        Operation operation = c.setup(size);
+
+        // Reserved up front so the harness itself allocates nothing while timing
+        std::vector<double> samples;
+        samples.reserve(static_cast<std::size_t>(options.max_iterations));
+
+        const std::uint64_t spawns_before = Core::Metrics::value(spawn_counter);
+        const std::uint64_t allocations_before = allocations();
+        const Clock::time_point start = Clock::now();
+        Clock::time_point now = start;
+        std::uint64_t iteration = 0;
+        while (iteration < options.max_iterations && (iteration == 0 || now - start < options.min_time))
+        {
+            const Clock::time_point before = Clock::now();
+            operation(iteration);
+            now = Clock::now();
+            samples.push_back(std::chrono::duration<double, std::micro>(now - before).count());
+            ++iteration;
+        }
+        const std::uint64_t allocations_after = allocations();
+        const std::uint64_t spawns_after = Core::Metrics::value(spawn_counter);
+
+        Result result;
+        result.name = c.name;
+        result.backend = c.backend;
+        result.size = size;
+        result.iterations = iteration;
+
+        double total = 0;
+        for (double sample : samples)
+        {
+            total += sample;
+        }
+        std::sort(samples.begin(), samples.end());
+        result.mean_us = total / static_cast<double>(iteration);
+        result.median_us = quantile(samples, 0.5);
+        result.p95_us = quantile(samples, 0.95);
+        result.min_us = samples.front();
+        result.max_us = samples.back();
+        result.ops_per_second = total > 0 ? 1e6 * static_cast<double>(iteration) / total : 0;
+        result.allocations_per_op = static_cast<double>(allocations_after - allocations_before) / static_cast<double>(iteration);
+        result.spawns_per_op = static_cast<double>(spawns_after - spawns_before) / static_cast<double>(iteration);
+        return result;
+    }
+
+    std::string to_json(const std::vector<Result> &results, const Options &options)
+    {
+        char date[32] = "";
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        std::ostringstream out;
+        out << std::setprecision(6);
+        out << "{\"context\":{\"date\":" << Core::Json::quote(date)
+            << ",\"cpus\":" << std::thread::hardware_concurrency()
+            << ",\"min_time_ms\":" << options.min_time.count()
+            << ",\"max_iterations\":" << options.max_iterations << "},\"benchmarks\":[";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result &r = results[i];
+            if (i > 0)
+            {
+                out << ",";
+            }
+            out << "\n{\"name\":" << Core::Json::quote(r.name)
+                << ",\"backend\":" << Core::Json::quote(r.backend)
+                << ",\"size\":" << r.size
+                << ",\"iterations\":" << r.iterations
+                << ",\"mean_us\":" << r.mean_us
+                << ",\"median_us\":" << r.median_us
+                << ",\"p95_us\":" << r.p95_us
+                << ",\"min_us\":" << r.min_us
+                << ",\"max_us\":" << r.max_us
+                << ",\"ops_per_second\":" << r.ops_per_second
+                << ",\"allocations_per_op\":" << r.allocations_per_op
+                << ",\"spawns_per_op\":" << r.spawns_per_op << "}";
+        }
+        out << "\n]}\n";
+        return out.str();
+    }
+
+} // namespace Bench
@@ -0,0 +1,127 @@
+/**
+ * @file Bench.hpp
+ * @brief Minimal benchmark harness for ultimate-control-bench
+ *
+ * Cases are registered explicitly by the bench translation units and run
+ * once per environment size. Every run reports latency percentiles,
+ * throughput, heap allocations and spawned processes per operation, and
+ * the whole suite is written as one JSON document.
+ */
+
+#pragma once
+
+#include "core/Backend.hpp"
+#include <chrono>     // for std::chrono::milliseconds
+#include <cstdint>    // for std::uint64_t
+#include <functional> // for std::function
+#include <string>     // for std::string
+#include <vector>     // for std::vector
+
+/**
+ * @namespace Bench
+ * @brief The ultimate-control-bench harness and its cases
+ */
+namespace Bench
+{
+    /**
+     * @brief The operation a case times; called once per iteration
+     * @param iteration Index of the iteration, e.g. to cycle through devices
+     */
+    using Operation = std::function<void(std::uint64_t iteration)>;
+
+    /**
+     * @struct Case
+     * @brief One benchmark, run at each of its sizes
+     */
+    struct Case
+    {
+        std::string name;               ///< Dotted name, e.g. "volume.refresh"
+        std::string backend;            ///< "tools", "mock" or "none"
+        std::vector<std::size_t> sizes; ///< Sizes to run; empty for the suite's sizes
+
+        /// Build an environment of the given size and return the operation to time
+        std::function<Operation(std::size_t size)> setup;
+    };
+
+    /**
+     * @struct Options
+     * @brief How long and at which sizes the suite runs
+     */
+    struct Options
+    {
+        std::vector<std::size_t> sizes = {1, 10, 100, 1000}; ///< Devices or access points per environment
+        std::string filter;                                  ///< Only cases whose name contains this
+        std::string backend;                                 ///< Only cases with this backend; empty for all
+        std::chrono::milliseconds min_time{200};             ///< Keep iterating at least this long
+        std::uint64_t max_iterations = 100000;               ///< ... but never more than this
+    };
+
+    /**
+     * @struct Result
+     * @brief Measurements of one case at one size
+     */
+    struct Result
+    {
+        std::string name;
+        std::string backend;
+        std::size_t size = 0;
+        std::uint64_t iterations = 0;
+        double mean_us = 0;
+        double median_us = 0;
+        double p95_us = 0;
+        double min_us = 0;
+        double max_us = 0;
+        double ops_per_second = 0;
+        double allocations_per_op = 0; ///< operator new calls
+        double spawns_per_op = 0;      ///< subprocess.spawns increments
+    };
+
+    /**
+     * @brief Add a case to the suite
+     */
+    void add(Case c);
+
+    /**
+     * @brief Every registered case, in registration order
+     */
+    const std::vector<Case> &cases();
+
+    /**
+     * @brief Run one case at one size
+     */
+    Result run(const Case &c, std::size_t size, const Options &options);
+
+    /**
+     * @brief Heap allocations made by the whole process so far
+     */
+    std::uint64_t allocations();
+
+    /**
+     * @brief The suite's results as a JSON document
+     */
+    std::string to_json(const std::vector<Result> &results, const Options &options);
+
+    /**
+     * @brief Register the manager cases, against fake tools and mocks
+     * @param tools Directory holding the fake pactl, nmcli, ... scripts
+     * @param mock Latency, failures, ... of the mocks; devices is set per size
+     */
+    void register_manager_benchmarks(const std::string &tools, const Core::Backend::MockOptions &mock);
+
+    /**
+     * @brief Register the QR encoding and rasterising cases
+     */
+    void register_qr_benchmarks();
+
+    /**
+     * @brief Compare every QR version, level and mask against the golden digests
+     * @return The number of symbols that differ; each is reported on stderr
+     */
+    int check_qr_golden();
+
+    /**
+     * @brief Print the golden digests of the current encoder, to update kGolden
+     */
+    void print_qr_golden();
+
+} // namespace Bench
@@ -0,0 +1,192 @@
+/**
+ * @file ManagerBench.cpp
+ * @brief Benchmarks of every manager against synthetic environments
+ *
+ * Each manager is driven twice: through its system backend, with the fake
+ * pactl, nmcli, brightnessctl and powerprofilesctl scripts from
+ * bench/fake-tools first on PATH, and through its mock backend. The
+ * scripts and the mocks both present UC_BENCH_DEVICES / MockOptions::devices
+ * devices or access points. BluetoothManager talks to BlueZ over D-Bus, so
+ * it only runs against its mock.
+ *
+ * "refresh" cases time one full re-read as the tabs and `get` do it; the
+ * other cases time one change. Changes the managers only make on worker
+ * threads (WiFi radio, Bluetooth connect) go straight to the backend.
+ */
+
+#include "Bench.hpp"
+#include "volume/VolumeManager.hpp"
+#include "wifi/WifiBackend.hpp"
+#include "wifi/WifiManager.hpp"
+#include "bluetooth/BluetoothBackend.hpp"
+#include "bluetooth/BluetoothManager.hpp"
+#include "display/DisplayManager.hpp"
+#include "power/PowerManager.hpp"
+#include <cstdlib> // for std::getenv, setenv
+#include <memory>  // for std::shared_ptr
+
+namespace Bench
+{
+    namespace
+    {
+        /**
+         * @brief Environment sizes for subsystems with a single device
+         */
+        const std::vector<std::size_t> kSingle = {1};
+
+        /**
+         * @brief Registers one case per backend and knows how to select each
+         */
+        class Registrar
+        {
+        public:
+            /**
+             * @param tools Put first on PATH, so the system backends never reach the real tools
+             * @param mock Options of the mocks, but for the number of devices
+             */
+            Registrar(const std::string &tools, Core::Backend::MockOptions mock) : mock_(mock)
+            {
+                const char *path = std::getenv("PATH");
+                const std::string value = tools + ":" + (path ? path : "/usr/bin:/bin");
+                setenv("PATH", value.c_str(), 1);
+            }
+
+            /**
+             * @brief Add a case that runs against the fake tools and one against the mock
+             */
+            void both(const std::string &name, std::vector<std::size_t> sizes,
+                      std::function<Operation(std::size_t)> setup)
+            {
+                add({name, "tools", sizes, [this, setup](std::size_t size)
+                     {
+                         use_tools(size);
+                         return setup(size);
+                     }});
+                mock_only(name, std::move(sizes), std::move(setup));
+            }
+
+            /**
+             * @brief Add a case that only runs against the mock
+             */
+            void mock_only(const std::string &name, std::vector<std::size_t> sizes,
+                           std::function<Operation(std::size_t)> setup)
+            {
+                add({name, "mock", std::move(sizes), [this, setup](std::size_t size)
+                     {
+                         use_mock(size);
+                         return setup(size);
+                     }});
+            }
+
+        private:
+            void use_tools(std::size_t size) const
+            {
+                setenv("UC_BENCH_DEVICES", std::to_string(size).c_str(), 1);
+                Core::Backend::use_system();
+            }
+
+            void use_mock(std::size_t size) const
+            {
+                Core::Backend::MockOptions options = mock_;
+                options.devices = size;
+                Core::Backend::use_mock(options);
+            }
+
+            Core::Backend::MockOptions mock_;
+        };
+    } // namespace
+
+    void register_manager_benchmarks(const std::string &tools, const Core::Backend::MockOptions &mock)
+    {
+        // Cases capture it; it lives as long as the suite
+        static Registrar r(tools, mock);
+
+        r.both("volume.refresh", {}, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Volume::VolumeManager>();
+                   return [manager](std::uint64_t)
+                   { manager->query_sinks(); };
+               });
+        r.both("volume.set_volume", {}, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Volume::VolumeManager>();
+                   std::vector<std::string> names;
+                   for (const auto &device : manager->query_sinks())
+                   {
+                       names.push_back(device.name);
+                   }
+                   if (names.empty())
+                   {
+                       names.push_back("missing");
+                   }
+                   return [manager, names](std::uint64_t i)
+                   { manager->set_volume(names[i % names.size()], static_cast<int>(i % 101)); };
+               });
+
+        r.both("wifi.refresh", {}, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Wifi::WifiManager>();
+                   return [manager](std::uint64_t)
+                   { manager->scan_networks(); };
+               });
+        r.both("wifi.set_radio", {}, [](std::size_t)
+               {
+                   std::shared_ptr<Wifi::WifiBackend> backend = Wifi::WifiBackend::create();
+                   return [backend](std::uint64_t)
+                   { backend->set_radio(true); };
+               });
+
+        r.mock_only("bluetooth.refresh", {}, [](std::size_t)
+                    {
+                        auto manager = std::make_shared<Bluetooth::BluetoothManager>();
+                        return [manager](std::uint64_t)
+                        { manager->scan_devices(); };
+                    });
+        r.mock_only("bluetooth.connect", {}, [](std::size_t)
+                    {
+                        std::shared_ptr<Bluetooth::BluetoothBackend> backend = Bluetooth::BluetoothBackend::create();
+                        std::vector<std::string> addresses;
+                        for (const auto &device : backend->list_devices())
+                        {
+                            addresses.push_back(device.address);
+                        }
+                        if (addresses.empty())
+                        {
+                            addresses.push_back("02:00:00:FF:FF:FF");
+                        }
+                        return [backend, addresses](std::uint64_t i)
+                        { backend->connect(addresses[i % addresses.size()]); };
+                    });
+
+        r.both("display.refresh", kSingle, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Display::DisplayManager>();
+                   return [manager](std::uint64_t)
+                   { manager->get_brightness(); };
+               });
+        r.both("display.set_brightness", kSingle, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Display::DisplayManager>();
+                   return [manager](std::uint64_t i)
+                   { manager->set_brightness(static_cast<int>(i % 101)); };
+               });
+
+        r.both("power.refresh", kSingle, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Power::PowerManager>();
+                   return [manager](std::uint64_t)
+                   {
+                       manager->list_power_profiles();
+                       manager->get_current_power_profile();
+                   };
+               });
+        r.both("power.set_profile", kSingle, [](std::size_t)
+               {
+                   auto manager = std::make_shared<Power::PowerManager>();
+                   static const std::vector<std::string> profiles = {"power-saver", "balanced", "performance"};
+                   return [manager](std::uint64_t i)
+                   { manager->set_power_profile(profiles[i % profiles.size()]); };
+               });
+    }
+
+} // namespace Bench
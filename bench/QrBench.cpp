@@ -0,0 +1,59 @@
+/**
+ * @file QrBench.cpp
+ * @brief Benchmarks of QR encoding and rasterising
+ *
+ * Sizes are QR versions. The payload is kept short enough for version 1
+ * and the version is forced, so encoding time reflects the symbol size:
+ * mostly Reed-Solomon and the scoring of the 8 masks.
+ */
+
+#include "Bench.hpp"
+#include "utils/QrRaster.hpp"
+#include "utils/qrcodegen/qrcodegen.hpp"
+#include <memory> // for std::make_shared
+
+namespace Bench
+{
+    namespace
+    {
+        const std::vector<std::size_t> kVersions = {1, 10, 25, 40};
+        const std::vector<std::uint8_t> kPayload = {'W', 'I', 'F', 'I', ':', 'S', ':', 'u', 'c', ';'};
+
+        qrcodegen::QrCode encode(std::size_t version, int mask)
+        {
+            const int v = static_cast<int>(version);
+            return qrcodegen::QrCode::encodeSegments({qrcodegen::QrSegment::makeBytes(kPayload)},
+                                                     qrcodegen::QrCode::Ecc::LOW, v, v, mask, false);
+        }
+    } // namespace
+
+    void register_qr_benchmarks()
+    {
+        add({"qr.encode", "none", kVersions, [](std::size_t version) -> Operation
+             {
+                 return [version](std::uint64_t)
+                 { encode(version, -1); };
+             }});
+        add({"qr.encode_fixed_mask", "none", kVersions, [](std::size_t version) -> Operation
+             {
+                 return [version](std::uint64_t)
+                 { encode(version, 0); };
+             }});
+        add({"qr.render", "none", kVersions, [](std::size_t version) -> Operation
+             {
+                 // Same scale and layout as the WiFi share dialog
+                 constexpr int kScale = 7;
+                 constexpr int kChannels = 3;
+                 auto qr = std::make_shared<qrcodegen::QrCode>(encode(version, -1));
+                 const std::size_t rowstride = static_cast<std::size_t>(qr->getSize() * kScale * kChannels);
+                 auto pixels = std::make_shared<std::vector<std::uint8_t>>(rowstride * static_cast<std::size_t>(qr->getSize() * kScale));
+                 return [qr, pixels, rowstride](std::uint64_t)
+                 {
+                     static const std::uint8_t dark[kChannels] = {0, 0, 0};
+                     static const std::uint8_t light[kChannels] = {255, 255, 255};
+                     Utils::QrRaster::render(*qr, kScale, pixels->data(), rowstride, kChannels, dark, light);
+                 };
+             }});
+    }
+
+} // namespace Bench
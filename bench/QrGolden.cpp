@@ -0,0 +1,469 @@
+/**
+ * @file QrGolden.cpp
+ * @brief Regression guard for the QR encoder
+ *
+ * Every version, error correction level and mask (including the automatic
+ * choice) is encoded and the module grid hashed. The digests must match
+ * kGolden, recorded from the encoder as it was before its bit buffers and
+ * grid were packed into words. Each symbol is filled to capacity so
+ * padding and every Reed-Solomon block layout are exercised; the segment
+ * mix rotates with the version so each level sees numeric, alphanumeric,
+ * byte, kanji and mixed data with ECI designators of all three lengths.
+ */
+
+#include "Bench.hpp"
+#include "utils/qrcodegen/qrcodegen.hpp"
+#include <cinttypes> // for PRIx64
+#include <cstdio>    // for std::printf
+#include <iostream>  // for std::cerr
+
+namespace Bench
+{
+    namespace
+    {
+        using qrcodegen::BitBuffer;
+        using qrcodegen::QrCode;
+        using qrcodegen::QrSegment;
+
+        constexpr int kEccLevels = 4;
+        constexpr int kMasks = 9; ///< -1 (automatic) and 0..7
+        const QrCode::Ecc kEcc[kEccLevels] = {QrCode::Ecc::LOW, QrCode::Ecc::MEDIUM,
+                                              QrCode::Ecc::QUARTILE, QrCode::Ecc::HIGH};
+        const char *const kEccNames[kEccLevels] = {"L", "M", "Q", "H"};
+
+        // Generated by ultimate-control-bench --print-qr-golden
+        const std::uint64_t kGolden[QrCode::MAX_VERSION][kEccLevels][kMasks] = {
+            {
+                {0x55e6beb795e537ccull, 0x1ab82c772bd4ce6cull, 0x55e6beb795e537ccull, 0x117d9639caf5c600ull, 0xf7cc38f398390b04ull, 0xf1691b68e2fa085bull, 0x99a7bd2c110900e5ull, 0xb2e9576aca23ae1dull, 0xec4e14448f0c0fd1ull},
+                {0x5baed4f9bef1fd09ull, 0xa2d019db41435b1dull, 0xef74efd7b26b7365ull, 0x58c50645581f5659ull, 0x5baed4f9bef1fd09ull, 0x9f428e7eb279628eull, 0xb21a47acaaac7770ull, 0x179f215e9108d268ull, 0x9715c021e7f94ec4ull},
+                {0xe1bb3d89c18e16ecull, 0x8ec218f85707218cull, 0x02254c8d39fc8e8cull, 0x6666caf2d8d8d3c4ull, 0xe1bb3d89c18e16ecull, 0x833a5d9ad95b5dafull, 0x9cadf66968d49f85ull, 0x61cff49dd25aa719ull, 0x2a389866b7075535ull},
+                {0x2c8e7f831d16cb83ull, 0x9b2a91bcb883c5b3ull, 0x2c8e7f831d16cb83ull, 0xdac24c94a13f88a7ull, 0x4a0d130dbec786fbull, 0x9228e1f9c7034d34ull, 0x39e49ac96edf250eull, 0x815e5f478cae5f1aull, 0xd5ca339434a5ea62ull},
+            },
+            {
+                {0x376592897f5602feull, 0xef2b7a9faed73ec6ull, 0x376592897f5602feull, 0x0389382da1b6ce5aull, 0x5ddc8e67b01b08daull, 0x9e32b3e6b2c06b2full, 0x558795f4e4814cd9ull, 0x6abd1d4176848769ull, 0x23ec6dc7d3b4c3fdull},
+                {0x74f8338234841ec6ull, 0x74f8338234841ec6ull, 0x1b47d82dcde70252ull, 0xe2f12b83df27f71aull, 0xc3f2fdbd871a4a1eull, 0xb4cefe1289f8be83ull, 0x2b814234203d3409ull, 0xc829593798ece2d9ull, 0xc12c4868ab0d06b5ull},
+                {0xe1082685227dd72cull, 0x33fe0c130b2a43f7ull, 0x0c123abdf0ba9a6bull, 0xa9204898cf2f2d03ull, 0xe7e4fa4523d92df3ull, 0x7763eab1fbd23166ull, 0xe1082685227dd72cull, 0xf8ac994a460d4890ull, 0x0429e303427e9340ull},
+                {0xb91996f43b3bac15ull, 0xb91996f43b3bac15ull, 0xe36901fcac9eae1dull, 0x4158d12824265b45ull, 0xf1e8aeaf46828d5dull, 0xe48e0beaec3fd180ull, 0xe70c4b7ae2cf45a2ull, 0x82ab9ed35838109eull, 0xf6e581a3efc39ffeull},
+            },
+            {
+                {0xe254340f080d5cabull, 0xae03fb7e00cda23full, 0xa2ec47f98d11e69bull, 0x59278779eefbde0bull, 0xadbc63e83f3452afull, 0x9bbc449bfc2624b4ull, 0x2dc64d6da3512769ull, 0x93bcbd98375e280full, 0xe254340f080d5cabull},
+                {0x37776fb177c48a3bull, 0x0599238ae23ff978ull, 0x9caab3b5d19d751cull, 0xd9c1b841fa1650acull, 0xb21b0a4f356f9e70ull, 0x37776fb177c48a3bull, 0x1c66978f635cbf4aull, 0x17d2a0d1f1ccf8a4ull, 0x19118b07b2c2ae94ull},
+                {0x0dc64699b426bcaeull, 0x1221a8cc6379261dull, 0x188adc4ba16730a9ull, 0x1ad31be8dd6aba79ull, 0xe9be7b32321f0b25ull, 0x0dc64699b426bcaeull, 0xb111a194b5108913ull, 0xa19a851f6e840585ull, 0xa479194eb8c0767dull},
+                {0x51e23bf1a2d67e93ull, 0xee210a0c4150014full, 0x51e23bf1a2d67e93ull, 0x42f7bf9fa0d803afull, 0x2e8a13916bb41c4full, 0x3838856f75b9d7c8ull, 0x7915fa8538b4dcddull, 0x9a3a045a0ba1d4b3ull, 0x00de73508b3e942full},
+            },
+            {
+                {0x38287e498a2dd3e9ull, 0x0ff9f4600e531479ull, 0x38287e498a2dd3e9ull, 0xbfbc4fe237666401ull, 0xde3474a266f35f5dull, 0xab39a91ea9769efcull, 0x91d8ad4094927aacull, 0x674025645773720cull, 0xeb3e1323805fac48ull},
+                {0x44519fa4d225d147ull, 0x665d2027c7a1b456ull, 0xa2fd2b89cac802eeull, 0xafa0966fc33c7512ull, 0x1a921932d5390ce6ull, 0x44519fa4d225d147ull, 0x946665394665d4bfull, 0x1a065f72fbff3e07ull, 0x73848a4b53eaa5afull},
+                {0x7375d27c7f95660dull, 0x7375d27c7f95660dull, 0xbbd86af3e02f0c7dull, 0xcf13561a642409d1ull, 0xd8bb277aa8ee5b81ull, 0x21f631b21b28b6f0ull, 0x6c12e33d9db1c5f0ull, 0xcc36111960b2581cull, 0x55c9e9bec58a9d50ull},
+                {0x6daf93f0f0a601f0ull, 0x3265cc529e9bdf99ull, 0x395e42c13ca78e91ull, 0x3deb1cbdd4430331ull, 0x6a4f118b4b14d64dull, 0x0b0d110a60114e80ull, 0xd4fafb1a6280ceb4ull, 0x6daf93f0f0a601f0ull, 0xe2b89ec43725e6f4ull},
+            },
+            {
+                {0xc3c4fee46d9acf69ull, 0xd5b9e25934c07f0aull, 0x65a4e6e613a7cba2ull, 0x860f7ac6df5ca366ull, 0xcd7db0acafd77876ull, 0xc3c4fee46d9acf69ull, 0x7a3760b693783e41ull, 0xfde9bfd0dd938e6dull, 0x48295d57abae0621ull},
+                {0x45eeedf259d82ab2ull, 0xdbe15c52046207feull, 0xbb4c1651e2f7eeaeull, 0x64bbff979451db1eull, 0x45eeedf259d82ab2ull, 0xcbd821e732d7f459ull, 0x715675e6ccc1c8bdull, 0xe5042296f594496dull, 0x8501e76c58d21cfdull},
+                {0x5421143c832edc95ull, 0xc2c7812ff65e0811ull, 0x5421143c832edc95ull, 0x885190f8b093c6c1ull, 0x720fb49dfd4d391dull, 0xb9c787cbf99bb29eull, 0xad603188a61ce6ceull, 0x541988fc5848bceeull, 0xf595509af6426256ull},
+                {0xc1982d0d2668cfbbull, 0x110f32e89243fe1bull, 0x1be68ee663ba0cd3ull, 0xc1982d0d2668cfbbull, 0x993ba04f49d9f227ull, 0x34a28481f428876cull, 0x7224ca3a7eeebf7cull, 0xf3256e449957167cull, 0x138321e73e8e345cull},
+            },
+            {
+                {0x4356c1cb19819bcfull, 0x9646cce3d03a532bull, 0xfcea92371dd943ebull, 0x298947538ef1018full, 0xc3ceb4f4b72087f3ull, 0xfd2c9fa9da04b7e6ull, 0x8c6e6adecadf30b5ull, 0x00865872c630314bull, 0x4356c1cb19819bcfull},
+                {0x1f6b414b0a88bd74ull, 0x829c54a9d68a79c8ull, 0xaccf5f5c7fef4548ull, 0x0188f9d867b305c8ull, 0x1f6b414b0a88bd74ull, 0x2eeb19212b1b690dull, 0x9fc0cebaf1a631baull, 0x4c8cc28094fe420cull, 0x9a132b27c29b4878ull},
+                {0xa78f5a6eb9fda9e6ull, 0x7e8b5934af0a6b62ull, 0x75b48b8bde208deeull, 0x7f27332085c4dd1aull, 0xcccfc91bb8060816ull, 0xe28ec1c192e90907ull, 0x29873f6acc8a2910ull, 0xf66c7212afa27a52ull, 0xa78f5a6eb9fda9e6ull},
+                {0x4c835d7d4106fd24ull, 0x95e1435cb1500bdcull, 0x4c835d7d4106fd24ull, 0x6f60770cf29ac60cull, 0xbbf7e4af6440261cull, 0x0129a86d4ed85975ull, 0xf2a4c270f1e65e42ull, 0xc7b8056b24960600ull, 0x6b777bb13839eee0ull},
+            },
+            {
+                {0xa93684a69bb5be24ull, 0x6cbd2a1a05999da5ull, 0x133ae9757b8eb5f1ull, 0xe04117535b6319bdull, 0xd25fa7d83c2dcdbdull, 0xb69ed8114ad9067aull, 0x5a841eec3dfaef2cull, 0x37da208f3bc8275cull, 0xa93684a69bb5be24ull},
+                {0xeea3081e16d0c4dbull, 0x7d34a69d708369ffull, 0x56e92d8a8c285efbull, 0x3cbc465965edaa6bull, 0xeea3081e16d0c4dbull, 0xe4d246af015d18d8ull, 0x63be3a0aec152672ull, 0xdd669559243bf786ull, 0x903dcb0fe839292eull},
+                {0xebfcf24024c62093ull, 0xebfcf24024c62093ull, 0xff85591dcda4c2a3ull, 0x3e33d09a99a75bf7ull, 0x929182dcd1d8a5d7ull, 0xde27c6f065e84270ull, 0xed6d6cd70a1c236aull, 0xc0faa65ea9d970baull, 0x05bd22fe29cceebeull},
+                {0x58f949a3d46b1912ull, 0x9fb2ec1288d55de3ull, 0x37b6536456231053ull, 0x152c7508e135ce03ull, 0xab4af37551023aa3ull, 0xc9ce3f2afb6e0eb4ull, 0x6f93085eaf3ad1faull, 0xff827259eabdd136ull, 0x58f949a3d46b1912ull},
+            },
+            {
+                {0x38af8cacf06633efull, 0xbfb9d79a219ecbb0ull, 0x058f18cc374c0b34ull, 0x975181cc96baf1e8ull, 0x1edb3410b140d650ull, 0x3f187887fac363c5ull, 0x38af8cacf06633efull, 0x6034635b9451751bull, 0x9cb83e54e2b7927bull},
+                {0x555e9797c0b9d5deull, 0x74d2fcdcb72ff93aull, 0x555e9797c0b9d5deull, 0x27971385ef8865d6ull, 0xda62de92c4f339c6ull, 0x10378883079e0cefull, 0x9707406565014b11ull, 0x05e194eadbb8a8a9ull, 0xe0c2ec576dc42135ull},
+                {0x5c31b6860279a1d4ull, 0x5c31b6860279a1d4ull, 0x276f8cc73c5a3070ull, 0xb916a6a0553c02a0ull, 0xd798bcc644681708ull, 0xe4844bcf3272d3e9ull, 0xc4c26eef1e925f43ull, 0xbee2fa9d8e8da35bull, 0xf782e7112680c3a7ull},
+                {0x8aae509be415e17aull, 0xa46206f49a7aaadaull, 0x1c4b89beeeee52daull, 0x8aae509be415e17aull, 0x48361f9c9980c482ull, 0xff4fd6c2478a308full, 0x13513dc86cd5f651ull, 0xd91b07c1a371e6a5ull, 0xb2e51dca1c142f1dull},
+            },
+            {
+                {0x6a3964df7ebf4b97ull, 0x5e49ef2d1aaa18c7ull, 0x215c919a49af3823ull, 0x6a3964df7ebf4b97ull, 0x11e419db935d41cbull, 0x272cb74e10497c74ull, 0x4c7a321938ae08c1ull, 0xeceb82e1005ab653ull, 0xad36b56ab5717bb3ull},
+                {0x770f0e57880926afull, 0x2f31ba63ac9bcaffull, 0xf97ab90e3ddfb2c3ull, 0x770f0e57880926afull, 0x2d0dc58539a7ec7bull, 0x631d0fa94bbfa590ull, 0xd65dc4c41ebde74dull, 0x5b76b31c65daca27ull, 0xdd7be01b711204fbull},
+                {0x1a68343617df2cb9ull, 0x517d8087814816faull, 0x5cdcb6eda1a2d90aull, 0xa0e5e084c6e01742ull, 0x131f169c019dcab6ull, 0x1a68343617df2cb9ull, 0x6ae74663f6ca7808ull, 0xb461f4933ec1897eull, 0xde2943a308ad5bf6ull},
+                {0xcb764b6d51aa9e20ull, 0xc937e0b3e451e918ull, 0x17182c69a6e46280ull, 0x38079c9039427f30ull, 0xe0bf8b0dcfc5b8ecull, 0x4fdbba37b11d5a67ull, 0xa392364e03c19132ull, 0xcb764b6d51aa9e20ull, 0xe31de58415502304ull},
+            },
+            {
+                {0x4e2d214241186a91ull, 0xa2d101a50ededa2dull, 0xc04924ddc38d95c5ull, 0x4e2d214241186a91ull, 0x70bb76b8ce995aedull, 0x46998fec2bf918a4ull, 0x3143773c2297bd50ull, 0x708922566666b3b0ull, 0xd2986df2f9e461d0ull},
+                {0x96b8947769cec683ull, 0x3d71ff8c28fc5cd2ull, 0x9975b3a5cbe87d02ull, 0x975be523a327dff6ull, 0x97a3e2087b8c1ebaull, 0x96b8947769cec683ull, 0x3996460611ea38b7ull, 0x5ec0e3dabf62f333ull, 0x44e8471cd3e3de7full},
+                {0xef02839d42f5cbfdull, 0xf3f55022985e7b50ull, 0x5f5c455f44fbee80ull, 0x205cbe6075af9184ull, 0x9bc5cece3c641804ull, 0xa13eec3a71d9d79dull, 0xef02839d42f5cbfdull, 0xb84b85f406533e39ull, 0x58e878f8c3bcfc85ull},
+                {0x2c510d33fd320f01ull, 0x8b27fb92043db6bdull, 0xcbff00efe284d2f1ull, 0x2c510d33fd320f01ull, 0xb3bab36489913951ull, 0x8c1ea9d6c170b130ull, 0xf76448cdb51627c4ull, 0x2442a66e3ab67818ull, 0xe64d6826fc37f094ull},
+            },
+            {
+                {0x581a5fc2a3589050ull, 0xf6fe9ac5f4b5d608ull, 0x53556ff2defefefcull, 0x581a5fc2a3589050ull, 0x6f90b84deb84c94cull, 0xbfcf3b337fa437efull, 0xe2ec98897362a25bull, 0xd95d497c19d5fa43ull, 0x6455edb4101fa63full},
+                {0xb9f41cf76d7a99daull, 0x1dfbc0e4f580d482ull, 0x51e72bb27f0314ceull, 0xb9f41cf76d7a99daull, 0xddba46d13919f56aull, 0x181ecd15ded93b3dull, 0x99d41eff4b867a21ull, 0xef29d67bcbb5b415ull, 0x174656eba02bb1e9ull},
+                {0x7fab2ad9a8407859ull, 0x1993c6674b236711ull, 0x5bfe69d3801a353dull, 0x7fab2ad9a8407859ull, 0x2fa90b4eae1d4f8dull, 0x4f1d54914826ab36ull, 0x07f653d78f558e82ull, 0x38f7d10eb738f6c2ull, 0xec53591004c96b52ull},
+                {0x645858fe126fe27aull, 0x82706c928755d15dull, 0x1a6607b1ca143d31ull, 0xd159144bbbdd96f9ull, 0xdb1d84f357832ce1ull, 0x645858fe126fe27aull, 0xce838054fcd58a6aull, 0x81452890d2ee78deull, 0xd3f732318c4acccaull},
+            },
+            {
+                {0x525b11efa839a7bfull, 0xcdc65b9cad9def02ull, 0xd1c57015d5371991ull, 0x525b11efa839a7bfull, 0xc797e6c051c2edffull, 0xcb766796e050aa94ull, 0x4e27bbdf3bc33802ull, 0xe9ce938a2a4b514eull, 0x6c3621a9e08c6ce5ull},
+                {0x1c978ac3ba43242aull, 0xec8e802238f55767ull, 0x0535cea1d4c0938cull, 0x8f5f1a3b589d3b4eull, 0x1c978ac3ba43242aull, 0xb55aa8668e147b6dull, 0xf51c579dd706477full, 0x02eb339844951703ull, 0xcd646aae424058ccull},
+                {0x67d55d179a427a70ull, 0x996087d3e23d61afull, 0xc078f58b7c85fc04ull, 0x2795910155f1efeeull, 0x16b1186aae83cda6ull, 0x4e5ceaf631eb1a6dull, 0x400ba2957c6350a7ull, 0x92461136802ff3abull, 0x67d55d179a427a70ull},
+                {0x20840dba4be7799cull, 0x9b3757dd8da5f5b5ull, 0xad76eaad40a8c15aull, 0x20840dba4be7799cull, 0x7de8c5dbf75ed428ull, 0x2b3ff3bc24976923ull, 0xeeaff5abf13581c1ull, 0xfe490f9736b2238dull, 0x450df3ae0af896e2ull},
+            },
+            {
+                {0x6f52544d1af3c801ull, 0x6f52544d1af3c801ull, 0xd0fcd539fda16c72ull, 0xa1a51566e7b02a82ull, 0x2f4889f90680293bull, 0x098cce6d3fa94193ull, 0x44bcb2f5ed048e70ull, 0x726300529b27aee2ull, 0x20203ae51998fe0dull},
+                {0x777d9975882cef96ull, 0x777d9975882cef96ull, 0xb01806e802f231bdull, 0xe91181534de715e9ull, 0xbcd3452aea9c1a5cull, 0x4e8ab74400478178ull, 0x2adbb0f4558691a7ull, 0xf34aee6f81c9757dull, 0xf6d110d615f6f8daull},
+                {0x840c48f0baa25064ull, 0x20284dfe93027f3eull, 0x4c7af28cec542035ull, 0x2b12f239fa988111ull, 0xd265a885a5c289fcull, 0x840c48f0baa25064ull, 0x51b5ed44e4b9864bull, 0x60915af1ce878119ull, 0x89617166ed54cb3eull},
+                {0x367575b222e80732ull, 0x71a295c86930d3a9ull, 0x28b23a64a7d259faull, 0x367575b222e80732ull, 0xe51b1925c6d64e3bull, 0x63d60adcfdac2b5bull, 0x4138dbf382e15050ull, 0x2d93b170540a1392ull, 0x39135a4bd317ca95ull},
+            },
+            {
+                {0xada402d66fb06d44ull, 0x8573722183404b6aull, 0xada402d66fb06d44ull, 0x74dcb91fd9a3c8c9ull, 0x020806119d9d252dull, 0xe6d0e82b8db61dfbull, 0xf1fb7d7ba1ba2271ull, 0x8ae306aeb8189053ull, 0x0298466f5f287a3full},
+                {0xee68fe813d6daf62ull, 0x77e46aa21d26c453ull, 0x19c3521cc8114569ull, 0xe7efb898029d3718ull, 0x995944530a69556cull, 0xee68fe813d6daf62ull, 0x760ff51bd2f0b514ull, 0x1f452d4b6d7449faull, 0x442f05f57ecbd18eull},
+                {0xcc2eb5f30ff6496aull, 0x0680e4f1a957a015ull, 0x0ed6ff00060b826full, 0xcc2eb5f30ff6496aull, 0xccb49a21a3b9fdbaull, 0x8dddca598529e9e8ull, 0xdfae34f02bfe72f2ull, 0xffca49fed75eae50ull, 0xaaca28cc7c34a128ull},
+                {0xcda05bcbdf9cbdc7ull, 0x5bf1192e94b959c8ull, 0xf726915285daa12eull, 0xcda05bcbdf9cbdc7ull, 0x2a3c80ceaf120c4full, 0xae1736aba1de0ec1ull, 0x529d723640f4ab67ull, 0x6a49a27d38dad29dull, 0x16cc4478bcf505a1ull},
+            },
+            {
+                {0x672351a8d1975e04ull, 0x6b09296f5abb652aull, 0x672351a8d1975e04ull, 0x2b6cd9c492a63226ull, 0x7d71a6e8ac7f6673ull, 0xd27d961f791b679cull, 0x1fb6aadd3c28d9fcull, 0x84170de76139b486ull, 0xe3fae42933552a2cull},
+                {0x516abf58c36619d2ull, 0xc129a8dede5342d2ull, 0x3a485e05a7e43d60ull, 0x516abf58c36619d2ull, 0xacf9e070bb37b8fbull, 0x9f5c4c80af604640ull, 0x2a53e7a7171392bcull, 0xf0301822873ea66eull, 0x59d3c42587f2cd20ull},
+                {0x3d9efe0f9fb3c10full, 0x6dcc357b232b560dull, 0x3d9efe0f9fb3c10full, 0x1fb4d582c80cce05ull, 0x379c9f5d5f782078ull, 0xaa5f91aa73c9760bull, 0x02e3a11207710cb3ull, 0xa7ddb657971e1d99ull, 0xdb377d945c7a0d57ull},
+                {0xacf98502087979ceull, 0x95125601c4ed54f2ull, 0xc827c12c2bf21bb0ull, 0xacf98502087979ceull, 0xc5b7742faaa3677bull, 0xd629df93f8b7f924ull, 0xb9b11193e5a13e14ull, 0x1625f895e1ab8856ull, 0x10e85646281e3c4cull},
+            },
+            {
+                {0xad70e0ea262ff24dull, 0x7f939ca937ca8b99ull, 0x2ef728080095edcbull, 0xd5a34d420468bad1ull, 0xad70e0ea262ff24dull, 0x78807708ac26502full, 0x458c295fd6a24106ull, 0x8c3d94389f498246ull, 0x3d71a8a7739acd1cull},
+                {0x034d09565c8e6d94ull, 0x37ac51846bc713c3ull, 0x2b53fad9755c05e9ull, 0x4260a32465c3107bull, 0x45fc963dce01ca9full, 0xb0e9cb3a9d44e61dull, 0x034d09565c8e6d94ull, 0x66de1b6fcb75e9b0ull, 0xbc66a341c76d93e2ull},
+                {0x426daf470cf23eb3ull, 0x426daf470cf23eb3ull, 0x043b9b09b8e38451ull, 0xa827e7f99a76a6a3ull, 0xd501cceeb2398a77ull, 0xcec91da1047aee9dull, 0x6235b4ff88a0bcc0ull, 0xd395023cd8c8f854ull, 0x9fe47eb89ff14256ull},
+                {0xd03d2871c3c8372cull, 0x34d1ff39c3607a70ull, 0xf502bc89ab547ff6ull, 0x4120077ffed15428ull, 0xd03d2871c3c8372cull, 0xcf1f9d028b85b93eull, 0x0196253de6ab957bull, 0xa6789e0bcadf6dcfull, 0x97012f354878fa9dull},
+            },
+            {
+                {0xcfdf27bd2cde9b3dull, 0xf64b3b628fb67dffull, 0xae3b764624c4a551ull, 0xa7b2895a813c01f3ull, 0x2eb2176de1351db3ull, 0xcfdf27bd2cde9b3dull, 0x9388a959f1579f3aull, 0x5a313ae24e5c1060ull, 0xa1698cd89b47a8ceull},
+                {0xe9b51225904123bcull, 0xcc1e2873c6ee35c4ull, 0x1142f91b4eb9b9faull, 0xe9b51225904123bcull, 0xa9254614979abc24ull, 0x8814ecb9db76dcfaull, 0xfff256396bf831e1ull, 0x91c0891fbabf9ee7ull, 0x419878e370c53339ull},
+                {0xfad9fafcc95f8522ull, 0xfad9fafcc95f8522ull, 0x2c4cbaca9d75fe10ull, 0xe830e011f79fdfaaull, 0xcb663b91b1d4e0e2ull, 0x49aa664213b0176cull, 0x41b4b08333bed2ffull, 0xfe25297f22a99375ull, 0x0e76f1a84924d2f7ull},
+                {0x50625e36c12894eeull, 0x85c1ed543d40854aull, 0xc1393003b05a9418ull, 0x3fb9b4bbc5827972ull, 0x50625e36c12894eeull, 0x57246872398c69bcull, 0xfabc4f51cd4b88f3ull, 0x330c5ee53f8e13e9ull, 0xa24f286aa5a6824full},
+            },
+            {
+                {0x0d6816706370d9cbull, 0x40b949a77f76dbe5ull, 0xd779da025bf6b717ull, 0x1e8d408f7684db9dull, 0x6d271d4389b718b0ull, 0xbcc36dc54cdc35e3ull, 0x94565843e0d0c11full, 0xc2de9cf5ee458461ull, 0x0d6816706370d9cbull},
+                {0x7c3f7855c1ad85a9ull, 0x68ecfa44c5fca639ull, 0x98f62c3af64f94abull, 0x1f8bbcc7f7857a91ull, 0x3bfa62d3ddce6264ull, 0xee9ecf569ad04897ull, 0xffb4b93fe34e37cfull, 0x7c3f7855c1ad85a9ull, 0x52b67fe7d9cb057bull},
+                {0xb0535459c02d08d6ull, 0xe9b893d1c69e65deull, 0xc65ce7cb5703eb28ull, 0xb0535459c02d08d6ull, 0x16f5a54163dba8abull, 0x38376fb821a24218ull, 0x8c79ad60f9a0b39cull, 0xfd629f9b1f6d60a2ull, 0xf8122b4e042e2044ull},
+                {0xf1ed464b765de3b4ull, 0xbfd15b3655b28014ull, 0xfd100305f968c0b2ull, 0xf1ed464b765de3b4ull, 0x9fd72cb15d8947cdull, 0x8d45135ea1dfd1a6ull, 0xef8192a37f9f785aull, 0x2b1045c0e6882da0ull, 0xb5e284f3d148fdf6ull},
+            },
+            {
+                {0xcbcedb02d72ce4baull, 0x681311c7681d89acull, 0xad6d96bed3342d92ull, 0x86676e1b0348e238ull, 0xffafae1bb0db901cull, 0xcbcedb02d72ce4baull, 0x1f05b14078c34e1bull, 0x900450c36fbb2af3ull, 0x6f93cc4e3e973ea1ull},
+                {0x787cbfd249d29ebeull, 0xdfc196f260eba0c4ull, 0x47f7d6181ae1abdaull, 0x89097accf2031434ull, 0x29ce588034f7ed38ull, 0x787cbfd249d29ebeull, 0x74fdcb80b1ac0ec3ull, 0x03e21f873268ad97ull, 0xdc8fe605472979f5ull},
+                {0xbe9a902b182e6e79ull, 0x453ddf50fc66a94aull, 0x8eb03c60fea1ead8ull, 0x30c97a91161da91aull, 0x2331df4f415d6c62ull, 0xd54a1fe307cf7cc0ull, 0x0b000ac1e599eb85ull, 0xbe9a902b182e6e79ull, 0x6f03f81ed95efd63ull},
+                {0x48843fc21b294aacull, 0x5969c3d175ce9ac6ull, 0x48843fc21b294aacull, 0x267557983fb20d3eull, 0x647e341fb21b5c12ull, 0x54fe5f0ea92b5ebcull, 0x96230ec21db863fdull, 0x69bc5160656b8299ull, 0x7cc7ef64e14c0177ull},
+            },
+            {
+                {0xfc9dbaab0a5acc8cull, 0xd08ca9ac5cc7a1d7ull, 0xc5a220872035cd10ull, 0xfc9dbaab0a5acc8cull, 0x5fc97dea15382772ull, 0x4c205bcf7cf1b96aull, 0xb8325ae0fa756b37ull, 0x79ca370a63940587ull, 0x8210cd9bfa415500ull},
+                {0xa4520fda918c61d6ull, 0x22973da836c8091dull, 0xaad88416974e0f5eull, 0xa4520fda918c61d6ull, 0x452fea169f0efbf8ull, 0x54f284eea974ed08ull, 0x727f5c4450cc6d81ull, 0xca7d2e42c1236bedull, 0xc21ab55698ef148aull},
+                {0xe4c4d1cd1194e32dull, 0x14ad10eef88c4619ull, 0x49928ec546c06322ull, 0x6ef5464cb4eca852ull, 0xd29adb11369e3d8cull, 0xd21bebd7a5de4868ull, 0x01f3b329aeca01b9ull, 0xe4c4d1cd1194e32dull, 0x3cca3a523ee668faull},
+                {0x925bb889d1aa109eull, 0x556e4fbc70f416a5ull, 0xda962c02253adc9aull, 0x7c0e23a1d00f46aaull, 0x20534905979bd7bcull, 0x42d2ac7ad6ef36b8ull, 0x39bc2ec1ed340fc1ull, 0xcd796c9efa35e209ull, 0x925bb889d1aa109eull},
+            },
+            {
+                {0x4806c05854feb32full, 0x3cf3038ae4c6e186ull, 0xc7716b1eb174c7a8ull, 0xd02d8572cd0ea28eull, 0x4806c05854feb32full, 0x422efc9e42a5ffd8ull, 0x1655d55c1c26d210ull, 0x560f9f4e89c66712ull, 0x0d0aced3fced8614ull},
+                {0x1ecf1d363dce1b50ull, 0xa6c92c61f0febd90ull, 0xcbf1e3e7cbc591d6ull, 0x1ecf1d363dce1b50ull, 0xee9d988874f558cdull, 0x8773c5d55239e16aull, 0x6ec2fe05733246eeull, 0xffa04b0c0da2607cull, 0xf79fad7b0b8c48eaull},
+                {0x1ade83be027f1addull, 0x96de6c97c2d90dcfull, 0x7373050eeefcb229ull, 0xb87d4c46ec342173ull, 0x46bc297ec7ac696eull, 0x1ade83be027f1addull, 0xbdb4b0a304386ef1ull, 0xa4a417c37c09fe4full, 0x6461e892e18d843dull},
+                {0x174e6217a43908ffull, 0x174e6217a43908ffull, 0xb1445520cca4916dull, 0x3fcf552c5cf5d8d7ull, 0xaa398435056a540aull, 0xad017887edc8ec21ull, 0x86752fcba70d9831ull, 0xba473971e3e0f65full, 0x3fec278c9eb553fdull},
+            },
+            {
+                {0x20734a7578b4896aull, 0x29c5568a561c8da9ull, 0xf9e8e15dc938b8dfull, 0x09cd1b92359e6e89ull, 0x8cda8e460c66ab89ull, 0x679fb4abac2c7eafull, 0xb245459e4e865f56ull, 0x20734a7578b4896aull, 0xdbfb646717aec404ull},
+                {0xb38f755b241387b9ull, 0xf0d30cd55c45553dull, 0xb0dc59593815ace7ull, 0xb38f755b241387b9ull, 0x212526f155ebd33dull, 0x957e508e1d9618e3ull, 0x762b1f7713a9ddc2ull, 0x42c5c559fde417f6ull, 0x31892c9a3dbe6fd8ull},
+                {0x542d79980881ae62ull, 0x9dbf4ebd26777971ull, 0xf26e02f2d590cc5full, 0x70bb2a8889974249ull, 0xb66ed877ff3c7405ull, 0x17b3a46b369f2187ull, 0x542d79980881ae62ull, 0x7e04b1cfecb23fc6ull, 0x6c369c070500faa8ull},
+                {0x1fff5636d29e6f04ull, 0x708eb619f9c806eeull, 0x159e3643d9fb3498ull, 0xef05f17ed46c9aeaull, 0x31f52dc4b13eaae2ull, 0x1fff5636d29e6f04ull, 0x0cb589fd27147ae9ull, 0x79a47282ecc1e0a9ull, 0x4ae014777cdba877ull},
+            },
+            {
+                {0x45b505810616aeb9ull, 0x4cb634e34985e4e1ull, 0x772467ab2c791737ull, 0xa2692baf396c9d7dull, 0x45b505810616aeb9ull, 0x0d7e9d00d5a298f3ull, 0xaa3af08c0d159ed0ull, 0x89bd83979f57418eull, 0xa2521433d93a11a4ull},
+                {0xdc60c7f4e302237eull, 0x20b0e020e69626b5ull, 0x0f150c19472505c7ull, 0xc5056ada98896679ull, 0x77f53f040c81bc3dull, 0xf497012395bf04e7ull, 0x1ff3a48644035470ull, 0xdc60c7f4e302237eull, 0xed54027c62318d7cull},
+                {0x7f5dbb8a3d2ff9d6ull, 0xe23100d4e264976dull, 0xb4238104d5951b83ull, 0x5d634c3b588b558dull, 0x2464c67aa605f165ull, 0xce993fb55954029full, 0xb1ea8aa478fa1698ull, 0x7f5dbb8a3d2ff9d6ull, 0xb1c04d69208c613cull},
+                {0x91390d8a7441e24dull, 0x18fff7361803d20cull, 0xfce4194135ca3edeull, 0x11aecb165afc06a0ull, 0x6dbd5a85256f11fcull, 0x293bd68a12895e9eull, 0x91390d8a7441e24dull, 0x8b35926673861f17ull, 0x22d05cc880f7f9d5ull},
+            },
+            {
+                {0xbebffae5fefa34afull, 0x5a4cbb1ae6bef883ull, 0xd15eeef84d31141dull, 0xbebffae5fefa34afull, 0x15ce74d31df7eaa2ull, 0xd00ff627380f132dull, 0xeba16b266e8ea285ull, 0x7e7610b3ec6e1e07ull, 0xb933f64bea690aa1ull},
+                {0xc33a533fa2dc5685ull, 0xe12840751d4ed827ull, 0xd05ba2d190374e05ull, 0xb88aded40b1703b7ull, 0xd60eddea501a7766ull, 0xc33a533fa2dc5685ull, 0x356a13df1c5cfb0dull, 0x8ad1883ae29ce0b7ull, 0x24f05385f9075005ull},
+                {0xae61e47e2dc0eca5ull, 0x0e0748b558f5c45dull, 0xa0b2550ee2819c9bull, 0xa71f766182a1e259ull, 0x2c5baa8e209c5b40ull, 0xcb652f559a1fc773ull, 0x5f4a49b5895093efull, 0xae61e47e2dc0eca5ull, 0x1751efdc554a7a93ull},
+                {0x5f758ccd34615a51ull, 0xc0369ce9b571527full, 0x5f758ccd34615a51ull, 0x30df933476ae7407ull, 0x787d9f1e8b87c1f6ull, 0x0c5b9d11fd912989ull, 0xcc497b42326ab305ull, 0x92b6fdc71e24f76bull, 0xd2b944222000f771ull},
+            },
+            {
+                {0x4ade907327a0cf7cull, 0x483aec05cd6c55eaull, 0x4ade907327a0cf7cull, 0x389c61a7e8235a1aull, 0xbad3663450522a82ull, 0x1e2d8cc862eef280ull, 0xdf6a0ee15f566a69ull, 0xe5d84a83dc02b961ull, 0xba445e177330172bull},
+                {0x3be05092fe017ccfull, 0x1a72ec5b8039d8abull, 0x558fe4e7ab7ceb91ull, 0x3be05092fe017ccfull, 0x54fa78e5afcbbfb3ull, 0xe3e474cee7ceb935ull, 0x2021cc381492ecc4ull, 0xcf5e34f550202edcull, 0x3b9bd0556331fba2ull},
+                {0x6f6e974f5d6e2327ull, 0xe7538fe866701a90ull, 0x4d7dad2f4f615d2aull, 0x2ed18706fbab90d0ull, 0x2d4aad134c384218ull, 0x304fd2c3d0a2f70eull, 0x6f6e974f5d6e2327ull, 0xa89de7519317254full, 0x8b68c2c2b7f0d099ull},
+                {0x6733a325bb914fd5ull, 0xfe7619d8c27e992eull, 0x142739b4da6dbfc0ull, 0x4c30ba843495808eull, 0x662421d94d83fcf2ull, 0xa4b9f1e6923e3180ull, 0x6733a325bb914fd5ull, 0x66ad3114aca0fd95ull, 0xa453aac301b5495bull},
+            },
+            {
+                {0xe1444e9190f64eccull, 0x43fe0f1824373664ull, 0x5bb21028f55b75c6ull, 0xe1444e9190f64eccull, 0x9c231fd4bb2dca48ull, 0xee07aa99bf5d2142ull, 0x1a9cda4181e64fa5ull, 0x24ee7fd44c65cf5full, 0xc26f96a67b371a11ull},
+                {0x1b276309b67189a6ull, 0x03d29e51ff872fdcull, 0x1b276309b67189a6ull, 0xbadf6287f0308904ull, 0xeaa23646e67103a0ull, 0xcab1a6f94f78e3caull, 0xddc181c32112a3c1ull, 0xa8034f584aca7b5full, 0x79c6cb50938a5fcdull},
+                {0x888b44b91770b11eull, 0x7d72ab3efc4fecfbull, 0x2ff325fc4ba057e1ull, 0x62997671786f8f6full, 0xfcdafd6da32f3077ull, 0xc3a60f7b6b546e4dull, 0xb6529b1c7e6e7f12ull, 0xce8df977ae229358ull, 0x888b44b91770b11eull},
+                {0xf9e27864828767e0ull, 0xf9e27864828767e0ull, 0xd002635e7600439aull, 0xf1c78e0e9558922cull, 0xde88565250729ffcull, 0x092999c3e32420caull, 0xa2e8b6aa2fdeaf45ull, 0x6d55150957189dffull, 0x23c16dee4ff9de01ull},
+            },
+            {
+                {0x514b9de370b851beull, 0x1df57d9170f319beull, 0x91fa1e96c6f0b8e4ull, 0x0c2727d2c2fd2daaull, 0x514b9de370b851beull, 0x916c009f16668c3bull, 0x8ecc36dfdd8a2a06ull, 0xa20e596b151ee7a0ull, 0x1c3b0189d7629e0aull},
+                {0xe038c3d13d2582c6ull, 0xf65f277372a12472ull, 0xb3ed0f462793bfecull, 0x29dac8a81fe8567aull, 0x8e1896cb04afa1caull, 0x5c126b15a8b0e573ull, 0xe038c3d13d2582c6ull, 0xf6330927c22d4dd0ull, 0x668dc1145ddd2feeull},
+                {0x72b2cc65ea1ad4eaull, 0xaf5b32006252e922ull, 0x15d0687f93f953dcull, 0x165db4ea17145a82ull, 0x72b2cc65ea1ad4eaull, 0xd5cd68df5474acfbull, 0xdc92ec46b7bbce0eull, 0xf9ac853b5f2f4890ull, 0x1f8c08be8ad844c2ull},
+                {0x08b8069c68c38325ull, 0x14b4e198f027d778ull, 0x111b9e14fa2ed412ull, 0x637f93cbbaec3e9cull, 0x1fdfb1c80bea54b4ull, 0x08b8069c68c38325ull, 0xd97d1c512c6c4534ull, 0xcbc93827185f22a2ull, 0x9318625b8c092b30ull},
+            },
+            {
+                {0x213e8de7bda50160ull, 0xd81746df1d989070ull, 0x93e366bff8d4c419ull, 0x761b461242812c61ull, 0x213e8de7bda50160ull, 0x3d92c00122dec38bull, 0x2b2ea4328a9196dfull, 0x3fcc6a9c353b029dull, 0x9f752a4ae1861e30ull},
+                {0x00745ff96c13dfb3ull, 0xbd291314e67d1dc6ull, 0x277cfcbc545e341full, 0x00745ff96c13dfb3ull, 0x9afae10838a9c046ull, 0x0f31654e1c9b3d79ull, 0xc46ba5a08866e911ull, 0x979ea4f2b5814eafull, 0x7f3dd77555105562ull},
+                {0x49b4bf1f44a940bcull, 0x92bcf4ffa75e3525ull, 0xff0aa063ca0ac9f8ull, 0x49b4bf1f44a940bcull, 0xf44ec08a45e6965dull, 0x099ccab73ebda79aull, 0xd7529adb1f9b2346ull, 0xbb76daf8e3856b7cull, 0xaa93ae472a380bcdull},
+                {0xed831a401ad7a436ull, 0x2b1486574982eddbull, 0xed831a401ad7a436ull, 0xcc73dc0a8d340392ull, 0xb24497913f8abb5bull, 0x1ede571d0a6a5e00ull, 0x7513363b9b090088ull, 0xb6ba826e8b4bfb5aull, 0xc5b73b1806eb6a93ull},
+            },
+            {
+                {0x4199233736ca0a92ull, 0xfef3c53435780df1ull, 0x67998e5f05006d31ull, 0xcc8a1f038b0affd6ull, 0x4199233736ca0a92ull, 0x8f2bbd295829923bull, 0xe04aae5ca5daf314ull, 0x1e6ac30228dcbc3cull, 0xa058287944c3c124ull},
+                {0x462778c536c33f8eull, 0xe8fb2f3874d5d6fcull, 0xe2498f838ddca588ull, 0xf8c64e9c5caf754bull, 0x5fee8d73c1bb0827ull, 0x462778c536c33f8eull, 0x4015e46c4094f065ull, 0x5486ca30a5ff5175ull, 0x4ae764c4a60ff545ull},
+                {0x32bc2f8d7d1fc740ull, 0xf8a8d7b2b6d4b4dbull, 0x84ba43fbd6c2d91bull, 0xac2dadf631c0ca34ull, 0x32bc2f8d7d1fc740ull, 0x595863131d997c19ull, 0xcf2f111425edcd3aull, 0xada42336ed6d416aull, 0x8b7bb38d599b9982ull},
+                {0x7a61e97ad9a1055full, 0xa26a755e6a818dc3ull, 0x7a61e97ad9a1055full, 0x3d3a5c865c1e9460ull, 0x23dbdfcb524218a8ull, 0xe90989375d680259ull, 0x81f453ff1d611db6ull, 0x5a24a9c8cae3d4baull, 0xe0abb6366525d50eull},
+            },
+            {
+                {0x589345b066011cfdull, 0xe4784f3d32785977ull, 0x589345b066011cfdull, 0x2aa8d9446caf1396ull, 0x186e29e9f9c7cd4eull, 0x8e4ae6a0b5bff5c1ull, 0x56d2f1bfb755f9ebull, 0x2ac581bd28c6355dull, 0x69accf2a7865300dull},
+                {0xab38860e17b49db6ull, 0xd7b5fc21b9844c6cull, 0x5cc7035a8be3581eull, 0xecd097e375ef6b19ull, 0xab93038330a62fb5ull, 0xf6c01abeb3f607feull, 0x6ea4ca169b807d08ull, 0xab98797996fdea2eull, 0xab38860e17b49db6ull},
+                {0x2dd7fa351c5f9e61ull, 0xa8d2742cab23a800ull, 0x44cc43d6edab12b2ull, 0xe8d8072c06fe2689ull, 0x2dd7fa351c5f9e61ull, 0x10db624feccdd186ull, 0xd81315d42fba7c08ull, 0x89a8fdcce1eb3a5eull, 0xeeb7d8bdb24eba6eull},
+                {0xe5c97417aca1dcedull, 0x0e9c4657cfa7127bull, 0xe5c97417aca1dcedull, 0xcc84920251a9eb62ull, 0xbd3fff4692d69fceull, 0x50be24f70123de45ull, 0xc2c437cb2d0670abull, 0x5a7e18795ee11db9ull, 0x2690b4c9eddfabf5ull},
+            },
+            {
+                {0x8d7a626a569fd832ull, 0xde7173266afedf3cull, 0xe85272306244cbbcull, 0xcae510fef81bcba8ull, 0xe7261ed574a4766bull, 0xfcea8184e8eada4dull, 0xf76f1c15495b8558ull, 0x6d66f5d9a5faa67aull, 0x8d7a626a569fd832ull},
+                {0x894ab3656ab4a828ull, 0x2067e4500d7fdba1ull, 0x884f40f734c03081ull, 0x9b8fd8cf54534849ull, 0x277b139206fb914aull, 0x894ab3656ab4a828ull, 0x1a1f145dfc4e8919ull, 0x2c44c62b38669c5bull, 0x06f8129b2456fc07ull},
+                {0xb1f8ee86af367310ull, 0x7c2394e101061829ull, 0x615d8325d1157de5ull, 0x4ef809e2d343abc9ull, 0xb871611deab0bfeeull, 0xb1f8ee86af367310ull, 0x113a0eba89417afdull, 0x204041a994fa3b4full, 0xb399a10330ca154full},
+                {0x9656393b824e1256ull, 0x1176f5917a811638ull, 0xd2706a27e1f60404ull, 0x5dd6e4bf546246ecull, 0x55a318004d0676b7ull, 0xf2a7c3c984655539ull, 0x8baece9fcfde56b0ull, 0x9656393b824e1256ull, 0xea8b7a4c9f8abc1aull},
+            },
+            {
+                {0x0333ff85623ba6d1ull, 0xebcb69ab1aac8120ull, 0x3c3293cb93b20c78ull, 0x3e4356877723c55aull, 0xd4a38ba66bb8c656ull, 0xb0ccd1ef73dcc895ull, 0x0333ff85623ba6d1ull, 0x3766813c0c38d8d1ull, 0xe183f71b7d51acb9ull},
+                {0x57598ec5ba8009a1ull, 0x57598ec5ba8009a1ull, 0x14afb6cddea0a6b9ull, 0x50d7501137b789efull, 0x612dd5a7d8f6c133ull, 0xd9558ac9e85e6f70ull, 0x9554a2d7f9d4e060ull, 0x4347638a5fe7c70cull, 0xf0b8bd249948c204ull},
+                {0x9773d52bf46967c1ull, 0x6f37791b8d52c6ffull, 0xe5e4f1f36b171bcbull, 0x547156be1046c38dull, 0x9773d52bf46967c1ull, 0xb00bcf5f3483f7eeull, 0xe21e9b3f4752627eull, 0x6fc9e4365422c96eull, 0x451af3d39b24fd82ull},
+                {0x91b58dd11e5be54bull, 0xe5e5c448e43441f2ull, 0x67f35883f7ec4386ull, 0x9b9308aaa90ef798ull, 0x52e69ee403daf624ull, 0x91b58dd11e5be54bull, 0xf9a970fa708d6f9bull, 0x807873b9efc81903ull, 0x0b420fa81f0d89bbull},
+            },
+            {
+                {0xb43b8b84625f5cb5ull, 0x9273d12153734911ull, 0x5d71bc37bb2f9d99ull, 0xb43b8b84625f5cb5ull, 0xd33794ec43472467ull, 0x6e07944b4e71cd24ull, 0x6d3f642a170419c5ull, 0x791b15b8fd1f5dc9ull, 0xfef78142b500281dull},
+                {0xd900f5dab6d86525ull, 0x407f2b36dcbb3441ull, 0x445f8ca400424ae5ull, 0x813975fdd0039835ull, 0x378b3bacf8c02063ull, 0x512745f64ea93718ull, 0xd900f5dab6d86525ull, 0x103b50d48cb2da49ull, 0x85a24ef80e548759ull},
+                {0xfeadc2460909c95eull, 0xd945cf83b52a2a62ull, 0x55eefc41800d39a6ull, 0xfeadc2460909c95eull, 0x1422c6891f8be0f4ull, 0x82ff184b61834313ull, 0x1a5afe041915f0e2ull, 0x29b51c467086117aull, 0x2913ac8b9c183aceull},
+                {0xea0bcd58bf93f93eull, 0x26d0f4271d251652ull, 0xcc2540867a3537c6ull, 0xea0bcd58bf93f93eull, 0x09adfaf41e8da6d4ull, 0x431c786d9e3ade53ull, 0xa96408f6cd9afe72ull, 0xaa980fbbafd4cdbeull, 0x01647a7b1c00f2beull},
+            },
+            {
+                {0x040d1ea8adcfdbe6ull, 0xc6195b2c1bdc18a4ull, 0xf45372c2693ad347ull, 0xbd53d5ec58aa6a49ull, 0x040d1ea8adcfdbe6ull, 0x0e7faba8ac29eef2ull, 0x7f09a66e13ba7e87ull, 0x7f3195d166cdd1c5ull, 0xddfb90cf6f28b41eull},
+                {0x91620ba247e6c435ull, 0x546ca0644cb6a083ull, 0xa60b5e7dc3d67f58ull, 0x577dd79d60988a92ull, 0xd6ef51ade5f4f0b1ull, 0x91620ba247e6c435ull, 0x9ebb34ec8334bcecull, 0x57a4e022315a9c6eull, 0x32f3779e67b394a9ull},
+                {0x3436fc5099c87125ull, 0x172283321cebe493ull, 0xb6c94e1586c1fb14ull, 0x2243907d5d509bbeull, 0x3436fc5099c87125ull, 0xa9f9c4a2182acb41ull, 0xc09c46959e934c14ull, 0x38548d4146a12492ull, 0x49579423549eadadull},
+                {0x3eb0423a32346b9full, 0xa8c4e550d9c44026ull, 0x0036895018c0e9ddull, 0x3eb0423a32346b9full, 0x2cf1c4b4332000b0ull, 0x314943774ae7d93cull, 0x479c0038cc52d199ull, 0xaa697c7ee0bd7b5full, 0x2f690d042a61d784ull},
+            },
+            {
+                {0xda688604166bed63ull, 0x74db4e59f227061full, 0xc193ed239f401e87ull, 0xda688604166bed63ull, 0x549bf032b12133d1ull, 0xbe72471ff71f1077ull, 0x8fb0c8aac84a99fcull, 0x4d46da17c69aa7c2ull, 0xfedf0ef137ffc292ull},
+                {0xa480d5e5803749a0ull, 0xbec89f03affe292cull, 0x4a9a4a8ad6ea76bcull, 0xa480d5e5803749a0ull, 0x4431747811f9401eull, 0xab1472d23a5ce118ull, 0xf2b64fbecbe0d83full, 0x636eed6dbda5b089ull, 0x46a33cb6565142c5ull},
+                {0x9bb628126d16aa04ull, 0x3a8a8c198fa87b65ull, 0x8ba6d25de5ae541dull, 0x8f402a5fba07db5dull, 0x636bbc5ef9f0484full, 0xd3d4160dbc369cc1ull, 0x9729dcedaf9c5266ull, 0x9bb628126d16aa04ull, 0x623bf7d8864bbd0cull},
+                {0xe96c16c942962b4eull, 0xe96c16c942962b4eull, 0xe5ced65d61c7aa82ull, 0x712615510771dcdaull, 0xa2ed72957dc78dc4ull, 0x80b92f180158b616ull, 0xde2cad7c26c98491ull, 0xf4f9def4b4a9bf87ull, 0x48eda03ea6467203ull},
+            },
+            {
+                {0x106120f1113c46f7ull, 0xd796942b28816027ull, 0x4f7da4711893d727ull, 0x106120f1113c46f7ull, 0xc49bc06135d53893ull, 0x249f9b8454248e92ull, 0x6ade7a222b5523a7ull, 0x5cf48e68b9559eb9ull, 0x4b3250cfe7e58d75ull},
+                {0x5604b687b62c80fcull, 0x8d0405447f9745d2ull, 0x37dc941e71d4d36eull, 0x33b5768bd6260ef6ull, 0x83983caff8725fceull, 0x328678867660eaf7ull, 0xf7fb519e4ea4917eull, 0x087683ec22b5e020ull, 0x5604b687b62c80fcull},
+                {0xbdbe5e21bff35a88ull, 0xbd6eaf46c14996f2ull, 0xa453047cfe962beaull, 0x48e950a53e023ca2ull, 0x3254a829667a9062ull, 0xabfb76fb52b415e3ull, 0x668017876fbebff6ull, 0xcedd0c8ccfed1eacull, 0xbdbe5e21bff35a88ull},
+                {0xf4e4001846afa73full, 0xa21e63750a58cffbull, 0x96b7b435f524a577ull, 0xf4e4001846afa73full, 0x77edccf573c13befull, 0xee9e97feb818b466ull, 0x55e362e6d16d02ffull, 0xb1d2151fc6aa613dull, 0x47153c3ec1ee507dull},
+            },
+            {
+                {0x875c17b4d0b2e7f3ull, 0xc00e339ebecefe7eull, 0xa77eb878a76e0326ull, 0xc00abcedcfcd45eaull, 0x1125df578be1004dull, 0x875c17b4d0b2e7f3ull, 0xe1296ba45d24806aull, 0x9db935b5abf021d8ull, 0xb0baca1e74fd3478ull},
+                {0x51f6140e86d7eb29ull, 0x17f264e68c8b37fdull, 0x51f6140e86d7eb29ull, 0xbf4a10c61b0c4ef5ull, 0x1ea512d614443fa6ull, 0xae6513565b0b1ec0ull, 0xd4e8d6696aab854dull, 0x746981d21926f5cbull, 0x6320875cffc994dbull},
+                {0x55597712a7cc7144ull, 0xea341c24b4d54751ull, 0x26ab5f2305f68421ull, 0x5cf3a78883d84001ull, 0x63cbf519c2e3fc5aull, 0x55597712a7cc7144ull, 0x3116032f39a7609dull, 0x84b9f83e7fab6537ull, 0x569f29c549777cbbull},
+                {0x20d16701fd7d3094ull, 0x43bb1a87dee8ca4eull, 0x1759a2974811b9d2ull, 0x2b25607e87003606ull, 0xd1e6670049211909ull, 0x4735ea68bfb8c1ffull, 0x320db5469ff85ad6ull, 0xd364d662f201f834ull, 0x20d16701fd7d3094ull},
+            },
+            {
+                {0x93f9250441ab004bull, 0x39d35943d851b107ull, 0x536eede2f8736e9bull, 0x41938e9cf07c4c9full, 0x93f9250441ab004bull, 0xc70910838f707ee4ull, 0xee3783e2cd3c1bf0ull, 0xe49ffd56a8e03b40ull, 0x0ccdd619cbbf37dcull},
+                {0x9246c6cae76ebdf4ull, 0x556bd1e7d1fa04bbull, 0x6fdb2c1ef526f60full, 0x082309b26d2388efull, 0x69438c3f9a651d6bull, 0x9246c6cae76ebdf4ull, 0x772e04e1bcd1cc08ull, 0x761ceb1ffe103198ull, 0x94502cb30a01fe34ull},
+                {0xaa3a2aebe759a20bull, 0xea8dfbe98285c15full, 0x8f8337d6cd4de8c3ull, 0xaa3a2aebe759a20bull, 0x58ceda5b6f51ee23ull, 0x17853e97cdbbeae0ull, 0x72804437de67eff8ull, 0x898ec813f770c3acull, 0x686a86f0c2419decull},
+                {0x6e3ef95e820cf361ull, 0x6bb34ebd10817a56ull, 0xa911369b59b58a4aull, 0xba53adea7c009b5eull, 0xf755ad0cb6684d86ull, 0x6e3ef95e820cf361ull, 0xa305f98f8510eb79ull, 0x6457a1880debd009ull, 0xe9708f55efd00ebdull},
+            },
+            {
+                {0x5813ee090c8d6468ull, 0x5813ee090c8d6468ull, 0xda916c92f0992b24ull, 0x058dda5f9d686d54ull, 0x573473340830e4faull, 0x4ffce3a955a9d5a5ull, 0xfb3fc4f8adcf6868ull, 0x1d168facff989490ull, 0x59ede38037befac0ull},
+                {0xf037f755a52ddd80ull, 0x6e8224fb98690214ull, 0x738a6ae4c4246af0ull, 0xf037f755a52ddd80ull, 0xfe5c1f8ba3501e26ull, 0x9c236b23bc706095ull, 0xa9f6a72ed1811c6cull, 0xb6633011cd2e9b68ull, 0x97703e25cd74cd18ull},
+                {0x04ce58b0b4abe8a1ull, 0x04ce58b0b4abe8a1ull, 0xe0516468de54a7d9ull, 0x7b181045b7d8ea59ull, 0xe6eba468fa071237ull, 0xd77d0e4e3c9963b8ull, 0x02aa301f2d693d81ull, 0x12356c6f9a8e4f65ull, 0xed3789f7d811c845ull},
+                {0xd220a5c08f9ff5dcull, 0x947cb698051e7fb1ull, 0xe0fe7f8791a38849ull, 0x54c47c104a7fbb4dull, 0xde058f472a3154abull, 0xd220a5c08f9ff5dcull, 0x2beed9db553b76f5ull, 0x5e6d552bc2412eb1ull, 0x72ae48be90960a91ull},
+            },
+            {
+                {0x8102637aec9181ceull, 0xb28394165df87c7aull, 0x8102637aec9181ceull, 0x89ea79919c4a27caull, 0x5bec8d6806e8a1ddull, 0x4b3545153412c47dull, 0xb8713df979c7384eull, 0x0be18c5b6f06d520ull, 0xb0ff701c89a62f74ull},
+                {0x0e2fe7480e32254full, 0x3f72541739acd55full, 0x97835e869d96770bull, 0x0e2fe7480e32254full, 0x2bda691fdc965f98ull, 0x3f2702c467c7b4b8ull, 0xf34edbb2ab371bdbull, 0x227cfee37b507dc1ull, 0xfcf219b8ac3c7d21ull},
+                {0x838a62705a1fde42ull, 0x1dd0ebb345ec0a84ull, 0x0ce01dd52570f3b8ull, 0x8b2b9bebd022146cull, 0xc34e80bef19cbcdbull, 0xe7b714d502cdfc13ull, 0x4f9b042c43e74290ull, 0xf6ef1f2d78371c02ull, 0x838a62705a1fde42ull},
+                {0x71f9303828e4fa8aull, 0xf4baee4ce82f8cbeull, 0x12c4a82d60dfc5b2ull, 0x671b0834fad949beull, 0x71ed11ac68c67f25ull, 0xc8ed016421f07ad5ull, 0x71f9303828e4fa8aull, 0xb98ed71368bddef0ull, 0x0bad8ae44fc35830ull},
+            },
+        };
+
+        /**
+         * @brief What fills the symbol of one version and level
+         */
+        enum class Fill
+        {
+            Numeric,
+            Alphanumeric,
+            Byte,
+            Kanji,
+            Mixed, ///< ECI followed by one segment of each mode
+        };
+
+        QrSegment numeric(int version, int count)
+        {
+            std::string digits;
+            for (int i = 0; i < count; ++i)
+            {
+                digits += static_cast<char>('0' + (i * 7 + version) % 10);
+            }
+            return QrSegment::makeNumeric(digits.c_str());
+        }
+
+        QrSegment alphanumeric(int version, int count)
+        {
+            static const char charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+            std::string text;
+            for (int i = 0; i < count; ++i)
+            {
+                text += charset[(i * 11 + version) % 45];
+            }
+            return QrSegment::makeAlphanumeric(text.c_str());
+        }
+
+        QrSegment bytes(int version, int count)
+        {
+            std::vector<std::uint8_t> data;
+            for (int i = 0; i < count; ++i)
+            {
+                data.push_back(static_cast<std::uint8_t>(i * 37 + version));
+            }
+            return QrSegment::makeBytes(data);
+        }
+
+        QrSegment kanji(int version, int count)
+        {
+            BitBuffer bits;
+            for (int i = 0; i < count; ++i)
+            {
+                bits.appendBits(static_cast<std::uint32_t>((i * 97 + version) % 0x1FFF), 13);
+            }
+            return QrSegment(QrSegment::Mode::KANJI, count, std::move(bits));
+        }
+
+        std::vector<QrSegment> segments(int version, Fill fill, int count)
+        {
+            switch (fill)
+            {
+            case Fill::Numeric:
+                return {numeric(version, count)};
+            case Fill::Alphanumeric:
+                return {alphanumeric(version, count)};
+            case Fill::Byte:
+                return {bytes(version, count)};
+            case Fill::Kanji:
+                return {kanji(version, count)};
+            case Fill::Mixed:
+                break;
+            }
+            static const long eci[] = {3, 1000, 500000}; // 1-, 2- and 3-byte designators
+            return {QrSegment::makeEci(eci[version % 3]), numeric(version, count), alphanumeric(version, count),
+                    bytes(version, count), kanji(version, count)};
+        }
+
+        QrCode encode(const std::vector<QrSegment> &segs, int version, int ecc, int mask)
+        {
+            return QrCode::encodeSegments(segs, kEcc[ecc], version, version, mask, false);
+        }
+
+        /**
+         * @brief The fullest segment list that still fits the version
+         *
+         * Every list fits with a count of 0, so the search always succeeds.
+         */
+        std::vector<QrSegment> fill_symbol(int version, int ecc)
+        {
+            const Fill fill = static_cast<Fill>((version + ecc) % 5);
+            int fits = 0;
+            int too_long = 8192;
+            while (too_long - fits > 1)
+            {
+                const int count = fits + (too_long - fits) / 2;
+                try
+                {
+                    encode(segments(version, fill, count), version, ecc, 0);
+                    fits = count;
+                }
+                catch (const qrcodegen::data_too_long &)
+                {
+                    too_long = count;
+                }
+            }
+            return segments(version, fill, fits);
+        }
+
+        /**
+         * @brief FNV-1a over the symbol's parameters and its modules
+         */
+        std::uint64_t digest(const QrCode &qr)
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            const auto mix = [&hash](std::uint64_t value)
+            {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            };
+            mix(static_cast<std::uint64_t>(qr.getVersion()));
+            mix(static_cast<std::uint64_t>(qr.getErrorCorrectionLevel()));
+            mix(static_cast<std::uint64_t>(qr.getMask()));
+            for (int y = 0; y < qr.getSize(); ++y)
+            {
+                std::uint64_t word = 0;
+                for (int x = 0; x < qr.getSize(); ++x)
+                {
+                    word = (word << 1) | (qr.getModule(x, y) ? 1 : 0);
+                    if (x % 64 == 63)
+                    {
+                        mix(word);
+                        word = 0;
+                    }
+                }
+                mix(word);
+            }
+            return hash;
+        }
+
+        /**
+         * @brief Call visit(version, ecc, mask, digest) for every symbol
+         */
+        template <typename Visit>
+        void for_each_symbol(Visit visit)
+        {
+            for (int version = QrCode::MIN_VERSION; version <= QrCode::MAX_VERSION; ++version)
+            {
+                for (int ecc = 0; ecc < kEccLevels; ++ecc)
+                {
+                    const std::vector<QrSegment> segs = fill_symbol(version, ecc);
+                    for (int mask = -1; mask <= 7; ++mask)
+                    {
+                        visit(version, ecc, mask, digest(encode(segs, version, ecc, mask)));
+                    }
+                }
+            }
+        }
+    } // namespace
+
+    int check_qr_golden()
+    {
+        int mismatches = 0;
+        for_each_symbol([&mismatches](int version, int ecc, int mask, std::uint64_t actual)
+                        {
+            const std::uint64_t expected = kGolden[version - 1][ecc][mask + 1];
+            if (actual != expected)
+            {
+                std::cerr << "QR version " << version << " ECC " << kEccNames[ecc] << " mask " << mask
+                          << ": digest " << std::hex << actual << ", expected " << expected << std::dec << std::endl;
+                ++mismatches;
+            } });
+        std::cerr << "QR golden check: " << mismatches << " of "
+                  << QrCode::MAX_VERSION * kEccLevels * kMasks << " symbols differ" << std::endl;
+        return mismatches;
+    }
+
+    void print_qr_golden()
+    {
+        for_each_symbol([](int, int ecc, int mask, std::uint64_t actual)
+                        {
+            if (ecc == 0 && mask == -1)
+            {
+                std::printf("            {\n");
+            }
+            if (mask == -1)
+            {
+                std::printf("                {");
+            }
+            std::printf("0x%016" PRIx64 "ull%s", actual, mask == 7 ? "},\n" : ", ");
+            if (ecc == kEccLevels - 1 && mask == 7)
+            {
+                std::printf("            },\n");
+            } });
+    }
+
+} // namespace Bench
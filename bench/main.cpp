@@ -0,0 +1,220 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of ultimate-control-bench
+ *
+ * Runs every registered case at every size and prints one JSON document
+ * on stdout (or --out), so runs can be stored and compared over time.
+ * Progress and warnings go to stderr.
+ */
+
+#include "Bench.hpp"
+#include "core/Log.hpp"
+#include <cstdlib>  // for std::strtoull
+#include <fstream>  // for std::ofstream
+#include <iostream> // for std::cout, std::cerr
+#include <giomm.h>
+
+#ifndef UC_BENCH_TOOLS_DIR
+#define UC_BENCH_TOOLS_DIR "bench/fake-tools"
+#endif
+
+namespace
+{
+    void print_usage()
+    {
+        std::cerr << "Usage: ultimate-control-bench [options]\n"
+                     "  --sizes N,N,...      Devices or access points per environment (default 1,10,100,1000)\n"
+                     "  --filter TEXT        Only cases whose name contains TEXT\n"
+                     "  --backend NAME       Only \"tools\", \"mock\" or \"none\" cases\n"
+                     "  --min-time MS        Time each case at least this long (default 200)\n"
+                     "  --max-iterations N   Never run a case more often (default 100000)\n"
+                     "  --mock OPTIONS       Mock options as in UC_MOCK, e.g. latency=2,failures=0.01\n"
+                     "  --tools DIR          Fake pactl, nmcli, ... scripts (default " UC_BENCH_TOOLS_DIR ")\n"
+                     "  --out FILE           Write the JSON there instead of stdout\n"
+                     "  --list               List the cases and exit\n"
+                     "  --check-qr           Compare the QR encoder against its golden digests and exit\n"
+                     "  --print-qr-golden    Print the golden digests of the current QR encoder and exit\n";
+    }
+
+    /**
+     * @brief Parse a whole positive number
+     */
+    bool parse_count(const std::string &text, std::uint64_t &value)
+    {
+        if (text.empty() || text[0] == '-')
+        {
+            return false;
+        }
+        char *end = nullptr;
+        value = std::strtoull(text.c_str(), &end, 10);
+        return *end == '\0' && value > 0;
+    }
+
+    /**
+     * @brief Parse a comma-separated list of sizes
+     */
+    bool parse_sizes(const std::string &text, std::vector<std::size_t> &sizes)
+    {
+        sizes.clear();
+        std::size_t start = 0;
+        while (start <= text.size())
+        {
+            std::size_t comma = text.find(',', start);
+            if (comma == std::string::npos)
+            {
+                comma = text.size();
+            }
+            std::uint64_t size = 0;
+            if (!parse_count(text.substr(start, comma - start), size))
+            {
+                return false;
+            }
+            sizes.push_back(static_cast<std::size_t>(size));
+            start = comma + 1;
+        }
+        return !sizes.empty();
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Core::Log::init(Core::Log::Level::Warn, Core::Log::Sink::Stderr);
+
+    // WifiManager and BluetoothManager need GLib/GIO initialised, not GTK
+    Gio::init();
+
+    Bench::Options options;
+    Core::Backend::MockOptions mock;
+    std::string tools = UC_BENCH_TOOLS_DIR;
+    std::string out;
+    bool list = false;
+    bool check_qr = false;
+    bool print_qr_golden = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        std::uint64_t count = 0;
+        std::string error;
+        if (arg == "--list")
+        {
+            list = true;
+        }
+        else if (arg == "--check-qr")
+        {
+            check_qr = true;
+        }
+        else if (arg == "--print-qr-golden")
+        {
+            print_qr_golden = true;
+        }
+        else if (arg == "--sizes" && has_value)
+        {
+            if (!parse_sizes(argv[++i], options.sizes))
+            {
+                std::cerr << "Invalid sizes: " << argv[i] << std::endl;
+                return 2;
+            }
+        }
+        else if (arg == "--filter" && has_value)
+        {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--backend" && has_value)
+        {
+            options.backend = argv[++i];
+        }
+        else if ((arg == "--min-time" || arg == "--max-iterations") && has_value)
+        {
+            if (!parse_count(argv[++i], count))
+            {
+                std::cerr << "Invalid " << arg << ": " << argv[i] << std::endl;
+                return 2;
+            }
+            if (arg == "--min-time")
+            {
+                options.min_time = std::chrono::milliseconds(count);
+            }
+            else
+            {
+                options.max_iterations = count;
+            }
+        }
+        else if (arg == "--mock" && has_value)
+        {
+            if (!Core::Backend::parse_mock_options(argv[++i], mock, error))
+            {
+                std::cerr << "Invalid mock options: " << error << std::endl;
+                return 2;
+            }
+        }
+        else if (arg == "--tools" && has_value)
+        {
+            tools = argv[++i];
+        }
+        else if (arg == "--out" && has_value)
+        {
+            out = argv[++i];
+        }
+        else
+        {
+            print_usage();
+            return arg == "-h" || arg == "--help" ? 0 : 2;
+        }
+    }
+
+    if (check_qr)
+    {
+        return Bench::check_qr_golden() == 0 ? 0 : 1;
+    }
+    if (print_qr_golden)
+    {
+        Bench::print_qr_golden();
+        return 0;
+    }
+
+    Bench::register_manager_benchmarks(tools, mock);
+    Bench::register_qr_benchmarks();
+
+    std::vector<Bench::Result> results;
+    for (const auto &c : Bench::cases())
+    {
+        if (c.name.find(options.filter) == std::string::npos ||
+            (!options.backend.empty() && c.backend != options.backend))
+        {
+            continue;
+        }
+        for (std::size_t size : c.sizes.empty() ? options.sizes : c.sizes)
+        {
+            if (list)
+            {
+                std::cout << c.name << " " << c.backend << " " << size << "\n";
+                continue;
+            }
+            Bench::Result r = Bench::run(c, size, options);
+            std::cerr << r.name << " [" << r.backend << ", " << r.size << "]: " << r.median_us << " us median, "
+                      << r.spawns_per_op << " spawns/op, " << r.allocations_per_op << " allocations/op" << std::endl;
+            results.push_back(r);
+        }
+    }
+    if (list)
+    {
+        return 0;
+    }
+
+    const std::string json = Bench::to_json(results, options);
+    if (out.empty())
+    {
+        std::cout << json;
+        return 0;
+    }
+    std::ofstream file(out);
+    file << json;
+    if (!file)
+    {
+        std::cerr << "Failed to write " << out << std::endl;
+        return 1;
+    }
+    return 0;
+}
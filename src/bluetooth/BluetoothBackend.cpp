@@ -0,0 +1,432 @@
+/**
+ * @file BluetoothBackend.cpp
+ * @brief BlueZ D-Bus implementation of the Bluetooth backend
+ *
+ * This file implements the system BluetoothBackend, discovering and
+ * controlling devices via the BlueZ D-Bus API, and the runtime choice of
+ * backend.
+ */
+
+#include "BluetoothBackend.hpp"
+#include <giomm.h>
+#include <glibmm.h>
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include <map>
+
+namespace Bluetooth
+{
+
+    namespace
+    {
+        /// Counts every BlueZ method call made over the system bus
+        const Core::Metrics::Id dbus_counter = Core::Metrics::counter("dbus.calls");
+
+        // Helper: Map RSSI (dBm) to 0-100% (simple linear mapping, clamp to [0,100])
+        int rssi_to_percent(int rssi)
+        {
+            // Typical RSSI range: -100 (weak) to -40 (strong)
+            if (rssi <= -100)
+                return 0;
+            if (rssi >= -40)
+                return 100;
+            return (rssi + 100) * 100 / 60;
+        }
+
+        // Helper: Estimate signal strength based on other properties when RSSI is not available
+        int estimate_signal_strength(const std::map<std::string, Glib::VariantBase> &props)
+        {
+            // Check if the device is connected - connected devices likely have good signal
+            auto connected_it = props.find("Connected");
+            bool is_connected = (connected_it != props.end()) ? Glib::VariantBase::cast_dynamic<Glib::Variant<bool>>(connected_it->second).get() : false;
+
+            if (is_connected)
+            {
+                // Connected devices are assumed to have at least moderate signal strength
+                return 75; // 75% signal for connected devices
+            }
+
+            // Check if the device is paired - paired devices were in range recently
+            auto paired_it = props.find("Paired");
+            bool is_paired = (paired_it != props.end()) ? Glib::VariantBase::cast_dynamic<Glib::Variant<bool>>(paired_it->second).get() : false;
+
+            if (is_paired)
+            {
+                return 60; // 60% signal for paired but not connected devices
+            }
+
+            // For other detected devices, assume a moderate signal strength
+            // since they must be in range to be detected at all
+            return 50;
+        }
+
+        /**
+         * @brief Child node names of an object in an introspection document
+         */
+        std::vector<std::string> child_nodes(const std::string &xml)
+        {
+            std::vector<std::string> nodes;
+            size_t pos = 0;
+            while ((pos = xml.find("<node name=\"", pos)) != std::string::npos)
+            {
+                pos += 12;
+                size_t end = xml.find("\"", pos);
+                if (end == std::string::npos)
+                    break;
+                nodes.push_back(xml.substr(pos, end - pos));
+            }
+            return nodes;
+        }
+
+        /**
+         * @class BluezBackend
+         * @brief Bluetooth backend making BlueZ calls on the system bus
+         */
+        class BluezBackend : public BluetoothBackend
+        {
+        public:
+            BluezBackend()
+            {
+                try
+                {
+                    connection_ = Gio::DBus::Connection::get_sync(Gio::DBus::BUS_TYPE_SYSTEM);
+                }
+                catch (const Glib::Error &ex)
+                {
+                    UC_LOG_ERROR(Bluetooth, "Failed to connect to system D-Bus: " << ex.what());
+                    connection_.reset();
+                }
+            }
+
+            bool available() override
+            {
+                return static_cast<bool>(connection_);
+            }
+
+            BluetoothManager::DeviceList list_devices() override
+            {
+                BluetoothManager::DeviceList devices;
+                if (!connection_)
+                {
+                    UC_LOG_WARN(Bluetooth, "No D-Bus connection available");
+                    return devices;
+                }
+
+                UC_LOG_DEBUG(Bluetooth, "Scanning for Bluetooth devices...");
+
+                try
+                {
+                    // Check if BlueZ is available on the system bus
+                    bool bluez_found = false;
+                    try
+                    {
+                        Core::Metrics::increment(dbus_counter);
+                        auto reply = connection_->call_sync(
+                            "/org/freedesktop/DBus",
+                            "org.freedesktop.DBus",
+                            "ListNames",
+                            Glib::VariantContainerBase(),
+                            "org.freedesktop.DBus");
+                        auto names_variant = Glib::VariantBase::cast_dynamic<Glib::Variant<std::vector<Glib::ustring>>>(reply.get_child(0));
+                        auto names = names_variant.get();
+                        for (const auto &name : names)
+                        {
+                            if (name == "org.bluez")
+                            {
+                                bluez_found = true;
+                                break;
+                            }
+                        }
+                    }
+                    catch (const Glib::Error &ex)
+                    {
+                        UC_LOG_WARN(Bluetooth, "Failed to query D-Bus for available names: " << ex.what());
+                    }
+                    if (!bluez_found)
+                    {
+                        UC_LOG_WARN(Bluetooth, "BlueZ service (org.bluez) not found on system D-Bus. Is bluetoothd running?");
+                        return devices;
+                    }
+
+                    // Enumerate all objects under /org/bluez and look for org.bluez.Device1
+                    std::string xml = introspect("/org/bluez");
+                    UC_LOG_TRACE(Bluetooth, "BlueZ XML: " << xml.substr(0, 100) << "...");
+
+                    std::vector<std::string> device_paths;
+                    for (const auto &node : child_nodes(xml))
+                    {
+                        UC_LOG_TRACE(Bluetooth, "Found node: " << node);
+                        if (node.find("hci") != 0)
+                        {
+                            continue;
+                        }
+
+                        // Introspect this adapter
+                        std::string adapter_path = std::string("/org/bluez/") + node;
+                        UC_LOG_TRACE(Bluetooth, "Introspecting adapter: " << adapter_path);
+                        std::string adapter_xml = introspect(adapter_path);
+                        UC_LOG_TRACE(Bluetooth, "Adapter XML: " << adapter_xml.substr(0, 100) << "...");
+
+                        for (const auto &dev_node : child_nodes(adapter_xml))
+                        {
+                            UC_LOG_TRACE(Bluetooth, "Found device node: " << dev_node);
+                            if (dev_node.find("dev_") == 0)
+                            {
+                                std::string dev_path = adapter_path + "/" + dev_node;
+                                UC_LOG_TRACE(Bluetooth, "Adding device path: " << dev_path);
+                                device_paths.push_back(dev_path);
+                            }
+                        }
+                    }
+
+                    UC_LOG_DEBUG(Bluetooth, "Found " << device_paths.size() << " device paths");
+
+                    // For each device path, get properties from org.bluez.Device1
+                    for (const auto &dev_path : device_paths)
+                    {
+                        try
+                        {
+                            devices.push_back(read_device(dev_path));
+                        }
+                        catch (const Glib::Error &ex)
+                        {
+                            UC_LOG_WARN(Bluetooth, "Failed to get properties for " << dev_path << ": " << ex.what());
+                        }
+                    }
+
+                    UC_LOG_DEBUG(Bluetooth, "Total devices found: " << devices.size());
+                }
+                catch (const Glib::Error &ex)
+                {
+                    UC_LOG_WARN(Bluetooth, "D-Bus error: " << ex.what());
+                }
+                return devices;
+            }
+
+            bool connect(const std::string &address) override
+            {
+                try
+                {
+                    std::string device_path = device_path_for(address);
+                    if (device_path.empty())
+                    {
+                        UC_LOG_WARN(Bluetooth, "Could not find device path for address: " << address);
+                        return false;
+                    }
+                    UC_LOG_DEBUG(Bluetooth, "Found device path: " << device_path);
+
+                    // Call Connect method on the device
+                    call(device_path, "org.bluez.Device1", "Connect", Glib::VariantContainerBase());
+                    UC_LOG_INFO(Bluetooth, "Connect call succeeded for device: " << address);
+                    return true;
+                }
+                catch (const Glib::Error &ex)
+                {
+                    UC_LOG_ERROR(Bluetooth, "Failed to connect to device " << address << ": " << ex.what());
+                    return false;
+                }
+            }
+
+            bool disconnect(const std::string &address) override
+            {
+                try
+                {
+                    std::string device_path = device_path_for(address);
+                    if (device_path.empty())
+                    {
+                        UC_LOG_WARN(Bluetooth, "Could not find device path for address: " << address);
+                        return false;
+                    }
+                    UC_LOG_DEBUG(Bluetooth, "Found device path: " << device_path);
+
+                    // Call Disconnect method on the device
+                    call(device_path, "org.bluez.Device1", "Disconnect", Glib::VariantContainerBase());
+                    UC_LOG_INFO(Bluetooth, "Disconnect call succeeded for device: " << address);
+                    return true;
+                }
+                catch (const Glib::Error &ex)
+                {
+                    UC_LOG_ERROR(Bluetooth, "Failed to disconnect from device " << address << ": " << ex.what());
+                    return false;
+                }
+            }
+
+            bool forget(const std::string &address) override
+            {
+                try
+                {
+                    std::string device_path = device_path_for(address);
+                    if (device_path.empty())
+                    {
+                        UC_LOG_WARN(Bluetooth, "Could not find device path for address: " << address);
+                        return false;
+                    }
+                    UC_LOG_DEBUG(Bluetooth, "Found device path: " << device_path);
+
+                    // First make sure the device is disconnected
+                    try
+                    {
+                        call(device_path, "org.bluez.Device1", "Disconnect", Glib::VariantContainerBase());
+                        UC_LOG_DEBUG(Bluetooth, "Disconnected device before forgetting: " << address);
+                    }
+                    catch (const Glib::Error &)
+                    {
+                        // Ignore errors here, device might not be connected
+                    }
+
+                    // Call RemoveDevice method on the adapter
+                    std::string adapter_path = device_path.substr(0, device_path.find_last_of('/'));
+                    call(adapter_path, "org.bluez.Adapter1", "RemoveDevice",
+                         Glib::VariantContainerBase::create_tuple({Glib::Variant<Glib::DBusObjectPathString>::create(device_path)}));
+                    UC_LOG_INFO(Bluetooth, "Forget call succeeded for device: " << address);
+                    return true;
+                }
+                catch (const Glib::Error &ex)
+                {
+                    UC_LOG_ERROR(Bluetooth, "Failed to forget device " << address << ": " << ex.what());
+                    return false;
+                }
+            }
+
+        private:
+            /**
+             * @brief Call a BlueZ method; throws Glib::Error on failure
+             */
+            Glib::VariantContainerBase call(const std::string &path, const char *interface, const char *method,
+                                            const Glib::VariantContainerBase &parameters)
+            {
+                Core::Metrics::increment(dbus_counter);
+                return connection_->call_sync(path, interface, method, parameters, "org.bluez");
+            }
+
+            /**
+             * @brief Introspection XML of a BlueZ object
+             */
+            std::string introspect(const std::string &path)
+            {
+                auto reply = call(path, "org.freedesktop.DBus.Introspectable", "Introspect", Glib::VariantContainerBase());
+                return Glib::VariantBase::cast_dynamic<Glib::Variant<std::string>>(reply.get_child(0)).get();
+            }
+
+            /**
+             * @brief Read the org.bluez.Device1 properties of one device
+             */
+            Device read_device(const std::string &dev_path)
+            {
+                UC_LOG_TRACE(Bluetooth, "Getting properties for device: " << dev_path);
+
+                auto props_reply = call(dev_path, "org.freedesktop.DBus.Properties", "GetAll",
+                                        Glib::VariantContainerBase::create_tuple({Glib::Variant<Glib::ustring>::create("org.bluez.Device1")}));
+                auto props_variant = Glib::VariantBase::cast_dynamic<Glib::Variant<std::map<std::string, Glib::VariantBase>>>(props_reply.get_child(0));
+                const auto &props = props_variant.get();
+
+                UC_LOG_TRACE(Bluetooth, "Got properties for device: " << dev_path);
+
+                Device dev;
+                auto addr_it = props.find("Address");
+                if (addr_it != props.end())
+                {
+                    dev.address = Glib::VariantBase::cast_dynamic<Glib::Variant<std::string>>(addr_it->second).get();
+                    UC_LOG_TRACE(Bluetooth, "  Address: " << dev.address);
+                }
+
+                auto name_it = props.find("Name");
+                if (name_it != props.end())
+                {
+                    dev.name = Glib::VariantBase::cast_dynamic<Glib::Variant<std::string>>(name_it->second).get();
+                    UC_LOG_TRACE(Bluetooth, "  Name: " << dev.name);
+                }
+                else
+                {
+                    UC_LOG_TRACE(Bluetooth, "  No name found");
+                }
+
+                auto paired_it = props.find("Paired");
+                dev.paired = (paired_it != props.end()) ? Glib::VariantBase::cast_dynamic<Glib::Variant<bool>>(paired_it->second).get() : false;
+                UC_LOG_TRACE(Bluetooth, "  Paired: " << (dev.paired ? "yes" : "no"));
+
+                auto connected_it = props.find("Connected");
+                dev.connected = (connected_it != props.end()) ? Glib::VariantBase::cast_dynamic<Glib::Variant<bool>>(connected_it->second).get() : false;
+                UC_LOG_TRACE(Bluetooth, "  Connected: " << (dev.connected ? "yes" : "no"));
+
+                auto rssi_it = props.find("RSSI");
+                if (rssi_it != props.end())
+                {
+                    int rssi = Glib::VariantBase::cast_dynamic<Glib::Variant<int16_t>>(rssi_it->second).get();
+                    dev.signal_strength = rssi_to_percent(rssi);
+                    UC_LOG_TRACE(Bluetooth, "  RSSI: " << rssi << " (" << dev.signal_strength << "%)");
+                }
+                else
+                {
+                    // RSSI not available, use fallback estimation
+                    dev.signal_strength = estimate_signal_strength(props);
+                    UC_LOG_TRACE(Bluetooth, "  No RSSI information, using estimated signal strength: " << dev.signal_strength << "%");
+                }
+
+                UC_LOG_TRACE(Bluetooth, "Read device: " << dev.name << " (" << dev.address << ")");
+                return dev;
+            }
+
+            /**
+             * @brief Object path of a known device
+             * @return e.g. /org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF, or an empty string
+             */
+            std::string device_path_for(const std::string &address)
+            {
+                if (!connection_)
+                {
+                    return "";
+                }
+
+                bool known = false;
+                for (const auto &dev : list_devices())
+                {
+                    known = known || dev.address == address;
+                }
+                if (!known)
+                {
+                    return "";
+                }
+
+                // BlueZ names device objects after the address, with underscores
+                std::string dev_node = "dev_" + address;
+                for (auto &c : dev_node)
+                {
+                    if (c == ':')
+                    {
+                        c = '_';
+                    }
+                }
+
+                for (const auto &node : child_nodes(introspect("/org/bluez")))
+                {
+                    if (node.find("hci") != 0)
+                    {
+                        continue;
+                    }
+                    // Found an adapter, check if it has our device
+                    std::string adapter_path = std::string("/org/bluez/") + node;
+                    if (introspect(adapter_path).find(dev_node) != std::string::npos)
+                    {
+                        return adapter_path + "/" + dev_node;
+                    }
+                }
+                return "";
+            }
+
+            Glib::RefPtr<Gio::DBus::Connection> connection_;
+        };
+    } // namespace
+
+    std::unique_ptr<BluetoothBackend> BluetoothBackend::create()
+    {
+        return Core::Backend::mock() ? create_mock() : create_system();
+    }
+
+    std::unique_ptr<BluetoothBackend> BluetoothBackend::create_system()
+    {
+        return std::make_unique<BluezBackend>();
+    }
+
+} // namespace Bluetooth
@@ -0,0 +1,77 @@
+/**
+ * @file BluetoothBackend.hpp
+ * @brief Bluetooth backend interface for Ultimate Control
+ *
+ * This file defines the BluetoothBackend interface which BluetoothManager
+ * uses for every query and change of Bluetooth devices, so the BlueZ
+ * backend can be swapped for an in-process mock at runtime (see
+ * Core::Backend).
+ */
+
+#pragma once
+
+#include "BluetoothManager.hpp"
+#include <memory>
+#include <string>
+
+namespace Bluetooth
+{
+
+    /**
+     * @class BluetoothBackend
+     * @brief Lists, connects and removes Bluetooth devices
+     *
+     * Implementations must be safe to call from worker threads.
+     */
+    class BluetoothBackend
+    {
+    public:
+        virtual ~BluetoothBackend() = default;
+
+        /**
+         * @brief Whether the Bluetooth service can be reached at all
+         */
+        virtual bool available() = 0;
+
+        /**
+         * @brief List known and discovered devices
+         * @return Devices; empty on failure
+         */
+        virtual BluetoothManager::DeviceList list_devices() = 0;
+
+        /**
+         * @brief Connect to a device
+         * @param address MAC address
+         * @return true once connected
+         */
+        virtual bool connect(const std::string &address) = 0;
+
+        /**
+         * @brief Disconnect from a device
+         * @return false if the device is unknown or the call failed
+         */
+        virtual bool disconnect(const std::string &address) = 0;
+
+        /**
+         * @brief Disconnect from a device and remove it, pairing included
+         * @return false if the device is unknown or the call failed
+         */
+        virtual bool forget(const std::string &address) = 0;
+
+        /**
+         * @brief The backend selected by Core::Backend
+         */
+        static std::unique_ptr<BluetoothBackend> create();
+
+        /**
+         * @brief Backend talking to BlueZ over the system bus
+         */
+        static std::unique_ptr<BluetoothBackend> create_system();
+
+        /**
+         * @brief Simulated devices; see Core::Backend::MockOptions
+         */
+        static std::unique_ptr<BluetoothBackend> create_mock();
+    };
+
+} // namespace Bluetooth
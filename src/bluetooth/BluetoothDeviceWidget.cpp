@@ -8,15 +8,23 @@
  */
 
 #include "BluetoothDeviceWidget.hpp"
-#include <iostream>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
 
 namespace Bluetooth
 {
 
+    namespace
+    {
+        const Core::Metrics::Id widget_counter = Core::Metrics::counter("widgets.created");
+    }
+
     BluetoothDeviceWidget::BluetoothDeviceWidget(const Device &device, std::shared_ptr<BluetoothManager> manager)
         : Gtk::Box(Gtk::ORIENTATION_HORIZONTAL, 10), manager_(manager), device_(device),
           device_info_box_(Gtk::ORIENTATION_HORIZONTAL, 5), controls_box_(Gtk::ORIENTATION_HORIZONTAL, 5)
     {
+        Core::Metrics::increment(widget_counter);
+
         set_margin_top(5);
         set_margin_bottom(5);
         set_margin_start(10);
@@ -115,7 +123,7 @@ namespace Bluetooth
 
         show_all_children();
 
-        std::cout << "Created widget for device: " << device_.name << " (" << device_.address << ")" << std::endl;
+        UC_LOG_TRACE(Bluetooth, "Created widget for device: " << device_.name << " (" << device_.address << ")");
     }
 
     BluetoothDeviceWidget::~BluetoothDeviceWidget() {}
@@ -124,25 +132,25 @@ namespace Bluetooth
     {
         if (device_.connected)
         {
-            std::cout << "Disconnecting from " << device_.name << std::endl;
+            UC_LOG_DEBUG(Bluetooth, "Disconnecting from " << device_.name);
             manager_->disconnect(device_.address);
         }
         else
         {
-            std::cout << "Connecting to " << device_.name << std::endl;
+            UC_LOG_DEBUG(Bluetooth, "Connecting to " << device_.name);
             manager_->connect_async(device_.address, [this](bool success, const std::string &addr)
                                     {
                 if (success) {
-                    std::cout << "Successfully connected to " << addr << std::endl;
+                    UC_LOG_DEBUG(Bluetooth, "Successfully connected to " << addr);
                 } else {
-                    std::cout << "Failed to connect to " << addr << std::endl;
+                    UC_LOG_WARN(Bluetooth, "Failed to connect to " << addr);
                 } });
         }
     }
 
     void BluetoothDeviceWidget::on_forget_clicked()
     {
-        std::cout << "Forgetting device " << device_.name << std::endl;
+        UC_LOG_DEBUG(Bluetooth, "Forgetting device " << device_.name);
         manager_->forget_device(device_.address);
     }
 
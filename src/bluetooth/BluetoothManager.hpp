@@ -42,7 +42,8 @@ namespace Bluetooth
      * @brief Manages Bluetooth connections and device scanning
      *
      * Provides an interface for scanning available devices, connecting to devices,
-     * and managing paired devices.
+     * and managing paired devices. Talks to BlueZ over D-Bus, or to a mock
+     * chosen by Core::Backend (see BluetoothBackend).
      */
     class BluetoothManager
     {
@@ -73,14 +74,10 @@ namespace Bluetooth
 
     private:
         class Impl;
-        std::unique_ptr<Impl> impl_;
+        std::shared_ptr<Impl> impl_; ///< Shared with worker threads that may outlive the manager
         bool enabled_ = false;
         StateCallback state_callback_;
         UpdateCallback update_callback_;
-
-        // --- Added for BlueZ D-Bus implementation ---
-        void on_get_managed_objects_finished(const Glib::RefPtr<Gio::AsyncResult> &result);
-        DeviceList get_devices_from_bluez() const;
     };
 
 } // namespace Bluetooth
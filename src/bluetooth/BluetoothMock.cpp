@@ -0,0 +1,171 @@
+/**
+ * @file BluetoothMock.cpp
+ * @brief Simulated Bluetooth devices for tests and benchmarks
+ */
+
+#include "BluetoothBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include <algorithm> // for std::find_if
+#include <cstdio>    // for std::snprintf
+
+namespace Bluetooth
+{
+
+    namespace
+    {
+        /**
+         * @struct World
+         * @brief Devices shared by every mock backend built from the same options
+         */
+        struct World
+        {
+            explicit World(std::uint64_t gen) : generation(gen), simulation("bluetooth")
+            {
+                const std::size_t count = simulation.options().devices;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    // Locally administered addresses, so they never match real hardware
+                    char address[18];
+                    std::snprintf(address, sizeof(address), "02:00:00:%02X:%02X:%02X",
+                                  static_cast<unsigned>((i >> 16) & 0xff), static_cast<unsigned>((i >> 8) & 0xff),
+                                  static_cast<unsigned>(i & 0xff));
+                    Device device;
+                    device.name = "Mock Device " + std::to_string(i);
+                    device.address = address;
+                    device.signal_strength = simulation.uniform(0, 100);
+                    device.paired = i == 0 || simulation.chance(0.25);
+                    device.connected = i == 0;
+                    devices.push_back(device);
+                }
+            }
+
+            const std::uint64_t generation;
+            Core::Backend::Simulation simulation;
+            std::mutex mutex; ///< Guards devices
+            BluetoothManager::DeviceList devices;
+        };
+
+        /**
+         * @brief The devices for the current options, rebuilt when they change
+         */
+        std::shared_ptr<World> world()
+        {
+            static std::mutex mutex;
+            static std::shared_ptr<World> current;
+            std::lock_guard<std::mutex> lock(mutex);
+            const std::uint64_t generation = Core::Backend::generation();
+            if (!current || current->generation != generation)
+            {
+                current = std::make_shared<World>(generation);
+            }
+            return current;
+        }
+
+        /**
+         * @brief Change the signal of one random device
+         */
+        void perturb()
+        {
+            auto w = world();
+            std::lock_guard<std::mutex> lock(w->mutex);
+            if (w->devices.empty())
+            {
+                return;
+            }
+            auto &device = w->devices[static_cast<std::size_t>(w->simulation.uniform(0, static_cast<int>(w->devices.size()) - 1))];
+            device.signal_strength = w->simulation.uniform(0, 100);
+        }
+
+        /**
+         * @class MockBackend
+         * @brief Bluetooth backend answering from a World
+         */
+        class MockBackend : public BluetoothBackend
+        {
+        public:
+            MockBackend() : world_(world()) {}
+
+            bool available() override
+            {
+                return true;
+            }
+
+            BluetoothManager::DeviceList list_devices() override
+            {
+                if (!world_->simulation.call())
+                {
+                    UC_LOG_DEBUG(Bluetooth, "Mock device list failed");
+                    return {};
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                return world_->devices;
+            }
+
+            /**
+             * @brief Connect, pairing first if needed
+             */
+            bool connect(const std::string &address) override
+            {
+                return change(address, [](Device &device)
+                              { device.paired = true; device.connected = true; return true; });
+            }
+
+            bool disconnect(const std::string &address) override
+            {
+                return change(address, [](Device &device)
+                              { device.connected = false; return true; });
+            }
+
+            bool forget(const std::string &address) override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                auto &devices = world_->devices;
+                auto it = std::find_if(devices.begin(), devices.end(), [&address](const Device &device)
+                                       { return device.address == address; });
+                if (it == devices.end())
+                {
+                    return false;
+                }
+                devices.erase(it);
+                return true;
+            }
+
+        private:
+            /**
+             * @brief Apply a change to one device after a simulated call
+             * @return false if the call failed or the device is unknown
+             */
+            template <typename Change>
+            bool change(const std::string &address, Change apply)
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                for (auto &device : world_->devices)
+                {
+                    if (device.address == address)
+                    {
+                        return apply(device);
+                    }
+                }
+                return false;
+            }
+
+            std::shared_ptr<World> world_;
+        };
+    } // namespace
+
+    std::unique_ptr<BluetoothBackend> BluetoothBackend::create_mock()
+    {
+        Core::Backend::start_storm("bluetooth", perturb);
+        return std::make_unique<MockBackend>();
+    }
+
+} // namespace Bluetooth
@@ -7,12 +7,28 @@
  */
 
 #include "BluetoothTab.hpp"
-#include <iostream>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/TabModule.hpp"
+#include "core/Activity.hpp"
+#include "core/Staging.hpp"
+#include "core/Trace.hpp"
+#include "core/Wakeups.hpp"
+#include "core/WarmCache.hpp"
 #include <algorithm>
 
 namespace Bluetooth
 {
 
+    namespace
+    {
+        const Core::Metrics::Id reconcile_counter = Core::Metrics::counter("reconciles");
+        const Core::Metrics::Id reconcile_histogram = Core::Metrics::histogram("bt.reconcile");
+
+        /// Warm cache section holding the last device list
+        const char *const kCacheSection = "bluetooth";
+    }
+
     BluetoothTab::BluetoothTab()
         : manager_(std::make_shared<BluetoothManager>()),
           container_(Gtk::ORIENTATION_VERTICAL, 10)
@@ -80,17 +96,19 @@ namespace Bluetooth
             scan_button_.set_sensitive(false);
             scan_button_.set_label("Scanning...");
             manager_->scan_devices_async();
-            Glib::signal_timeout().connect_once([this]() {
+            Core::Wakeups::timeout_once(sigc::track_obj([this]() {
                 scan_button_.set_sensitive(true);
                 scan_button_.set_label("Scan");
-            }, 2000); });
+            }, *this), 2000); });
 
         // Bluetooth switch handler
         bluetooth_switch_.property_active().signal_changed().connect(sigc::mem_fun(*this, &BluetoothTab::on_bluetooth_switch_toggled));
 
         // Register callbacks
         manager_->set_update_callback([this](const std::vector<Device> &devices)
-                                      { update_device_list(devices); });
+                                      {
+            update_device_list(devices);
+            remember_state(devices); });
         manager_->set_state_callback([this](bool enabled)
                                      { update_bluetooth_state(enabled); });
 
@@ -101,15 +119,23 @@ namespace Bluetooth
         loading_label_->set_margin_bottom(20);
         container_.pack_start(*loading_label_, Gtk::PACK_SHRINK);
 
+        // Replace it with the last run's devices until the scan completes
+        show_cached_state();
+
         show_all_children();
-        std::cout << "Bluetooth tab loaded!" << std::endl;
+        UC_LOG_DEBUG(Bluetooth, "Bluetooth tab loaded!");
 
-        Glib::signal_timeout().connect_once(
-            sigc::mem_fun(*this, &BluetoothTab::perform_delayed_scan), 100);
+        // The scan runs on a worker thread; no need to wait for a frame first
+        perform_initial_scan();
     }
 
     BluetoothTab::~BluetoothTab() {}
 
+    void BluetoothTab::refresh()
+    {
+        manager_->scan_devices_async();
+    }
+
     void BluetoothTab::update_bluetooth_state(bool enabled)
     {
         bluetooth_switch_.set_active(enabled);
@@ -140,77 +166,153 @@ namespace Bluetooth
             manager_->disable_bluetooth();
         }
 
-        Glib::signal_timeout().connect_once([this]()
-                                            { bluetooth_switch_.set_sensitive(true); }, 1000);
+        Core::Wakeups::timeout_once(sigc::track_obj([this]()
+                                            { bluetooth_switch_.set_sensitive(true); }, *this), 1000);
     }
 
-    void BluetoothTab::update_device_list(const std::vector<Device> &devices)
+    void BluetoothTab::show_cached_state()
     {
-        // Remove all existing widgets from the container
-        for (auto &widget : widgets_)
+        Core::WarmCache::Reader reader;
+        std::uint32_t count = 0;
+        if (!manager_->is_bluetooth_enabled() || !Core::WarmCache::read(kCacheSection, reader) || !reader.u32(count))
         {
-            container_.remove(*widget);
+            return;
         }
-        widgets_.clear();
 
-        // Remove loading label if it exists
-        if (loading_label_ != nullptr)
+        std::vector<Device> devices;
+        for (std::uint32_t i = 0; i < count && reader.ok(); ++i)
         {
-            container_.remove(*loading_label_);
-            loading_label_ = nullptr;
+            Device device;
+            std::int32_t signal = 0;
+            reader.str(device.name);
+            reader.str(device.address);
+            reader.i32(signal);
+            reader.boolean(device.connected);
+            reader.boolean(device.paired);
+            device.signal_strength = signal;
+            devices.push_back(device);
         }
-
-        // Remove any other children (like status messages) that might be in the container
-        std::vector<Gtk::Widget *> children = container_.get_children();
-        for (auto child : children)
+        if (!reader.ok() || devices.empty())
         {
-            container_.remove(*child);
+            return;
         }
 
-        // If devices list is empty and Bluetooth is disabled, show "Bluetooth is turned off" message
-        if (devices.empty() && !manager_->is_bluetooth_enabled())
-        {
-            Gtk::Label *bluetooth_off = Gtk::manage(new Gtk::Label("Bluetooth is turned off"));
-            bluetooth_off->set_margin_top(20);
-            bluetooth_off->set_margin_bottom(20);
-            container_.pack_start(*bluetooth_off, Gtk::PACK_SHRINK);
-        }
-        // If Bluetooth is enabled but no devices found
-        else if (devices.empty())
+        update_device_list(devices);
+        container_.get_style_context()->add_class("stale");
+    }
+
+    void BluetoothTab::remember_state(const std::vector<Device> &devices)
+    {
+        container_.get_style_context()->remove_class("stale");
+
+        Core::WarmCache::Writer writer;
+        writer.u32(static_cast<std::uint32_t>(devices.size()));
+        for (const auto &device : devices)
         {
-            Gtk::Label *no_devices = Gtk::manage(new Gtk::Label("No Bluetooth devices found"));
-            no_devices->set_margin_top(20);
-            no_devices->set_margin_bottom(20);
-            container_.pack_start(*no_devices, Gtk::PACK_SHRINK);
+            writer.str(device.name);
+            writer.str(device.address);
+            writer.i32(device.signal_strength);
+            writer.boolean(device.connected);
+            writer.boolean(device.paired);
         }
-        else
-        {
-            // Sort devices to keep connected ones at the top
-            std::vector<Device> sorted_devices = devices;
-            std::sort(sorted_devices.begin(), sorted_devices.end(), [](const Device &a, const Device &b)
-                      {
-                if(a.connected != b.connected)
-                    return a.connected;
-                return a.name < b.name; });
-
-            for (const auto &dev : sorted_devices)
+        Core::WarmCache::store(kCacheSection, writer.take());
+    }
+
+    void BluetoothTab::update_device_list(const std::vector<Device> &devices)
+    {
+        Core::Metrics::increment(reconcile_counter);
+        const unsigned int generation = ++list_generation_;
+        const std::int64_t start_us = Core::Trace::now_us();
+
+        // Sort devices to keep connected ones at the top
+        std::vector<Device> sorted_devices = devices;
+        std::sort(sorted_devices.begin(), sorted_devices.end(), [](const Device &a, const Device &b)
+                  {
+            if(a.connected != b.connected)
+                return a.connected;
+            return a.name < b.name; });
+
+        // Clear in the first step so the old rows stay up until new ones land
+        const bool empty = devices.empty();
+        Core::Staging::step(*this, [this, generation, empty]()
+                            {
+            if (generation != list_generation_)
             {
+                return;
+            }
+
+            // Remove all existing widgets from the container
+            for (auto &widget : widgets_)
+            {
+                container_.remove(*widget);
+            }
+            widgets_.clear();
+
+            // Remove loading label if it exists
+            if (loading_label_ != nullptr)
+            {
+                container_.remove(*loading_label_);
+                loading_label_ = nullptr;
+            }
+
+            // Remove any other children (like status messages) that might be in the container
+            std::vector<Gtk::Widget *> children = container_.get_children();
+            for (auto child : children)
+            {
+                container_.remove(*child);
+            }
+
+            if (!empty)
+            {
+                return;
+            }
+
+            // Say why the list is empty: Bluetooth is off, or nothing was found
+            Gtk::Label *message = Gtk::manage(new Gtk::Label(
+                manager_->is_bluetooth_enabled() ? "No Bluetooth devices found" : "Bluetooth is turned off"));
+            message->set_margin_top(20);
+            message->set_margin_bottom(20);
+            container_.pack_start(*message, Gtk::PACK_SHRINK);
+            message->show(); });
+
+        // Create one device row per frame step
+        for (const auto &dev : sorted_devices)
+        {
+            Core::Staging::step(*this, [this, dev, generation]()
+                                {
+                if (generation != list_generation_)
+                {
+                    return;
+                }
                 auto widget = std::make_unique<BluetoothDeviceWidget>(dev, manager_);
                 container_.pack_start(*widget, Gtk::PACK_SHRINK);
-                widgets_.push_back(std::move(widget));
-            }
+                widget->show_all();
+                widgets_.push_back(std::move(widget)); });
         }
 
-        show_all_children();
+        // Time from the update to its last row
+        Core::Staging::step(*this, [this, generation, start_us]()
+                            {
+            if (generation == list_generation_)
+            {
+                Core::Metrics::record_us(reconcile_histogram, static_cast<std::uint64_t>(Core::Trace::now_us() - start_us));
+            } });
     }
 
-    void BluetoothTab::perform_delayed_scan()
+    void BluetoothTab::perform_initial_scan()
     {
         if (initial_scan_performed_)
         {
             return;
         }
 
+        // Don't scan while the window is hidden or unfocused
+        if (!Core::Activity::is_active())
+        {
+            Core::Activity::when_active(sigc::mem_fun(*this, &BluetoothTab::perform_initial_scan));
+            return;
+        }
+
         initial_scan_performed_ = true;
 
         if (manager_->is_bluetooth_enabled())
@@ -218,11 +320,14 @@ namespace Bluetooth
             scan_button_.set_sensitive(false);
             scan_button_.set_label("Scanning...");
             manager_->scan_devices_async();
-            Glib::signal_timeout().connect_once([this]()
+            Core::Wakeups::timeout_once(sigc::track_obj([this]()
                                                 {
                 scan_button_.set_sensitive(true);
-                scan_button_.set_label("Scan"); }, 2000);
+                scan_button_.set_label("Scan"); }, *this), 2000);
         }
     }
 
 } // namespace Bluetooth
+
+/// Factory looked up when libuc-bluetooth.so is loaded
+UC_TAB_MODULE("bluetooth", Bluetooth::BluetoothTab);
@@ -42,16 +42,33 @@ namespace Bluetooth
          */
         virtual ~BluetoothTab();
 
+        /**
+         * @brief Re-read the device list after an outside change
+         */
+        void refresh();
+
     private:
         /**
          * @brief Update the list of displayed Bluetooth devices
          * @param devices Vector of Device objects to display
          *
          * Clears the current list of device widgets and creates new ones
-         * for each device in the provided vector.
+         * for each device in the provided vector. Rows are added in frame
+         * steps (see Core::Staging).
          */
         void update_device_list(const std::vector<Device> &devices);
 
+        /**
+         * @brief Show the devices saved by the last run, marked as stale
+         */
+        void show_cached_state();
+
+        /**
+         * @brief Save live devices to the warm cache and clear the stale marker
+         * @param devices The devices just reported by the manager
+         */
+        void remember_state(const std::vector<Device> &devices);
+
         /**
          * @brief Update the UI based on Bluetooth state
          * @param enabled Whether Bluetooth is enabled
@@ -69,12 +86,12 @@ namespace Bluetooth
         void on_bluetooth_switch_toggled();
 
         /**
-         * @brief Perform a delayed device scan
+         * @brief Perform the first device scan
          *
-         * Called after the tab is fully loaded and visible to the user.
-         * Delays the scan by a short time to ensure UI responsiveness.
+         * Called from the constructor; waits until the window is active and
+         * scans on a worker thread.
          */
-        void perform_delayed_scan();
+        void perform_initial_scan();
 
         std::shared_ptr<BluetoothManager> manager_;                   ///< Bluetooth manager for device operations
         Gtk::Box container_;                                          ///< Container for device widgets
@@ -85,6 +102,7 @@ namespace Bluetooth
         std::vector<std::unique_ptr<BluetoothDeviceWidget>> widgets_; ///< List of device widgets
         bool initial_scan_performed_ = false;                         ///< Flag to track if initial scan has been done
         Gtk::Label *loading_label_ = nullptr;                         ///< Loading message shown before devices are loaded
+        unsigned int list_generation_ = 0;                            ///< Bumped per list update; older queued rows are skipped
     };
 
 } // namespace Bluetooth
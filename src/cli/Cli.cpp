@@ -0,0 +1,130 @@
+/**
+ * @file Cli.cpp
+ * @brief Implementation of the headless command-line mode
+ */
+
+#include "Cli.hpp"
+#include "Query.hpp"
+#include "Watch.hpp"
+#include "core/Json.hpp"
+#include "core/Log.hpp"
+#include <cstring>  // for std::strcmp
+#include <iostream> // for std::cout, std::cerr
+#include <giomm/init.h>
+
+namespace Cli
+{
+
+    namespace
+    {
+        void print_usage()
+        {
+            std::cerr << "Usage: ultimate-control get [subsystem]\n"
+                         "       ultimate-control set <subsystem> <value...>\n"
+                         "       ultimate-control --watch [subsystem,...]\n"
+                         "\n"
+                         "Subsystems:\n"
+                         "  volume     set volume <0-100|+N|-N|mute|unmute|toggle> [device]\n"
+                         "  wifi       set wifi <on|off|disconnect>\n"
+                         "  bluetooth  (read-only)\n"
+                         "  display    set display <0-100|+N|-N>\n"
+                         "  power      set power <profile>\n"
+                         "  battery    (read-only)\n";
+        }
+
+        int fail(const std::string &error)
+        {
+            std::cout << "{\"ok\":false,\"error\":" << Core::Json::quote(error) << "}" << std::endl;
+            return 1;
+        }
+    } // namespace
+
+    bool wants_cli(int argc, char *argv[])
+    {
+        return argc >= 2 && (std::strcmp(argv[1], "get") == 0 || std::strcmp(argv[1], "set") == 0 ||
+                             std::strcmp(argv[1], "--watch") == 0 || std::strncmp(argv[1], "--watch=", 8) == 0);
+    }
+
+    int run(int argc, char *argv[])
+    {
+        // Diagnostics go to stderr so stdout stays pure JSON
+        Core::Log::init(Core::Log::Level::Warn, Core::Log::Sink::Stderr);
+
+        // BlueZ is reached through GDBus; this initialises GLib/GIO only, not GTK
+        Gio::init();
+
+        const std::string command = argv[1];
+        std::vector<std::string> args(argv + 2, argv + argc);
+
+        if (command.compare(0, 7, "--watch") == 0)
+        {
+            // Accept "--watch=a,b", "--watch a,b" and "--watch a b"
+            std::vector<std::string> watched;
+            if (command.size() > 8)
+            {
+                args.insert(args.begin(), command.substr(8));
+            }
+            for (const auto &arg : args)
+            {
+                std::size_t start = 0;
+                while (start <= arg.size())
+                {
+                    std::size_t comma = arg.find(',', start);
+                    std::string name = arg.substr(start, comma == std::string::npos ? std::string::npos : comma - start);
+                    if (!name.empty())
+                    {
+                        watched.push_back(name);
+                    }
+                    if (comma == std::string::npos)
+                    {
+                        break;
+                    }
+                    start = comma + 1;
+                }
+            }
+            return watch(watched);
+        }
+
+        if (command == "get")
+        {
+            if (args.size() > 1)
+            {
+                print_usage();
+                return 2;
+            }
+
+            std::string json;
+            std::string error;
+            if (args.size() == 1)
+            {
+                if (!get(args[0], json, error))
+                {
+                    return fail(error);
+                }
+                std::cout << json << std::endl;
+                return 0;
+            }
+
+            // No subsystem: report everything as one object
+            std::cout << get_all() << std::endl;
+            return 0;
+        }
+
+        if (args.empty())
+        {
+            print_usage();
+            return 2;
+        }
+
+        std::string error;
+        const std::string subsystem = args[0];
+        args.erase(args.begin());
+        if (!set(subsystem, args, error))
+        {
+            return fail(error);
+        }
+        std::cout << "{\"ok\":true}" << std::endl;
+        return 0;
+    }
+
+} // namespace Cli
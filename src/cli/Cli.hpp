@@ -0,0 +1,40 @@
+/**
+ * @file Cli.hpp
+ * @brief Headless command-line mode for Ultimate Control
+ *
+ * This file declares the entry point of `ultimate-control get|set`, which
+ * prints subsystem state as JSON for scripts and status bars without
+ * initialising GTK or opening a display connection.
+ */
+
+#pragma once
+
+/**
+ * @namespace Cli
+ * @brief Contains the headless command-line interface
+ */
+namespace Cli
+{
+
+    /**
+     * @brief Whether the command line asks for the headless mode
+     * @param argc Number of command-line arguments
+     * @param argv Array of command-line arguments
+     * @return true if the first argument is "get", "set" or "--watch"
+     */
+    bool wants_cli(int argc, char *argv[]);
+
+    /**
+     * @brief Run a get or set command and print the result
+     * @param argc Number of command-line arguments
+     * @param argv Array of command-line arguments
+     * @return Process exit code: 0 on success, 1 on failure, 2 on usage errors
+     *
+     * `get [subsystem]` prints one JSON object (all subsystems when none is
+     * given); `set <subsystem> <args...>` applies the change and prints
+     * `{"ok":true}`. Failures print `{"ok":false,"error":"..."}`.
+     * `--watch [subsystem,...]` streams changes until killed (see watch()).
+     */
+    int run(int argc, char *argv[]);
+
+} // namespace Cli
@@ -0,0 +1,674 @@
+/**
+ * @file ControlServer.cpp
+ * @brief Implementation of the control socket server
+ *
+ * The listening socket and every connection are plain non-blocking file
+ * descriptors watched by the default GLib main loop. Each decoded request
+ * becomes a job on a single worker thread; the job's reply is posted back
+ * through a Glib::Dispatcher and written out on the main loop.
+ */
+
+#include "ControlServer.hpp"
+#include "Protocol.hpp"
+#include "Query.hpp"
+#include "Watch.hpp"
+#include "core/Json.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/Trace.hpp"
+#include "core/Wakeups.hpp"
+#include <algorithm>          // for std::find
+#include <cerrno>             // for errno
+#include <condition_variable> // for std::condition_variable
+#include <cstring>            // for std::strerror
+#include <deque>              // for std::deque
+#include <functional>         // for std::function
+#include <map>                // for std::map
+#include <mutex>              // for std::mutex
+#include <set>                // for std::set
+#include <thread>             // for std::thread
+#include <vector>             // for std::vector
+#include <glibmm.h>
+#include <sys/socket.h> // for socket, bind, listen, accept4
+#include <sys/stat.h>   // for chmod
+#include <sys/un.h>     // for sockaddr_un
+#include <unistd.h>     // for read, close, unlink
+
+namespace Cli
+{
+
+    namespace
+    {
+        /// Replies a client hasn't read yet before it is disconnected
+        constexpr std::size_t kMaxPendingOutput = 4u << 20;
+
+        const Core::Metrics::Id connection_counter = Core::Metrics::counter("control.connections");
+        const Core::Metrics::Id request_counter = Core::Metrics::counter("control.requests");
+        const Core::Metrics::Id notification_counter = Core::Metrics::counter("control.notifications");
+        /// Time from a request arriving to its reply being queued for writing
+        const Core::Metrics::Id request_histogram = Core::Metrics::histogram("control.request");
+
+        /**
+         * @brief Check whether someone is accepting connections on a socket path
+         */
+        bool socket_in_use(const sockaddr_un &address)
+        {
+            int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0)
+            {
+                return false;
+            }
+            bool in_use = ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+            ::close(fd);
+            return in_use;
+        }
+
+        /**
+         * @brief Build a response message
+         * @param id The request id, already serialised
+         * @param ok Whether @p body is a result or an error message
+         * @param body JSON result, or the error text
+         */
+        std::string make_response(const std::string &id, bool ok, const std::string &body)
+        {
+            return "{\"id\":" + id + (ok ? ",\"result\":" + body : ",\"error\":" + Core::Json::quote(body)) + "}";
+        }
+    } // namespace
+
+    /**
+     * @class ControlServer::Impl
+     * @brief Private implementation of ControlServer
+     */
+    class ControlServer::Impl
+    {
+    public:
+        /// Work done off the main thread; returns what to run back on it
+        using Job = std::function<std::function<void()>()>;
+
+        Impl()
+        {
+            done_dispatcher_.connect(sigc::mem_fun(*this, &Impl::on_jobs_done));
+            Core::Wakeups::track(done_dispatcher_);
+            worker_ = std::thread(&Impl::worker_loop, this);
+        }
+
+        ~Impl()
+        {
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                stopping_ = true;
+            }
+            jobs_cv_.notify_one();
+            worker_.join();
+
+            // Drop subscriptions first so closing connections doesn't rebuild the watcher
+            watcher_.reset();
+            for (auto &[id, connection] : connections_)
+            {
+                connection.subscribed.clear();
+            }
+            while (!connections_.empty())
+            {
+                close_connection(connections_.begin()->first);
+            }
+            if (listen_fd_ >= 0)
+            {
+                accept_watch_.disconnect();
+                ::close(listen_fd_);
+                ::unlink(path_.c_str());
+            }
+        }
+
+        bool start(std::string &error)
+        {
+            path_ = control_socket_path();
+            if (path_.empty())
+            {
+                error = "XDG_RUNTIME_DIR is not set";
+                return false;
+            }
+
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            if (path_.size() >= sizeof(address.sun_path))
+            {
+                error = "socket path too long: " + path_;
+                return false;
+            }
+            std::copy(path_.begin(), path_.end(), address.sun_path);
+
+            if (socket_in_use(address))
+            {
+                error = "another instance is serving " + path_;
+                return false;
+            }
+            ::unlink(path_.c_str()); // Stale socket from a crashed instance
+
+            listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listen_fd_ < 0 || ::bind(listen_fd_, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+                ::chmod(path_.c_str(), 0600) != 0 || ::listen(listen_fd_, 16) != 0)
+            {
+                error = "cannot listen on " + path_ + ": " + std::strerror(errno);
+                if (listen_fd_ >= 0)
+                {
+                    ::close(listen_fd_);
+                    listen_fd_ = -1;
+                }
+                return false;
+            }
+
+            accept_watch_ = Glib::signal_io().connect(sigc::mem_fun(*this, &Impl::on_accept), listen_fd_, Glib::IO_IN);
+            UC_LOG_INFO(App, "Control socket listening on " << path_);
+            return true;
+        }
+
+        sigc::signal<void, const std::string &> changed_signal_; ///< See ControlServer::signal_changed()
+
+    private:
+        /**
+         * @struct Connection
+         * @brief State of one client connection
+         */
+        struct Connection
+        {
+            int fd = -1;                       ///< Client socket
+            FrameReader reader;                ///< Incoming message decoder
+            std::string output;                ///< Encoded replies not yet written
+            std::set<std::string> subscribed;  ///< Subsystems whose changes are pushed
+            sigc::connection read_watch;       ///< IO_IN watch on fd
+            sigc::connection write_watch;      ///< IO_OUT watch while output is pending
+        };
+
+        bool on_accept(Glib::IOCondition)
+        {
+            int fd;
+            while ((fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+            {
+                Core::Metrics::increment(connection_counter);
+                const unsigned int id = next_connection_id_++;
+                auto &connection = connections_[id];
+                connection.fd = fd;
+                connection.read_watch = Glib::signal_io().connect(
+                    [this, id](Glib::IOCondition condition) -> bool
+                    { return on_readable(id, condition); },
+                    fd, Glib::IO_IN | Glib::IO_HUP | Glib::IO_ERR);
+                UC_LOG_DEBUG(App, "Control client " << id << " connected");
+            }
+            return true;
+        }
+
+        bool on_readable(unsigned int id, Glib::IOCondition condition)
+        {
+            auto it = connections_.find(id);
+            if (it == connections_.end())
+            {
+                return false;
+            }
+
+            char buffer[16384];
+            ssize_t count = (condition & Glib::IO_IN) ? ::read(it->second.fd, buffer, sizeof(buffer)) : 0;
+            if (count < 0 && (errno == EAGAIN || errno == EINTR))
+            {
+                return true;
+            }
+            if (count <= 0)
+            {
+                close_connection(id);
+                return false;
+            }
+
+            auto &reader = it->second.reader;
+            reader.feed(buffer, static_cast<std::size_t>(count));
+            std::string payload;
+            while (reader.next(payload))
+            {
+                handle_request(id, payload);
+            }
+            if (reader.oversized())
+            {
+                UC_LOG_WARN(App, "Control client " << id << " sent an oversized message, disconnecting");
+                close_connection(id);
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Decode one request and queue it for the worker
+         *
+         * Even malformed requests are answered through the worker queue so
+         * that replies stay in request order.
+         */
+        void handle_request(unsigned int connection, const std::string &payload)
+        {
+            Core::Metrics::increment(request_counter);
+            const std::int64_t received_us = Core::Trace::now_us();
+
+            Core::Json::Value request;
+            std::string error;
+            std::string id = "null";
+            std::string method;
+            const Core::Json::Value *params = nullptr;
+            if (Core::Json::parse(payload, request, error))
+            {
+                if (const auto *value = request.find("id"))
+                {
+                    id = Core::Json::dump(*value);
+                }
+                if (const auto *value = request.find("method"); value && value->type == Core::Json::Value::Type::String)
+                {
+                    method = value->string;
+                }
+                params = request.find("params");
+            }
+            else
+            {
+                error = "invalid request: " + error;
+            }
+
+            auto reply = [this, connection, id, received_us](bool ok, const std::string &body)
+            {
+                return [this, connection, id, received_us, ok, body]()
+                {
+                    Core::Metrics::record_us(request_histogram, static_cast<std::uint64_t>(Core::Trace::now_us() - received_us));
+                    send(connection, make_response(id, ok, body));
+                };
+            };
+
+            std::string subsystem;
+            if (params)
+            {
+                if (const auto *value = params->find("subsystem"); value && value->type == Core::Json::Value::Type::String)
+                {
+                    subsystem = value->string;
+                }
+            }
+
+            if (error.empty() && method == "get")
+            {
+                submit([subsystem, reply]()
+                       {
+                    std::string json;
+                    std::string error;
+                    if (subsystem.empty())
+                    {
+                        return reply(true, get_all());
+                    }
+                    bool ok = get(subsystem, json, error);
+                    return reply(ok, ok ? json : error); });
+                return;
+            }
+
+            if (error.empty() && method == "set")
+            {
+                std::vector<std::string> args;
+                const auto *value = params ? params->find("args") : nullptr;
+                if (value && value->type == Core::Json::Value::Type::Array)
+                {
+                    for (const auto &arg : value->array)
+                    {
+                        // Accept {"args":[50]} as well as {"args":["50"]}
+                        args.push_back(arg.type == Core::Json::Value::Type::String ? arg.string : Core::Json::dump(arg));
+                    }
+                }
+                submit([this, subsystem, args, reply]() -> std::function<void()>
+                       {
+                    std::string error;
+                    if (!set(subsystem, args, error))
+                    {
+                        return reply(false, error);
+                    }
+                    auto respond = reply(true, "true");
+                    return [this, subsystem, respond]()
+                    {
+                        respond();
+                        changed_signal_.emit(subsystem);
+                    }; });
+                return;
+            }
+
+            if (error.empty() && method == "subscribe")
+            {
+                subscribe(connection, params, reply);
+                return;
+            }
+
+            if (error.empty())
+            {
+                error = method.empty() ? "missing method" : "unknown method: " + method;
+            }
+            submit([reply, error]()
+                   { return reply(false, error); });
+        }
+
+        /**
+         * @brief Add subsystems to a connection's subscriptions
+         *
+         * The reply carries the current state of the requested subsystems;
+         * afterwards only changes are pushed as "changed" notifications.
+         */
+        template <typename Reply>
+        void subscribe(unsigned int connection, const Core::Json::Value *params, const Reply &reply)
+        {
+            std::vector<std::string> requested;
+            const auto *value = params ? params->find("subsystems") : nullptr;
+            if (value && value->type == Core::Json::Value::Type::Array)
+            {
+                for (const auto &name : value->array)
+                {
+                    requested.push_back(name.string);
+                }
+            }
+            if (requested.empty())
+            {
+                requested = subsystems();
+            }
+
+            const auto &known = subsystems();
+            for (const auto &name : requested)
+            {
+                if (std::find(known.begin(), known.end(), name) == known.end())
+                {
+                    submit([reply, name]()
+                           { return reply(false, "unknown subsystem: " + name); });
+                    return;
+                }
+            }
+
+            auto &subscribed = connections_[connection].subscribed;
+            subscribed.insert(requested.begin(), requested.end());
+            update_watcher();
+
+            submit([this, requested, reply]()
+                   {
+                std::string state = "{";
+                for (std::size_t i = 0; i < requested.size(); ++i)
+                {
+                    state += (i ? "," : "") + Core::Json::quote(requested[i]) + ":" + read_state(requested[i]);
+                }
+                return reply(true, state + "}"); });
+        }
+
+        /**
+         * @brief Read a subsystem and remember the result (worker thread only)
+         * @return The subsystem's JSON, or an error object
+         */
+        std::string read_state(const std::string &subsystem)
+        {
+            std::string json;
+            std::string error;
+            if (!get(subsystem, json, error))
+            {
+                json = "{\"error\":" + Core::Json::quote(error) + "}";
+            }
+            last_state_[subsystem] = json;
+            return json;
+        }
+
+        /**
+         * @brief Make the watcher cover exactly the subscribed subsystems
+         */
+        void update_watcher()
+        {
+            std::set<std::string> wanted;
+            for (const auto &[id, connection] : connections_)
+            {
+                wanted.insert(connection.subscribed.begin(), connection.subscribed.end());
+            }
+            if (wanted == watched_)
+            {
+                return;
+            }
+
+            watched_ = wanted;
+            watcher_.reset();
+            if (watched_.empty())
+            {
+                return; // Last subscriber left; stop pactl and the bus subscriptions
+            }
+            watcher_ = std::make_unique<Watcher>(std::vector<std::string>(watched_.begin(), watched_.end()),
+                                                 [this](const std::set<std::string> &dirty)
+                                                 { on_dirty(dirty); });
+            watcher_->start();
+        }
+
+        /**
+         * @brief Re-read dirty subsystems off-thread and push the ones that changed
+         *
+         * The first read of a subsystem only records a baseline: subscribers
+         * receive the initial state in their subscribe reply instead.
+         */
+        void on_dirty(const std::set<std::string> &dirty)
+        {
+            submit([this, dirty]() -> std::function<void()>
+                   {
+                std::map<std::string, std::string> changed;
+                for (const auto &subsystem : dirty)
+                {
+                    auto previous = last_state_.find(subsystem);
+                    const bool known = previous != last_state_.end();
+                    const std::string before = known ? previous->second : "";
+                    std::string json = read_state(subsystem);
+                    if (known && json != before)
+                    {
+                        changed[subsystem] = json;
+                    }
+                }
+                return [this, changed]()
+                {
+                    notify(changed);
+                }; });
+        }
+
+        void notify(const std::map<std::string, std::string> &changed)
+        {
+            if (changed.empty())
+            {
+                return;
+            }
+
+            std::vector<unsigned int> ids;
+            for (const auto &[id, connection] : connections_)
+            {
+                ids.push_back(id);
+            }
+            for (unsigned int id : ids)
+            {
+                auto it = connections_.find(id);
+                if (it == connections_.end())
+                {
+                    continue;
+                }
+                std::string params;
+                for (const auto &[subsystem, json] : changed)
+                {
+                    if (it->second.subscribed.count(subsystem))
+                    {
+                        params += (params.empty() ? "{" : ",") + Core::Json::quote(subsystem) + ":" + json;
+                    }
+                }
+                if (!params.empty())
+                {
+                    Core::Metrics::increment(notification_counter);
+                    send(id, "{\"method\":\"changed\",\"params\":" + params + "}}");
+                }
+            }
+
+            // The window only needs to know which subsystems to refresh
+            for (const auto &[subsystem, json] : changed)
+            {
+                changed_signal_.emit(subsystem);
+            }
+        }
+
+        /**
+         * @brief Queue a message for a connection and write what the socket accepts
+         */
+        void send(unsigned int id, const std::string &message)
+        {
+            auto it = connections_.find(id);
+            if (it == connections_.end())
+            {
+                return; // Client went away before its reply was ready
+            }
+            auto &connection = it->second;
+            connection.output += encode_frame(message);
+            if (connection.output.size() > kMaxPendingOutput)
+            {
+                UC_LOG_WARN(App, "Control client " << id << " is not reading its replies, disconnecting");
+                close_connection(id);
+                return;
+            }
+            if (!connection.write_watch.connected())
+            {
+                flush_output(id);
+            }
+        }
+
+        /**
+         * @brief Write pending output; keeps an IO_OUT watch while the socket is full
+         * @return true while output remains
+         */
+        bool flush_output(unsigned int id)
+        {
+            auto it = connections_.find(id);
+            if (it == connections_.end())
+            {
+                return false;
+            }
+            auto &connection = it->second;
+            while (!connection.output.empty())
+            {
+                ssize_t written = ::send(connection.fd, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (errno != EAGAIN)
+                    {
+                        close_connection(id);
+                        return false;
+                    }
+                    if (!connection.write_watch.connected())
+                    {
+                        connection.write_watch = Glib::signal_io().connect(
+                            [this, id](Glib::IOCondition) -> bool
+                            { return flush_output(id); },
+                            connection.fd, Glib::IO_OUT);
+                    }
+                    return true;
+                }
+                connection.output.erase(0, static_cast<std::size_t>(written));
+            }
+            connection.write_watch.disconnect();
+            return false;
+        }
+
+        void close_connection(unsigned int id)
+        {
+            auto it = connections_.find(id);
+            if (it == connections_.end())
+            {
+                return;
+            }
+            it->second.read_watch.disconnect();
+            it->second.write_watch.disconnect();
+            ::close(it->second.fd);
+            const bool had_subscriptions = !it->second.subscribed.empty();
+            connections_.erase(it);
+            UC_LOG_DEBUG(App, "Control client " << id << " disconnected");
+
+            if (had_subscriptions)
+            {
+                update_watcher();
+            }
+        }
+
+        void submit(Job job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                jobs_.push_back(std::move(job));
+            }
+            jobs_cv_.notify_one();
+        }
+
+        void worker_loop()
+        {
+            Core::Trace::set_thread_name("control");
+            while (true)
+            {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(jobs_mutex_);
+                    jobs_cv_.wait(lock, [this]()
+                                  { return stopping_ || !jobs_.empty(); });
+                    if (stopping_)
+                    {
+                        return;
+                    }
+                    job = std::move(jobs_.front());
+                    jobs_.pop_front();
+                }
+
+                auto done = job();
+                {
+                    std::lock_guard<std::mutex> lock(jobs_mutex_);
+                    done_.push_back(std::move(done));
+                }
+                done_dispatcher_.emit();
+            }
+        }
+
+        /**
+         * @brief Run the main-thread halves of finished jobs, in order
+         */
+        void on_jobs_done()
+        {
+            std::deque<std::function<void()>> done;
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                done.swap(done_);
+            }
+            for (auto &callback : done)
+            {
+                callback();
+            }
+        }
+
+        std::string path_;                                ///< Socket file path
+        int listen_fd_ = -1;                              ///< Listening socket
+        sigc::connection accept_watch_;                   ///< IO_IN watch on listen_fd_
+        unsigned int next_connection_id_ = 1;             ///< Id given to the next client
+        std::map<unsigned int, Connection> connections_;  ///< Open client connections
+
+        std::set<std::string> watched_;                   ///< Subsystems the watcher covers
+        std::unique_ptr<Watcher> watcher_;                ///< Change notifications for subscribers
+        std::map<std::string, std::string> last_state_;   ///< Last JSON read per subsystem (worker only)
+
+        std::mutex jobs_mutex_;                           ///< Guards jobs_, done_ and stopping_
+        std::condition_variable jobs_cv_;                 ///< Wakes the worker
+        std::deque<Job> jobs_;                            ///< Requests waiting for the worker
+        std::deque<std::function<void()>> done_;          ///< Replies waiting for the main thread
+        bool stopping_ = false;                           ///< Set when the worker must exit
+        Glib::Dispatcher done_dispatcher_;                ///< Wakes the main thread for done_
+        std::thread worker_;                              ///< Runs get/set off the main thread
+    };
+
+    ControlServer::ControlServer() : impl_(std::make_unique<Impl>()) {}
+
+    ControlServer::~ControlServer() = default;
+
+    bool ControlServer::start(std::string &error)
+    {
+        return impl_->start(error);
+    }
+
+    sigc::signal<void, const std::string &> &ControlServer::signal_changed()
+    {
+        return impl_->changed_signal_;
+    }
+
+} // namespace Cli
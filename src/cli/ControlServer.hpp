@@ -0,0 +1,70 @@
+/**
+ * @file ControlServer.hpp
+ * @brief Control socket served by the running instance
+ *
+ * This file declares the server behind `$XDG_RUNTIME_DIR/ultimate-control.sock`.
+ * Scripts and keybindings talk to it (directly or through
+ * `ultimate-control-ctl`) instead of running pactl/nmcli themselves, so the
+ * open window learns about every change immediately. See Protocol.hpp for
+ * the wire format.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <sigc++/sigc++.h>
+
+/**
+ * @namespace Cli
+ * @brief Contains the headless command-line interface
+ */
+namespace Cli
+{
+
+    /**
+     * @class ControlServer
+     * @brief Accepts connections on the control socket and answers requests
+     *
+     * Sockets are watched on the default main loop. get/set requests run on
+     * one worker thread in arrival order, so pipelined requests are answered
+     * in order and a slow nmcli scan never blocks the window. Subscriptions
+     * share a single Watcher covering every subscribed subsystem.
+     */
+    class ControlServer
+    {
+    public:
+        /**
+         * @brief Constructor; does not open the socket yet
+         */
+        ControlServer();
+
+        /**
+         * @brief Destructor; closes every connection and removes the socket
+         */
+        ~ControlServer();
+
+        /**
+         * @brief Bind the socket and start accepting connections
+         * @param error Receives a message on failure
+         * @return true if the server is listening
+         *
+         * Fails if XDG_RUNTIME_DIR is unset or another process is already
+         * serving the socket. A stale socket file left by a crash is replaced.
+         */
+        bool start(std::string &error);
+
+        /**
+         * @brief Signal emitted on the main loop when a subsystem changed
+         *
+         * Emitted after a successful `set` and, while clients are subscribed,
+         * for changes made outside the application.
+         */
+        sigc::signal<void, const std::string &> &signal_changed();
+
+    private:
+        class Impl;                  ///< Forward declaration of implementation class
+        std::unique_ptr<Impl> impl_; ///< Pointer to implementation (PIMPL idiom)
+    };
+
+} // namespace Cli
@@ -0,0 +1,78 @@
+/**
+ * @file Protocol.cpp
+ * @brief Implementation of the control socket framing
+ */
+
+#include "Protocol.hpp"
+#include <cstdlib> // for std::getenv
+
+namespace Cli
+{
+
+    std::string control_socket_path()
+    {
+        const char *runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+        if (runtime_dir == nullptr || *runtime_dir == '\0')
+        {
+            return "";
+        }
+        return std::string(runtime_dir) + "/ultimate-control.sock";
+    }
+
+    std::string encode_frame(const std::string &payload)
+    {
+        const auto size = static_cast<std::uint32_t>(payload.size());
+        std::string frame;
+        frame.reserve(4 + payload.size());
+        frame += static_cast<char>((size >> 24) & 0xFF);
+        frame += static_cast<char>((size >> 16) & 0xFF);
+        frame += static_cast<char>((size >> 8) & 0xFF);
+        frame += static_cast<char>(size & 0xFF);
+        frame += payload;
+        return frame;
+    }
+
+    void FrameReader::feed(const char *data, std::size_t size)
+    {
+        // Compact lazily so a burst of small frames isn't copied once per frame
+        if (offset_ > 0 && offset_ >= buffer_.size() / 2)
+        {
+            buffer_.erase(0, offset_);
+            offset_ = 0;
+        }
+        buffer_.append(data, size);
+    }
+
+    bool FrameReader::next(std::string &payload)
+    {
+        if (oversized_ || buffer_.size() - offset_ < 4)
+        {
+            return false;
+        }
+
+        const auto *header = reinterpret_cast<const unsigned char *>(buffer_.data() + offset_);
+        const std::uint32_t size = (static_cast<std::uint32_t>(header[0]) << 24) |
+                                   (static_cast<std::uint32_t>(header[1]) << 16) |
+                                   (static_cast<std::uint32_t>(header[2]) << 8) |
+                                   static_cast<std::uint32_t>(header[3]);
+        if (size > kMaxFrameSize)
+        {
+            oversized_ = true;
+            return false;
+        }
+        if (buffer_.size() - offset_ - 4 < size)
+        {
+            return false; // Rest of the frame hasn't arrived yet
+        }
+
+        payload.assign(buffer_, offset_ + 4, size);
+        offset_ += 4 + size;
+        if (offset_ == buffer_.size())
+        {
+            buffer_.clear();
+            offset_ = 0;
+        }
+        return true;
+    }
+
+} // namespace Cli
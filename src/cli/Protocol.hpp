@@ -0,0 +1,80 @@
+/**
+ * @file Protocol.hpp
+ * @brief Wire format of the control socket
+ *
+ * This file declares the framing shared by the control server and the
+ * `ultimate-control-ctl` client. Every message is a 4-byte big-endian
+ * length followed by that many bytes of UTF-8 JSON:
+ *
+ * - request: `{"id":1,"method":"get","params":{"subsystem":"volume"}}`
+ * - response: `{"id":1,"result":{...}}` or `{"id":1,"error":"..."}`
+ * - notification: `{"method":"changed","params":{"volume":{...}}}`
+ *
+ * Methods are `get` (params.subsystem optional), `set` (params.subsystem
+ * and params.args) and `subscribe` (params.subsystems optional). Requests
+ * may be pipelined; responses come back in request order.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace Cli
+ * @brief Contains the headless command-line interface
+ */
+namespace Cli
+{
+
+    /// Largest accepted message; anything bigger closes the connection
+    constexpr std::uint32_t kMaxFrameSize = 1u << 20;
+
+    /**
+     * @brief Path of the control socket
+     * @return `$XDG_RUNTIME_DIR/ultimate-control.sock`, or an empty string
+     *         when XDG_RUNTIME_DIR is not set
+     */
+    std::string control_socket_path();
+
+    /**
+     * @brief Prefix a message with its length
+     * @param payload The JSON text
+     * @return The bytes to write to the socket
+     */
+    std::string encode_frame(const std::string &payload);
+
+    /**
+     * @class FrameReader
+     * @brief Splits a byte stream back into messages
+     */
+    class FrameReader
+    {
+    public:
+        /**
+         * @brief Append bytes read from the socket
+         * @param data Start of the bytes
+         * @param size Number of bytes
+         */
+        void feed(const char *data, std::size_t size);
+
+        /**
+         * @brief Take the next complete message
+         * @param payload Receives the JSON text
+         * @return true if a message was available
+         */
+        bool next(std::string &payload);
+
+        /**
+         * @brief Whether the peer announced a message over kMaxFrameSize
+         */
+        bool oversized() const { return oversized_; }
+
+    private:
+        std::string buffer_;     ///< Bytes received but not yet returned
+        std::size_t offset_ = 0; ///< Start of the first unread frame in buffer_
+        bool oversized_ = false; ///< Set once an oversized frame is seen
+    };
+
+} // namespace Cli
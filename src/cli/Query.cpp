@@ -0,0 +1,412 @@
+/**
+ * @file Query.cpp
+ * @brief Implementation of the GTK-free state queries
+ *
+ * Each subsystem gets a pair of functions that construct the manager,
+ * read or change its state synchronously and report the result. Nothing
+ * here needs a main loop: managers are used through their blocking calls.
+ */
+
+#include "Query.hpp"
+#include "core/Json.hpp"
+#include "volume/VolumeManager.hpp"
+#include "wifi/WifiManager.hpp"
+#include "bluetooth/BluetoothManager.hpp"
+#include "display/DisplayManager.hpp"
+#include "power/PowerManager.hpp"
+#include "core/Metrics.hpp"
+#include <algorithm> // for std::find, std::clamp
+#include <map>       // for std::map
+#include <sstream>   // for std::ostringstream
+#include <giomm.h>
+
+namespace Cli
+{
+
+    namespace
+    {
+        /// Counts synchronous D-Bus round trips
+        const Core::Metrics::Id dbus_counter = Core::Metrics::counter("dbus.calls");
+
+        using GetFunction = bool (*)(std::string &, std::string &);
+        using SetFunction = bool (*)(const std::vector<std::string> &, std::string &);
+
+        /**
+         * @brief Parse an absolute ("40") or relative ("+5", "-5") percentage
+         * @param text The argument text
+         * @param current The current value, used for relative changes
+         * @param result Receives the new value, clamped to 0-100
+         * @return true if the text is a valid number
+         */
+        bool parse_percent(const std::string &text, int current, int &result)
+        {
+            if (text.empty())
+            {
+                return false;
+            }
+            try
+            {
+                std::size_t used = 0;
+                int value = std::stoi(text, &used);
+                if (used != text.size())
+                {
+                    return false;
+                }
+                bool relative = text[0] == '+' || text[0] == '-';
+                result = std::clamp(relative ? current + value : value, 0, 100);
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Whether a PulseAudio device name refers to an input device
+         *
+         * Mirrors the heuristic VolumeManager uses to pick sink or source commands.
+         */
+        bool is_input_device(const std::string &name)
+        {
+            return name.find("input") != std::string::npos || name.find("source") != std::string::npos;
+        }
+
+        Volume::VolumeManager::SinkList list_audio_devices(Volume::VolumeManager &manager)
+        {
+            Volume::VolumeManager::SinkList devices;
+            manager.set_update_callback([&devices](const Volume::VolumeManager::SinkList &list)
+                                        { devices = list; });
+            manager.refresh_sinks();
+            return devices;
+        }
+
+        bool get_volume(std::string &json, std::string &error)
+        {
+            Volume::VolumeManager manager;
+            auto devices = list_audio_devices(manager);
+
+            std::ostringstream out;
+            out << "{\"devices\":[";
+            for (std::size_t i = 0; i < devices.size(); ++i)
+            {
+                const auto &device = devices[i];
+                out << (i ? "," : "")
+                    << "{\"name\":" << Core::Json::quote(device.name)
+                    << ",\"description\":" << Core::Json::quote(device.description)
+                    << ",\"input\":" << (is_input_device(device.name) ? "true" : "false")
+                    << ",\"volume\":" << device.volume
+                    << ",\"muted\":" << (device.muted ? "true" : "false")
+                    << ",\"default\":" << (device.is_default ? "true" : "false") << "}";
+            }
+            out << "]}";
+            json = out.str();
+            return true;
+        }
+
+        bool set_volume(const std::vector<std::string> &args, std::string &error)
+        {
+            if (args.empty() || args.size() > 2)
+            {
+                error = "usage: set volume <0-100|+N|-N|mute|unmute|toggle> [device]";
+                return false;
+            }
+
+            Volume::VolumeManager manager;
+            auto devices = list_audio_devices(manager);
+
+            // Default to the default output device
+            auto device = std::find_if(devices.begin(), devices.end(), [&args](const Volume::AudioSink &sink)
+                                       { return args.size() == 2 ? sink.name == args[1]
+                                                                 : sink.is_default && !is_input_device(sink.name); });
+            if (device == devices.end())
+            {
+                error = args.size() == 2 ? "unknown audio device: " + args[1] : "no default audio output";
+                return false;
+            }
+
+            const std::string &action = args[0];
+            if (action == "toggle" || (action == "mute" && !device->muted) || (action == "unmute" && device->muted))
+            {
+                manager.toggle_mute(device->name);
+                return true;
+            }
+            if (action == "mute" || action == "unmute")
+            {
+                return true; // Already in the requested state
+            }
+
+            int volume = 0;
+            if (!parse_percent(action, device->volume, volume))
+            {
+                error = "invalid volume: " + action;
+                return false;
+            }
+            manager.set_volume(device->name, volume);
+            return true;
+        }
+
+        bool get_wifi(std::string &json, std::string &error)
+        {
+            Wifi::WifiManager manager;
+            bool enabled = manager.is_wifi_enabled();
+            if (enabled)
+            {
+                manager.scan_networks();
+            }
+
+            std::string connected;
+            std::ostringstream networks;
+            const auto &list = manager.get_networks();
+            for (std::size_t i = 0; i < list.size(); ++i)
+            {
+                const auto &network = list[i];
+                if (network.connected)
+                {
+                    connected = network.ssid;
+                }
+                networks << (i ? "," : "")
+                         << "{\"ssid\":" << Core::Json::quote(network.ssid)
+                         << ",\"signal\":" << network.signal_strength
+                         << ",\"secured\":" << (network.secured ? "true" : "false")
+                         << ",\"connected\":" << (network.connected ? "true" : "false") << "}";
+            }
+
+            std::ostringstream out;
+            out << "{\"enabled\":" << (enabled ? "true" : "false")
+                << ",\"ethernet\":" << (manager.is_ethernet_connected() ? "true" : "false")
+                << ",\"connected\":" << (connected.empty() ? "null" : Core::Json::quote(connected))
+                << ",\"networks\":[" << networks.str() << "]}";
+            json = out.str();
+            return true;
+        }
+
+        bool set_wifi(const std::vector<std::string> &args, std::string &error)
+        {
+            if (args.size() != 1)
+            {
+                error = "usage: set wifi <on|off|disconnect>";
+                return false;
+            }
+
+            Wifi::WifiManager manager;
+            if (args[0] == "on")
+            {
+                manager.enable_wifi();
+            }
+            else if (args[0] == "off")
+            {
+                manager.disable_wifi();
+            }
+            else if (args[0] == "disconnect")
+            {
+                manager.disconnect();
+            }
+            else
+            {
+                error = "invalid wifi state: " + args[0];
+                return false;
+            }
+            return true;
+        }
+
+        bool get_bluetooth(std::string &json, std::string &error)
+        {
+            Bluetooth::BluetoothManager manager;
+            manager.scan_devices();
+
+            std::ostringstream out;
+            out << "{\"enabled\":" << (manager.is_bluetooth_enabled() ? "true" : "false") << ",\"devices\":[";
+            const auto &devices = manager.get_devices();
+            for (std::size_t i = 0; i < devices.size(); ++i)
+            {
+                const auto &device = devices[i];
+                out << (i ? "," : "")
+                    << "{\"name\":" << Core::Json::quote(device.name)
+                    << ",\"address\":" << Core::Json::quote(device.address)
+                    << ",\"signal\":" << device.signal_strength
+                    << ",\"paired\":" << (device.paired ? "true" : "false")
+                    << ",\"connected\":" << (device.connected ? "true" : "false") << "}";
+            }
+            out << "]}";
+            json = out.str();
+            return true;
+        }
+
+        bool get_display(std::string &json, std::string &error)
+        {
+            Display::DisplayManager manager;
+            json = "{\"brightness\":" + std::to_string(manager.get_brightness()) + "}";
+            return true;
+        }
+
+        bool set_display(const std::vector<std::string> &args, std::string &error)
+        {
+            if (args.size() != 1)
+            {
+                error = "usage: set display <0-100|+N|-N>";
+                return false;
+            }
+
+            Display::DisplayManager manager;
+            int brightness = 0;
+            if (!parse_percent(args[0], manager.get_brightness(), brightness))
+            {
+                error = "invalid brightness: " + args[0];
+                return false;
+            }
+            manager.set_brightness(brightness);
+            return true;
+        }
+
+        bool get_power(std::string &json, std::string &error)
+        {
+            Power::PowerManager manager;
+            auto profiles = manager.list_power_profiles();
+
+            std::ostringstream out;
+            out << "{\"profile\":" << Core::Json::quote(manager.get_current_power_profile()) << ",\"profiles\":[";
+            for (std::size_t i = 0; i < profiles.size(); ++i)
+            {
+                out << (i ? "," : "") << Core::Json::quote(profiles[i]);
+            }
+            out << "]}";
+            json = out.str();
+            return true;
+        }
+
+        bool set_power(const std::vector<std::string> &args, std::string &error)
+        {
+            if (args.size() != 1)
+            {
+                error = "usage: set power <profile>";
+                return false;
+            }
+
+            Power::PowerManager manager;
+            auto profiles = manager.list_power_profiles();
+            if (std::find(profiles.begin(), profiles.end(), args[0]) == profiles.end())
+            {
+                error = "unknown power profile: " + args[0];
+                return false;
+            }
+            manager.set_power_profile(args[0]);
+            return true;
+        }
+
+        /**
+         * @brief Read a cached property of a D-Bus proxy
+         * @return The value, or @p fallback if the property is missing
+         */
+        template <typename T>
+        T cached_property(const Glib::RefPtr<Gio::DBus::Proxy> &proxy, const char *name, T fallback)
+        {
+            Glib::VariantBase value;
+            proxy->get_cached_property(value, name);
+            if (!value)
+            {
+                return fallback;
+            }
+            return Glib::VariantBase::cast_dynamic<Glib::Variant<T>>(value).get();
+        }
+
+        bool get_battery(std::string &json, std::string &error)
+        {
+            static const char *const states[] = {"unknown", "charging", "discharging", "empty",
+                                                 "fully-charged", "pending-charge", "pending-discharge"};
+            try
+            {
+                // UPower's composite device summarises all batteries
+                Core::Metrics::increment(dbus_counter);
+                auto proxy = Gio::DBus::Proxy::create_for_bus_sync(
+                    Gio::DBus::BUS_TYPE_SYSTEM, "org.freedesktop.UPower",
+                    "/org/freedesktop/UPower/devices/DisplayDevice", "org.freedesktop.UPower.Device");
+
+                guint32 state = cached_property<guint32>(proxy, "State", 0);
+                std::ostringstream out;
+                out << "{\"present\":" << (cached_property<bool>(proxy, "IsPresent", false) ? "true" : "false")
+                    << ",\"percentage\":" << static_cast<int>(cached_property<double>(proxy, "Percentage", 0.0) + 0.5)
+                    << ",\"state\":" << Core::Json::quote(state < 7 ? states[state] : "unknown")
+                    << ",\"time_to_empty\":" << cached_property<gint64>(proxy, "TimeToEmpty", 0)
+                    << ",\"time_to_full\":" << cached_property<gint64>(proxy, "TimeToFull", 0) << "}";
+                json = out.str();
+                return true;
+            }
+            catch (const Glib::Error &ex)
+            {
+                error = "UPower unavailable: " + std::string(ex.what());
+                return false;
+            }
+        }
+
+        struct Handlers
+        {
+            GetFunction get;
+            SetFunction set; ///< nullptr if the subsystem is read-only
+        };
+
+        const std::map<std::string, Handlers> &handlers()
+        {
+            static const std::map<std::string, Handlers> table = {
+                {"volume", {get_volume, set_volume}},
+                {"wifi", {get_wifi, set_wifi}},
+                {"bluetooth", {get_bluetooth, nullptr}},
+                {"display", {get_display, set_display}},
+                {"power", {get_power, set_power}},
+                {"battery", {get_battery, nullptr}},
+            };
+            return table;
+        }
+    } // namespace
+
+    const std::vector<std::string> &subsystems()
+    {
+        static const std::vector<std::string> names = {"volume", "wifi", "bluetooth", "display", "power", "battery"};
+        return names;
+    }
+
+    bool get(const std::string &subsystem, std::string &json, std::string &error)
+    {
+        auto it = handlers().find(subsystem);
+        if (it == handlers().end())
+        {
+            error = "unknown subsystem: " + subsystem;
+            return false;
+        }
+        return it->second.get(json, error);
+    }
+
+    std::string get_all()
+    {
+        std::string all = "{";
+        const auto &names = subsystems();
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            std::string json;
+            std::string error;
+            if (!get(names[i], json, error))
+            {
+                json = "{\"error\":" + Core::Json::quote(error) + "}";
+            }
+            all += (i ? "," : "") + Core::Json::quote(names[i]) + ":" + json;
+        }
+        return all + "}";
+    }
+
+    bool set(const std::string &subsystem, const std::vector<std::string> &args, std::string &error)
+    {
+        auto it = handlers().find(subsystem);
+        if (it == handlers().end())
+        {
+            error = "unknown subsystem: " + subsystem;
+            return false;
+        }
+        if (!it->second.set)
+        {
+            error = subsystem + " cannot be changed from the command line";
+            return false;
+        }
+        return it->second.set(args, error);
+    }
+
+} // namespace Cli
@@ -0,0 +1,60 @@
+/**
+ * @file Query.hpp
+ * @brief GTK-free state queries and changes for Ultimate Control
+ *
+ * This file declares the functions that read and change the state of each
+ * subsystem (volume, wifi, bluetooth, display, power, battery) directly
+ * through the managers, and serialise it as JSON. They are used by the
+ * headless `ultimate-control get|set` command line, --watch and the control
+ * socket, and never touch GTK.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Cli
+ * @brief Contains the headless command-line interface
+ */
+namespace Cli
+{
+
+    /**
+     * @brief Names of all subsystems that can be queried
+     * @return The subsystem names in display order
+     */
+    const std::vector<std::string> &subsystems();
+
+    /**
+     * @brief Read the current state of a subsystem as JSON
+     * @param subsystem Subsystem name (see subsystems())
+     * @param json Receives a JSON object on success
+     * @param error Receives a message on failure
+     * @return true on success
+     */
+    bool get(const std::string &subsystem, std::string &json, std::string &error);
+
+    /**
+     * @brief Read every subsystem as one JSON object keyed by name
+     * @return The object; subsystems that fail hold `{"error":"..."}`
+     */
+    std::string get_all();
+
+    /**
+     * @brief Change the state of a subsystem
+     * @param subsystem Subsystem name (see subsystems())
+     * @param args Subsystem-specific arguments, e.g. {"+5"} for volume
+     * @param error Receives a message on failure
+     * @return true on success
+     *
+     * Accepted arguments:
+     * - volume: `<0-100|+N|-N|mute|unmute|toggle> [device]`
+     * - wifi: `on|off|disconnect`
+     * - display: `<0-100|+N|-N>`
+     * - power: `<profile>`
+     */
+    bool set(const std::string &subsystem, const std::vector<std::string> &args, std::string &error);
+
+} // namespace Cli
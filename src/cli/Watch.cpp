@@ -0,0 +1,387 @@
+/**
+ * @file Watch.cpp
+ * @brief Implementation of the event-stream watch mode
+ *
+ * A single GLib main loop multiplexes every event source. Sources only mark
+ * subsystems dirty; a 16 ms one-shot timer then hands the dirty set to the
+ * watcher's owner. watch() re-reads it through Cli::get() and prints
+ * whatever changed.
+ */
+
+#include "Watch.hpp"
+#include "Query.hpp"
+#include "core/Backend.hpp"
+#include "core/Json.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/Wakeups.hpp"
+#include <algorithm>  // for std::find
+#include <filesystem> // for std::filesystem::directory_iterator
+#include <iostream>   // for std::cout
+#include <map>        // for std::map
+#include <set>        // for std::set
+#include <csignal>    // for SIGTERM, kill
+#include <giomm.h>
+#include <glibmm.h>
+#include <sys/prctl.h> // for prctl
+#include <sys/wait.h>  // for waitpid
+#include <unistd.h>    // for read, close
+
+namespace Cli
+{
+
+    namespace
+    {
+        constexpr unsigned int kCoalesceMs = 16;       ///< Window in which events are merged into one line
+        constexpr unsigned int kRespawnDelayMs = 1000; ///< Delay before restarting `pactl subscribe`
+
+        /// Counts the pactl subscribe processes started
+        const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+        const Core::Metrics::Id event_counter = Core::Metrics::counter("watch.events");
+        const Core::Metrics::Id line_counter = Core::Metrics::counter("watch.lines");
+    } // namespace
+
+    /**
+     * @class Watcher::Impl
+     * @brief Owns the event sources and the coalescing state
+     */
+    class Watcher::Impl
+    {
+    public:
+        Impl(std::vector<std::string> subsystems, DirtyCallback on_dirty)
+            : subsystems_(std::move(subsystems)), on_dirty_(std::move(on_dirty))
+        {
+        }
+
+        ~Impl()
+        {
+            // Sources capture this; none may fire once the watcher is gone
+            for (auto &connection : connections_)
+            {
+                connection.disconnect();
+            }
+            for (guint id : subscriptions_)
+            {
+                system_bus_->signal_unsubscribe(id);
+            }
+            if (audio_pid_ > 0)
+            {
+                ::kill(audio_pid_, SIGTERM);
+                ::waitpid(audio_pid_, nullptr, 0);
+                Glib::spawn_close_pid(audio_pid_);
+            }
+            if (audio_fd_ >= 0)
+            {
+                ::close(audio_fd_);
+            }
+        }
+
+        /**
+         * @brief Report every watched subsystem dirty and install the event sources
+         */
+        void start()
+        {
+            for (const auto &subsystem : subsystems_)
+            {
+                dirty_.insert(subsystem);
+            }
+            flush();
+
+            if (Core::Backend::mock())
+            {
+                // Mock backends report their own changes; only the battery stays real
+                for (const auto &subsystem : subsystems_)
+                {
+                    if (subsystem != "battery")
+                    {
+                        connections_.push_back(Core::Backend::subscribe(subsystem, [this, subsystem]()
+                                                                        { mark_dirty(subsystem); }));
+                    }
+                }
+                if (watching("battery"))
+                {
+                    watch_dbus("battery", "org.freedesktop.UPower", "org.freedesktop.DBus.Properties");
+                }
+                return;
+            }
+
+            if (watching("volume"))
+            {
+                watch_audio();
+            }
+            if (watching("wifi"))
+            {
+                watch_dbus("wifi", "org.freedesktop.NetworkManager", "");
+            }
+            if (watching("bluetooth"))
+            {
+                // Properties of adapters and devices, plus devices appearing or vanishing
+                watch_dbus("bluetooth", "org.bluez", "");
+            }
+            if (watching("display"))
+            {
+                watch_backlight();
+            }
+            if (watching("power"))
+            {
+                // Older daemons use the net.hadess name, newer ones the UPower one
+                watch_dbus("power", "net.hadess.PowerProfiles", "org.freedesktop.DBus.Properties");
+                watch_dbus("power", "org.freedesktop.UPower.PowerProfiles", "org.freedesktop.DBus.Properties");
+            }
+            if (watching("battery"))
+            {
+                watch_dbus("battery", "org.freedesktop.UPower", "org.freedesktop.DBus.Properties");
+            }
+        }
+
+    private:
+        bool watching(const std::string &subsystem) const
+        {
+            return std::find(subsystems_.begin(), subsystems_.end(), subsystem) != subsystems_.end();
+        }
+
+        /**
+         * @brief Record that a subsystem may have changed
+         *
+         * The first event arms the coalescing timer; later events within
+         * the window only add to the dirty set.
+         */
+        void mark_dirty(const std::string &subsystem)
+        {
+            Core::Metrics::increment(event_counter);
+            dirty_.insert(subsystem);
+            if (!flush_pending_)
+            {
+                flush_pending_ = true;
+                connections_.push_back(Core::Wakeups::timeout_once(sigc::mem_fun(*this, &Impl::flush), kCoalesceMs));
+            }
+        }
+
+        /**
+         * @brief Hand the dirty set to the owner
+         */
+        void flush()
+        {
+            flush_pending_ = false;
+            std::set<std::string> dirty;
+            dirty.swap(dirty_);
+
+            // Drop connections of timers that already fired
+            connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+                                              [](const sigc::connection &c)
+                                              { return !c.connected(); }),
+                               connections_.end());
+
+            if (!dirty.empty())
+            {
+                on_dirty_(dirty);
+            }
+        }
+
+        /**
+         * @brief Follow PulseAudio/PipeWire events through `pactl subscribe`
+         */
+        void watch_audio()
+        {
+            try
+            {
+                Core::Metrics::increment(spawn_counter);
+                Glib::spawn_async_with_pipes(
+                    "", std::vector<std::string>{"pactl", "subscribe"},
+                    Glib::SPAWN_SEARCH_PATH | Glib::SPAWN_DO_NOT_REAP_CHILD,
+                    []()
+                    { prctl(PR_SET_PDEATHSIG, SIGTERM); }, // Don't outlive the watcher
+                    &audio_pid_, nullptr, &audio_fd_, nullptr);
+            }
+            catch (const Glib::Error &ex)
+            {
+                UC_LOG_WARN(Volume, "Failed to start pactl subscribe: " << ex.what());
+                connections_.push_back(Core::Wakeups::timeout_once(sigc::mem_fun(*this, &Impl::watch_audio), kRespawnDelayMs));
+                return;
+            }
+
+            audio_buffer_.clear();
+            connections_.push_back(Glib::signal_io().connect(
+                [this](Glib::IOCondition condition) -> bool
+                {
+                    char buffer[4096];
+                    ssize_t count = (condition & Glib::IO_IN) ? ::read(audio_fd_, buffer, sizeof(buffer)) : 0;
+                    if (count <= 0)
+                    {
+                        // pactl exited (e.g. the sound server restarted); start over
+                        ::close(audio_fd_);
+                        audio_fd_ = -1;
+                        ::waitpid(audio_pid_, nullptr, 0);
+                        Glib::spawn_close_pid(audio_pid_);
+                        audio_pid_ = 0;
+                        UC_LOG_INFO(Volume, "pactl subscribe exited, restarting");
+                        connections_.push_back(Core::Wakeups::timeout_once(sigc::mem_fun(*this, &Impl::watch_audio), kRespawnDelayMs));
+                        mark_dirty("volume");
+                        return false;
+                    }
+                    on_audio_output(std::string(buffer, static_cast<std::size_t>(count)));
+                    return true;
+                },
+                audio_fd_, Glib::IO_IN | Glib::IO_HUP | Glib::IO_ERR));
+        }
+
+        /**
+         * @brief Handle lines such as "Event 'change' on sink #56"
+         */
+        void on_audio_output(const std::string &chunk)
+        {
+            audio_buffer_ += chunk;
+            std::size_t newline;
+            while ((newline = audio_buffer_.find('\n')) != std::string::npos)
+            {
+                std::string line = audio_buffer_.substr(0, newline);
+                audio_buffer_.erase(0, newline + 1);
+
+                // Client and module events don't affect devices or volumes
+                if (line.find(" on sink") != std::string::npos || line.find(" on source") != std::string::npos ||
+                    line.find(" on server") != std::string::npos || line.find(" on card") != std::string::npos)
+                {
+                    mark_dirty("volume");
+                }
+            }
+        }
+
+        /**
+         * @brief Mark a subsystem dirty on signals from a system-bus service
+         * @param subsystem The subsystem the service backs
+         * @param sender Well-known bus name of the service
+         * @param interface Signal interface to match (empty for all signals)
+         */
+        void watch_dbus(const std::string &subsystem, const char *sender, const char *interface)
+        {
+            try
+            {
+                if (!system_bus_)
+                {
+                    system_bus_ = Gio::DBus::Connection::get_sync(Gio::DBus::BUS_TYPE_SYSTEM);
+                }
+                subscriptions_.push_back(system_bus_->signal_subscribe(
+                    [this, subsystem](const Glib::RefPtr<Gio::DBus::Connection> &, const Glib::ustring &,
+                                      const Glib::ustring &, const Glib::ustring &, const Glib::ustring &,
+                                      const Glib::VariantContainerBase &)
+                    { mark_dirty(subsystem); },
+                    sender, interface));
+            }
+            catch (const Glib::Error &ex)
+            {
+                UC_LOG_WARN(App, "Cannot watch " << sender << " on the system bus: " << ex.what());
+            }
+        }
+
+        /**
+         * @brief Watch every backlight's brightness file
+         *
+         * Writes from userspace (brightnessctl, the GUI) are reported by
+         * inotify; sysfs has no change notification for the file itself.
+         */
+        void watch_backlight()
+        {
+            std::error_code ec;
+            for (const auto &entry : std::filesystem::directory_iterator("/sys/class/backlight", ec))
+            {
+                auto file = Gio::File::create_for_path((entry.path() / "brightness").string());
+                try
+                {
+                    auto monitor = file->monitor_file();
+                    monitor->signal_changed().connect(
+                        [this](const Glib::RefPtr<Gio::File> &, const Glib::RefPtr<Gio::File> &, Gio::FileMonitorEvent)
+                        { mark_dirty("display"); });
+                    monitors_.push_back(monitor);
+                }
+                catch (const Glib::Error &ex)
+                {
+                    UC_LOG_WARN(Display, "Cannot watch " << file->get_path() << ": " << ex.what());
+                }
+            }
+            if (monitors_.empty())
+            {
+                UC_LOG_WARN(Display, "No backlight devices to watch");
+            }
+        }
+
+        std::vector<std::string> subsystems_;           ///< Watched subsystems
+        DirtyCallback on_dirty_;                        ///< Receives each coalesced dirty set
+        std::set<std::string> dirty_;                   ///< Subsystems changed since the last flush
+        bool flush_pending_ = false;                    ///< Whether the coalescing timer is armed
+        std::vector<sigc::connection> connections_;     ///< Pending timers and the pactl fd watch
+        Glib::Pid audio_pid_ = 0;                       ///< Running `pactl subscribe`, if any
+        int audio_fd_ = -1;                             ///< Its stdout
+        std::string audio_buffer_;                      ///< Partial line from pactl subscribe
+        Glib::RefPtr<Gio::DBus::Connection> system_bus_;
+        std::vector<guint> subscriptions_;              ///< Signal subscriptions on system_bus_
+        std::vector<Glib::RefPtr<Gio::FileMonitor>> monitors_;
+    };
+
+    Watcher::Watcher(std::vector<std::string> subsystems, DirtyCallback on_dirty)
+        : impl_(std::make_unique<Impl>(std::move(subsystems), std::move(on_dirty)))
+    {
+    }
+
+    Watcher::~Watcher() = default;
+
+    void Watcher::start()
+    {
+        impl_->start();
+    }
+
+    int watch(const std::vector<std::string> &requested)
+    {
+        std::vector<std::string> watched = requested.empty() ? subsystems() : requested;
+        for (const auto &subsystem : watched)
+        {
+            const auto &known = subsystems();
+            if (std::find(known.begin(), known.end(), subsystem) == known.end())
+            {
+                std::cerr << "Unknown subsystem: " << subsystem << std::endl;
+                return 2;
+            }
+        }
+
+        // Re-read dirty subsystems and print one line with the ones that changed
+        std::map<std::string, std::string> last;
+        auto print_changes = [&watched, &last](const std::set<std::string> &dirty)
+        {
+            std::string line;
+            for (const auto &subsystem : watched)
+            {
+                if (!dirty.count(subsystem))
+                {
+                    continue;
+                }
+
+                std::string json;
+                std::string error;
+                if (!get(subsystem, json, error))
+                {
+                    json = "{\"error\":" + Core::Json::quote(error) + "}";
+                }
+
+                auto &previous = last[subsystem];
+                if (json == previous)
+                {
+                    continue; // Event did not change anything we report
+                }
+                previous = json;
+                line += (line.empty() ? "{" : ",") + Core::Json::quote(subsystem) + ":" + json;
+            }
+
+            if (!line.empty())
+            {
+                Core::Metrics::increment(line_counter);
+                std::cout << line << "}" << std::endl;
+            }
+        };
+
+        auto loop = Glib::MainLoop::create();
+        Watcher watcher(watched, print_changes);
+        watcher.start();
+        loop->run();
+        return 0;
+    }
+
+} // namespace Cli
@@ -0,0 +1,83 @@
+/**
+ * @file Watch.hpp
+ * @brief Event-stream watch mode for status bars
+ *
+ * This file declares `ultimate-control --watch`, which subscribes to the
+ * change notifications of each backend and prints one JSON line whenever
+ * the state of a watched subsystem changes, without polling.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Cli
+ * @brief Contains the headless command-line interface
+ */
+namespace Cli
+{
+
+    /**
+     * @class Watcher
+     * @brief Turns backend change notifications into coalesced dirty sets
+     *
+     * Installs the event sources of the given subsystems on the thread-default
+     * main loop. Sources only mark subsystems dirty; events arriving within
+     * 16 ms of each other are merged and reported through one callback. The
+     * watcher never reads state itself, so callers decide where Cli::get()
+     * runs (inline for --watch, on a worker thread for the control socket).
+     */
+    class Watcher
+    {
+    public:
+        /// Receives the subsystems that may have changed since the last call
+        using DirtyCallback = std::function<void(const std::set<std::string> &)>;
+
+        /**
+         * @brief Constructor
+         * @param subsystems Subsystems to watch (see subsystems())
+         * @param on_dirty Called on the main loop after each coalescing window
+         */
+        Watcher(std::vector<std::string> subsystems, DirtyCallback on_dirty);
+
+        /**
+         * @brief Destructor; removes every event source
+         */
+        ~Watcher();
+
+        /**
+         * @brief Install the event sources
+         */
+        void start();
+
+    private:
+        class Impl;                  ///< Forward declaration of implementation class
+        std::unique_ptr<Impl> impl_; ///< Pointer to implementation (PIMPL idiom)
+    };
+
+    /**
+     * @brief Stream state changes of the given subsystems to stdout
+     * @param subsystems Subsystems to watch (see subsystems()); empty for all
+     * @return Process exit code; only returns on setup errors
+     *
+     * Event sources:
+     * - volume: `pactl subscribe`
+     * - wifi: NetworkManager PropertiesChanged signals
+     * - bluetooth: BlueZ object manager and property signals
+     * - display: inotify on /sys/class/backlight/{name}/brightness
+     * - power: power-profiles-daemon property signals
+     * - battery: UPower property signals
+     *
+     * Events arriving within 16 ms of each other are coalesced. Every flush
+     * re-reads the dirty subsystems and prints one line containing only the
+     * ones whose JSON actually changed, e.g. `{"volume":{...},"wifi":{...}}`.
+     * The first line contains the initial state of every watched subsystem.
+     */
+    int watch(const std::vector<std::string> &subsystems);
+
+} // namespace Cli
@@ -0,0 +1,132 @@
+/**
+ * @file Activity.cpp
+ * @brief Implementation of window visibility and focus tracking
+ */
+
+#include "Activity.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Wakeups.hpp"
+#include <vector>           // for std::vector
+#include <gtkmm/settings.h> // for Gtk::Settings
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id deferred_counter = Metrics::counter("activity.deferred");
+const Metrics::Id skipped_animation_counter = Metrics::counter("activity.animations_skipped");
+
+/**
+ * @struct State
+ * @brief Main-thread state behind the Activity facade
+ */
+struct State {
+    bool visible = false;
+    bool focused = false;
+    bool active = false;
+    bool animations_saved = false;          // Whether saved_animations holds a value
+    bool saved_animations = true;           // gtk-enable-animations before we turned it off
+    std::vector<sigc::slot<void>> deferred;
+    sigc::signal<void, bool> changed;
+};
+
+State &state()
+{
+    static State instance;
+    return instance;
+}
+
+/**
+ * @brief Turn GTK animations off while inactive and restore them afterwards
+ */
+void apply_animations(State &s)
+{
+    auto settings = Gtk::Settings::get_default();
+    if (!settings) {
+        return;
+    }
+
+    if (!s.active) {
+        if (!s.animations_saved) {
+            s.saved_animations = settings->property_gtk_enable_animations().get_value();
+            s.animations_saved = true;
+        }
+        settings->property_gtk_enable_animations() = false;
+    } else if (s.animations_saved) {
+        settings->property_gtk_enable_animations() = s.saved_animations;
+        s.animations_saved = false;
+    }
+}
+
+void update()
+{
+    State &s = state();
+    bool active = s.visible && s.focused;
+    if (active == s.active) {
+        return;
+    }
+    s.active = active;
+
+    UC_LOG_DEBUG(App, "Window " << (active ? "active" : "inactive"));
+    apply_animations(s);
+    s.changed.emit(active);
+
+    if (active && !s.deferred.empty()) {
+        // Run from an idle so focus handling finishes first
+        auto work = std::move(s.deferred);
+        s.deferred.clear();
+        Wakeups::idle_once([work]() {
+            for (const auto &slot : work) {
+                slot();
+            }
+        });
+    }
+}
+
+} // namespace
+
+bool Activity::is_active()
+{
+    return state().active;
+}
+
+void Activity::set_visible(bool visible)
+{
+    state().visible = visible;
+    update();
+}
+
+void Activity::set_focused(bool focused)
+{
+    state().focused = focused;
+    update();
+}
+
+void Activity::when_active(const sigc::slot<void> &work)
+{
+    State &s = state();
+    if (s.active) {
+        work();
+        return;
+    }
+    Metrics::increment(deferred_counter);
+    s.deferred.push_back(work);
+}
+
+void Activity::animate(const sigc::slot<void> &finish, unsigned int delay_ms)
+{
+    if (!state().active) {
+        Metrics::increment(skipped_animation_counter);
+        finish();
+        return;
+    }
+    Wakeups::timeout_once(finish, delay_ms);
+}
+
+sigc::signal<void, bool> &Activity::signal_changed()
+{
+    return state().changed;
+}
+
+} // namespace Core
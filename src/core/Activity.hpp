@@ -0,0 +1,73 @@
+/**
+ * @file Activity.hpp
+ * @brief Window visibility and focus tracking for Ultimate Control
+ *
+ * This file defines the Activity class which knows whether the main window
+ * is currently visible and focused, so that polling, scans and animations
+ * can be suspended while nobody is looking.
+ */
+
+#pragma once
+
+#include <sigc++/sigc++.h>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Activity
+ * @brief Gate for background work and animations
+ *
+ * The application is "active" while the main window is both mapped and
+ * focused. While inactive, GTK animations (spinners, CSS transitions) are
+ * turned off, deferred work queued with when_active() waits, and animation
+ * delays scheduled with animate() complete immediately instead of arming
+ * a timer. All methods must be called on the main thread.
+ */
+class Activity {
+public:
+    /**
+     * @brief Whether the main window is visible and focused
+     * @return True if background work and animations may run
+     */
+    static bool is_active();
+
+    /**
+     * @brief Record that the main window was mapped or unmapped
+     * @param visible True if the window is on screen
+     */
+    static void set_visible(bool visible);
+
+    /**
+     * @brief Record that the main window gained or lost focus
+     * @param focused True if the window has keyboard focus
+     */
+    static void set_focused(bool focused);
+
+    /**
+     * @brief Run work now if active, otherwise when the window becomes active
+     * @param work The work to run
+     *
+     * Slots bound to a sigc::trackable (any widget) are dropped if the
+     * object is destroyed while the work is still waiting.
+     */
+    static void when_active(const sigc::slot<void> &work);
+
+    /**
+     * @brief Finish an animation after a delay, or immediately when inactive
+     * @param finish Callback that completes the animation
+     * @param delay_ms Animation duration in milliseconds
+     */
+    static void animate(const sigc::slot<void> &finish, unsigned int delay_ms);
+
+    /**
+     * @brief Signal emitted when the active state changes
+     * @return Signal carrying the new active state
+     */
+    static sigc::signal<void, bool> &signal_changed();
+};
+
+} // namespace Core
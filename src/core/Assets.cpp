@@ -0,0 +1,139 @@
+/**
+ * @file Assets.cpp
+ * @brief Implementation of compiled-in asset access
+ */
+
+#include "Assets.hpp"
+#include "Log.hpp"
+#include "Trace.hpp"
+#include <cstdlib>              // for std::getenv
+#include <map>                  // for std::map
+#include <utility>              // for std::pair
+#include <giomm/file.h>         // for Gio::File
+#include <giomm/filemonitor.h>  // for Gio::FileMonitor
+#include <gtkmm/cssprovider.h>  // for Gtk::CssProvider
+#include <gtkmm/stylecontext.h> // for Gtk::StyleContext
+
+namespace Core {
+
+namespace {
+
+/// Prefix of every asset in the bundle
+const char *const kResourcePrefix = "/org/ultimate-control/";
+
+/**
+ * @struct State
+ * @brief Providers, the override monitor and decoded images
+ */
+struct State {
+    Glib::RefPtr<Gtk::CssProvider> builtin;
+    Glib::RefPtr<Gtk::CssProvider> user;
+    Glib::RefPtr<Gio::FileMonitor> monitor;
+    std::map<std::pair<std::string, int>, Glib::RefPtr<Gdk::Pixbuf>> images;
+};
+
+State &state()
+{
+    static State instance;
+    return instance;
+}
+
+std::string user_css_path()
+{
+    const char *config_home = std::getenv("XDG_CONFIG_HOME");
+    if (config_home != nullptr && *config_home != '\0') {
+        return std::string(config_home) + "/ultimate-control/style.css";
+    }
+    const char *home = std::getenv("HOME");
+    if (home == nullptr) {
+        return "";
+    }
+    return std::string(home) + "/.config/ultimate-control/style.css";
+}
+
+/**
+ * @brief (Re)load the user stylesheet; a deleted file clears it
+ */
+void load_user_css(State &s, const Glib::RefPtr<Gio::File> &file)
+{
+    try {
+        if (file->query_exists()) {
+            s.user->load_from_file(file);
+            UC_LOG_INFO(App, "Loaded user stylesheet " << file->get_path());
+        } else {
+            s.user->load_from_data("");
+        }
+    } catch (const Glib::Error &ex) {
+        // GTK keeps the rules parsed before the error
+        UC_LOG_WARN(App, "Error in user stylesheet " << file->get_path() << ": " << ex.what());
+    }
+}
+
+} // namespace
+
+void Assets::apply_css(const Glib::RefPtr<Gdk::Screen> &screen)
+{
+    Trace::Span span("Assets::apply_css", "startup");
+    State &s = state();
+
+    if (!s.builtin) {
+        s.builtin = Gtk::CssProvider::create();
+        try {
+            s.builtin->load_from_resource(std::string(kResourcePrefix) + "style.css");
+        } catch (const Glib::Error &ex) {
+            UC_LOG_ERROR(App, "Error loading CSS: " << ex.what());
+        }
+    }
+    Gtk::StyleContext::add_provider_for_screen(screen, s.builtin, GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+
+    // Only an override present at startup is watched: monitoring a missing
+    // directory makes GIO poll for it
+    const std::string path = user_css_path();
+    auto file = path.empty() ? Glib::RefPtr<Gio::File>() : Gio::File::create_for_path(path);
+    if (!s.user && file && file->query_exists()) {
+        s.user = Gtk::CssProvider::create();
+        load_user_css(s, file);
+        try {
+            s.monitor = file->monitor_file();
+            s.monitor->signal_changed().connect(
+                [file](const Glib::RefPtr<Gio::File> &, const Glib::RefPtr<Gio::File> &,
+                       Gio::FileMonitorEvent event) {
+                    // Editors save in several writes; reload once they are done
+                    if (event == Gio::FILE_MONITOR_EVENT_CHANGES_DONE_HINT ||
+                        event == Gio::FILE_MONITOR_EVENT_CREATED ||
+                        event == Gio::FILE_MONITOR_EVENT_DELETED) {
+                        load_user_css(state(), file);
+                    }
+                });
+        } catch (const Glib::Error &ex) {
+            UC_LOG_WARN(App, "Not watching " << path << ": " << ex.what());
+        }
+    }
+    if (s.user) {
+        Gtk::StyleContext::add_provider_for_screen(screen, s.user, GTK_STYLE_PROVIDER_PRIORITY_APPLICATION + 1);
+    }
+}
+
+Glib::RefPtr<Gdk::Pixbuf> Assets::image(const std::string &name, int size)
+{
+    auto &images = state().images;
+    auto it = images.find({name, size});
+    if (it != images.end()) {
+        return it->second;
+    }
+
+    Trace::Span span("Assets::image", "assets", name);
+    Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+    try {
+        const std::string path = kResourcePrefix + name;
+        pixbuf = size > 0 ? Gdk::Pixbuf::create_from_resource(path, size, size, true)
+                          : Gdk::Pixbuf::create_from_resource(path);
+    } catch (const Glib::Error &ex) {
+        UC_LOG_WARN(App, "Error decoding " << name << ": " << ex.what());
+    }
+    // Failures are cached too, so a broken asset is reported once
+    images.emplace(std::make_pair(name, size), pixbuf);
+    return pixbuf;
+}
+
+} // namespace Core
@@ -0,0 +1,52 @@
+/**
+ * @file Assets.hpp
+ * @brief Access to the stylesheet and images compiled into Ultimate Control
+ *
+ * This file defines the Assets class which serves the CSS, the error image
+ * and the logo from the GResource bundle linked into the executable, so
+ * nothing depends on the working directory or on files next to the binary.
+ */
+
+#pragma once
+
+#include <string>
+#include <gdkmm/pixbuf.h>
+#include <gdkmm/screen.h>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Assets
+ * @brief Stylesheet and images from the compiled-in resource bundle
+ *
+ * Bundle paths live under /org/ultimate-control/ (see
+ * src/ultimate-control.gresource.xml). Images are decoded on first use and
+ * shared afterwards. All methods must be called on the main thread.
+ */
+class Assets {
+public:
+    /**
+     * @brief Apply the application stylesheet to a screen
+     * @param screen Screen to style
+     *
+     * The built-in stylesheet is parsed straight from the bundle. If
+     * $XDG_CONFIG_HOME/ultimate-control/style.css exists at startup it is
+     * applied on top and reloaded whenever it is saved, so themes can be
+     * edited without restarting.
+     */
+    static void apply_css(const Glib::RefPtr<Gdk::Screen> &screen);
+
+    /**
+     * @brief Decoded image from the bundle
+     * @param name File name in the bundle, e.g. "error.png"
+     * @param size Width and height to scale to, or 0 for the natural size
+     * @return The shared pixbuf, or an empty pointer if it cannot be decoded
+     */
+    static Glib::RefPtr<Gdk::Pixbuf> image(const std::string &name, int size = 0);
+};
+
+} // namespace Core
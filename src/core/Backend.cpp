@@ -0,0 +1,275 @@
+/**
+ * @file Backend.cpp
+ * @brief Implementation of the backend selection and mock support
+ */
+
+#include "Backend.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include "Wakeups.hpp"
+#include <algorithm> // for std::max
+#include <cstdlib>   // for std::getenv, std::strtod, std::strtoull
+#include <map>       // for std::map
+#include <set>       // for std::set
+#include <thread>    // for std::thread, std::this_thread::sleep_for
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id mock_call_counter = Metrics::counter("backend.mock_calls");
+const Metrics::Id mock_failure_counter = Metrics::counter("backend.mock_failures");
+const Metrics::Id mock_event_counter = Metrics::counter("backend.mock_events");
+
+/**
+ * @struct State
+ * @brief The selected backend and the mock event plumbing
+ */
+struct State {
+    std::once_flag loaded;
+    std::mutex mutex; ///< Guards everything but signals
+    Backend::Kind kind = Backend::Kind::System;
+    Backend::MockOptions options;
+    std::uint64_t generation = 0;
+    std::set<std::string> storms;                         ///< Subsystems with a storm thread
+    std::map<std::string, sigc::signal<void>> signals;    ///< Main thread only
+};
+
+State &state()
+{
+    // Leaked: storm threads may still run while static destructors do
+    static State *instance = new State();
+    return *instance;
+}
+
+/**
+ * @brief Parse a whole unsigned number
+ */
+bool parse_count(const std::string &text, std::uint64_t &value)
+{
+    if (text.empty() || text[0] == '-') {
+        return false;
+    }
+    char *end = nullptr;
+    value = std::strtoull(text.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+/**
+ * @brief Read UC_BACKEND and UC_MOCK, once
+ */
+State &loaded_state()
+{
+    State &s = state();
+    std::call_once(s.loaded, [&s]() {
+        const char *kind = std::getenv("UC_BACKEND");
+        if (kind == nullptr || *kind == '\0' || std::string(kind) == "system") {
+            return;
+        }
+        if (std::string(kind) != "mock") {
+            UC_LOG_WARN(App, "Unknown UC_BACKEND '" << kind << "', using the system backends");
+            return;
+        }
+        s.kind = Backend::Kind::Mock;
+        const char *options = std::getenv("UC_MOCK");
+        std::string error;
+        if (options != nullptr && !Backend::parse_mock_options(options, s.options, error)) {
+            UC_LOG_WARN(App, "Ignoring the rest of UC_MOCK: " << error);
+        }
+        UC_LOG_INFO(App, "Using mock backends with " << s.options.devices << " devices");
+    });
+    return s;
+}
+
+/**
+ * @brief 32-bit FNV-1a; stable across runs and standard libraries, unlike std::hash
+ */
+std::uint32_t fnv1a(const std::string &text)
+{
+    std::uint32_t hash = 2166136261u;
+    for (unsigned char c : text) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+Backend::Kind Backend::kind()
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.kind;
+}
+
+Backend::MockOptions Backend::mock_options()
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.options;
+}
+
+std::uint64_t Backend::generation()
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.generation;
+}
+
+void Backend::use_system()
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.kind = Kind::System;
+    ++s.generation;
+}
+
+void Backend::use_mock(const MockOptions &options)
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.kind = Kind::Mock;
+    s.options = options;
+    ++s.generation;
+}
+
+bool Backend::parse_mock_options(const std::string &text, MockOptions &options, std::string &error)
+{
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t comma = text.find(',', start);
+        if (comma == std::string::npos) {
+            comma = text.size();
+        }
+        const std::string field = text.substr(start, comma - start);
+        start = comma + 1;
+        if (field.empty()) {
+            continue;
+        }
+
+        std::size_t equals = field.find('=');
+        if (equals == std::string::npos) {
+            error = "expected key=value, got '" + field + "'";
+            return false;
+        }
+        const std::string key = field.substr(0, equals);
+        const std::string value = field.substr(equals + 1);
+
+        std::uint64_t number = 0;
+        if (key == "failures") {
+            char *end = nullptr;
+            double rate = std::strtod(value.c_str(), &end);
+            if (value.empty() || *end != '\0' || rate < 0.0 || rate > 1.0) {
+                error = "failures must be between 0 and 1, got '" + value + "'";
+                return false;
+            }
+            options.failures = rate;
+        } else if (!parse_count(value, number)) {
+            error = key + " must be a whole number, got '" + value + "'";
+            return false;
+        } else if (key == "devices") {
+            options.devices = static_cast<std::size_t>(number);
+        } else if (key == "latency") {
+            options.latency = std::chrono::milliseconds(number);
+        } else if (key == "jitter") {
+            options.jitter = std::chrono::milliseconds(number);
+        } else if (key == "storm") {
+            options.storm = static_cast<std::size_t>(number);
+        } else if (key == "storm_interval") {
+            options.storm_interval = std::chrono::milliseconds(std::max<std::uint64_t>(number, 1));
+        } else if (key == "seed") {
+            options.seed = static_cast<std::uint32_t>(number);
+        } else {
+            error = "unknown option '" + key + "'";
+            return false;
+        }
+    }
+    return true;
+}
+
+sigc::connection Backend::subscribe(const std::string &subsystem, const sigc::slot<void> &slot)
+{
+    return state().signals[subsystem].connect(slot);
+}
+
+void Backend::emit(const std::string &subsystem)
+{
+    Metrics::increment(mock_event_counter);
+    Wakeups::idle_once([subsystem]() {
+        auto &signals = state().signals;
+        auto it = signals.find(subsystem);
+        if (it != signals.end()) {
+            it->second.emit();
+        }
+    });
+}
+
+void Backend::start_storm(const std::string &subsystem, std::function<void()> perturb)
+{
+    State &s = loaded_state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.storms.insert(subsystem).second) {
+            return;
+        }
+    }
+
+    std::thread([subsystem, perturb = std::move(perturb)]() {
+        Trace::set_thread_name("storm-" + subsystem);
+        for (;;) {
+            const MockOptions options = mock_options();
+            std::this_thread::sleep_for(options.storm_interval);
+            if (kind() != Kind::Mock) {
+                continue;
+            }
+            for (std::size_t i = 0; i < options.storm; ++i) {
+                perturb();
+                emit(subsystem);
+            }
+        }
+    }).detach();
+}
+
+Backend::Simulation::Simulation(const std::string &subsystem)
+    : options_(mock_options()), rng_(options_.seed ^ fnv1a(subsystem))
+{
+}
+
+bool Backend::Simulation::call()
+{
+    Metrics::increment(mock_call_counter);
+    std::chrono::milliseconds delay = options_.latency;
+    bool fail = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (options_.jitter.count() > 0) {
+            const auto jitter = options_.jitter.count();
+            delay += std::chrono::milliseconds(std::uniform_int_distribution<long long>(-jitter, jitter)(rng_));
+        }
+        if (options_.failures > 0.0) {
+            fail = std::bernoulli_distribution(options_.failures)(rng_);
+        }
+    }
+    if (delay.count() > 0) {
+        std::this_thread::sleep_for(delay);
+    }
+    if (fail) {
+        Metrics::increment(mock_failure_counter);
+    }
+    return !fail;
+}
+
+int Backend::Simulation::uniform(int lo, int hi)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::uniform_int_distribution<int>(lo, hi)(rng_);
+}
+
+bool Backend::Simulation::chance(double p)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::bernoulli_distribution(p)(rng_);
+}
+
+} // namespace Core
@@ -0,0 +1,181 @@
+/**
+ * @file Backend.hpp
+ * @brief Runtime choice between system and mock backends
+ *
+ * This file defines the Backend class which decides whether the managers
+ * talk to the real tools and daemons (pactl, nmcli, BlueZ, brightnessctl,
+ * powerprofilesctl) or to in-process mocks, and the knobs, randomness and
+ * change events the mocks share.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <sigc++/sigc++.h>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Backend
+ * @brief Selects the backend of every manager and drives the mocks
+ *
+ * The choice is read once from the environment:
+ *
+ *     UC_BACKEND=mock UC_MOCK=devices=200,latency=20,jitter=5,failures=0.05,storm=50,seed=7
+ *
+ * UC_BACKEND is "system" (the default) or "mock". UC_MOCK is a comma
+ * separated list of MockOptions fields; times are in milliseconds.
+ * Benchmarks can switch in-process with use_mock() and use_system().
+ *
+ * Mocks never touch the system. Their state is shared by every manager of
+ * a subsystem, so a change made through one manager is seen by the next,
+ * and is rebuilt from the seed whenever the options change. Given the same
+ * options and the same sequence of calls, a mock answers the same way.
+ */
+class Backend {
+public:
+    /**
+     * @enum Kind
+     * @brief What the managers talk to
+     */
+    enum class Kind {
+        System, ///< Real tools and daemons
+        Mock    ///< In-process simulation
+    };
+
+    /**
+     * @struct MockOptions
+     * @brief Shape and behaviour of the simulated environment
+     */
+    struct MockOptions {
+        std::size_t devices = 8;                         ///< Audio devices, access points or Bluetooth devices
+        std::chrono::milliseconds latency{0};            ///< Added to every backend call
+        std::chrono::milliseconds jitter{0};             ///< Latency varies by up to this much either way
+        double failures = 0.0;                           ///< Chance that a call fails, 0-1
+        std::size_t storm = 0;                           ///< Change events per burst; 0 for none
+        std::chrono::milliseconds storm_interval{1000};  ///< Time between bursts
+        std::uint32_t seed = 1;                          ///< Seed of every mock's random sequence
+    };
+
+    /**
+     * @brief The backend the managers use
+     */
+    static Kind kind();
+
+    /**
+     * @brief Whether the managers use mocks
+     */
+    static bool mock() { return kind() == Kind::Mock; }
+
+    /**
+     * @brief Options of the mocks; meaningful when mock() is true
+     */
+    static MockOptions mock_options();
+
+    /**
+     * @brief Bumped by every use_mock() and use_system()
+     *
+     * Mocks rebuild their state when it changes.
+     */
+    static std::uint64_t generation();
+
+    /**
+     * @brief Switch to the real backends for managers created from now on
+     */
+    static void use_system();
+
+    /**
+     * @brief Switch to mocks with the given options for managers created from now on
+     */
+    static void use_mock(const MockOptions &options);
+
+    /**
+     * @brief Parse a UC_MOCK string
+     * @param text e.g. "devices=100,latency=10"
+     * @param options Fields named in @p text are overwritten
+     * @param error Receives the first problem found
+     * @return false if a field is unknown or a value is invalid
+     */
+    static bool parse_mock_options(const std::string &text, MockOptions &options, std::string &error);
+
+    /**
+     * @brief Be told when a mock subsystem changes by itself
+     * @param subsystem "volume", "wifi", "bluetooth", "display" or "power"
+     * @param slot Called on the main loop after each change
+     *
+     * Must be called on the main thread.
+     */
+    static sigc::connection subscribe(const std::string &subsystem, const sigc::slot<void> &slot);
+
+    /**
+     * @brief Report a change of a mock subsystem to its subscribers
+     *
+     * May be called from any thread; subscribers run on the main loop.
+     */
+    static void emit(const std::string &subsystem);
+
+    /**
+     * @brief Keep changing a mock subsystem in bursts of MockOptions::storm events
+     * @param subsystem Subsystem emitted after every change
+     * @param perturb Changes one thing in the mock's state; called on a background thread
+     *
+     * Starts at most one storm thread per subsystem. Bursts follow the
+     * current options, so a storm idles while MockOptions::storm is 0.
+     */
+    static void start_storm(const std::string &subsystem, std::function<void()> perturb);
+
+    /**
+     * @class Simulation
+     * @brief Latency, failures and randomness of one mock
+     *
+     * Seeded from MockOptions::seed and the subsystem name, so mocks of
+     * different subsystems do not mirror each other. Thread-safe.
+     */
+    class Simulation {
+    public:
+        /**
+         * @brief Snapshot the current options for a subsystem
+         */
+        explicit Simulation(const std::string &subsystem);
+
+        /**
+         * @brief Options this simulation was created with
+         */
+        const MockOptions &options() const { return options_; }
+
+        /**
+         * @brief Simulate one backend call
+         * @return false if the call should fail
+         *
+         * Sleeps for the latency plus or minus the jitter first.
+         */
+        bool call();
+
+        /**
+         * @brief Random integer in [lo, hi]
+         */
+        int uniform(int lo, int hi);
+
+        /**
+         * @brief true with probability @p p
+         */
+        bool chance(double p);
+
+    private:
+        MockOptions options_;
+        std::mutex mutex_; ///< Guards rng_
+        std::mt19937 rng_;
+    };
+};
+
+} // namespace Core
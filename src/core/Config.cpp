@@ -0,0 +1,598 @@
+/**
+ * @file Config.cpp
+ * @brief Implementation of the unified settings store
+ */
+
+#include "Config.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Shutdown.hpp"
+#include "Trace.hpp"
+#include <algorithm>          // for std::sort
+#include <cctype>             // for std::isdigit
+#include <cerrno>             // for errno
+#include <chrono>             // for std::chrono::milliseconds
+#include <condition_variable> // for std::condition_variable
+#include <cstdlib>            // for std::getenv, std::strtoll
+#include <filesystem>         // for std::filesystem::create_directories
+#include <fstream>            // for std::ifstream
+#include <map>                // for std::map
+#include <mutex>              // for std::mutex, std::call_once
+#include <set>                // for std::set
+#include <sstream>            // for std::ostringstream
+#include <thread>             // for std::thread
+#include <unordered_map>      // for std::unordered_map
+#include <variant>            // for std::variant
+#include <glibmm/main.h>      // for Glib::signal_io
+#include <fcntl.h>            // for open
+#include <sys/inotify.h>      // for inotify_init1, inotify_add_watch
+#include <unistd.h>           // for write, fsync, close
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id write_counter = Metrics::counter("config.writes");
+const Metrics::Id reload_counter = Metrics::counter("config.reloads");
+const Metrics::Id write_histogram = Metrics::histogram("config.write");
+
+/// A write waits until save() was not called for this long
+constexpr std::chrono::milliseconds kQuietPeriod(500);
+
+/// File name inside the configuration directory
+const char *const kFileName = "settings.conf";
+
+using Value = std::variant<bool, std::int64_t, std::string>;
+using Values = std::unordered_map<std::string, Value>;
+
+/**
+ * @struct State
+ * @brief The parsed settings and the file watch
+ */
+struct State {
+    std::once_flag loaded;
+    std::mutex mutex;             ///< Guards values, dirty, written and the save request
+    std::mutex io_mutex;          ///< Serialises file writes so they land in order
+    std::condition_variable cv;   ///< Wakes the writer thread
+    Values values;
+    bool dirty = false;           ///< Changed since the last write
+    std::set<std::string> local;  ///< Keys set here since the last write; win over reloads
+    std::string written;          ///< File contents as last read or written
+    bool requested = false;       ///< save() was called since the writer last woke
+    std::uint64_t generation = 0; ///< Bumped by every save(), to detect bursts
+    std::thread writer;           ///< Started by the first save()
+
+    std::map<std::string, sigc::signal<void>> subscribers; ///< Main thread only
+    int inotify_fd = -1;
+    sigc::connection inotify_watch;
+};
+
+State &state()
+{
+    // Leaked: worker threads may still read settings during exit
+    static State &instance = *new State;
+    return instance;
+}
+
+std::string config_dir()
+{
+    const char *config_home = std::getenv("XDG_CONFIG_HOME");
+    if (config_home != nullptr && *config_home != '\0') {
+        return std::string(config_home) + "/ultimate-control";
+    }
+    const char *home = std::getenv("HOME");
+    if (home == nullptr) {
+        return "";
+    }
+    return std::string(home) + "/.config/ultimate-control";
+}
+
+std::string trim(const std::string &text)
+{
+    const std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    const std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+Value parse_value(const std::string &text)
+{
+    if (text == "true") {
+        return true;
+    }
+    if (text == "false") {
+        return false;
+    }
+    // Only plain decimal integers; "+5", " 5" and "0x5" stay text
+    if (!text.empty() && (std::isdigit(static_cast<unsigned char>(text[0])) || text[0] == '-')) {
+        char *end = nullptr;
+        errno = 0;
+        const long long number = std::strtoll(text.c_str(), &end, 10);
+        if (errno == 0 && end != text.c_str() && *end == '\0') {
+            return static_cast<std::int64_t>(number);
+        }
+    }
+    return text;
+}
+
+std::string to_text(const Value &value)
+{
+    if (const bool *boolean = std::get_if<bool>(&value)) {
+        return *boolean ? "true" : "false";
+    }
+    if (const std::int64_t *integer = std::get_if<std::int64_t>(&value)) {
+        return std::to_string(*integer);
+    }
+    return std::get<std::string>(value);
+}
+
+Values parse(const std::string &contents)
+{
+    Values values;
+    std::istringstream stream(contents);
+    std::string line;
+    while (std::getline(stream, line)) {
+        line = trim(line);
+        const std::size_t separator = line.find('=');
+        if (line.empty() || line[0] == '#' || separator == std::string::npos) {
+            continue;
+        }
+        const std::string key = trim(line.substr(0, separator));
+        if (!key.empty()) {
+            values[key] = parse_value(trim(line.substr(separator + 1)));
+        }
+    }
+    return values;
+}
+
+std::string serialise(const Values &values)
+{
+    std::vector<std::string> sorted;
+    for (const auto &[key, value] : values) {
+        sorted.push_back(key);
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string out = "# Ultimate Control settings\n";
+    std::string section;
+    for (const auto &key : sorted) {
+        // A blank line between "general.", "tabs.", ... for readability
+        const std::string key_section = key.substr(0, key.find('.'));
+        if (key_section != section) {
+            out += '\n';
+            section = key_section;
+        }
+        out += key + "=" + to_text(values.at(key)) + "\n";
+    }
+    return out;
+}
+
+bool read_file(const std::string &path, std::string &contents)
+{
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+/**
+ * @brief Replace the settings file atomically
+ * @return False if the file could not be written
+ */
+bool write_file(const std::string &contents)
+{
+    const std::string path = Config::path();
+    if (path.empty()) {
+        return false;
+    }
+    Metrics::increment(write_counter);
+    Metrics::ScopedTimer timer(write_histogram);
+
+    std::error_code ec;
+    std::filesystem::create_directories(config_dir(), ec);
+
+    const std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        UC_LOG_WARN(Settings, "Cannot write " << temp);
+        return false;
+    }
+    std::size_t written = 0;
+    while (written < contents.size()) {
+        ssize_t count = ::write(fd, contents.data() + written, contents.size() - written);
+        if (count <= 0) {
+            break;
+        }
+        written += static_cast<std::size_t>(count);
+    }
+    // Unlike the warm cache, losing settings to a crash is not acceptable
+    const bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+
+    if (written != contents.size() || !synced || std::rename(temp.c_str(), path.c_str()) != 0) {
+        UC_LOG_WARN(Settings, "Failed to replace " << path);
+        ::unlink(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read one of the per-module files used before settings.conf
+ * @param name File name in the old configuration directory
+ * @param separator Character between key and value; ' ' splits on whitespace
+ * @param add Called with each key and value
+ * @return True if the file existed
+ */
+template <typename Add>
+bool import_legacy(const std::string &name, char separator, Add add)
+{
+    const char *home = std::getenv("HOME");
+    std::ifstream in(home == nullptr ? "" : std::string(home) + "/.config/ultimate-control/" + name);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::string key;
+        std::string value;
+        if (separator == ' ') {
+            std::istringstream fields(line);
+            fields >> key >> value;
+        } else {
+            const std::size_t position = line.find(separator);
+            if (position == std::string::npos) {
+                continue;
+            }
+            key = line.substr(0, position);
+            value = line.substr(position + 1);
+        }
+        if (!key.empty()) {
+            add(key, value);
+        }
+    }
+    UC_LOG_INFO(Settings, "Imported " << name << " into " << kFileName);
+    return true;
+}
+
+/**
+ * @brief Build settings.conf from the files each module used to keep
+ * @return True if anything was imported
+ */
+bool import_all_legacy(Values &values)
+{
+    bool imported = false;
+    imported |= import_legacy("general.conf", ' ', [&values](const std::string &key, const std::string &value) {
+        values["general." + key] = parse_value(value);
+    });
+    imported |= import_legacy("taborder.json", '=', [&values](const std::string &key, const std::string &value) {
+        if (key == "tab_order") {
+            values["tabs.order"] = value;
+        } else if (key.rfind("tab_", 0) == 0) {
+            values["tabs.enabled." + key.substr(4)] = value == "1" || value == "true";
+        }
+    });
+    imported |= import_legacy("power.conf", '=', [&values](const std::string &key, const std::string &value) {
+        if (key.rfind("keybind_", 0) == 0) {
+            values["power.keybind." + key.substr(8)] = value;
+        } else {
+            values["power.command." + key] = value;
+        }
+    });
+    imported |= import_legacy("volume.conf", ' ', [&values](const std::string &key, const std::string &value) {
+        values["volume." + key] = parse_value(value);
+    });
+    return imported;
+}
+
+void load(State &s)
+{
+    std::string contents;
+    if (read_file(Config::path(), contents)) {
+        s.values = parse(contents);
+        s.written = contents;
+    } else if (import_all_legacy(s.values)) {
+        s.dirty = true;
+        for (const auto &[key, value] : s.values) {
+            s.local.insert(key);
+        }
+    }
+    Shutdown::add_flush(&Config::flush);
+}
+
+State &loaded_state()
+{
+    State &s = state();
+    std::call_once(s.loaded, [&s]() { load(s); });
+    return s;
+}
+
+bool lookup(const std::string &key, Value &value)
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.values.find(key);
+    if (it == s.values.end()) {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+void notify(State &s, const std::string &key)
+{
+    auto it = s.subscribers.find(key);
+    if (it != s.subscribers.end()) {
+        it->second.emit();
+    }
+}
+
+void store(const std::string &key, Value value)
+{
+    State &s = loaded_state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.values.find(key);
+        if (it != s.values.end() && it->second == value) {
+            return;
+        }
+        s.values[key] = std::move(value);
+        s.dirty = true;
+        s.local.insert(key);
+    }
+    notify(s, key);
+}
+
+/**
+ * @brief Re-read the file after another program changed it
+ *
+ * Keys set here but not yet written keep their values, so an edit still
+ * waiting out the quiet period is not lost; the next write stores them
+ * together with the other program's changes.
+ */
+void reload(State &s)
+{
+    std::string contents;
+    if (!read_file(Config::path(), contents)) {
+        return; // Removed or renamed away; keep what we have
+    }
+
+    std::vector<std::string> changed;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (contents == s.written) {
+            return; // Our own write
+        }
+        Values values = parse(contents);
+        for (const auto &key : s.local) {
+            values[key] = s.values.at(key);
+        }
+        std::set<std::string> keys;
+        for (const auto &[key, value] : s.values) {
+            keys.insert(key);
+        }
+        for (const auto &[key, value] : values) {
+            keys.insert(key);
+        }
+        for (const auto &key : keys) {
+            auto before = s.values.find(key);
+            auto after = values.find(key);
+            if (before == s.values.end() || after == values.end() || before->second != after->second) {
+                changed.push_back(key);
+            }
+        }
+        s.values = std::move(values);
+        s.written = contents;
+        s.dirty = !s.local.empty();
+    }
+
+    Metrics::increment(reload_counter);
+    UC_LOG_INFO(Settings, "Reloaded " << kFileName << ", " << changed.size() << " settings changed");
+    for (const auto &key : changed) {
+        notify(s, key);
+    }
+}
+
+bool on_inotify(Glib::IOCondition)
+{
+    State &s = state();
+    alignas(inotify_event) char buffer[4096];
+    bool ours = false;
+    ssize_t count;
+    while ((count = ::read(s.inotify_fd, buffer, sizeof(buffer))) > 0) {
+        for (char *p = buffer; p < buffer + count;) {
+            const auto *event = reinterpret_cast<const inotify_event *>(p);
+            if (event->len > 0 && std::string(event->name) == kFileName) {
+                ours = true;
+            }
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+    if (ours) {
+        reload(s);
+    }
+    return true;
+}
+
+/**
+ * @brief Write the current settings if they changed; holds io_mutex
+ */
+void write_snapshot(State &s)
+{
+    std::string contents;
+    std::set<std::string> local;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.dirty) {
+            return;
+        }
+        contents = serialise(s.values);
+        s.written = contents;
+        s.dirty = false;
+        local.swap(s.local);
+    }
+    if (!write_file(contents)) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.dirty = true; // Try again on the next save
+        s.local.insert(local.begin(), local.end());
+    }
+}
+
+void writer_loop()
+{
+    Trace::set_thread_name("config");
+    State &s = state();
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(s.mutex);
+            s.cv.wait(lock, [&s]() { return s.requested; });
+            // Wait out the burst: reordering tabs saves on every click
+            std::uint64_t seen;
+            do {
+                seen = s.generation;
+            } while (s.cv.wait_for(lock, kQuietPeriod, [&s, seen]() { return s.generation != seen; }));
+            s.requested = false;
+        }
+
+        std::lock_guard<std::mutex> io_lock(s.io_mutex);
+        write_snapshot(s);
+    }
+}
+
+} // namespace
+
+bool Config::get_bool(const std::string &key, bool fallback)
+{
+    Value value;
+    if (!lookup(key, value)) {
+        return fallback;
+    }
+    if (const bool *boolean = std::get_if<bool>(&value)) {
+        return *boolean;
+    }
+    if (const std::int64_t *integer = std::get_if<std::int64_t>(&value)) {
+        return *integer != 0;
+    }
+    return fallback;
+}
+
+std::int64_t Config::get_int(const std::string &key, std::int64_t fallback)
+{
+    Value value;
+    if (!lookup(key, value)) {
+        return fallback;
+    }
+    if (const std::int64_t *integer = std::get_if<std::int64_t>(&value)) {
+        return *integer;
+    }
+    if (const bool *boolean = std::get_if<bool>(&value)) {
+        return *boolean ? 1 : 0;
+    }
+    return fallback;
+}
+
+std::string Config::get_string(const std::string &key, const std::string &fallback)
+{
+    Value value;
+    return lookup(key, value) ? to_text(value) : fallback;
+}
+
+std::vector<std::string> Config::keys(const std::string &prefix)
+{
+    State &s = loaded_state();
+    std::vector<std::string> result;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (const auto &[key, value] : s.values) {
+            if (key.compare(0, prefix.size(), prefix) == 0) {
+                result.push_back(key);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void Config::set(const std::string &key, bool value)
+{
+    store(key, value);
+}
+
+void Config::set(const std::string &key, std::int64_t value)
+{
+    store(key, value);
+}
+
+void Config::set(const std::string &key, const std::string &value)
+{
+    store(key, value);
+}
+
+void Config::save()
+{
+    State &s = loaded_state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.dirty) {
+            return;
+        }
+        s.requested = true;
+        ++s.generation;
+        if (!s.writer.joinable()) {
+            s.writer = std::thread(writer_loop);
+        }
+    }
+    s.cv.notify_one();
+}
+
+void Config::flush()
+{
+    State &s = loaded_state();
+    std::lock_guard<std::mutex> io_lock(s.io_mutex);
+    write_snapshot(s);
+}
+
+void Config::watch()
+{
+    State &s = loaded_state();
+    if (s.inotify_fd >= 0) {
+        return;
+    }
+    const std::string dir = config_dir();
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    s.inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    // Editors and our own writes replace the file, so watch the directory
+    if (s.inotify_fd < 0 || ::inotify_add_watch(s.inotify_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        UC_LOG_WARN(Settings, "Not watching " << dir << " for changes");
+        if (s.inotify_fd >= 0) {
+            ::close(s.inotify_fd);
+            s.inotify_fd = -1;
+        }
+        return;
+    }
+    s.inotify_watch = Glib::signal_io().connect(sigc::ptr_fun(&on_inotify), s.inotify_fd, Glib::IO_IN);
+}
+
+sigc::connection Config::subscribe(const std::string &key, const sigc::slot<void> &slot)
+{
+    return state().subscribers[key].connect(slot);
+}
+
+std::string Config::path()
+{
+    const std::string dir = config_dir();
+    return dir.empty() ? "" : dir + "/" + kFileName;
+}
+
+} // namespace Core
@@ -0,0 +1,120 @@
+/**
+ * @file Config.hpp
+ * @brief Unified settings store for Ultimate Control
+ *
+ * This file defines the Config class, the single in-memory copy of every
+ * user setting. It is backed by $XDG_CONFIG_HOME/ultimate-control/settings.conf,
+ * a key=value file with dotted keys ("general.floating", "tabs.order",
+ * "power.command.shutdown", ...).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sigc++/sigc++.h>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Config
+ * @brief Typed key/value settings with change notification
+ *
+ * The file is parsed once, on first use; values that look like booleans
+ * ("true"/"false") or integers are stored as such, everything else as
+ * text. Getters convert where it makes sense (an integer is a bool if it
+ * is not 0) and return the fallback otherwise. On first run the older
+ * per-module files (general.conf, taborder.json, power.conf, volume.conf)
+ * are imported.
+ *
+ * Getters, save() and flush() may be called from any thread. set(),
+ * watch() and subscribe() must be called on the main thread, and
+ * subscribers are notified there.
+ */
+class Config {
+public:
+    /**
+     * @brief Boolean setting
+     * @param key Dotted key, e.g. "general.floating"
+     * @param fallback Returned if the key is missing or not a boolean/integer
+     */
+    static bool get_bool(const std::string &key, bool fallback);
+
+    /**
+     * @brief Integer setting
+     * @param key Dotted key
+     * @param fallback Returned if the key is missing or not an integer/boolean
+     */
+    static std::int64_t get_int(const std::string &key, std::int64_t fallback);
+
+    /**
+     * @brief Text setting; booleans and integers are returned as written
+     * @param key Dotted key
+     * @param fallback Returned if the key is missing
+     */
+    static std::string get_string(const std::string &key, const std::string &fallback = "");
+
+    /**
+     * @brief Keys starting with a prefix, e.g. "power.command."
+     * @return Matching keys, sorted
+     */
+    static std::vector<std::string> keys(const std::string &prefix);
+
+    /**
+     * @brief Change a setting in memory and notify its subscribers
+     *
+     * Nothing is written until save(). Setting the current value again is
+     * a no-op.
+     */
+    static void set(const std::string &key, bool value);
+    static void set(const std::string &key, std::int64_t value);
+    static void set(const std::string &key, int value) { set(key, static_cast<std::int64_t>(value)); }
+    static void set(const std::string &key, const std::string &value);
+    static void set(const std::string &key, const char *value) { set(key, std::string(value)); }
+
+    /**
+     * @brief Write the settings soon if they changed since the last write
+     *
+     * Returns at once. The file is written on a background thread once
+     * no save was asked for during a short quiet period, so a burst of
+     * changes costs one write. It is written to a temporary name and
+     * renamed over the old one, so a crash never leaves it torn.
+     */
+    static void save();
+
+    /**
+     * @brief Write pending changes now, on the calling thread
+     *
+     * Registered as a Core::Shutdown flush hook; any thread.
+     */
+    static void flush();
+
+    /**
+     * @brief Apply edits made to the file by other programs as they happen
+     *
+     * Watches the configuration directory with inotify on the default main
+     * loop. Changed keys are notified as if set() had been called.
+     */
+    static void watch();
+
+    /**
+     * @brief Get notified when a setting changes
+     * @param key Dotted key
+     * @param slot Called on the main thread after the value changed
+     * @return Connection to disconnect the slot
+     */
+    static sigc::connection subscribe(const std::string &key, const sigc::slot<void> &slot);
+
+    /**
+     * @brief Path of the settings file
+     * @return Absolute path, or an empty string if HOME is not set
+     */
+    static std::string path();
+};
+
+} // namespace Core
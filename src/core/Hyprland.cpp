@@ -0,0 +1,261 @@
+/**
+ * @file Hyprland.cpp
+ * @brief Implementation of the asynchronous Hyprland IPC client
+ *
+ * Request socket: write the request, read the reply until Hyprland closes
+ * the connection. Event socket: newline-separated "EVENT>>DATA" lines.
+ */
+
+#include "Hyprland.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <cerrno>        // for errno
+#include <cstdint>       // for std::int64_t
+#include <cstdlib>       // for std::getenv
+#include <cstring>       // for std::strerror
+#include <map>           // for std::map
+#include <glibmm/main.h> // for Glib::signal_io
+#include <sys/socket.h>  // for socket, connect, send
+#include <sys/un.h>      // for sockaddr_un
+#include <unistd.h>      // for read, close
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id request_counter = Metrics::counter("hyprland.requests");
+const Metrics::Id event_counter = Metrics::counter("hyprland.events");
+const Metrics::Id request_histogram = Metrics::histogram("hyprland.request");
+
+/**
+ * @struct Request
+ * @brief One request connection waiting to be written or answered
+ */
+struct Request {
+    int fd = -1;
+    std::string output;             ///< Request bytes not written yet
+    std::string reply;              ///< Reply bytes read so far
+    Hyprland::ReplyCallback done;
+    std::int64_t started_us = 0;
+    sigc::connection watch;
+};
+
+/**
+ * @struct State
+ * @brief Open request connections and the event socket
+ */
+struct State {
+    unsigned int next_request = 0;
+    std::map<unsigned int, Request> requests;
+
+    int event_fd = -1;
+    std::string event_buffer; ///< Event bytes after the last complete line
+    sigc::connection event_watch;
+    sigc::signal<void, const std::string &, const std::string &> events;
+};
+
+State &state()
+{
+    static State instance;
+    return instance;
+}
+
+/**
+ * @brief Connect to a socket in the instance directory
+ * @param name Socket file name, ".socket.sock" or ".socket2.sock"
+ * @return Non-blocking socket, or -1
+ */
+int connect_socket(const char *name)
+{
+    const char *signature = std::getenv("HYPRLAND_INSTANCE_SIGNATURE");
+    if (signature == nullptr || *signature == '\0') {
+        return -1;
+    }
+
+    std::vector<std::string> dirs;
+    const char *runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+    if (runtime_dir != nullptr && *runtime_dir != '\0') {
+        dirs.push_back(std::string(runtime_dir) + "/hypr/");
+    }
+    dirs.emplace_back("/tmp/hypr/");
+
+    for (const auto &dir : dirs) {
+        const std::string path = dir + signature + "/" + name;
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            continue;
+        }
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, path.size());
+
+        // A local connect never waits for the peer to accept
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            return -1;
+        }
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0) {
+            return fd;
+        }
+        ::close(fd);
+    }
+    return -1;
+}
+
+void finish_request(unsigned int id, bool ok)
+{
+    const int error = errno;
+    State &s = state();
+    auto it = s.requests.find(id);
+    if (it == s.requests.end()) {
+        return;
+    }
+
+    Request request = std::move(it->second);
+    s.requests.erase(it);
+    request.watch.disconnect();
+    ::close(request.fd);
+    Metrics::record_us(request_histogram, static_cast<std::uint64_t>(Trace::now_us() - request.started_us));
+
+    if (!ok) {
+        UC_LOG_WARN(App, "Hyprland request failed: " << std::strerror(error));
+    }
+    if (request.done) {
+        request.done(ok, request.reply);
+    }
+}
+
+bool on_request_io(unsigned int id, Glib::IOCondition condition)
+{
+    State &s = state();
+    auto it = s.requests.find(id);
+    if (it == s.requests.end()) {
+        return false;
+    }
+    Request &request = it->second;
+
+    if (!request.output.empty()) {
+        ssize_t count = ::send(request.fd, request.output.data(), request.output.size(), MSG_NOSIGNAL);
+        if (count < 0 && (errno == EAGAIN || errno == EINTR)) {
+            return true;
+        }
+        if (count < 0) {
+            finish_request(id, false);
+            return false;
+        }
+        request.output.erase(0, static_cast<std::size_t>(count));
+        if (request.output.empty()) {
+            // Everything sent: wait for the reply instead
+            request.watch = Glib::signal_io().connect(
+                [id](Glib::IOCondition next) { return on_request_io(id, next); },
+                request.fd, Glib::IO_IN | Glib::IO_HUP | Glib::IO_ERR);
+            return false;
+        }
+        return true;
+    }
+
+    char buffer[4096];
+    ssize_t count = (condition & (Glib::IO_IN | Glib::IO_HUP)) ? ::read(request.fd, buffer, sizeof(buffer)) : -1;
+    if (count < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return true;
+    }
+    if (count > 0) {
+        request.reply.append(buffer, static_cast<std::size_t>(count));
+        return true;
+    }
+    finish_request(id, count == 0); // Hyprland closes the connection after replying
+    return false;
+}
+
+bool on_event_io(Glib::IOCondition condition)
+{
+    State &s = state();
+    char buffer[4096];
+    ssize_t count = (condition & (Glib::IO_IN | Glib::IO_HUP)) ? ::read(s.event_fd, buffer, sizeof(buffer)) : -1;
+    if (count < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return true;
+    }
+    if (count <= 0) {
+        UC_LOG_INFO(App, "Hyprland event socket closed");
+        ::close(s.event_fd);
+        s.event_fd = -1;
+        s.event_buffer.clear();
+        return false;
+    }
+
+    s.event_buffer.append(buffer, static_cast<std::size_t>(count));
+    std::size_t start = 0;
+    std::size_t end;
+    while ((end = s.event_buffer.find('\n', start)) != std::string::npos) {
+        const std::string line = s.event_buffer.substr(start, end - start);
+        start = end + 1;
+        const std::size_t separator = line.find(">>");
+        if (separator == std::string::npos) {
+            continue;
+        }
+        Metrics::increment(event_counter);
+        s.events.emit(line.substr(0, separator), line.substr(separator + 2));
+    }
+    s.event_buffer.erase(0, start);
+    return true;
+}
+
+} // namespace
+
+bool Hyprland::available()
+{
+    const char *signature = std::getenv("HYPRLAND_INSTANCE_SIGNATURE");
+    return signature != nullptr && *signature != '\0';
+}
+
+bool Hyprland::request(const std::string &command, ReplyCallback done)
+{
+    Trace::Span span("Hyprland::request", "hyprland", command);
+    int fd = connect_socket(".socket.sock");
+    if (fd < 0) {
+        UC_LOG_WARN(App, "Hyprland request socket not reachable");
+        return false;
+    }
+    Metrics::increment(request_counter);
+
+    State &s = state();
+    const unsigned int id = s.next_request++;
+    Request &request = s.requests[id];
+    request.fd = fd;
+    request.output = command;
+    request.done = std::move(done);
+    request.started_us = Trace::now_us();
+    request.watch = Glib::signal_io().connect(
+        [id](Glib::IOCondition condition) { return on_request_io(id, condition); },
+        fd, Glib::IO_OUT | Glib::IO_HUP | Glib::IO_ERR);
+    return true;
+}
+
+bool Hyprland::batch(const std::vector<std::string> &commands, ReplyCallback done)
+{
+    std::string joined = "[[BATCH]]";
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        if (i > 0) {
+            joined += ';';
+        }
+        joined += commands[i];
+    }
+    return request(joined, std::move(done));
+}
+
+sigc::connection Hyprland::on_event(const sigc::slot<void, const std::string &, const std::string &> &slot)
+{
+    State &s = state();
+    sigc::connection connection = s.events.connect(slot);
+    if (s.event_fd < 0) {
+        s.event_fd = connect_socket(".socket2.sock");
+        if (s.event_fd >= 0) {
+            s.event_watch = Glib::signal_io().connect(sigc::ptr_fun(&on_event_io), s.event_fd, Glib::IO_IN | Glib::IO_HUP | Glib::IO_ERR);
+        } else {
+            UC_LOG_WARN(App, "Hyprland event socket not reachable");
+        }
+    }
+    return connection;
+}
+
+} // namespace Core
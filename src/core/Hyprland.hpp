@@ -0,0 +1,75 @@
+/**
+ * @file Hyprland.hpp
+ * @brief Asynchronous client for Hyprland's IPC sockets
+ *
+ * This file defines the Hyprland class which talks to the compositor over
+ * its request socket (.socket.sock, what hyprctl uses) and its event socket
+ * (.socket2.sock) on the main loop, so window rules can be set without
+ * spawning hyprctl and without waiting for the reply.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <sigc++/sigc++.h>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Hyprland
+ * @brief Non-blocking Hyprland IPC on the default main loop
+ *
+ * The sockets are looked up in $XDG_RUNTIME_DIR/hypr/<signature>/, then in
+ * /tmp/hypr/<signature>/ (Hyprland before 0.40), where <signature> is
+ * $HYPRLAND_INSTANCE_SIGNATURE. Every request uses its own connection, as
+ * hyprctl does. All methods must be called on the main thread.
+ */
+class Hyprland {
+public:
+    /**
+     * @brief Callback receiving the reply to a request
+     * @param ok False if the socket could not be reached or the connection failed
+     * @param reply Text sent back by Hyprland, e.g. "ok"
+     */
+    using ReplyCallback = std::function<void(bool ok, const std::string &reply)>;
+
+    /**
+     * @brief Whether the application runs under Hyprland
+     * @return True if HYPRLAND_INSTANCE_SIGNATURE is set
+     */
+    static bool available();
+
+    /**
+     * @brief Send one request, e.g. "keyword windowrule ...", without blocking
+     * @param command Request text as hyprctl would send it
+     * @param done Called on the main loop with the reply; may be empty
+     * @return False if the request could not be started; @p done is not called then
+     */
+    static bool request(const std::string &command, ReplyCallback done = ReplyCallback());
+
+    /**
+     * @brief Send several commands as one batch, like `hyprctl --batch`
+     * @param commands Commands run in order by Hyprland
+     * @param done Called on the main loop with the combined reply; may be empty
+     * @return False if the request could not be started
+     */
+    static bool batch(const std::vector<std::string> &commands, ReplyCallback done = ReplyCallback());
+
+    /**
+     * @brief Listen to compositor events such as "workspace" or "monitoradded"
+     * @param slot Called with the event name and its data for every event
+     * @return Connection to disconnect the slot
+     *
+     * The event socket is opened by the first subscription. If Hyprland
+     * closes it, the next subscription opens it again.
+     */
+    static sigc::connection on_event(const sigc::slot<void, const std::string &, const std::string &> &slot);
+};
+
+} // namespace Core
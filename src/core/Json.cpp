@@ -0,0 +1,375 @@
+/**
+ * @file Json.cpp
+ * @brief Implementation of the minimal JSON helpers
+ */
+
+#include "Json.hpp"
+#include <cmath>   // for std::isfinite
+#include <cstdio>  // for std::snprintf
+#include <cstdlib> // for std::strtod
+
+namespace Core {
+namespace Json {
+
+std::string escape(const std::string &text)
+{
+    std::string out;
+    out.reserve(text.size() + 8);
+
+    for (unsigned char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+
+    return out;
+}
+
+std::string quote(const std::string &text)
+{
+    return "\"" + escape(text) + "\"";
+}
+
+namespace {
+
+/// Nesting limit, so hostile input cannot exhaust the stack
+constexpr int kMaxDepth = 64;
+
+/**
+ * @class Parser
+ * @brief Recursive-descent parser over one document
+ */
+class Parser {
+public:
+    explicit Parser(const std::string &text) : text_(text) {}
+
+    bool parse_document(Value &value)
+    {
+        if (!parse_value(value, 0)) {
+            return false;
+        }
+        skip_space();
+        if (pos_ != text_.size()) {
+            return fail("trailing characters");
+        }
+        return true;
+    }
+
+    const std::string &error() const { return error_; }
+
+private:
+    bool fail(const std::string &message)
+    {
+        if (error_.empty()) {
+            error_ = message + " at offset " + std::to_string(pos_);
+        }
+        return false;
+    }
+
+    void skip_space()
+    {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool literal(const char *word)
+    {
+        std::size_t length = std::char_traits<char>::length(word);
+        if (text_.compare(pos_, length, word) != 0) {
+            return fail("invalid literal");
+        }
+        pos_ += length;
+        return true;
+    }
+
+    bool parse_value(Value &value, int depth)
+    {
+        if (depth > kMaxDepth) {
+            return fail("nesting too deep");
+        }
+        skip_space();
+        if (pos_ >= text_.size()) {
+            return fail("unexpected end of input");
+        }
+
+        switch (text_[pos_]) {
+            case 'n': value.type = Value::Type::Null; return literal("null");
+            case 't': value.type = Value::Type::Bool; value.boolean = true; return literal("true");
+            case 'f': value.type = Value::Type::Bool; value.boolean = false; return literal("false");
+            case '"': value.type = Value::Type::String; return parse_string(value.string);
+            case '[': return parse_array(value, depth);
+            case '{': return parse_object(value, depth);
+            default: return parse_number(value);
+        }
+    }
+
+    bool parse_number(Value &value)
+    {
+        // strtod accepts more than JSON does (hex, inf); check the first character
+        char first = text_[pos_];
+        if (first != '-' && (first < '0' || first > '9')) {
+            return fail("unexpected character");
+        }
+        const char *start = text_.c_str() + pos_;
+        char *end = nullptr;
+        double number = std::strtod(start, &end);
+        if (end == start || !std::isfinite(number)) {
+            return fail("invalid number");
+        }
+        pos_ += static_cast<std::size_t>(end - start);
+        value.type = Value::Type::Number;
+        value.number = number;
+        return true;
+    }
+
+    bool parse_hex4(unsigned int &code)
+    {
+        if (pos_ + 4 > text_.size()) {
+            return fail("truncated escape");
+        }
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text_[pos_++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<unsigned int>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<unsigned int>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<unsigned int>(c - 'A' + 10);
+            } else {
+                return fail("invalid escape");
+            }
+        }
+        return true;
+    }
+
+    static void append_utf8(std::string &out, unsigned int code)
+    {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parse_string(std::string &out)
+    {
+        ++pos_; // Opening quote
+        out.clear();
+        while (pos_ < text_.size()) {
+            char c = text_[pos_++];
+            if (c == '"') {
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return fail("control character in string");
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                break;
+            }
+            switch (text_[pos_++]) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned int code = 0;
+                    if (!parse_hex4(code)) {
+                        return false;
+                    }
+                    // Combine a UTF-16 surrogate pair into one code point
+                    if (code >= 0xD800 && code < 0xDC00 && text_.compare(pos_, 2, "\\u") == 0) {
+                        pos_ += 2;
+                        unsigned int low = 0;
+                        if (!parse_hex4(low) || low < 0xDC00 || low >= 0xE000) {
+                            return fail("invalid surrogate pair");
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(out, code);
+                    break;
+                }
+                default: return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parse_array(Value &value, int depth)
+    {
+        ++pos_; // Opening bracket
+        value.type = Value::Type::Array;
+        value.array.clear();
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == ']') {
+            ++pos_;
+            return true;
+        }
+        while (true) {
+            value.array.emplace_back();
+            if (!parse_value(value.array.back(), depth + 1)) {
+                return false;
+            }
+            skip_space();
+            if (pos_ < text_.size() && text_[pos_] == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < text_.size() && text_[pos_] == ']') {
+                ++pos_;
+                return true;
+            }
+            return fail("expected ',' or ']'");
+        }
+    }
+
+    bool parse_object(Value &value, int depth)
+    {
+        ++pos_; // Opening brace
+        value.type = Value::Type::Object;
+        value.object.clear();
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == '}') {
+            ++pos_;
+            return true;
+        }
+        while (true) {
+            skip_space();
+            if (pos_ >= text_.size() || text_[pos_] != '"') {
+                return fail("expected member name");
+            }
+            value.object.emplace_back();
+            auto &member = value.object.back();
+            if (!parse_string(member.first)) {
+                return false;
+            }
+            skip_space();
+            if (pos_ >= text_.size() || text_[pos_] != ':') {
+                return fail("expected ':'");
+            }
+            ++pos_;
+            if (!parse_value(member.second, depth + 1)) {
+                return false;
+            }
+            skip_space();
+            if (pos_ < text_.size() && text_[pos_] == ',') {
+                ++pos_;
+                continue;
+            }
+            if (pos_ < text_.size() && text_[pos_] == '}') {
+                ++pos_;
+                return true;
+            }
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    const std::string &text_;
+    std::size_t pos_ = 0;
+    std::string error_;
+};
+
+void dump_to(const Value &value, std::string &out)
+{
+    switch (value.type) {
+        case Value::Type::Null: out += "null"; break;
+        case Value::Type::Bool: out += value.boolean ? "true" : "false"; break;
+        case Value::Type::Number: {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.17g", value.number);
+            out += buf;
+            break;
+        }
+        case Value::Type::String: out += quote(value.string); break;
+        case Value::Type::Array:
+            out += '[';
+            for (std::size_t i = 0; i < value.array.size(); ++i) {
+                if (i) {
+                    out += ',';
+                }
+                dump_to(value.array[i], out);
+            }
+            out += ']';
+            break;
+        case Value::Type::Object:
+            out += '{';
+            for (std::size_t i = 0; i < value.object.size(); ++i) {
+                if (i) {
+                    out += ',';
+                }
+                out += quote(value.object[i].first);
+                out += ':';
+                dump_to(value.object[i].second, out);
+            }
+            out += '}';
+            break;
+    }
+}
+
+} // namespace
+
+const Value *Value::find(const std::string &key) const
+{
+    if (type != Type::Object) {
+        return nullptr;
+    }
+    for (const auto &member : object) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+bool parse(const std::string &text, Value &value, std::string &error)
+{
+    Parser parser(text);
+    if (!parser.parse_document(value)) {
+        error = parser.error();
+        return false;
+    }
+    return true;
+}
+
+std::string dump(const Value &value)
+{
+    std::string out;
+    dump_to(value, out);
+    return out;
+}
+
+} // namespace Json
+} // namespace Core
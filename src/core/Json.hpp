@@ -0,0 +1,87 @@
+/**
+ * @file Json.hpp
+ * @brief Minimal JSON helpers for Ultimate Control
+ *
+ * This file declares small helpers used when emitting JSON for statistics,
+ * traces and the command-line interface, and a small parser for the
+ * requests received on the control socket. Output is still hand-built, so
+ * no full JSON library is required.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @namespace Core::Json
+ * @brief JSON string helpers
+ */
+namespace Json {
+
+/**
+ * @brief Escape a string for inclusion inside a JSON string literal
+ * @param text The raw text
+ * @return The escaped text (without surrounding quotes)
+ */
+std::string escape(const std::string &text);
+
+/**
+ * @brief Escape and quote a string as a JSON string literal
+ * @param text The raw text
+ * @return The quoted JSON string
+ */
+std::string quote(const std::string &text);
+
+/**
+ * @struct Value
+ * @brief A parsed JSON value
+ *
+ * Object members keep their document order so that re-serialised output
+ * matches what the sender wrote.
+ */
+struct Value {
+    /// Kind of value held
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;                            ///< Kind of value held
+    bool boolean = false;                              ///< Value when type is Bool
+    double number = 0.0;                               ///< Value when type is Number
+    std::string string;                                ///< Value when type is String
+    std::vector<Value> array;                          ///< Elements when type is Array
+    std::vector<std::pair<std::string, Value>> object; ///< Members when type is Object
+
+    /**
+     * @brief Look up an object member
+     * @param key Member name
+     * @return The member, or nullptr if absent or this is not an object
+     */
+    const Value *find(const std::string &key) const;
+};
+
+/**
+ * @brief Parse a JSON document
+ * @param text The document
+ * @param value Receives the parsed value on success
+ * @param error Receives a message on failure
+ * @return true if the whole text is one valid JSON value
+ */
+bool parse(const std::string &text, Value &value, std::string &error);
+
+/**
+ * @brief Serialise a value as compact JSON
+ * @param value The value
+ * @return The JSON text
+ */
+std::string dump(const Value &value);
+
+} // namespace Json
+
+} // namespace Core
@@ -0,0 +1,359 @@
+/**
+ * @file Log.cpp
+ * @brief Implementation of the asynchronous logger
+ *
+ * This file implements the Log class: a bounded multi-producer ring buffer
+ * (one sequence number per slot, no locks on the hot path) and a writer
+ * thread that formats records for stderr, a file, or journald.
+ */
+
+#include "Log.hpp"
+#include <algorithm>          // for std::min
+#include <array>              // for std::array
+#include <cctype>             // for std::tolower
+#include <chrono>             // for std::chrono::steady_clock
+#include <condition_variable> // for std::condition_variable
+#include <cstdio>             // for std::fopen, std::fwrite
+#include <cstdlib>            // for std::getenv, std::at_quick_exit
+#include <cstring>            // for std::memcpy
+#include <mutex>              // for std::mutex
+#include <thread>             // for std::thread
+#include <sys/socket.h>       // for socket, sendto
+#include <sys/un.h>           // for sockaddr_un
+#include <unistd.h>           // for close, write
+
+namespace Core {
+
+std::atomic<int> Log::threshold_{static_cast<int>(Log::Level::Warn)};
+
+namespace {
+
+constexpr std::size_t kCapacity = 1024;   ///< Number of slots (power of two)
+constexpr std::size_t kMaxMessage = 232;  ///< Bytes of text kept per message
+
+/**
+ * @struct Record
+ * @brief One slot of the ring buffer
+ *
+ * The sequence number tells producers and the consumer whose turn it is
+ * to touch the slot, which is what makes the queue lock-free.
+ */
+struct Record {
+    std::atomic<std::size_t> sequence{0};
+    std::uint8_t level = 0;
+    std::uint8_t category = 0;
+    std::uint16_t length = 0;
+    std::int64_t timestamp_us = 0;
+    char text[kMaxMessage];
+};
+
+/**
+ * @brief Shared state of the logger
+ */
+struct State {
+    std::array<Record, kCapacity> ring;
+    std::atomic<std::size_t> enqueue_pos{0};
+    std::size_t dequeue_pos = 0; // Only touched by the writer thread
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> writer_sleeping{false};
+    std::atomic<std::uint64_t> dropped{0};
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::thread writer;
+
+    Log::Sink sink = Log::Sink::Stderr;
+    std::FILE *file = nullptr;
+    int journal_fd = -1;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    State()
+    {
+        for (std::size_t i = 0; i < kCapacity; ++i) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+};
+
+State &state()
+{
+    static State instance;
+    return instance;
+}
+
+const char *level_name(std::uint8_t level)
+{
+    static const char *names[] = {"TRACE", "DEBUG", "INFO", "WARN", "ERROR"};
+    return level < 5 ? names[level] : "?";
+}
+
+const char *category_name(std::uint8_t category)
+{
+    static const char *names[] = {"app", "volume", "wifi", "bluetooth",
+                                  "display", "power", "settings", "utils"};
+    return category < static_cast<std::uint8_t>(Log::Category::Count) ? names[category] : "?";
+}
+
+/**
+ * @brief Map a level to a syslog priority for journald
+ */
+int syslog_priority(std::uint8_t level)
+{
+    switch (level) {
+        case 0:
+        case 1: return 7; // LOG_DEBUG
+        case 2: return 6; // LOG_INFO
+        case 3: return 4; // LOG_WARNING
+        default: return 3; // LOG_ERR
+    }
+}
+
+/**
+ * @brief Format and emit a single record on the writer thread
+ */
+void emit(State &s, std::uint8_t level, std::uint8_t category, std::int64_t timestamp_us,
+          const char *text, std::size_t length)
+{
+    if (s.sink == Log::Sink::Journal && s.journal_fd >= 0) {
+        std::string datagram;
+        datagram.reserve(length + 96);
+        datagram += "PRIORITY=";
+        datagram += std::to_string(syslog_priority(level));
+        datagram += "\nSYSLOG_IDENTIFIER=ultimate-control\nUC_CATEGORY=";
+        datagram += category_name(category);
+        datagram += "\nMESSAGE=";
+        for (std::size_t i = 0; i < length; ++i) {
+            datagram += (text[i] == '\n') ? ' ' : text[i];
+        }
+        datagram += '\n';
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, "/run/systemd/journal/socket", sizeof(addr.sun_path) - 1);
+        if (sendto(s.journal_fd, datagram.data(), datagram.size(), MSG_NOSIGNAL,
+                   reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) >= 0) {
+            return;
+        }
+        // Fall through to stderr if journald went away
+    }
+
+    char prefix[64];
+    int prefix_len = std::snprintf(prefix, sizeof(prefix), "[%8.3f] %-5s %s: ",
+                                   static_cast<double>(timestamp_us) / 1e6,
+                                   level_name(level), category_name(category));
+    std::string line(prefix, prefix_len > 0 ? static_cast<std::size_t>(prefix_len) : 0);
+    line.append(text, length);
+    line += '\n';
+
+    if (s.sink == Log::Sink::File && s.file) {
+        std::fwrite(line.data(), 1, line.size(), s.file);
+    } else {
+        // Plain write(2): the writer thread is the only one allowed to block here
+        const char *data = line.data();
+        std::size_t remaining = line.size();
+        while (remaining > 0) {
+            ssize_t n = ::write(STDERR_FILENO, data, remaining);
+            if (n <= 0) {
+                break;
+            }
+            data += n;
+            remaining -= static_cast<std::size_t>(n);
+        }
+    }
+}
+
+/**
+ * @brief Check whether the slot at the consumer position is ready
+ */
+bool has_pending(State &s)
+{
+    Record &rec = s.ring[s.dequeue_pos & (kCapacity - 1)];
+    // seq_cst pairs with the producer's store of sequence then load of
+    // writer_sleeping: either the writer sees the record or the producer
+    // sees the writer parked and wakes it
+    return rec.sequence.load(std::memory_order_seq_cst) == s.dequeue_pos + 1;
+}
+
+/**
+ * @brief Write out every record currently published in the ring buffer
+ */
+void drain(State &s)
+{
+    while (has_pending(s)) {
+        Record &rec = s.ring[s.dequeue_pos & (kCapacity - 1)];
+        emit(s, rec.level, rec.category, rec.timestamp_us, rec.text, rec.length);
+        // Hand the slot back to producers for the next lap
+        rec.sequence.store(s.dequeue_pos + kCapacity, std::memory_order_release);
+        ++s.dequeue_pos;
+    }
+    if (s.file) {
+        std::fflush(s.file);
+    }
+}
+
+/**
+ * @brief Body of the writer thread
+ *
+ * Sleeps on a condition variable while the buffer is empty, so an idle
+ * application causes no periodic wakeups.
+ */
+void writer_loop(State &s)
+{
+    for (;;) {
+        drain(s);
+
+        std::unique_lock<std::mutex> lock(s.wake_mutex);
+        s.writer_sleeping.store(true, std::memory_order_seq_cst);
+        s.wake.wait(lock, [&s]() {
+            return has_pending(s) || !s.running.load(std::memory_order_acquire);
+        });
+        s.writer_sleeping.store(false, std::memory_order_seq_cst);
+
+        if (!s.running.load(std::memory_order_acquire)) {
+            lock.unlock();
+            drain(s);
+            return;
+        }
+    }
+}
+
+} // namespace
+
+void Log::init(Level level, Sink sink, const std::string &path)
+{
+    State &s = state();
+    if (s.running.load()) {
+        set_level(level);
+        return;
+    }
+
+    set_level(level);
+
+    // Pick journald automatically when stderr is already going to the journal
+    if (sink == Sink::Auto) {
+        sink = std::getenv("JOURNAL_STREAM") ? Sink::Journal : Sink::Stderr;
+    }
+
+    if (sink == Sink::File) {
+        s.file = std::fopen(path.c_str(), "a");
+        if (!s.file) {
+            sink = Sink::Stderr;
+        }
+    } else if (sink == Sink::Journal) {
+        s.journal_fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (s.journal_fd < 0) {
+            sink = Sink::Stderr;
+        }
+    }
+    s.sink = sink;
+
+    s.running.store(true, std::memory_order_release);
+    s.writer = std::thread([&s]() { writer_loop(s); });
+
+    std::at_quick_exit(&Log::shutdown);
+    std::atexit(&Log::shutdown);
+}
+
+void Log::shutdown()
+{
+    State &s = state();
+    if (!s.running.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s.wake_mutex);
+        s.wake.notify_one();
+    }
+    if (s.writer.joinable()) {
+        s.writer.join();
+    }
+
+    if (s.file) {
+        std::fclose(s.file);
+        s.file = nullptr;
+    }
+    if (s.journal_fd >= 0) {
+        close(s.journal_fd);
+        s.journal_fd = -1;
+    }
+}
+
+void Log::set_level(Level level)
+{
+    threshold_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+bool Log::parse_level(const std::string &name, Level &level)
+{
+    std::string lower;
+    for (char c : name) {
+        lower += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    if (lower == "trace") level = Level::Trace;
+    else if (lower == "debug") level = Level::Debug;
+    else if (lower == "info") level = Level::Info;
+    else if (lower == "warn" || lower == "warning") level = Level::Warn;
+    else if (lower == "error") level = Level::Error;
+    else if (lower == "off" || lower == "none") level = Level::Off;
+    else return false;
+
+    return true;
+}
+
+void Log::write(Level level, Category category, const std::string &message)
+{
+    State &s = state();
+    auto now = std::chrono::steady_clock::now();
+    std::int64_t timestamp_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - s.start).count();
+
+    // Before init() (or after shutdown()) there is no writer: write synchronously
+    if (!s.running.load(std::memory_order_acquire)) {
+        emit(s, static_cast<std::uint8_t>(level), static_cast<std::uint8_t>(category),
+             timestamp_us, message.data(), message.size());
+        return;
+    }
+
+    // Claim a slot: classic bounded MPMC sequence protocol
+    Record *rec = nullptr;
+    std::size_t pos = s.enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Record &candidate = s.ring[pos & (kCapacity - 1)];
+        std::size_t seq = candidate.sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (s.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                rec = &candidate;
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring is full: never block the caller, just count the loss
+            s.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = s.enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    rec->level = static_cast<std::uint8_t>(level);
+    rec->category = static_cast<std::uint8_t>(category);
+    rec->timestamp_us = timestamp_us;
+    rec->length = static_cast<std::uint16_t>(std::min(message.size(), kMaxMessage));
+    std::memcpy(rec->text, message.data(), rec->length);
+    rec->sequence.store(pos + 1, std::memory_order_seq_cst);
+
+    // Only pay for the mutex when the writer is actually parked
+    if (s.writer_sleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(s.wake_mutex);
+        s.wake.notify_one();
+    }
+}
+
+std::uint64_t Log::dropped()
+{
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace Core
@@ -0,0 +1,181 @@
+/**
+ * @file Log.hpp
+ * @brief Leveled, asynchronous logging for Ultimate Control
+ *
+ * This file defines the Log class which replaces direct std::cout/std::cerr
+ * output. Messages are filtered at compile time and at runtime by level,
+ * tagged with a subsystem category, and pushed into a lock-free ring buffer
+ * that a background thread drains to journald, a file, or stderr.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+/**
+ * @def UC_LOG_COMPILE_LEVEL
+ * @brief Lowest level compiled into the binary (0 = trace ... 4 = error)
+ *
+ * Log statements below this level are removed entirely by the compiler.
+ * Release builds keep info and above, debug builds keep debug and above.
+ */
+#ifndef UC_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define UC_LOG_COMPILE_LEVEL 2
+#else
+#define UC_LOG_COMPILE_LEVEL 1
+#endif
+#endif
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Log
+ * @brief Process-wide asynchronous logger
+ *
+ * Producers format their message on the calling thread and enqueue it
+ * without taking a lock. A single writer thread performs all I/O, so a
+ * slow stderr pipe or journald never blocks the GTK main loop. When the
+ * ring buffer is full, messages are dropped and counted instead of blocking.
+ */
+class Log {
+public:
+    /**
+     * @enum Level
+     * @brief Severity of a log message
+     */
+    enum class Level {
+        Trace = 0, ///< Very verbose diagnostics (per-item output)
+        Debug = 1, ///< Per-action diagnostics
+        Info = 2,  ///< Notable lifecycle events
+        Warn = 3,  ///< Recoverable problems
+        Error = 4, ///< Failed operations
+        Off = 5    ///< Disable all output
+    };
+
+    /**
+     * @enum Category
+     * @brief Subsystem a log message belongs to
+     */
+    enum class Category {
+        App,
+        Volume,
+        Wifi,
+        Bluetooth,
+        Display,
+        Power,
+        Settings,
+        Utils,
+        Count ///< Number of categories (not a real category)
+    };
+
+    /**
+     * @enum Sink
+     * @brief Destination the writer thread sends messages to
+     */
+    enum class Sink {
+        Auto,    ///< journald when stderr is connected to the journal, stderr otherwise
+        Stderr,  ///< Plain text on standard error
+        Journal, ///< Native journald protocol over its datagram socket
+        File     ///< Plain text appended to a file
+    };
+
+    /**
+     * @brief Start the writer thread
+     * @param level Minimum runtime level to record
+     * @param sink Destination for log output
+     * @param path File path when sink is Sink::File
+     *
+     * Safe to call once at startup. Messages logged before init() are
+     * written synchronously to stderr so nothing is lost.
+     */
+    static void init(Level level, Sink sink = Sink::Auto, const std::string &path = "");
+
+    /**
+     * @brief Drain the ring buffer and stop the writer thread
+     *
+     * Registered with std::at_quick_exit by init() so that pending messages
+     * are written even when the application exits via std::quick_exit.
+     */
+    static void shutdown();
+
+    /**
+     * @brief Set the minimum runtime level
+     * @param level Messages below this level are discarded
+     */
+    static void set_level(Level level);
+
+    /**
+     * @brief Check whether a level is currently recorded
+     * @param level The level to check
+     * @return true if messages at this level are recorded
+     */
+    static bool enabled(Level level)
+    {
+        return static_cast<int>(level) >= threshold_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Parse a level name such as "debug" or "warn"
+     * @param name The level name (case-insensitive)
+     * @param level Receives the parsed level on success
+     * @return true if the name was recognised
+     */
+    static bool parse_level(const std::string &name, Level &level);
+
+    /**
+     * @brief Enqueue a formatted message
+     * @param level Severity of the message
+     * @param category Subsystem the message belongs to
+     * @param message The message text
+     *
+     * Prefer the UC_LOG_* macros, which skip formatting entirely when the
+     * level is filtered out.
+     */
+    static void write(Level level, Category category, const std::string &message);
+
+    /**
+     * @brief Number of messages dropped because the ring buffer was full
+     */
+    static std::uint64_t dropped();
+
+private:
+    static std::atomic<int> threshold_; ///< Current runtime level as an int
+};
+
+} // namespace Core
+
+/**
+ * @brief Log a streamed expression at the given level and category
+ *
+ * Usage: UC_LOG_DEBUG(Wifi, "Connecting to " << ssid);
+ * The expression is only evaluated when the level is compiled in and
+ * enabled at runtime.
+ */
+#define UC_LOG(level, category, expr)                                                 \
+    do                                                                                \
+    {                                                                                 \
+        if constexpr (static_cast<int>(level) >= UC_LOG_COMPILE_LEVEL)                \
+        {                                                                             \
+            if (::Core::Log::enabled(level))                                          \
+            {                                                                         \
+                std::ostringstream uc_log_stream_;                                    \
+                uc_log_stream_ << expr;                                               \
+                ::Core::Log::write(level, ::Core::Log::Category::category,            \
+                                   uc_log_stream_.str());                             \
+            }                                                                         \
+        }                                                                             \
+    } while (0)
+
+#define UC_LOG_TRACE(category, expr) UC_LOG(::Core::Log::Level::Trace, category, expr)
+#define UC_LOG_DEBUG(category, expr) UC_LOG(::Core::Log::Level::Debug, category, expr)
+#define UC_LOG_INFO(category, expr) UC_LOG(::Core::Log::Level::Info, category, expr)
+#define UC_LOG_WARN(category, expr) UC_LOG(::Core::Log::Level::Warn, category, expr)
+#define UC_LOG_ERROR(category, expr) UC_LOG(::Core::Log::Level::Error, category, expr)
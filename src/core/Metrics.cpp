@@ -0,0 +1,452 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of the metrics registry
+ *
+ * This file implements the Metrics class. Each thread owns a shard of
+ * relaxed atomic counters and lazily allocated histogram blocks; readers
+ * walk all live shards plus the totals of threads that already exited.
+ */
+
+#include "Metrics.hpp"
+#include "Json.hpp"
+#include <algorithm>     // for std::max
+#include <atomic>        // for std::atomic
+#include <cstdio>        // for std::snprintf
+#include <deque>         // for std::deque
+#include <fstream>       // for std::ofstream
+#include <mutex>         // for std::mutex
+#include <sstream>       // for std::ostringstream
+#include <unordered_map> // for std::unordered_map
+#include <vector>        // for std::vector
+
+namespace Core {
+
+namespace {
+
+constexpr std::size_t kMaxCounters = 128;   ///< Capacity of the counter table
+constexpr std::size_t kMaxGauges = 32;      ///< Capacity of the gauge table
+constexpr std::size_t kMaxHistograms = 64;  ///< Capacity of the histogram table
+constexpr Metrics::Id kInvalidId = 0xFFFF;  ///< Returned when a table is full
+
+constexpr unsigned kSubBits = 3;                          ///< 8 sub-buckets per power of two (<= 12.5% error)
+constexpr unsigned kSubCount = 1u << kSubBits;            ///< Sub-buckets per power of two
+constexpr unsigned kMaxExponent = 40;                     ///< Largest power of two tracked (~12 days in us)
+constexpr unsigned kBuckets = kSubCount * (kMaxExponent - kSubBits + 2);
+
+/**
+ * @brief Map a value to its log-linear bucket
+ */
+unsigned bucket_index(std::uint64_t value)
+{
+    if (value < kSubCount) {
+        return static_cast<unsigned>(value);
+    }
+    unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    if (exponent > kMaxExponent) {
+        return kBuckets - 1;
+    }
+    unsigned sub = static_cast<unsigned>(value >> (exponent - kSubBits)) & (kSubCount - 1);
+    return (exponent - kSubBits + 1) * kSubCount + sub;
+}
+
+/**
+ * @brief Highest value that falls into a bucket
+ */
+std::uint64_t bucket_upper_bound(unsigned index)
+{
+    if (index < kSubCount) {
+        return index;
+    }
+    unsigned exponent = index / kSubCount + kSubBits - 1;
+    std::uint64_t sub = index % kSubCount;
+    std::uint64_t width = 1ull << (exponent - kSubBits);
+    return ((kSubCount + sub) << (exponent - kSubBits)) + width - 1;
+}
+
+/**
+ * @struct HistogramShard
+ * @brief One thread's samples for one histogram
+ */
+struct HistogramShard {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> max{0};
+    std::atomic<std::uint64_t> buckets[kBuckets] = {};
+};
+
+/**
+ * @struct Shard
+ * @brief All metrics recorded by one thread
+ *
+ * Only the owning thread writes; the relaxed atomics make concurrent reads
+ * from the snapshot code well defined without costing anything extra on x86.
+ */
+struct Shard {
+    std::atomic<std::uint64_t> counters[kMaxCounters] = {};
+    std::atomic<HistogramShard *> histograms[kMaxHistograms] = {};
+
+    ~Shard()
+    {
+        for (auto &h : histograms) {
+            delete h.load(std::memory_order_relaxed);
+        }
+    }
+
+    HistogramShard &histogram(Metrics::Id id)
+    {
+        HistogramShard *h = histograms[id].load(std::memory_order_relaxed);
+        if (!h) {
+            h = new HistogramShard();
+            histograms[id].store(h, std::memory_order_release);
+        }
+        return *h;
+    }
+};
+
+/**
+ * @struct Registry
+ * @brief Names, live shards, and the totals of exited threads
+ */
+struct Registry {
+    std::mutex mutex;
+    std::deque<std::string> counter_names;   // deque keeps c_str() pointers stable
+    std::deque<std::string> gauge_names;
+    std::deque<std::string> histogram_names;
+    std::atomic<const char *> histogram_name_ptrs[kMaxHistograms] = {};
+    std::unordered_map<std::string, Metrics::Id> counter_ids;
+    std::unordered_map<std::string, Metrics::Id> gauge_ids;
+    std::unordered_map<std::string, Metrics::Id> histogram_ids;
+    std::atomic<std::int64_t> gauges[kMaxGauges] = {};
+    std::vector<Shard *> live;
+    Shard retired;
+};
+
+Registry &registry()
+{
+    // Intentionally leaked: detached worker threads may still record during exit
+    static Registry *instance = new Registry();
+    return *instance;
+}
+
+void add_relaxed(std::atomic<std::uint64_t> &target, std::uint64_t delta)
+{
+    target.store(target.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+void max_relaxed(std::atomic<std::uint64_t> &target, std::uint64_t value)
+{
+    if (value > target.load(std::memory_order_relaxed)) {
+        target.store(value, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Folds a thread's shard into the retired totals when the thread exits
+ */
+struct ShardOwner {
+    Shard *shard;
+
+    ShardOwner() : shard(new Shard())
+    {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live.push_back(shard);
+    }
+
+    ~ShardOwner()
+    {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        for (std::size_t i = 0; i < kMaxCounters; ++i) {
+            // retired is only written under the registry mutex, so plain
+            // load/store pairs are sufficient
+            add_relaxed(r.retired.counters[i], shard->counters[i].load(std::memory_order_relaxed));
+        }
+        for (std::size_t i = 0; i < kMaxHistograms; ++i) {
+            HistogramShard *src = shard->histograms[i].load(std::memory_order_acquire);
+            if (!src) {
+                continue;
+            }
+            HistogramShard &dst = r.retired.histogram(static_cast<Metrics::Id>(i));
+            add_relaxed(dst.count, src->count.load(std::memory_order_relaxed));
+            add_relaxed(dst.sum, src->sum.load(std::memory_order_relaxed));
+            max_relaxed(dst.max, src->max.load(std::memory_order_relaxed));
+            for (unsigned b = 0; b < kBuckets; ++b) {
+                add_relaxed(dst.buckets[b], src->buckets[b].load(std::memory_order_relaxed));
+            }
+        }
+
+        r.live.erase(std::remove(r.live.begin(), r.live.end(), shard), r.live.end());
+        delete shard;
+    }
+};
+
+Shard &local_shard()
+{
+    thread_local ShardOwner owner;
+    return *owner.shard;
+}
+
+/**
+ * @struct HistogramSnapshot
+ * @brief Merged view of one histogram
+ */
+struct HistogramSnapshot {
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t max = 0;
+    std::vector<std::uint64_t> buckets = std::vector<std::uint64_t>(kBuckets, 0);
+
+    void merge(const HistogramShard &h)
+    {
+        count += h.count.load(std::memory_order_relaxed);
+        sum += h.sum.load(std::memory_order_relaxed);
+        max = std::max(max, h.max.load(std::memory_order_relaxed));
+        for (unsigned b = 0; b < kBuckets; ++b) {
+            buckets[b] += h.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t percentile(double p) const
+    {
+        if (count == 0) {
+            return 0;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (unsigned b = 0; b < kBuckets; ++b) {
+            seen += buckets[b];
+            if (seen >= rank) {
+                return std::min(bucket_upper_bound(b), max);
+            }
+        }
+        return max;
+    }
+};
+
+/**
+ * @struct Snapshot
+ * @brief Merged view of every metric, taken under the registry lock
+ */
+struct Snapshot {
+    std::vector<std::pair<std::string, std::uint64_t>> counters;
+    std::vector<std::pair<std::string, std::int64_t>> gauges;
+    std::vector<std::pair<std::string, HistogramSnapshot>> histograms;
+};
+
+Snapshot take_snapshot()
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Snapshot snap;
+
+    std::vector<const Shard *> shards(r.live.begin(), r.live.end());
+    shards.push_back(&r.retired);
+
+    for (std::size_t i = 0; i < r.counter_names.size(); ++i) {
+        std::uint64_t total = 0;
+        for (const Shard *s : shards) {
+            total += s->counters[i].load(std::memory_order_relaxed);
+        }
+        snap.counters.emplace_back(r.counter_names[i], total);
+    }
+
+    for (std::size_t i = 0; i < r.gauge_names.size(); ++i) {
+        snap.gauges.emplace_back(r.gauge_names[i], r.gauges[i].load(std::memory_order_relaxed));
+    }
+
+    for (std::size_t i = 0; i < r.histogram_names.size(); ++i) {
+        HistogramSnapshot h;
+        for (const Shard *s : shards) {
+            const HistogramShard *hs = s->histograms[i].load(std::memory_order_acquire);
+            if (hs) {
+                h.merge(*hs);
+            }
+        }
+        snap.histograms.emplace_back(r.histogram_names[i], std::move(h));
+    }
+
+    return snap;
+}
+
+Metrics::Id register_name(const std::string &name, std::deque<std::string> &names,
+                          std::unordered_map<std::string, Metrics::Id> &ids, std::size_t capacity)
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    if (names.size() >= capacity) {
+        return kInvalidId;
+    }
+
+    Metrics::Id id = static_cast<Metrics::Id>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+} // namespace
+
+Metrics::Id Metrics::counter(const std::string &name)
+{
+    Registry &r = registry();
+    return register_name(name, r.counter_names, r.counter_ids, kMaxCounters);
+}
+
+Metrics::Id Metrics::gauge(const std::string &name)
+{
+    Registry &r = registry();
+    return register_name(name, r.gauge_names, r.gauge_ids, kMaxGauges);
+}
+
+Metrics::Id Metrics::histogram(const std::string &name)
+{
+    Registry &r = registry();
+    Id id = register_name(name, r.histogram_names, r.histogram_ids, kMaxHistograms);
+    if (id < kMaxHistograms) {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.histogram_name_ptrs[id].store(r.histogram_names[id].c_str(), std::memory_order_release);
+    }
+    return id;
+}
+
+const char *Metrics::histogram_name(Id id)
+{
+    if (id >= kMaxHistograms) {
+        return "unknown";
+    }
+    const char *name = registry().histogram_name_ptrs[id].load(std::memory_order_acquire);
+    return name ? name : "unknown";
+}
+
+void Metrics::increment(Id id, std::uint64_t delta)
+{
+    if (id >= kMaxCounters) {
+        return;
+    }
+    add_relaxed(local_shard().counters[id], delta);
+}
+
+void Metrics::set(Id id, std::int64_t value)
+{
+    if (id >= kMaxGauges) {
+        return;
+    }
+    registry().gauges[id].store(value, std::memory_order_relaxed);
+}
+
+void Metrics::record_us(Id id, std::uint64_t micros)
+{
+    if (id >= kMaxHistograms) {
+        return;
+    }
+    HistogramShard &h = local_shard().histogram(id);
+    add_relaxed(h.count, 1);
+    add_relaxed(h.sum, micros);
+    max_relaxed(h.max, micros);
+    add_relaxed(h.buckets[bucket_index(micros)], 1);
+}
+
+std::uint64_t Metrics::value(Id id)
+{
+    if (id >= kMaxCounters) {
+        return 0;
+    }
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::uint64_t total = r.retired.counters[id].load(std::memory_order_relaxed);
+    for (const Shard *s : r.live) {
+        total += s->counters[id].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::string Metrics::to_json()
+{
+    Snapshot snap = take_snapshot();
+    std::ostringstream out;
+
+    out << "{\"counters\":{";
+    for (std::size_t i = 0; i < snap.counters.size(); ++i) {
+        out << (i ? "," : "") << Json::quote(snap.counters[i].first) << ":" << snap.counters[i].second;
+    }
+
+    out << "},\"gauges\":{";
+    for (std::size_t i = 0; i < snap.gauges.size(); ++i) {
+        out << (i ? "," : "") << Json::quote(snap.gauges[i].first) << ":" << snap.gauges[i].second;
+    }
+
+    out << "},\"histograms\":{";
+    for (std::size_t i = 0; i < snap.histograms.size(); ++i) {
+        const HistogramSnapshot &h = snap.histograms[i].second;
+        out << (i ? "," : "") << Json::quote(snap.histograms[i].first)
+            << ":{\"count\":" << h.count
+            << ",\"sum_us\":" << h.sum
+            << ",\"mean_us\":" << (h.count ? h.sum / h.count : 0)
+            << ",\"p50_us\":" << h.percentile(0.50)
+            << ",\"p90_us\":" << h.percentile(0.90)
+            << ",\"p99_us\":" << h.percentile(0.99)
+            << ",\"max_us\":" << h.max << "}";
+    }
+    out << "}}";
+
+    return out.str();
+}
+
+std::string Metrics::to_text()
+{
+    Snapshot snap = take_snapshot();
+    std::ostringstream out;
+    char line[160];
+
+    out << "Counters\n";
+    for (const auto &c : snap.counters) {
+        std::snprintf(line, sizeof(line), "  %-32s %12llu\n", c.first.c_str(),
+                      static_cast<unsigned long long>(c.second));
+        out << line;
+    }
+
+    if (!snap.gauges.empty()) {
+        out << "\nGauges\n";
+        for (const auto &g : snap.gauges) {
+            std::snprintf(line, sizeof(line), "  %-32s %12lld\n", g.first.c_str(),
+                          static_cast<long long>(g.second));
+            out << line;
+        }
+    }
+
+    out << "\nLatency (us)\n";
+    std::snprintf(line, sizeof(line), "  %-32s %8s %9s %9s %9s %9s\n",
+                  "operation", "count", "p50", "p90", "p99", "max");
+    out << line;
+    for (const auto &entry : snap.histograms) {
+        const HistogramSnapshot &h = entry.second;
+        std::snprintf(line, sizeof(line), "  %-32s %8llu %9llu %9llu %9llu %9llu\n",
+                      entry.first.c_str(),
+                      static_cast<unsigned long long>(h.count),
+                      static_cast<unsigned long long>(h.percentile(0.50)),
+                      static_cast<unsigned long long>(h.percentile(0.90)),
+                      static_cast<unsigned long long>(h.percentile(0.99)),
+                      static_cast<unsigned long long>(h.max));
+        out << line;
+    }
+
+    return out.str();
+}
+
+bool Metrics::dump_json(const std::string &path)
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << to_json() << "\n";
+    return static_cast<bool>(file);
+}
+
+} // namespace Core
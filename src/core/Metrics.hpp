@@ -0,0 +1,156 @@
+/**
+ * @file Metrics.hpp
+ * @brief Counters, gauges and latency histograms for Ultimate Control
+ *
+ * This file defines the Metrics registry. Backends and tabs record how
+ * often they spawn subprocesses, call D-Bus or rebuild widgets, and how
+ * long each backend operation takes, so slow tabs can be diagnosed with
+ * --stats, a SIGUSR1 dump, or the hidden debug page in the settings window.
+ */
+
+#pragma once
+
+#include "Trace.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Metrics
+ * @brief Process-wide registry of counters, gauges and latency histograms
+ *
+ * Every thread records into its own shard using relaxed atomics, so
+ * recording never takes a lock and never contends with other threads.
+ * Shards are summed when a snapshot is read. Gauges hold a single current
+ * value (last write wins) and are not sharded. Histograms use log-linear
+ * buckets (HDR style): each power of two is split into equal sub-buckets,
+ * giving a bounded relative error at every scale from microseconds to minutes.
+ */
+class Metrics {
+public:
+    using Id = std::uint16_t; ///< Handle of a registered counter, gauge or histogram
+
+    /**
+     * @brief Register (or look up) a counter
+     * @param name Dotted metric name, e.g. "subprocess.spawns"
+     * @return Handle used with increment()
+     *
+     * Registration takes a lock; call it once and keep the handle, e.g. in
+     * a function-local or file-scope static.
+     */
+    static Id counter(const std::string &name);
+
+    /**
+     * @brief Register (or look up) a gauge
+     * @param name Dotted metric name, e.g. "memory.rss_kb"
+     * @return Handle used with set()
+     */
+    static Id gauge(const std::string &name);
+
+    /**
+     * @brief Register (or look up) a latency histogram
+     * @param name Dotted operation name, e.g. "volume.refresh"
+     * @return Handle used with record_us() and ScopedTimer
+     */
+    static Id histogram(const std::string &name);
+
+    /**
+     * @brief Name a histogram was registered with
+     * @param id Histogram handle
+     * @return The name, valid for the lifetime of the process
+     */
+    static const char *histogram_name(Id id);
+
+    /**
+     * @brief Add to a counter
+     * @param id Counter handle from counter()
+     * @param delta Amount to add
+     */
+    static void increment(Id id, std::uint64_t delta = 1);
+
+    /**
+     * @brief Set a gauge to its current value
+     * @param id Gauge handle from gauge()
+     * @param value The value
+     */
+    static void set(Id id, std::int64_t value);
+
+    /**
+     * @brief Record one latency sample
+     * @param id Histogram handle from histogram()
+     * @param micros Duration in microseconds
+     */
+    static void record_us(Id id, std::uint64_t micros);
+
+    /**
+     * @brief Current value of a counter summed across all threads
+     * @param id Counter handle
+     * @return The counter value
+     */
+    static std::uint64_t value(Id id);
+
+    /**
+     * @brief Snapshot every metric as a JSON object
+     * @return JSON text with "counters", "gauges" and "histograms" members
+     */
+    static std::string to_json();
+
+    /**
+     * @brief Snapshot every metric as a human-readable table
+     * @return Multi-line text suitable for a terminal or a label
+     */
+    static std::string to_text();
+
+    /**
+     * @brief Write the JSON snapshot to a file
+     * @param path Destination file
+     * @return true on success
+     */
+    static bool dump_json(const std::string &path);
+
+    /**
+     * @class ScopedTimer
+     * @brief Records the lifetime of a scope into a histogram
+     *
+     * When tracing is enabled the scope is also recorded as a trace span
+     * named after the histogram, so every timed operation shows up in the
+     * trace without separate instrumentation.
+     */
+    class ScopedTimer {
+    public:
+        /**
+         * @brief Start timing
+         * @param id Histogram handle
+         */
+        explicit ScopedTimer(Id id)
+            : id_(id), span_(histogram_name(id), "op"), start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        /**
+         * @brief Stop timing and record the sample
+         */
+        ~ScopedTimer()
+        {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            record_us(id_, static_cast<std::uint64_t>(
+                               std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    private:
+        Id id_;                                       ///< Histogram to record into
+        Trace::Span span_;                            ///< Matching trace span
+        std::chrono::steady_clock::time_point start_; ///< Start of the scope
+    };
+};
+
+} // namespace Core
@@ -0,0 +1,125 @@
+/**
+ * @file Modules.cpp
+ * @brief Implementation of on-demand tab module loading
+ */
+
+#include "Modules.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "TabModule.hpp"
+#include "Trace.hpp"
+#include <cstdlib>   // for std::getenv
+#include <map>       // for std::map
+#include <stdexcept> // for std::runtime_error
+#include <vector>    // for std::vector
+#include <dlfcn.h>   // for dlopen, dlsym
+#include <limits.h>  // for PATH_MAX
+#include <unistd.h>  // for readlink
+
+#ifndef UC_MODULE_DIR
+#define UC_MODULE_DIR "/usr/local/lib/ultimate-control"
+#endif
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id load_histogram = Metrics::histogram("module.load");
+
+/**
+ * @brief Directory holding the running executable
+ */
+std::string executable_dir()
+{
+    char path[PATH_MAX];
+    ssize_t length = ::readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (length <= 0) {
+        return "";
+    }
+    std::string exe(path, static_cast<std::size_t>(length));
+    return exe.substr(0, exe.rfind('/'));
+}
+
+/**
+ * @brief Directories searched for modules, in order
+ */
+std::vector<std::string> search_path()
+{
+    std::vector<std::string> dirs;
+    const char *env = std::getenv("UC_MODULE_DIR");
+    if (env != nullptr && *env != '\0') {
+        dirs.emplace_back(env);
+    }
+    std::string exe_dir = executable_dir();
+    if (!exe_dir.empty()) {
+        dirs.push_back(exe_dir);
+    }
+    dirs.emplace_back(UC_MODULE_DIR);
+    return dirs;
+}
+
+/**
+ * @brief Open a tab's module and check its descriptor
+ */
+const UcTabModule *load(const std::string &id)
+{
+    Trace::Span span("Modules::load", "module", id);
+    Metrics::ScopedTimer timer(load_histogram);
+
+    const std::string file = "libuc-" + id + ".so";
+    std::string errors;
+    for (const auto &dir : search_path()) {
+        const std::string path = dir + "/" + file;
+        // RTLD_NOW: fail here on a missing symbol, not in the middle of a click
+        void *handle = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == nullptr) {
+            errors += std::string("\n  ") + ::dlerror();
+            continue;
+        }
+
+        auto *module = static_cast<const UcTabModule *>(::dlsym(handle, "uc_tab_module"));
+        if (module == nullptr || module->abi != UC_TAB_MODULE_ABI || id != module->id) {
+            ::dlclose(handle);
+            throw std::runtime_error(path + " is not a compatible module for tab " + id);
+        }
+        UC_LOG_DEBUG(App, "Loaded module " << path);
+        return module;
+    }
+    throw std::runtime_error("Module " + file + " not found:" + errors);
+}
+
+/**
+ * @brief Loaded modules by tab ID
+ */
+std::map<std::string, const UcTabModule *> &loaded()
+{
+    static std::map<std::string, const UcTabModule *> modules;
+    return modules;
+}
+
+const UcTabModule &module_for(const std::string &id)
+{
+    auto &modules = loaded();
+    auto it = modules.find(id);
+    if (it == modules.end()) {
+        it = modules.emplace(id, load(id)).first;
+    }
+    return *it->second;
+}
+
+} // namespace
+
+Gtk::Widget *Modules::create(const std::string &id)
+{
+    return module_for(id).create();
+}
+
+void Modules::refresh(const std::string &id, Gtk::Widget *tab)
+{
+    auto it = loaded().find(id);
+    if (it != loaded().end()) {
+        it->second->refresh(tab);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,52 @@
+/**
+ * @file Modules.hpp
+ * @brief On-demand loading of tab modules for Ultimate Control
+ *
+ * This file defines the Modules class which finds and dlopens the shared
+ * object of a tab the first time that tab is built, so tabs that are
+ * disabled or never opened are never mapped.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace Gtk {
+class Widget;
+}
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Modules
+ * @brief Registry of loaded tab modules
+ *
+ * The module for tab "id" is libuc-<id>.so. It is looked for in
+ * $UC_MODULE_DIR, then next to the executable (the build tree), then in
+ * the install directory. Modules stay loaded once opened: evicted tabs
+ * come back quickly, and no code is unmapped while a signal may still
+ * point into it. All methods must be called on the main thread.
+ */
+class Modules {
+public:
+    /**
+     * @brief Build a tab, loading its module first if needed
+     * @param id Tab ID
+     * @return The managed tab widget
+     * @throws std::runtime_error if the module is missing or incompatible
+     */
+    static Gtk::Widget *create(const std::string &id);
+
+    /**
+     * @brief Ask a built tab to re-read its state
+     * @param id Tab ID
+     * @param tab Widget returned by create() for that ID
+     */
+    static void refresh(const std::string &id, Gtk::Widget *tab);
+};
+
+} // namespace Core
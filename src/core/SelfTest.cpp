@@ -0,0 +1,50 @@
+/**
+ * @file SelfTest.cpp
+ * @brief Implementation of the timed self-checks
+ */
+
+#include "SelfTest.hpp"
+#include "Metrics.hpp"
+#include "StallDetector.hpp"
+#include "Wakeups.hpp"
+#include <chrono>   // for std::chrono::seconds
+#include <iostream> // for std::cerr
+#include <thread>   // for std::thread, std::this_thread::sleep_for
+
+namespace Core {
+
+void SelfTest::check_stalls(unsigned int seconds, Finish finish)
+{
+    std::thread([seconds, finish]() {
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        Wakeups::idle_once([finish]() {
+            StallDetector::stop();
+            const std::uint64_t stalls = StallDetector::severe_stalls();
+            std::cerr << "check-stalls: " << stalls << " main-loop stalls of 100 ms or more" << std::endl;
+            finish(stalls > 0 ? 1 : 0);
+        });
+    }).detach();
+}
+
+void SelfTest::expect_idle(unsigned int seconds, Finish finish)
+{
+    std::thread([seconds, finish]() {
+        const Metrics::Id timeouts = Metrics::counter("wakeups.timeout");
+        const Metrics::Id timer_polls = Metrics::counter("wakeups.poll.timer");
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const std::uint64_t timeouts_before = Metrics::value(timeouts);
+        const std::uint64_t timer_polls_before = Metrics::value(timer_polls);
+        std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        const std::uint64_t timeout_wakeups = Metrics::value(timeouts) - timeouts_before;
+        const std::uint64_t timer_wakeups = Metrics::value(timer_polls) - timer_polls_before;
+
+        Wakeups::idle_once([finish, seconds, timeout_wakeups, timer_wakeups]() {
+            std::cerr << "self-test-idle: " << timeout_wakeups << " timeouts and " << timer_wakeups
+                      << " timer wakeups in " << seconds << " s hidden" << std::endl;
+            finish(timeout_wakeups > 0 || timer_wakeups > 0 ? 1 : 0);
+        });
+    }).detach();
+}
+
+} // namespace Core
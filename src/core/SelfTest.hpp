@@ -0,0 +1,57 @@
+/**
+ * @file SelfTest.hpp
+ * @brief Timed self-checks run by CTest against the real window
+ *
+ * This file defines the SelfTest class which runs the application for a
+ * fixed time and turns a diagnostic (the stall detector, the wakeup audit)
+ * into an exit status, so CI can fail on regressions.
+ */
+
+#pragma once
+
+#include <functional>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class SelfTest
+ * @brief Pass/fail checks over a running main loop
+ *
+ * Each check waits on a plain thread rather than a main-loop timer, so the
+ * check itself adds no timer wakeups, and reports through @p finish on the
+ * main thread with the process exit status: 0 if the check passed.
+ */
+class SelfTest {
+public:
+    /**
+     * @brief Exit status callback, called once on the main thread
+     */
+    using Finish = std::function<void(int status)>;
+
+    /**
+     * @brief Fail if the main loop stalls for 100 ms or more
+     * @param seconds How long to watch
+     * @param finish Receives 1 if StallDetector saw a severe stall, else 0
+     *
+     * StallDetector must already be running; it is stopped before @p finish
+     * runs.
+     */
+    static void check_stalls(unsigned int seconds, Finish finish);
+
+    /**
+     * @brief Fail if a timer wakes the main loop while nothing is visible
+     * @param seconds How long to stay idle
+     * @param finish Receives 1 if "wakeups.timeout" or "wakeups.poll.timer" moved, else 0
+     *
+     * Call with the window hidden and Wakeups::enable_audit() active.
+     * Counting starts after a one second grace period for work that was
+     * already queued when the window was hidden.
+     */
+    static void expect_idle(unsigned int seconds, Finish finish);
+};
+
+} // namespace Core
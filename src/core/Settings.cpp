@@ -11,34 +11,10 @@
 #include <gtkmm/box.h>       // for Gtk::Box
 #include <gtkmm/buttonbox.h> // for Gtk::ButtonBox
 #include <gtkmm/label.h>     // for Gtk::Label
-#include <fstream>           // for std::ifstream, std::ofstream
-#include <iostream>          // for std::cerr
+#include "Config.hpp"
 
 namespace Core {
 
-/**
- * @brief Get a setting value from the configuration file
- * @param key The setting key to retrieve
- * @param default_value The default value to return if the setting is not found
- * @return The setting value or the default value if not found
- */
-std::string get_setting(const std::string& key, const std::string& default_value) {
-    // Try to open the configuration file
-    std::string config_path = "/home/felipe/.config/ultimate-control/general.conf";
-    std::ifstream infile(config_path);
-    if (!infile.is_open()) return default_value;  // Return default if file doesn't exist
-
-    // Read key-value pairs from the file
-    std::string k, v;
-    while (infile >> k >> v) {
-        if (k == key) {
-            return v;  // Return the value if the key is found
-        }
-    }
-
-    return default_value;  // Return default if key not found
-}
-
 /**
  * @brief Constructor for the settings window
  * @param parent Parent window for the dialog
@@ -110,25 +86,15 @@ SettingsWindow::~SettingsWindow() {
  * Reads settings from the configuration file and updates the UI.
  */
 void SettingsWindow::load_settings() {
-    // Try to open the configuration file
-    std::string config_path = "/home/felipe/.config/ultimate-control/general.conf";
-    std::ifstream infile(config_path);
-    if (!infile.is_open()) return;  // Return if file doesn't exist or can't be opened
-
-    // Read key-value pairs from the file
-    std::string key, value;
-    while (infile >> key >> value) {
-        settings_[key] = value;  // Store each setting in the map
-    }
-
-    // Update UI components with loaded settings
-    autostart_check_.set_active(settings_["autostart"] == "1");
-    notifications_check_.set_active(settings_["notifications"] == "1");
-    floating_check_.set_active(settings_["floating"] == "1");
+    // Update UI components with the stored settings
+    autostart_check_.set_active(Config::get_bool("general.autostart", false));
+    notifications_check_.set_active(Config::get_bool("general.notifications", false));
+    floating_check_.set_active(Config::get_bool("general.floating", false));
 
     // Set the language dropdown if a language is specified
-    if (!settings_["language"].empty()) {
-        language_combo_.set_active_text(settings_["language"]);
+    const std::string language = Config::get_string("general.language");
+    if (!language.empty()) {
+        language_combo_.set_active_text(language);
     }
 }
 
@@ -138,23 +104,11 @@ void SettingsWindow::load_settings() {
  * Writes the current settings to the configuration file.
  */
 void SettingsWindow::save_settings() {
-    // Update settings map from UI components
-    settings_["autostart"] = autostart_check_.get_active() ? "1" : "0";
-    settings_["notifications"] = notifications_check_.get_active() ? "1" : "0";
-    settings_["floating"] = floating_check_.get_active() ? "1" : "0";
-    settings_["language"] = language_combo_.get_active_text();
-
-    // Try to open the configuration file for writing
-    std::ofstream outfile("/home/felipe/.config/ultimate-control/general.conf");
-    if (!outfile.is_open()) {
-        std::cerr << "Failed to save settings\n";
-        return;  // Return if file can't be opened for writing
-    }
-
-    // Write each setting as a key-value pair
-    for (const auto& pair : settings_) {
-        outfile << pair.first << " " << pair.second << "\n";
-    }
+    Config::set("general.autostart", autostart_check_.get_active());
+    Config::set("general.notifications", notifications_check_.get_active());
+    Config::set("general.floating", floating_check_.get_active());
+    Config::set("general.language", std::string(language_combo_.get_active_text()));
+    Config::save();
 }
 
 } // namespace Core
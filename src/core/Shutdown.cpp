@@ -0,0 +1,131 @@
+/**
+ * @file Shutdown.cpp
+ * @brief Implementation of the bounded shutdown
+ */
+
+#include "Shutdown.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <atomic>             // for std::atomic
+#include <chrono>             // for std::chrono::milliseconds
+#include <condition_variable> // for std::condition_variable
+#include <cstdlib>            // for std::quick_exit
+#include <map>                // for std::map
+#include <memory>             // for std::shared_ptr
+#include <mutex>              // for std::mutex
+#include <thread>             // for std::thread
+#include <vector>             // for std::vector
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id flush_histogram = Metrics::histogram("shutdown.flush");
+const Metrics::Id overrun_counter = Metrics::counter("shutdown.deadline_missed");
+
+/**
+ * @struct State
+ * @brief Registered hooks and the shutdown flags
+ */
+struct State {
+    std::mutex mutex;
+    unsigned int next_id = 0;
+    std::map<unsigned int, std::function<void()>> hooks;
+    bool flushed = false;
+    std::atomic<bool> requested{false};
+};
+
+State &state()
+{
+    // Leaked: the flush thread may outlive static destruction
+    static State &instance = *new State;
+    return instance;
+}
+
+/**
+ * @struct Latch
+ * @brief Completion flag shared with the flush thread
+ */
+struct Latch {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+};
+
+} // namespace
+
+unsigned int Shutdown::add_flush(std::function<void()> hook)
+{
+    State &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const unsigned int id = s.next_id++;
+    s.hooks.emplace(id, std::move(hook));
+    return id;
+}
+
+void Shutdown::remove_flush(unsigned int id)
+{
+    State &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.hooks.erase(id);
+}
+
+bool Shutdown::requested()
+{
+    return state().requested.load(std::memory_order_relaxed);
+}
+
+void Shutdown::flush()
+{
+    State &s = state();
+    std::vector<std::function<void()>> hooks;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.flushed) {
+            return;
+        }
+        s.flushed = true;
+        for (auto &[id, hook] : s.hooks) {
+            hooks.push_back(std::move(hook));
+        }
+        s.hooks.clear();
+    }
+
+    Trace::Span span("Shutdown::flush", "shutdown");
+    Metrics::ScopedTimer timer(flush_histogram);
+    for (auto &hook : hooks) {
+        try {
+            hook();
+        } catch (const std::exception &e) {
+            UC_LOG_WARN(App, "Shutdown flush failed: " << e.what());
+        }
+    }
+}
+
+void Shutdown::exit(int code)
+{
+    State &s = state();
+    s.requested = true;
+    UC_LOG_INFO(App, "Shutting down");
+
+    auto latch = std::make_shared<Latch>();
+    std::thread([latch]() {
+        Trace::set_thread_name("shutdown");
+        flush();
+        std::lock_guard<std::mutex> lock(latch->mutex);
+        latch->done = true;
+        latch->cv.notify_one();
+    }).detach();
+
+    {
+        std::unique_lock<std::mutex> lock(latch->mutex);
+        if (!latch->cv.wait_for(lock, std::chrono::milliseconds(kDeadlineMs), [&latch]() { return latch->done; })) {
+            Metrics::increment(overrun_counter);
+            UC_LOG_WARN(App, "Flushing state took over " << kDeadlineMs << " ms, exiting anyway");
+        }
+    }
+    std::quick_exit(code);
+}
+
+} // namespace Core
@@ -0,0 +1,71 @@
+/**
+ * @file Shutdown.hpp
+ * @brief Bounded application shutdown for Ultimate Control
+ *
+ * This file defines the Shutdown class which ends the process quickly
+ * without losing state: settings and caches register flush hooks, and
+ * exit() runs them against a hard deadline before leaving.
+ */
+
+#pragma once
+
+#include <functional>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Shutdown
+ * @brief Flush hooks, a cancellation flag and a deadline-bound exit
+ *
+ * Destructors are not run at exit: detached worker threads may still use
+ * the managers. Whatever must reach the disk registers a flush hook
+ * instead. Hooks may be added and removed from any thread.
+ */
+class Shutdown {
+public:
+    /// Longest time exit() waits for the flush hooks
+    static constexpr unsigned int kDeadlineMs = 150;
+
+    /**
+     * @brief Register work that saves state
+     * @param hook Called once at shutdown, on a helper thread
+     * @return Handle for remove_flush()
+     */
+    static unsigned int add_flush(std::function<void()> hook);
+
+    /**
+     * @brief Unregister a flush hook, e.g. from the owner's destructor
+     * @param id Handle returned by add_flush()
+     */
+    static void remove_flush(unsigned int id);
+
+    /**
+     * @brief Whether shutdown has begun
+     * @return True once exit() was called; background work should stop early
+     */
+    static bool requested();
+
+    /**
+     * @brief Run every flush hook on the calling thread
+     *
+     * Only the first call does anything. Registered with std::atexit so a
+     * normal return from main flushes too.
+     */
+    static void flush();
+
+    /**
+     * @brief Flush with a deadline, then end the process
+     * @param code Exit status
+     *
+     * Sets requested(), runs flush() on a helper thread and waits for it at
+     * most kDeadlineMs before calling std::quick_exit(). Hide windows
+     * before calling this so the exit looks instant.
+     */
+    [[noreturn]] static void exit(int code);
+};
+
+} // namespace Core
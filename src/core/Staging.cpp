@@ -0,0 +1,280 @@
+/**
+ * @file Staging.cpp
+ * @brief Implementation of phased tab construction
+ */
+
+#include "Staging.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Shutdown.hpp"
+#include "Trace.hpp"
+#include "Wakeups.hpp"
+#include <condition_variable> // for std::condition_variable
+#include <deque>              // for std::deque
+#include <exception>          // for std::exception
+#include <map>                // for std::map
+#include <mutex>              // for std::mutex
+#include <set>                // for std::set
+#include <system_error>       // for std::system_error
+#include <thread>             // for std::thread
+#include <glibmm/dispatcher.h>
+#include <gtkmm/widget.h>
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id hydrate_histogram = Metrics::histogram("tab.hydrate");
+const Metrics::Id step_counter = Metrics::counter("staging.steps");
+const Metrics::Id frame_counter = Metrics::counter("staging.frames");
+
+/**
+ * @struct Job
+ * @brief One query travelling to a hydration thread and back
+ */
+struct Job {
+    std::uint64_t id = 0;
+    const void *owner = nullptr; ///< Only compared, never dereferenced
+    std::function<void()> query;
+    std::int64_t queued_us = 0;
+    bool failed = false;
+};
+
+/**
+ * @struct State
+ * @brief Hydration queue and step queue
+ *
+ * The queues of jobs and the thread bookkeeping are shared with the
+ * hydration threads; everything else is main-thread only, including the
+ * apply slots, so trackable slots are never copied or destroyed off the
+ * main thread.
+ */
+struct State {
+    std::mutex mutex;                             ///< Guards the fields up to dispatcher
+    std::condition_variable cv;                   ///< Wakes the hydration threads
+    std::deque<Job> pending;                      ///< Queries not yet run
+    std::deque<Job> finished;                     ///< Queries waiting for their apply
+    std::set<const void *> busy;                  ///< Owners with a query running
+    unsigned threads = 0;                         ///< Hydration threads started
+    unsigned idle = 0;                            ///< Hydration threads waiting for a job
+    std::unique_ptr<Glib::Dispatcher> dispatcher; ///< Wakes the main thread; created with the first thread
+    std::map<std::uint64_t, sigc::slot<void>> applies;
+    std::uint64_t next_id = 1;
+
+    std::deque<sigc::slot<void>> steps;
+    Gtk::Widget *window = nullptr; ///< Frame clock source, cleared when destroyed
+    guint tick_id = 0;             ///< Active tick callback, 0 if none
+    bool running = false;          ///< Whether steps are being run right now
+};
+
+State &state()
+{
+    // Leaked: a detached hydration thread may still be in a query at exit
+    static State &instance = *new State;
+    return instance;
+}
+
+/**
+ * @brief Find the oldest pending job whose owner has nothing running
+ * @return The job's position, or pending.end() if there is none
+ *
+ * Must be called with the mutex held.
+ */
+std::deque<Job>::iterator next_runnable(State &s)
+{
+    for (auto it = s.pending.begin(); it != s.pending.end(); ++it) {
+        if (s.busy.count(it->owner) == 0) {
+            return it;
+        }
+    }
+    return s.pending.end();
+}
+
+void hydration_loop()
+{
+    Trace::set_thread_name("hydrate");
+    State &s = state();
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(s.mutex);
+            ++s.idle;
+            s.cv.wait(lock, [&s]() { return next_runnable(s) != s.pending.end(); });
+            --s.idle;
+            auto it = next_runnable(s);
+            job = std::move(*it);
+            s.pending.erase(it);
+            s.busy.insert(job.owner);
+        }
+        if (Shutdown::requested()) {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.busy.erase(job.owner);
+            continue; // Nobody will see the result
+        }
+
+        try {
+            Trace::Span span("hydrate", "tab");
+            job.query();
+        } catch (const std::exception &e) {
+            UC_LOG_WARN(App, "Hydration query failed: " << e.what());
+            job.failed = true;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.busy.erase(job.owner);
+            s.finished.push_back(std::move(job));
+        }
+        // The owner's next query, if any, may now run on any thread
+        s.cv.notify_all();
+        s.dispatcher->emit();
+    }
+}
+
+/**
+ * @brief Apply finished queries on the main thread
+ */
+void on_finished()
+{
+    State &s = state();
+    std::deque<Job> finished;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        finished.swap(s.finished);
+    }
+
+    for (auto &job : finished) {
+        // Destroy the query's captures here rather than on the worker
+        job.query = nullptr;
+
+        auto it = s.applies.find(job.id);
+        if (it == s.applies.end()) {
+            continue;
+        }
+        sigc::slot<void> apply = std::move(it->second);
+        s.applies.erase(it);
+
+        Metrics::record_us(hydrate_histogram, static_cast<std::uint64_t>(Trace::now_us() - job.queued_us));
+        if (!job.failed) {
+            apply(); // Empty if the owner was destroyed meanwhile
+        }
+    }
+}
+
+/**
+ * @brief Run queued steps until the queue is empty or the budget is spent
+ * @param budget_us Time allowed, or a negative value for no limit
+ *
+ * At least one step runs per call so progress is always made.
+ */
+void run_steps(std::int64_t budget_us)
+{
+    State &s = state();
+    const std::int64_t start = Trace::now_us();
+    s.running = true;
+    do {
+        sigc::slot<void> work = std::move(s.steps.front());
+        s.steps.pop_front();
+        Metrics::increment(step_counter);
+        try {
+            work();
+        } catch (const std::exception &e) {
+            UC_LOG_ERROR(App, "Build step failed: " << e.what());
+        }
+    } while (!s.steps.empty() && (budget_us < 0 || Trace::now_us() - start < budget_us));
+    s.running = false;
+}
+
+gboolean on_tick(GtkWidget * /*widget*/, GdkFrameClock * /*clock*/, gpointer /*user_data*/)
+{
+    State &s = state();
+    Metrics::increment(frame_counter);
+    run_steps(Staging::kFrameBudgetUs);
+    if (s.steps.empty()) {
+        s.tick_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void *on_window_destroyed(void * /*data*/)
+{
+    State &s = state();
+    s.window = nullptr;
+    s.tick_id = 0; // Removed by GTK with the widget
+    return nullptr;
+}
+
+/**
+ * @brief Make sure queued steps will run
+ */
+void schedule()
+{
+    State &s = state();
+    if (s.steps.empty() || s.tick_id != 0 || s.running) {
+        return; // Nothing to do, or a running loop/tick picks the new step up
+    }
+
+    if (s.window == nullptr || !s.window->get_mapped()) {
+        // No frames to protect
+        run_steps(-1);
+        return;
+    }
+    s.tick_id = gtk_widget_add_tick_callback(GTK_WIDGET(s.window->gobj()), &on_tick, nullptr, nullptr);
+}
+
+} // namespace
+
+void Staging::attach(Gtk::Widget &window)
+{
+    State &s = state();
+    s.window = &window;
+    window.add_destroy_notify_callback(nullptr, &on_window_destroyed);
+}
+
+void Staging::step(const sigc::trackable &owner, std::function<void()> work)
+{
+    State &s = state();
+    s.steps.push_back(sigc::track_obj(work, owner));
+    schedule();
+}
+
+void Staging::post(const void *owner, std::function<void()> query, const sigc::slot<void> &apply)
+{
+    State &s = state();
+    if (!s.dispatcher) {
+        s.dispatcher = std::make_unique<Glib::Dispatcher>();
+        s.dispatcher->connect(&on_finished);
+        Wakeups::track(*s.dispatcher);
+    }
+
+    Job job;
+    job.id = s.next_id++;
+    job.owner = owner;
+    job.query = std::move(query);
+    job.queued_us = Trace::now_us();
+    s.applies.emplace(job.id, apply);
+    bool spawn = false;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.pending.push_back(std::move(job));
+        // Grow the pool only when every thread is busy with another query
+        if (s.idle == 0 && s.threads < kMaxHydrationThreads) {
+            ++s.threads;
+            spawn = true;
+        }
+    }
+    if (spawn) {
+        try {
+            std::thread(&hydration_loop).detach();
+        } catch (const std::system_error &e) {
+            // The threads already running pick the job up
+            UC_LOG_ERROR(App, "Cannot start a hydration thread: " << e.what());
+            std::lock_guard<std::mutex> lock(s.mutex);
+            --s.threads;
+        }
+    }
+    s.cv.notify_all();
+}
+
+} // namespace Core
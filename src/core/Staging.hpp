@@ -0,0 +1,99 @@
+/**
+ * @file Staging.hpp
+ * @brief Phased tab construction for Ultimate Control
+ *
+ * This file defines the Staging class which moves backend queries off the
+ * main thread and spreads widget creation over frames, so that building a
+ * tab never blocks a frame for longer than a fixed budget.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <sigc++/sigc++.h>
+
+namespace Gtk {
+class Widget;
+}
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Staging
+ * @brief Skeleton, hydration and row phases of building a tab
+ *
+ * A tab constructor only creates its widget skeleton. Backend queries are
+ * run on the hydration threads with hydrate() and their results applied on
+ * the main thread. Rows for those results are added with step(): queued
+ * steps run from the frame clock of the attached window, as many per frame
+ * as fit in kFrameBudgetUs, so a long list fills in over several frames
+ * instead of stalling one. While the window is not on screen there are no
+ * frames to protect and steps run at once.
+ *
+ * Work is tied to an owner (any widget): if the owner is destroyed first,
+ * its pending applies and steps are dropped. All methods must be called on
+ * the main thread.
+ */
+class Staging {
+public:
+    /// Main-thread time per frame given to queued steps, in microseconds
+    static constexpr std::int64_t kFrameBudgetUs = 4000;
+
+    /// Most hydration threads running at once
+    static constexpr unsigned kMaxHydrationThreads = 4;
+
+    /**
+     * @brief Use a window's frame clock to pace steps
+     * @param window The main window
+     */
+    static void attach(Gtk::Widget &window);
+
+    /**
+     * @brief Run a query on a hydration thread and apply its result
+     * @param owner Object whose destruction cancels the apply
+     * @param query Callable run off the main thread; must not touch widgets
+     * @param apply Callable receiving the query's result on the main thread
+     *
+     * Queries of different owners run in parallel, on up to
+     * kMaxHydrationThreads threads, so one slow backend does not hold back
+     * the other tabs. Queries of the same owner run one at a time in
+     * submission order, so an older result never replaces a newer one. If
+     * the query throws, the error is logged and apply is not called.
+     */
+    template <typename Query, typename Apply>
+    static void hydrate(const sigc::trackable &owner, Query query, Apply apply);
+
+    /**
+     * @brief Queue a main-thread build step paced by the frame clock
+     * @param owner Object whose destruction cancels the step
+     * @param work The step; may queue further steps, which run after it
+     */
+    static void step(const sigc::trackable &owner, std::function<void()> work);
+
+private:
+    /**
+     * @brief Queue type-erased work for the hydration threads
+     * @param owner Queries with the same owner are not run concurrently
+     * @param query Run on a hydration thread; destroyed on the main thread
+     * @param apply Run on the main thread once query returned
+     */
+    static void post(const void *owner, std::function<void()> query, const sigc::slot<void> &apply);
+};
+
+template <typename Query, typename Apply>
+void Staging::hydrate(const sigc::trackable &owner, Query query, Apply apply)
+{
+    using Result = std::decay_t<std::invoke_result_t<const Query &>>;
+    auto result = std::make_shared<Result>();
+    post(&owner, [query, result]() { *result = query(); },
+         sigc::track_obj([apply, result]() { apply(*result); }, owner));
+}
+
+} // namespace Core
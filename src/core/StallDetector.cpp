@@ -0,0 +1,327 @@
+/**
+ * @file StallDetector.cpp
+ * @brief Implementation of the main-loop stall detector
+ *
+ * This file implements the StallDetector class: the marker GSource, the
+ * watchdog thread, and backtrace capture of the main thread.
+ */
+
+#include "StallDetector.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <atomic>             // for std::atomic
+#include <cerrno>             // for errno
+#include <chrono>             // for std::chrono::steady_clock
+#include <condition_variable> // for std::condition_variable
+#include <csignal>            // for sigaction
+#include <cstdlib>            // for std::free
+#include <cstring>            // for std::strchr
+#include <mutex>              // for std::mutex
+#include <sstream>            // for std::ostringstream
+#include <string>             // for std::string
+#include <thread>             // for std::thread
+#include <cxxabi.h>           // for abi::__cxa_demangle
+#include <execinfo.h>         // for backtrace, backtrace_symbols
+#include <glib.h>             // for GSource
+#include <pthread.h>          // for pthread_kill
+
+namespace Core {
+
+namespace {
+
+constexpr std::int64_t kThresholdsUs[] = {16000, 50000, 100000}; ///< Reporting levels
+constexpr auto kPollInterval = std::chrono::milliseconds(5);      ///< Watchdog sampling period
+constexpr int kMaxFrames = 48;                                    ///< Backtrace depth
+
+const Metrics::Id stall_histogram = Metrics::histogram("mainloop.stall");
+const Metrics::Id stall_counters[] = {
+    Metrics::counter("mainloop.stalls.16ms"),
+    Metrics::counter("mainloop.stalls.50ms"),
+    Metrics::counter("mainloop.stalls.100ms"),
+};
+
+/**
+ * @struct State
+ * @brief Shared state between the main thread, the watchdog and the signal handler
+ */
+struct State {
+    std::atomic<std::int64_t> busy_since_us{0};  // 0 while the loop is polling
+    std::atomic<std::uint64_t> iteration{0};     // Bumped at the end of every iteration
+    std::atomic<bool> running{false};
+
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::thread watchdog;
+    pthread_t main_thread{};
+    GSource *source = nullptr;
+
+    std::mutex capture_mutex;
+    std::uint64_t capture_iteration = 0;         // Iteration the capture belongs to
+    std::string capture;                         // Span name or symbolised backtrace
+
+    // Written by the signal handler on the main thread
+    void *frames[kMaxFrames];
+    std::atomic<int> frame_count{0};
+    std::atomic<bool> frames_ready{false};
+};
+
+State &state()
+{
+    // Intentionally leaked: the watchdog may still be running at exit
+    static State *instance = new State();
+    return *instance;
+}
+
+int capture_signal()
+{
+    return SIGRTMIN + 4;
+}
+
+std::int64_t now_us()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Signal handler run on the main thread to record its stack
+ *
+ * Only async-signal-safe work happens here; symbolisation is done later
+ * on the watchdog thread.
+ */
+void on_capture_signal(int)
+{
+    int saved_errno = errno;
+    State &s = state();
+    s.frame_count.store(backtrace(s.frames, kMaxFrames), std::memory_order_relaxed);
+    s.frames_ready.store(true, std::memory_order_release);
+    errno = saved_errno;
+}
+
+/**
+ * @brief Demangle one line of backtrace_symbols() output
+ *
+ * Lines look like "binary(_ZN3Foo3barEv+0x1c) [0x...]".
+ */
+std::string demangle_frame(const char *line)
+{
+    std::string text(line);
+    std::size_t open = text.find('(');
+    std::size_t plus = text.find('+', open);
+    if (open == std::string::npos || plus == std::string::npos || plus == open + 1) {
+        return text;
+    }
+
+    std::string mangled = text.substr(open + 1, plus - open - 1);
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || !demangled) {
+        return text;
+    }
+    std::string result = demangled;
+    std::free(demangled);
+    return result + text.substr(plus);
+}
+
+/**
+ * @brief Capture what the main thread is doing right now
+ * @return The innermost trace span, or a symbolised backtrace
+ */
+std::string capture_main_thread(State &s)
+{
+    if (Trace::enabled()) {
+        const char *span = Trace::main_thread_span();
+        return std::string("in span: ") + (span ? span : "(no open span)");
+    }
+
+    s.frames_ready.store(false, std::memory_order_relaxed);
+    if (pthread_kill(s.main_thread, capture_signal()) != 0) {
+        return "(backtrace unavailable)";
+    }
+
+    // Give the main thread a moment to run the handler
+    for (int i = 0; i < 20 && !s.frames_ready.load(std::memory_order_acquire); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!s.frames_ready.load(std::memory_order_acquire)) {
+        return "(main thread did not respond to backtrace request)";
+    }
+
+    int count = s.frame_count.load(std::memory_order_relaxed);
+    char **symbols = backtrace_symbols(s.frames, count);
+    if (!symbols) {
+        return "(backtrace_symbols failed)";
+    }
+
+    std::ostringstream out;
+    // Skip the handler and the signal trampoline
+    for (int i = 2; i < count; ++i) {
+        out << "\n    #" << (i - 2) << " " << demangle_frame(symbols[i]);
+    }
+    std::free(symbols);
+    return out.str();
+}
+
+/**
+ * @brief Body of the watchdog thread
+ */
+void watchdog_loop(State &s)
+{
+    std::uint64_t reported_iteration = 0;
+    int reported_level = -1;
+
+    std::unique_lock<std::mutex> lock(s.wake_mutex);
+    while (s.running.load(std::memory_order_acquire)) {
+        s.wake.wait_for(lock, kPollInterval);
+
+        std::int64_t since = s.busy_since_us.load(std::memory_order_acquire);
+        if (since == 0) {
+            continue;
+        }
+
+        std::uint64_t iteration = s.iteration.load(std::memory_order_acquire);
+        if (iteration != reported_iteration) {
+            reported_iteration = iteration;
+            reported_level = -1;
+        }
+
+        std::int64_t elapsed = now_us() - since;
+        int level = -1;
+        for (int i = 0; i < 3; ++i) {
+            if (elapsed >= kThresholdsUs[i]) {
+                level = i;
+            }
+        }
+        if (level <= reported_level) {
+            continue;
+        }
+        reported_level = level;
+
+        std::string capture = capture_main_thread(s);
+        std::lock_guard<std::mutex> capture_lock(s.capture_mutex);
+        s.capture_iteration = iteration;
+        s.capture = std::move(capture);
+    }
+}
+
+/**
+ * @brief Called before the main loop polls: the iteration is over
+ */
+gboolean marker_prepare(GSource *, gint *timeout)
+{
+    *timeout = -1;
+    State &s = state();
+
+    std::int64_t since = s.busy_since_us.exchange(0, std::memory_order_acq_rel);
+    std::uint64_t iteration = s.iteration.fetch_add(1, std::memory_order_acq_rel);
+    if (since == 0) {
+        return FALSE;
+    }
+
+    std::int64_t elapsed = now_us() - since;
+    if (elapsed < kThresholdsUs[0]) {
+        return FALSE;
+    }
+
+    Metrics::record_us(stall_histogram, static_cast<std::uint64_t>(elapsed));
+    for (int i = 0; i < 3; ++i) {
+        if (elapsed >= kThresholdsUs[i]) {
+            Metrics::increment(stall_counters[i]);
+        }
+    }
+
+    std::string capture;
+    {
+        std::lock_guard<std::mutex> lock(s.capture_mutex);
+        if (s.capture_iteration == iteration) {
+            capture = std::move(s.capture);
+        }
+    }
+
+    if (elapsed >= kThresholdsUs[2]) {
+        UC_LOG_WARN(App, "Main loop blocked for " << elapsed / 1000 << " ms " << capture);
+    } else {
+        UC_LOG_DEBUG(App, "Main loop blocked for " << elapsed / 1000 << " ms " << capture);
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Called after the main loop polls: the iteration starts working
+ */
+gboolean marker_check(GSource *)
+{
+    State &s = state();
+    std::int64_t expected = 0;
+    s.busy_since_us.compare_exchange_strong(expected, now_us(), std::memory_order_acq_rel);
+    return FALSE;
+}
+
+gboolean marker_dispatch(GSource *, GSourceFunc, gpointer)
+{
+    return G_SOURCE_CONTINUE;
+}
+
+GSourceFuncs marker_funcs = {marker_prepare, marker_check, marker_dispatch, nullptr, nullptr, nullptr};
+
+} // namespace
+
+void StallDetector::start()
+{
+    State &s = state();
+    if (s.running.exchange(true)) {
+        return;
+    }
+
+    s.main_thread = pthread_self();
+
+    // backtrace() may allocate on first use; do that here rather than in the handler
+    void *warmup[1];
+    backtrace(warmup, 1);
+
+    struct sigaction action {};
+    action.sa_handler = on_capture_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(capture_signal(), &action, nullptr);
+
+    // Everything until the first poll (window construction) counts as busy
+    s.busy_since_us.store(now_us(), std::memory_order_release);
+
+    s.source = g_source_new(&marker_funcs, sizeof(GSource));
+    g_source_set_name(s.source, "ultimate-control stall detector");
+    g_source_attach(s.source, nullptr);
+
+    s.watchdog = std::thread([&s]() { watchdog_loop(s); });
+    UC_LOG_INFO(App, "Main-loop stall detector enabled");
+}
+
+void StallDetector::stop()
+{
+    State &s = state();
+    if (!s.running.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s.wake_mutex);
+        s.wake.notify_one();
+    }
+    if (s.watchdog.joinable()) {
+        s.watchdog.join();
+    }
+    if (s.source) {
+        g_source_destroy(s.source);
+        g_source_unref(s.source);
+        s.source = nullptr;
+    }
+}
+
+std::uint64_t StallDetector::severe_stalls()
+{
+    return Metrics::value(stall_counters[2]);
+}
+
+} // namespace Core
@@ -0,0 +1,55 @@
+/**
+ * @file StallDetector.hpp
+ * @brief Main-loop stall detection for Ultimate Control
+ *
+ * This file defines the StallDetector class which watches the GLib main
+ * loop from a separate thread and reports iterations that block the UI
+ * for longer than a frame.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class StallDetector
+ * @brief Watchdog that reports long main-loop iterations
+ *
+ * A GSource attached to the default main context marks when the loop wakes
+ * up (check) and when it goes back to sleep (prepare). A watchdog thread
+ * samples that state; once an iteration crosses 16, 50 or 100 ms it
+ * captures what the main thread is doing — the innermost trace span when
+ * --trace is active, otherwise a symbolised backtrace taken from a signal
+ * handler on the main thread. When the iteration finishes, the main thread
+ * logs the stall and records it in the "mainloop.stall" histogram and the
+ * "mainloop.stalls.*" counters.
+ */
+class StallDetector {
+public:
+    /**
+     * @brief Start watching the default main context
+     *
+     * Must be called on the main thread, before the window is built, so
+     * that stalls during startup are caught as well.
+     */
+    static void start();
+
+    /**
+     * @brief Stop the watchdog thread
+     */
+    static void stop();
+
+    /**
+     * @brief Number of iterations that exceeded 100 ms since start()
+     * @return The count of severe stalls
+     */
+    static std::uint64_t severe_stalls();
+};
+
+} // namespace Core
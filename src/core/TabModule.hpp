@@ -0,0 +1,50 @@
+/**
+ * @file TabModule.hpp
+ * @brief Factory ABI between the main window and per-tab modules
+ *
+ * This file defines the descriptor each tab module (libuc-volume.so,
+ * libuc-wifi.so, ...) exports, and the macro that defines it. The main
+ * window only sees Gtk::Widget pointers; tab classes stay inside their
+ * module.
+ */
+
+#pragma once
+
+namespace Gtk {
+class Widget;
+}
+
+/// Bumped whenever UcTabModule changes; modules built for another value are rejected
+#define UC_TAB_MODULE_ABI 1
+
+extern "C" {
+
+/**
+ * @struct UcTabModule
+ * @brief Descriptor exported by a tab module as the symbol "uc_tab_module"
+ */
+struct UcTabModule {
+    unsigned int abi;                  ///< UC_TAB_MODULE_ABI the module was built with
+    const char *id;                    ///< Tab ID, e.g. "volume"
+    Gtk::Widget *(*create)();          ///< Build the tab; the widget is managed
+    void (*refresh)(Gtk::Widget *tab); ///< Re-read state after an outside change
+};
+
+}
+
+/**
+ * @brief Export the descriptor for a tab class
+ * @param ID Tab ID string
+ * @param TYPE Tab widget class; needs a default constructor and refresh()
+ *
+ * Use once, at namespace scope, in the module's tab source file.
+ */
+#define UC_TAB_MODULE(ID, TYPE)                                                  \
+    extern "C" const UcTabModule uc_tab_module = {                               \
+        UC_TAB_MODULE_ABI, ID,                                                   \
+        []() -> Gtk::Widget * { return Gtk::make_managed<TYPE>(); },             \
+        [](Gtk::Widget *tab) {                                                   \
+            if (auto *typed = dynamic_cast<TYPE *>(tab)) {                       \
+                typed->refresh();                                                \
+            }                                                                    \
+        }}
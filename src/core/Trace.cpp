@@ -0,0 +1,232 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the trace-event recorder
+ *
+ * This file implements the Trace class. Every thread owns a buffer of
+ * events; buffers of exited threads are kept until the trace is written.
+ */
+
+#include "Trace.hpp"
+#include "Json.hpp"
+#include <chrono>   // for std::chrono::steady_clock
+#include <cstdlib>  // for std::atexit, std::at_quick_exit
+#include <fstream>  // for std::ofstream
+#include <memory>   // for std::unique_ptr
+#include <mutex>    // for std::mutex
+#include <vector>   // for std::vector
+#include <unistd.h> // for getpid
+#include <sys/syscall.h>
+
+namespace Core {
+
+std::atomic<bool> Trace::enabled_{false};
+
+namespace {
+
+constexpr std::size_t kMaxEventsPerThread = 1 << 20; ///< Cap per thread to bound memory
+
+/**
+ * @struct Event
+ * @brief One recorded trace event
+ */
+struct Event {
+    const char *name;
+    const char *category;
+    char phase;               // 'X' complete, 'i' instant
+    std::int64_t start_us;
+    std::int64_t duration_us;
+    std::string detail;
+};
+
+/**
+ * @struct ThreadBuffer
+ * @brief Events recorded by one thread
+ *
+ * The mutex is only contended while the trace is being written.
+ */
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string name;
+    long tid = 0;
+    std::atomic<const char *> current{nullptr}; ///< Innermost open span
+};
+
+/**
+ * @struct Registry
+ * @brief All thread buffers, including those of exited threads
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::string path;
+    std::atomic<ThreadBuffer *> main_buffer{nullptr};
+    std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+Registry &registry()
+{
+    // Intentionally leaked: worker threads may record while the process exits
+    static Registry *instance = new Registry();
+    return *instance;
+}
+
+ThreadBuffer &local_buffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+        auto b = std::make_shared<ThreadBuffer>();
+        b->tid = static_cast<long>(syscall(SYS_gettid));
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.buffers.push_back(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+void append(ThreadBuffer &buffer, Event &&event)
+{
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() < kMaxEventsPerThread) {
+        buffer.events.push_back(std::move(event));
+    }
+}
+
+} // namespace
+
+void Trace::start(const std::string &path)
+{
+    Registry &r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.path = path;
+    }
+    enabled_.store(true, std::memory_order_relaxed);
+
+    std::atexit(&Trace::stop);
+    std::at_quick_exit(&Trace::stop);
+}
+
+void Trace::stop()
+{
+    if (!enabled_.exchange(false)) {
+        return;
+    }
+
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::ofstream out(r.path, std::ios::trunc);
+    if (!out) {
+        return;
+    }
+
+    const long pid = static_cast<long>(getpid());
+    bool first = true;
+    auto separator = [&]() -> std::ofstream & {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    separator() << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+                << ",\"tid\":" << pid << ",\"args\":{\"name\":\"ultimate-control\"}}";
+
+    for (const auto &buffer : r.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+
+        if (!buffer->name.empty()) {
+            separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                        << ",\"tid\":" << buffer->tid
+                        << ",\"args\":{\"name\":" << Json::quote(buffer->name) << "}}";
+        }
+
+        for (const Event &e : buffer->events) {
+            separator() << "{\"name\":" << Json::quote(e.name)
+                        << ",\"cat\":" << Json::quote(e.category)
+                        << ",\"ph\":\"" << e.phase << "\""
+                        << ",\"ts\":" << e.start_us;
+            if (e.phase == 'X') {
+                out << ",\"dur\":" << e.duration_us;
+            } else {
+                out << ",\"s\":\"t\"";
+            }
+            out << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid;
+            if (!e.detail.empty()) {
+                out << ",\"args\":{\"detail\":" << Json::quote(e.detail) << "}";
+            }
+            out << "}";
+        }
+    }
+
+    out << "\n]}\n";
+}
+
+std::int64_t Trace::now_us()
+{
+    auto elapsed = std::chrono::steady_clock::now() - registry().origin;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+void Trace::set_thread_name(const std::string &name)
+{
+    ThreadBuffer &buffer = local_buffer();
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.name = name;
+    }
+    if (name == "main") {
+        registry().main_buffer.store(&buffer, std::memory_order_release);
+    }
+}
+
+void Trace::complete(const char *name, const char *category, std::int64_t start_us,
+                     std::int64_t duration_us, const std::string &detail)
+{
+    if (!enabled()) {
+        return;
+    }
+    append(local_buffer(), Event{name, category, 'X', start_us, duration_us, detail});
+}
+
+void Trace::instant(const char *name, const char *category)
+{
+    if (!enabled()) {
+        return;
+    }
+    append(local_buffer(), Event{name, category, 'i', now_us(), 0, std::string()});
+}
+
+const char *Trace::main_thread_span()
+{
+    ThreadBuffer *buffer = registry().main_buffer.load(std::memory_order_acquire);
+    return buffer ? buffer->current.load(std::memory_order_relaxed) : nullptr;
+}
+
+Trace::Span::Span(const char *name, const char *category, const std::string &detail)
+    : name_(nullptr), category_(category), parent_(nullptr), start_us_(0)
+{
+    if (!enabled()) {
+        return;
+    }
+    name_ = name;
+    detail_ = detail;
+    ThreadBuffer &buffer = local_buffer();
+    parent_ = buffer.current.exchange(name, std::memory_order_relaxed);
+    start_us_ = now_us();
+}
+
+Trace::Span::~Span()
+{
+    if (!name_) {
+        return;
+    }
+    ThreadBuffer &buffer = local_buffer();
+    buffer.current.store(parent_, std::memory_order_relaxed);
+    if (enabled()) {
+        append(buffer, Event{name_, category_, 'X', start_us_, now_us() - start_us_, std::move(detail_)});
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,131 @@
+/**
+ * @file Trace.hpp
+ * @brief Chrome trace-event recording for Ultimate Control
+ *
+ * This file defines the Trace class which records scoped spans into
+ * per-thread buffers and writes them as trace-event JSON on exit, so a
+ * startup or a tab load can be inspected in Perfetto or chrome://tracing.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Trace
+ * @brief Process-wide trace-event recorder
+ *
+ * Recording is disabled unless start() was called. While disabled, a span
+ * costs a single relaxed atomic load. While enabled, each thread appends
+ * to its own buffer under an uncontended lock; buffers are only walked
+ * when the trace is written.
+ */
+class Trace {
+public:
+    /**
+     * @brief Start recording
+     * @param path File the trace is written to by stop()
+     *
+     * Registers stop() with std::atexit and std::at_quick_exit so the
+     * trace is written however the application exits.
+     */
+    static void start(const std::string &path);
+
+    /**
+     * @brief Stop recording and write the trace file
+     *
+     * Safe to call more than once; only the first call writes.
+     */
+    static void stop();
+
+    /**
+     * @brief Check whether spans are currently recorded
+     * @return true between start() and stop()
+     */
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Microseconds since process start on the trace clock
+     * @return The current trace timestamp
+     */
+    static std::int64_t now_us();
+
+    /**
+     * @brief Name the calling thread in the trace viewer
+     * @param name Thread name, e.g. "main"
+     */
+    static void set_thread_name(const std::string &name);
+
+    /**
+     * @brief Record a complete event with explicit timing
+     * @param name Event name (must outlive the trace, e.g. a string literal)
+     * @param category Event category (must outlive the trace)
+     * @param start_us Start timestamp from now_us()
+     * @param duration_us Duration in microseconds
+     * @param detail Optional free-form argument shown in the viewer
+     */
+    static void complete(const char *name, const char *category, std::int64_t start_us,
+                         std::int64_t duration_us, const std::string &detail = "");
+
+    /**
+     * @brief Record an instant event on the calling thread
+     * @param name Event name (must outlive the trace)
+     * @param category Event category (must outlive the trace)
+     */
+    static void instant(const char *name, const char *category);
+
+    /**
+     * @brief Name of the innermost open span on the main thread
+     * @return The span name, or nullptr if none is open
+     *
+     * Readable from any thread; used by the stall detector to report what
+     * the main loop was doing.
+     */
+    static const char *main_thread_span();
+
+    /**
+     * @class Span
+     * @brief Records the lifetime of a scope as a complete ("X") event
+     */
+    class Span {
+    public:
+        /**
+         * @brief Open a span
+         * @param name Span name (must outlive the trace, e.g. a string literal)
+         * @param category Span category (must outlive the trace)
+         * @param detail Optional free-form argument shown in the viewer
+         */
+        Span(const char *name, const char *category = "app", const std::string &detail = "");
+
+        /**
+         * @brief Close the span and record it
+         */
+        ~Span();
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+
+    private:
+        const char *name_;        ///< Span name, nullptr when tracing was disabled at open
+        const char *category_;    ///< Span category
+        const char *parent_;      ///< Enclosing span name, restored on close
+        std::int64_t start_us_;   ///< Start timestamp
+        std::string detail_;      ///< Optional argument
+    };
+
+private:
+    static std::atomic<bool> enabled_; ///< Whether recording is active
+};
+
+} // namespace Core
@@ -0,0 +1,184 @@
+/**
+ * @file UsageHistory.cpp
+ * @brief Implementation of the tab usage history
+ *
+ * Section layout: u32 tab count | per tab: id, u32 visits |
+ * u32 transition count | per transition: from, to, u32 count
+ */
+
+#include "UsageHistory.hpp"
+#include "WarmCache.hpp"
+#include <algorithm> // for std::sort
+#include <cstdint>   // for std::uint32_t
+#include <iterator>  // for std::next
+#include <map>       // for std::map
+#include <utility>   // for std::pair
+
+namespace Core {
+
+namespace {
+
+/// Warm cache section holding the counts
+const char *const kCacheSection = "usage";
+
+/// Total visits after which every count is halved
+constexpr std::uint32_t kMaxVisits = 512;
+
+/// Weight of overall frequency against the transition from the current tab
+constexpr double kFrequencyWeight = 0.25;
+
+/**
+ * @struct State
+ * @brief Counts loaded from the cache on first use
+ */
+struct State {
+    bool loaded = false;
+    std::map<std::string, std::uint32_t> visits;
+    std::map<std::pair<std::string, std::string>, std::uint32_t> transitions;
+    std::uint32_t total = 0;
+    std::string last; ///< Tab recorded by the previous visit in this run
+};
+
+State &state()
+{
+    static State instance;
+    return instance;
+}
+
+void load(State &s)
+{
+    s.loaded = true;
+    WarmCache::Reader reader;
+    std::uint32_t count = 0;
+    if (!WarmCache::read(kCacheSection, reader) || !reader.u32(count)) {
+        return;
+    }
+
+    State loaded;
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        std::string tab;
+        std::uint32_t visits = 0;
+        reader.str(tab);
+        reader.u32(visits);
+        loaded.visits[tab] = visits;
+        loaded.total += visits;
+    }
+    reader.u32(count);
+    for (std::uint32_t i = 0; i < count && reader.ok(); ++i) {
+        std::string from;
+        std::string to;
+        std::uint32_t transitions = 0;
+        reader.str(from);
+        reader.str(to);
+        reader.u32(transitions);
+        loaded.transitions[{from, to}] = transitions;
+    }
+    if (!reader.ok()) {
+        return; // Start over rather than trust half a section
+    }
+
+    s.visits = std::move(loaded.visits);
+    s.transitions = std::move(loaded.transitions);
+    s.total = loaded.total;
+}
+
+void save(const State &s)
+{
+    WarmCache::Writer writer;
+    writer.u32(static_cast<std::uint32_t>(s.visits.size()));
+    for (const auto &[tab, visits] : s.visits) {
+        writer.str(tab);
+        writer.u32(visits);
+    }
+    writer.u32(static_cast<std::uint32_t>(s.transitions.size()));
+    for (const auto &[key, transitions] : s.transitions) {
+        writer.str(key.first);
+        writer.str(key.second);
+        writer.u32(transitions);
+    }
+    WarmCache::store(kCacheSection, writer.take());
+}
+
+/**
+ * @brief Halve every count and drop those that reach zero
+ */
+template <typename Map>
+void decay(Map &counts)
+{
+    for (auto it = counts.begin(); it != counts.end();) {
+        it->second /= 2;
+        it = it->second == 0 ? counts.erase(it) : std::next(it);
+    }
+}
+
+State &loaded_state()
+{
+    State &s = state();
+    if (!s.loaded) {
+        load(s);
+    }
+    return s;
+}
+
+} // namespace
+
+void UsageHistory::record_visit(const std::string &tab)
+{
+    State &s = loaded_state();
+    if (tab == s.last) {
+        return;
+    }
+
+    ++s.visits[tab];
+    ++s.total;
+    if (!s.last.empty()) {
+        ++s.transitions[{s.last, tab}];
+    }
+    s.last = tab;
+
+    if (s.total > kMaxVisits) {
+        decay(s.visits);
+        decay(s.transitions);
+        s.total = 0;
+        for (const auto &[id, visits] : s.visits) {
+            s.total += visits;
+        }
+    }
+    save(s);
+}
+
+std::vector<std::string> UsageHistory::predict(const std::string &current, std::size_t count)
+{
+    State &s = loaded_state();
+
+    std::uint32_t leaving = 0;
+    for (const auto &[key, transitions] : s.transitions) {
+        if (key.first == current) {
+            leaving += transitions;
+        }
+    }
+
+    std::vector<std::pair<double, std::string>> ranked;
+    for (const auto &[tab, visits] : s.visits) {
+        if (tab == current) {
+            continue;
+        }
+        double score = kFrequencyWeight * visits / std::max<std::uint32_t>(s.total, 1);
+        auto it = s.transitions.find({current, tab});
+        if (it != s.transitions.end()) {
+            score += static_cast<double>(it->second) / leaving;
+        }
+        ranked.emplace_back(score, tab);
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    std::vector<std::string> tabs;
+    for (std::size_t i = 0; i < ranked.size() && i < count; ++i) {
+        tabs.push_back(ranked[i].second);
+    }
+    return tabs;
+}
+
+} // namespace Core
@@ -0,0 +1,54 @@
+/**
+ * @file UsageHistory.hpp
+ * @brief Local record of which tabs are opened, and in which order
+ *
+ * This file defines the UsageHistory class which counts tab visits and
+ * tab-to-tab transitions so the main window can build the tabs the user
+ * is likely to open next before they are asked for.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class UsageHistory
+ * @brief Per-tab visit frequency and transition counts
+ *
+ * Counts are kept in the "usage" section of the warm cache, so they never
+ * leave the machine and deleting the cache simply forgets them. Once the
+ * total number of visits passes a limit every count is halved, so recent
+ * habits outweigh old ones. All methods must be called on the main thread.
+ */
+class UsageHistory {
+public:
+    /**
+     * @brief Record that a tab was opened
+     * @param tab Tab ID
+     *
+     * Counts a transition from the previously recorded tab, if different.
+     */
+    static void record_visit(const std::string &tab);
+
+    /**
+     * @brief Tabs most likely to be opened after the current one
+     * @param current Tab ID shown now
+     * @param count Maximum number of tabs to return
+     * @return Tab IDs, most likely first; never includes @p current
+     *
+     * Tabs are ranked by how often @p current was followed by them, with
+     * overall visit frequency as a weaker signal. Tabs never visited are
+     * not returned.
+     */
+    static std::vector<std::string> predict(const std::string &current, std::size_t count);
+};
+
+} // namespace Core
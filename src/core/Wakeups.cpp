@@ -0,0 +1,78 @@
+/**
+ * @file Wakeups.cpp
+ * @brief Implementation of main-loop wakeup accounting
+ */
+
+#include "Wakeups.hpp"
+#include "Metrics.hpp"
+#include <glib.h>           // for g_main_context_set_poll_func
+#include <glibmm/main.h>    // for Glib::signal_timeout, Glib::signal_idle
+
+namespace Core {
+
+namespace {
+
+const Metrics::Id timeout_counter = Metrics::counter("wakeups.timeout");
+const Metrics::Id idle_counter = Metrics::counter("wakeups.idle");
+const Metrics::Id dispatcher_counter = Metrics::counter("wakeups.dispatcher");
+const Metrics::Id poll_timer_counter = Metrics::counter("wakeups.poll.timer");
+const Metrics::Id poll_fd_counter = Metrics::counter("wakeups.poll.fd");
+
+/**
+ * @brief Poll function that classifies each blocking wakeup
+ *
+ * A zero timeout is a non-blocking check for already-ready sources and is
+ * not a wakeup, so it is not counted.
+ */
+gint counting_poll(GPollFD *fds, guint nfds, gint timeout)
+{
+    gint ready = g_poll(fds, nfds, timeout);
+    if (timeout != 0) {
+        if (ready == 0) {
+            Metrics::increment(poll_timer_counter);
+        } else if (ready > 0) {
+            Metrics::increment(poll_fd_counter);
+        }
+    }
+    return ready;
+}
+
+} // namespace
+
+void Wakeups::enable_audit()
+{
+    g_main_context_set_poll_func(g_main_context_default(), counting_poll);
+}
+
+sigc::connection Wakeups::timeout_once(const sigc::slot<void> &slot, unsigned int interval_ms)
+{
+    return Glib::signal_timeout().connect([slot]() {
+        Metrics::increment(timeout_counter);
+        slot();
+        return false;
+    }, interval_ms);
+}
+
+void Wakeups::idle_once(const sigc::slot<void> &slot)
+{
+    Glib::signal_idle().connect_once([slot]() {
+        Metrics::increment(idle_counter);
+        slot();
+    });
+}
+
+sigc::connection Wakeups::idle_cancellable(const sigc::slot<void> &slot)
+{
+    return Glib::signal_idle().connect([slot]() {
+        Metrics::increment(idle_counter);
+        slot();
+        return false;
+    });
+}
+
+void Wakeups::track(Glib::Dispatcher &dispatcher)
+{
+    dispatcher.connect([]() { Metrics::increment(dispatcher_counter); });
+}
+
+} // namespace Core
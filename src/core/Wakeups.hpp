@@ -0,0 +1,75 @@
+/**
+ * @file Wakeups.hpp
+ * @brief Main-loop wakeup accounting for Ultimate Control
+ *
+ * This file defines the Wakeups class which counts how often the GLib
+ * main loop wakes up and why, so that stray timers and background work
+ * that keep the CPU busy while nothing is visible can be found.
+ */
+
+#pragma once
+
+#include <glibmm/dispatcher.h>
+#include <sigc++/sigc++.h>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class Wakeups
+ * @brief Counted replacements for one-shot main-loop sources
+ *
+ * Every callback scheduled through timeout_once() or idle_once(), and every
+ * emission of a tracked Glib::Dispatcher, increments a "wakeups.*" counter
+ * in the metrics registry. With enable_audit() the main loop's poll
+ * function is wrapped as well, separating wakeups caused by an expiring
+ * timer from wakeups caused by file descriptors (D-Bus, pipes, X/Wayland).
+ */
+class Wakeups {
+public:
+    /**
+     * @brief Count every poll() wakeup of the default main context
+     *
+     * Installs a poll function that records whether each blocking poll
+     * returned because a timeout expired or because a descriptor was ready.
+     */
+    static void enable_audit();
+
+    /**
+     * @brief Schedule a counted one-shot timeout on the main loop
+     * @param slot Callback to run
+     * @param interval_ms Delay in milliseconds
+     * @return Connection that can be used to cancel the timeout
+     */
+    static sigc::connection timeout_once(const sigc::slot<void> &slot, unsigned int interval_ms);
+
+    /**
+     * @brief Schedule a counted one-shot idle callback on the main loop
+     * @param slot Callback to run
+     *
+     * Safe to call from worker threads, like Glib::signal_idle().
+     */
+    static void idle_once(const sigc::slot<void> &slot);
+
+    /**
+     * @brief Schedule a counted one-shot idle callback that can be cancelled
+     * @param slot Callback to run
+     * @return Connection that can be used to cancel the callback
+     *
+     * Main thread only.
+     */
+    static sigc::connection idle_cancellable(const sigc::slot<void> &slot);
+
+    /**
+     * @brief Count every emission of a dispatcher
+     * @param dispatcher The dispatcher to track
+     *
+     * Must be called on the thread that owns the dispatcher (the main thread).
+     */
+    static void track(Glib::Dispatcher &dispatcher);
+};
+
+} // namespace Core
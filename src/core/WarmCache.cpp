@@ -0,0 +1,364 @@
+/**
+ * @file WarmCache.cpp
+ * @brief Implementation of the persisted warm-state cache
+ *
+ * File layout (host byte order):
+ *   "UCWC" | u32 version | u32 section count |
+ *   per section: u32 name length | name | u32 payload length | payload
+ */
+
+#include "WarmCache.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Trace.hpp"
+#include <condition_variable> // for std::condition_variable
+#include <cstdlib>            // for std::getenv
+#include <cstring>            // for std::memcpy
+#include <filesystem>         // for std::filesystem::create_directories
+#include <map>                // for std::map
+#include <mutex>              // for std::mutex
+#include <thread>             // for std::thread
+#include <fcntl.h>            // for open
+#include <sys/mman.h>         // for mmap
+#include <sys/stat.h>         // for fstat
+#include <unistd.h>           // for write, close
+
+namespace Core {
+
+namespace {
+
+constexpr char kMagic[4] = {'U', 'C', 'W', 'C'};
+constexpr std::uint32_t kVersion = 2;
+
+const Metrics::Id write_counter = Metrics::counter("warmcache.writes");
+const Metrics::Id write_histogram = Metrics::histogram("warmcache.write");
+
+/**
+ * @struct Section
+ * @brief Where a section's bytes live
+ *
+ * Sections loaded from disk point into the mapping; sections stored in
+ * this run own their bytes.
+ */
+struct Section {
+    const char *data = nullptr;
+    std::size_t size = 0;
+    std::string owned;
+};
+
+/**
+ * @struct State
+ * @brief Process-wide cache state
+ */
+struct State {
+    std::mutex mutex;                        ///< Guards sections, dirty and stopping
+    std::mutex io_mutex;                     ///< Serialises file writes so they land in order
+    std::condition_variable cv;              ///< Wakes the writer thread
+    std::map<std::string, Section> sections; ///< Current contents by name
+    bool dirty = false;                      ///< Whether sections differ from the file
+    bool stopping = false;                   ///< Set by flush(); the writer exits
+    std::thread writer;                      ///< Started by the first store(), joined by flush()
+};
+
+State &state()
+{
+    // Leaked: flush() runs from an exit hook, possibly after static
+    // destruction has started
+    static State &instance = *new State;
+    return instance;
+}
+
+std::string cache_path()
+{
+    const char *cache_home = std::getenv("XDG_CACHE_HOME");
+    if (cache_home != nullptr && *cache_home != '\0') {
+        return std::string(cache_home) + "/ultimate-control/state.bin";
+    }
+    const char *home = std::getenv("HOME");
+    if (home == nullptr) {
+        return "";
+    }
+    return std::string(home) + "/.cache/ultimate-control/state.bin";
+}
+
+void append_u32(std::string &out, std::uint32_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/**
+ * @brief Serialise every section; caller holds State::mutex
+ */
+std::string encode_file(const State &s)
+{
+    std::string out(kMagic, sizeof(kMagic));
+    append_u32(out, kVersion);
+    append_u32(out, static_cast<std::uint32_t>(s.sections.size()));
+    for (const auto &[name, section] : s.sections) {
+        append_u32(out, static_cast<std::uint32_t>(name.size()));
+        out += name;
+        append_u32(out, static_cast<std::uint32_t>(section.size));
+        out.append(section.data, section.size);
+    }
+    return out;
+}
+
+/**
+ * @brief Write the file next to its final name and rename it into place
+ */
+void write_file(const std::string &bytes)
+{
+    const std::string path = cache_path();
+    if (path.empty()) {
+        return;
+    }
+    Metrics::ScopedTimer timer(write_histogram);
+    Metrics::increment(write_counter);
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    const std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        UC_LOG_WARN(App, "Cannot write warm cache " << temp);
+        return;
+    }
+    std::size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t count = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (count <= 0) {
+            break;
+        }
+        written += static_cast<std::size_t>(count);
+    }
+    ::close(fd);
+
+    // A torn or empty file after a crash fails validation on load and is
+    // discarded, so there is no fsync here: this is only a cache
+    if (written != bytes.size() || std::rename(temp.c_str(), path.c_str()) != 0) {
+        UC_LOG_WARN(App, "Failed to replace warm cache " << path);
+        ::unlink(temp.c_str());
+    }
+}
+
+/**
+ * @brief Take a snapshot if anything changed; caller holds State::io_mutex
+ * @return true if @p bytes received a snapshot to write
+ */
+bool take_snapshot(State &s, std::string &bytes)
+{
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.dirty) {
+        return false;
+    }
+    s.dirty = false;
+    bytes = encode_file(s);
+    return true;
+}
+
+void writer_loop()
+{
+    Trace::set_thread_name("warmcache");
+    State &s = state();
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(s.mutex);
+            s.cv.wait(lock, [&s]() { return s.dirty || s.stopping; });
+            if (s.stopping) {
+                return; // flush() handles the final write
+            }
+        }
+
+        std::lock_guard<std::mutex> io_lock(s.io_mutex);
+        std::string bytes;
+        if (take_snapshot(s, bytes)) {
+            write_file(bytes);
+        }
+    }
+}
+
+} // namespace
+
+void WarmCache::Writer::u32(std::uint32_t value)
+{
+    append_u32(bytes_, value);
+}
+
+void WarmCache::Writer::i32(std::int32_t value)
+{
+    bytes_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void WarmCache::Writer::boolean(bool value)
+{
+    bytes_ += static_cast<char>(value ? 1 : 0);
+}
+
+void WarmCache::Writer::str(const std::string &text)
+{
+    u32(static_cast<std::uint32_t>(text.size()));
+    bytes_ += text;
+}
+
+bool WarmCache::Reader::take(void *out, std::size_t size)
+{
+    if (!ok_ || size > size_ - pos_) {
+        ok_ = false;
+        return false;
+    }
+    std::memcpy(out, data_ + pos_, size);
+    pos_ += size;
+    return true;
+}
+
+bool WarmCache::Reader::u32(std::uint32_t &value)
+{
+    return take(&value, sizeof(value));
+}
+
+bool WarmCache::Reader::i32(std::int32_t &value)
+{
+    return take(&value, sizeof(value));
+}
+
+bool WarmCache::Reader::boolean(bool &value)
+{
+    char byte = 0;
+    if (!take(&byte, 1)) {
+        return false;
+    }
+    value = byte != 0;
+    return true;
+}
+
+bool WarmCache::Reader::str(std::string &text)
+{
+    std::uint32_t length = 0;
+    if (!u32(length) || length > size_ - pos_) {
+        ok_ = false;
+        return false;
+    }
+    text.assign(data_ + pos_, length);
+    pos_ += length;
+    return true;
+}
+
+void WarmCache::load()
+{
+    Trace::Span span("WarmCache::load", "startup");
+    const std::string path = cache_path();
+    int fd = path.empty() ? -1 : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+
+    struct stat info {};
+    void *mapping = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapping = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return;
+    }
+
+    // The mapping is never unmapped: sections point into it until replaced
+    const char *base = static_cast<const char *>(mapping);
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    std::map<std::string, Section> sections;
+
+    bool valid = size >= sizeof(kMagic) && std::memcmp(base, kMagic, sizeof(kMagic)) == 0;
+    std::size_t offset = sizeof(kMagic);
+    Reader reader(base + offset, size - offset);
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    valid = valid && reader.u32(version) && version == kVersion && reader.u32(count);
+    offset += 2 * sizeof(std::uint32_t);
+
+    for (std::uint32_t i = 0; valid && i < count; ++i) {
+        std::string name;
+        std::uint32_t length = 0;
+        valid = reader.str(name) && reader.u32(length);
+        offset += sizeof(std::uint32_t) + name.size() + sizeof(std::uint32_t);
+        if (!valid || length > size - offset) {
+            valid = false;
+            break;
+        }
+        Section section;
+        section.data = base + offset;
+        section.size = length;
+        sections[name] = section;
+
+        // Skip the payload without copying it
+        offset += length;
+        reader = Reader(base + offset, size - offset);
+    }
+
+    if (!valid) {
+        UC_LOG_INFO(App, "Ignoring invalid warm cache " << path);
+        ::munmap(mapping, size);
+        return;
+    }
+
+    State &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (auto &[name, section] : sections) {
+        s.sections.emplace(name, section); // Sections stored before load() win
+    }
+    UC_LOG_DEBUG(App, "Loaded " << sections.size() << " warm cache sections from " << path);
+}
+
+bool WarmCache::read(const std::string &name, Reader &reader)
+{
+    State &s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.sections.find(name);
+    if (it == s.sections.end()) {
+        return false;
+    }
+    reader = Reader(it->second.data, it->second.size);
+    return true;
+}
+
+void WarmCache::store(const std::string &name, std::string bytes)
+{
+    State &s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto &section = s.sections[name];
+        if (section.data != nullptr && section.size == bytes.size() &&
+            std::memcmp(section.data, bytes.data(), bytes.size()) == 0) {
+            return; // Unchanged; no disk write
+        }
+        section.owned = std::move(bytes);
+        section.data = section.owned.data();
+        section.size = section.owned.size();
+        s.dirty = true;
+        if (!s.writer.joinable() && !s.stopping) {
+            s.writer = std::thread(writer_loop);
+        }
+    }
+    s.cv.notify_one();
+}
+
+void WarmCache::flush()
+{
+    State &s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.stopping = true;
+    }
+    s.cv.notify_one();
+    if (s.writer.joinable()) {
+        s.writer.join();
+    }
+
+    std::lock_guard<std::mutex> io_lock(s.io_mutex);
+    std::string bytes;
+    if (take_snapshot(s, bytes)) {
+        write_file(bytes);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,130 @@
+/**
+ * @file WarmCache.hpp
+ * @brief Persisted last-known state for instant first paint
+ *
+ * This file defines the WarmCache class, a small binary file in
+ * $XDG_CACHE_HOME/ultimate-control/ holding the last device lists each tab
+ * displayed. It is memory-mapped at startup so a tab can render the old
+ * state in its first frame, marked stale, while the live query runs.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace Core
+ * @brief Contains core application functionality
+ */
+namespace Core {
+
+/**
+ * @class WarmCache
+ * @brief Named binary sections persisted across runs
+ *
+ * Each tab owns one section ("volume", "wifi", ...) and encodes it with
+ * Writer and decodes it with Reader. Sections are opaque to the cache.
+ * store() replaces a section in memory and wakes a writer thread that
+ * rewrites the file to a temporary name and renames it over the old one,
+ * so readers never see a torn file and the main thread never blocks on I/O.
+ *
+ * The file is machine-local and uses host byte order; a version or format
+ * mismatch simply discards it.
+ */
+class WarmCache {
+public:
+    /**
+     * @class Writer
+     * @brief Appends fields to a section being encoded
+     */
+    class Writer {
+    public:
+        void u32(std::uint32_t value);     ///< Append an unsigned 32-bit integer
+        void i32(std::int32_t value);      ///< Append a signed 32-bit integer
+        void boolean(bool value);          ///< Append a bool as one byte
+        void str(const std::string &text); ///< Append a length-prefixed string
+
+        /**
+         * @brief Take the encoded bytes
+         */
+        std::string take() { return std::move(bytes_); }
+
+    private:
+        std::string bytes_; ///< Encoded fields
+    };
+
+    /**
+     * @class Reader
+     * @brief Reads fields back from a section, with bounds checks
+     *
+     * Every getter returns false once the section is exhausted or malformed,
+     * and keeps returning false afterwards, so callers may check only the
+     * last read.
+     */
+    class Reader {
+    public:
+        Reader() = default;
+        Reader(const char *data, std::size_t size) : data_(data), size_(size) {}
+
+        bool u32(std::uint32_t &value);  ///< Read an unsigned 32-bit integer
+        bool i32(std::int32_t &value);   ///< Read a signed 32-bit integer
+        bool boolean(bool &value);       ///< Read a one-byte bool
+        bool str(std::string &text);     ///< Read a length-prefixed string
+
+        /**
+         * @brief Whether every read so far succeeded
+         */
+        bool ok() const { return ok_; }
+
+    private:
+        bool take(void *out, std::size_t size);
+
+        const char *data_ = nullptr; ///< Start of the section
+        std::size_t size_ = 0;       ///< Size of the section
+        std::size_t pos_ = 0;        ///< Read position
+        bool ok_ = true;             ///< Cleared by the first failed read
+    };
+
+    /**
+     * @brief Map the cache file
+     *
+     * Called once at startup. A missing or invalid file leaves the cache
+     * empty. Sections stay readable from the mapping for the process's
+     * lifetime; later writes go to a new file and never modify it.
+     */
+    static void load();
+
+    /**
+     * @brief Open a section for reading
+     * @param name Section name
+     * @param reader Receives a reader over the section's bytes
+     * @return true if the section exists
+     *
+     * The reader points into the cache without copying; decode the section
+     * before the next store() of the same name.
+     */
+    static bool read(const std::string &name, Reader &reader);
+
+    /**
+     * @brief Replace a section and schedule a background write
+     * @param name Section name
+     * @param bytes Encoded section, usually from Writer::take()
+     *
+     * Does nothing if the bytes are unchanged, so tabs can call it on
+     * every update without causing disk writes.
+     */
+    static void store(const std::string &name, std::string bytes);
+
+    /**
+     * @brief Write pending changes synchronously
+     *
+     * For shutdown; stops the background writer first, so later stores
+     * are kept in memory only. Returns once the file is renamed into
+     * place or there was nothing to write.
+     */
+    static void flush();
+};
+
+} // namespace Core
@@ -0,0 +1,254 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of ultimate-control-ctl, the control socket client
+ *
+ * A tiny client for the socket served by a running ultimate-control. It
+ * links only the framing and JSON helpers (no GLib, no GTK), so starting it
+ * from a keybinding costs about as much as starting `true`.
+ *
+ * Commands read from stdin (`ultimate-control-ctl -`) are all sent before
+ * the first reply is read, exercising the server's request pipelining.
+ */
+
+#include "cli/Protocol.hpp"
+#include "core/Json.hpp"
+#include <cerrno>       // for errno
+#include <cstring>      // for std::strerror
+#include <iostream>     // for std::cout, std::cerr
+#include <sstream>      // for std::istringstream
+#include <string>       // for std::string
+#include <vector>       // for std::vector
+#include <sys/socket.h> // for socket, connect, send, recv
+#include <sys/un.h>     // for sockaddr_un
+#include <unistd.h>     // for close
+
+namespace
+{
+    void print_usage()
+    {
+        std::cerr << "Usage: ultimate-control-ctl get [subsystem]\n"
+                     "       ultimate-control-ctl set <subsystem> <value...>\n"
+                     "       ultimate-control-ctl subscribe [subsystem...]\n"
+                     "       ultimate-control-ctl -    (one command per line on stdin)\n"
+                     "\n"
+                     "Talks to the running instance over $XDG_RUNTIME_DIR/ultimate-control.sock.\n"
+                     "Values are the same as for `ultimate-control set`.\n";
+    }
+
+    /**
+     * @brief Turn one command into a request message
+     * @param id Request id
+     * @param words Command words, e.g. {"set", "volume", "+5"}
+     * @param request Receives the JSON request
+     * @return false if the command is not understood
+     */
+    bool build_request(int id, const std::vector<std::string> &words, std::string &request)
+    {
+        if (words.empty())
+        {
+            return false;
+        }
+
+        const std::string &method = words[0];
+        std::string params;
+        if (method == "get" && words.size() <= 2)
+        {
+            params = words.size() == 2 ? "{\"subsystem\":" + Core::Json::quote(words[1]) + "}" : "{}";
+        }
+        else if (method == "set" && words.size() >= 3)
+        {
+            params = "{\"subsystem\":" + Core::Json::quote(words[1]) + ",\"args\":[";
+            for (std::size_t i = 2; i < words.size(); ++i)
+            {
+                params += (i > 2 ? "," : "") + Core::Json::quote(words[i]);
+            }
+            params += "]}";
+        }
+        else if (method == "subscribe")
+        {
+            params = "{\"subsystems\":[";
+            for (std::size_t i = 1; i < words.size(); ++i)
+            {
+                params += (i > 1 ? "," : "") + Core::Json::quote(words[i]);
+            }
+            params += "]}";
+        }
+        else
+        {
+            return false;
+        }
+
+        request = "{\"id\":" + std::to_string(id) + ",\"method\":" + Core::Json::quote(method) + ",\"params\":" + params + "}";
+        return true;
+    }
+
+    int connect_socket(std::string &error)
+    {
+        const std::string path = Cli::control_socket_path();
+        if (path.empty())
+        {
+            error = "XDG_RUNTIME_DIR is not set";
+            return -1;
+        }
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            error = "socket path too long: " + path;
+            return -1;
+        }
+        path.copy(address.sun_path, path.size());
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            error = "cannot connect to " + path + ": " + std::strerror(errno) + " (is ultimate-control running?)";
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+            return -1;
+        }
+        return fd;
+    }
+
+    bool send_all(int fd, const std::string &data)
+    {
+        std::size_t sent = 0;
+        while (sent < data.size())
+        {
+            ssize_t count = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (count <= 0)
+            {
+                return false;
+            }
+            sent += static_cast<std::size_t>(count);
+        }
+        return true;
+    }
+
+    int fail(const std::string &error)
+    {
+        std::cout << "{\"ok\":false,\"error\":" << Core::Json::quote(error) << "}" << std::endl;
+        return 1;
+    }
+} // namespace
+
+/**
+ * @brief Client entry point
+ * @param argc Number of command-line arguments
+ * @param argv Array of command-line arguments
+ * @return 0 on success, 1 if a request failed, 2 on usage errors
+ */
+int main(int argc, char *argv[])
+{
+    // Collect the commands: argv is one command, "-" reads one per line
+    std::vector<std::vector<std::string>> commands;
+    if (argc == 2 && std::string(argv[1]) == "-")
+    {
+        std::string line;
+        while (std::getline(std::cin, line))
+        {
+            std::istringstream stream(line);
+            std::vector<std::string> words;
+            for (std::string word; stream >> word;)
+            {
+                words.push_back(word);
+            }
+            if (!words.empty())
+            {
+                commands.push_back(words);
+            }
+        }
+    }
+    else if (argc >= 2)
+    {
+        commands.emplace_back(argv + 1, argv + argc);
+    }
+
+    std::string requests;
+    bool subscribing = false;
+    for (std::size_t i = 0; i < commands.size(); ++i)
+    {
+        std::string request;
+        if (!build_request(static_cast<int>(i), commands[i], request))
+        {
+            print_usage();
+            return 2;
+        }
+        subscribing = subscribing || commands[i][0] == "subscribe";
+        requests += Cli::encode_frame(request);
+    }
+    if (commands.empty())
+    {
+        print_usage();
+        return 2;
+    }
+
+    std::string error;
+    int fd = connect_socket(error);
+    if (fd < 0 || !send_all(fd, requests))
+    {
+        return fail(error.empty() ? "cannot send request" : error);
+    }
+
+    // Print replies in order; after a subscribe, keep printing notifications
+    int status = 0;
+    std::size_t replies = 0;
+    Cli::FrameReader reader;
+    char buffer[16384];
+    while (replies < commands.size() || subscribing)
+    {
+        ssize_t count = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            ::close(fd);
+            return replies < commands.size() ? fail("connection closed by ultimate-control") : status;
+        }
+        reader.feed(buffer, static_cast<std::size_t>(count));
+
+        std::string payload;
+        while (reader.next(payload))
+        {
+            Core::Json::Value message;
+            if (!Core::Json::parse(payload, message, error))
+            {
+                ::close(fd);
+                return fail("invalid reply: " + error);
+            }
+
+            if (const auto *params = message.find("params"); params && !message.find("id"))
+            {
+                std::cout << Core::Json::dump(*params) << std::endl; // "changed" notification
+                continue;
+            }
+
+            ++replies;
+            if (const auto *failure = message.find("error"))
+            {
+                std::cout << "{\"ok\":false,\"error\":" << Core::Json::dump(*failure) << "}" << std::endl;
+                status = 1;
+            }
+            else if (const auto *result = message.find("result"); result && result->type == Core::Json::Value::Type::Bool)
+            {
+                std::cout << "{\"ok\":" << Core::Json::dump(*result) << "}" << std::endl;
+            }
+            else if (result)
+            {
+                std::cout << Core::Json::dump(*result) << std::endl;
+            }
+        }
+    }
+
+    ::close(fd);
+    return status;
+}
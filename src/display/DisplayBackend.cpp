@@ -0,0 +1,90 @@
+/**
+ * @file DisplayBackend.cpp
+ * @brief brightnessctl implementation of the brightness backend
+ *
+ * This file implements the system DisplayBackend on top of the
+ * brightnessctl utility, and the runtime choice of backend.
+ */
+
+#include "DisplayBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Metrics.hpp"
+#include <cstdlib>   // for std::system
+#include <cstdio>    // for popen, pclose
+#include <array>     // for std::array
+#include <algorithm> // for std::clamp
+#include <string>    // for std::string, std::stoi
+
+namespace Display {
+
+namespace {
+/// Counts every brightnessctl invocation
+const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+
+/**
+ * @brief Run a brightnessctl query and parse the number it prints
+ * @param fallback Returned if the command fails or prints no number
+ */
+int read_number(const std::string &cmd, int fallback) {
+    std::array<char, 128> buffer;  // Buffer for command output
+    std::string result;            // Result string
+
+    // Execute the command and read the first line of its output
+    Core::Metrics::increment(spawn_counter);
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (!pipe) return fallback;
+    if (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
+        result = buffer.data();
+    }
+    pclose(pipe);
+
+    try {
+        return std::stoi(result);
+    } catch (...) {
+        return fallback;
+    }
+}
+
+/**
+ * @class BrightnessctlBackend
+ * @brief Brightness backend running brightnessctl for every operation
+ */
+class BrightnessctlBackend : public DisplayBackend {
+public:
+    /**
+     * @brief Current brightness from "brightnessctl get" and "brightnessctl max"
+     */
+    int brightness() override {
+        int current = read_number("brightnessctl get", -1);
+        if (current < 0) {
+            return 0;  // Return 0 if the command or parsing fails
+        }
+
+        // Default to 1 to avoid division by zero
+        int max = read_number("brightnessctl max", 1);
+        if (max <= 0) {
+            max = 1;
+        }
+
+        // Calculate brightness as a percentage of maximum
+        int percent = static_cast<int>(100.0 * current / max);
+        return std::clamp(percent, 0, 100);  // Ensure value is between 0 and 100
+    }
+
+    bool set_brightness(int percent) override {
+        std::string cmd = "brightnessctl set " + std::to_string(percent) + "%";
+        Core::Metrics::increment(spawn_counter);
+        return std::system(cmd.c_str()) == 0;
+    }
+};
+}
+
+std::unique_ptr<DisplayBackend> DisplayBackend::create() {
+    return Core::Backend::mock() ? create_mock() : create_system();
+}
+
+std::unique_ptr<DisplayBackend> DisplayBackend::create_system() {
+    return std::make_unique<BrightnessctlBackend>();
+}
+
+} // namespace Display
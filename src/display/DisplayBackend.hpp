@@ -0,0 +1,55 @@
+/**
+ * @file DisplayBackend.hpp
+ * @brief Brightness backend interface for Ultimate Control
+ *
+ * This file defines the DisplayBackend interface which DisplayManager uses
+ * to read and change the backlight, so the brightnessctl backend can be
+ * swapped for an in-process mock at runtime (see Core::Backend).
+ */
+
+#pragma once
+
+#include <memory>
+
+namespace Display {
+
+/**
+ * @class DisplayBackend
+ * @brief Reads and changes the display brightness
+ *
+ * Implementations must be safe to call from worker threads.
+ */
+class DisplayBackend {
+public:
+    virtual ~DisplayBackend() = default;
+
+    /**
+     * @brief Current brightness as a percentage of the maximum
+     * @return 0-100; 0 if it cannot be read
+     */
+    virtual int brightness() = 0;
+
+    /**
+     * @brief Set the brightness
+     * @param percent Brightness, already clamped to 0-100
+     * @return false if the change failed
+     */
+    virtual bool set_brightness(int percent) = 0;
+
+    /**
+     * @brief The backend selected by Core::Backend
+     */
+    static std::unique_ptr<DisplayBackend> create();
+
+    /**
+     * @brief Backend running brightnessctl
+     */
+    static std::unique_ptr<DisplayBackend> create_system();
+
+    /**
+     * @brief Simulated backlight; see Core::Backend::MockOptions
+     */
+    static std::unique_ptr<DisplayBackend> create_mock();
+};
+
+} // namespace Display
@@ -3,12 +3,14 @@
  * @brief Display brightness management for Ultimate Control
  *
  * This file defines the DisplayManager class which provides functionality
- * for getting and setting display brightness using the brightnessctl utility.
+ * for getting and setting display brightness through a DisplayBackend
+ * (brightnessctl, or a mock selected by Core::Backend).
  */
 
 #pragma once
 
 #include <functional>
+#include <memory>
 
 /**
  * @namespace Display
@@ -16,12 +18,14 @@
  */
 namespace Display {
 
+class DisplayBackend;
+
 /**
  * @class DisplayManager
  * @brief Manages display brightness
  *
  * Provides functionality for getting and setting display brightness
- * using the brightnessctl utility. Brightness values are normalized
+ * through a DisplayBackend. Brightness values are normalized
  * to a 0-100 scale representing percentage of maximum brightness.
  */
 class DisplayManager {
@@ -80,8 +84,9 @@ private:
      */
     void notify();
 
-    int brightness_;                ///< Current brightness level (0-100)
+    int brightness_ = -1;           ///< Last brightness set (0-100), -1 if unknown
     BrightnessCallback callback_;   ///< Callback function for brightness changes
+    std::unique_ptr<DisplayBackend> backend_; ///< Reads and changes the backlight
 };
 
 } // namespace Display
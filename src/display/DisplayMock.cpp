@@ -0,0 +1,88 @@
+/**
+ * @file DisplayMock.cpp
+ * @brief Simulated backlight for tests and benchmarks
+ */
+
+#include "DisplayBackend.hpp"
+#include "core/Backend.hpp"
+#include <mutex> // for std::mutex
+
+namespace Display {
+
+namespace {
+
+/**
+ * @struct World
+ * @brief Backlight shared by every mock backend built from the same options
+ */
+struct World {
+    explicit World(std::uint64_t gen) : generation(gen), simulation("display") {
+        brightness = simulation.uniform(10, 100);
+    }
+
+    const std::uint64_t generation;
+    Core::Backend::Simulation simulation;
+    std::mutex mutex; ///< Guards brightness
+    int brightness = 0;
+};
+
+/**
+ * @brief The backlight for the current options, rebuilt when they change
+ */
+std::shared_ptr<World> world() {
+    static std::mutex mutex;
+    static std::shared_ptr<World> current;
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::uint64_t generation = Core::Backend::generation();
+    if (!current || current->generation != generation) {
+        current = std::make_shared<World>(generation);
+    }
+    return current;
+}
+
+/**
+ * @brief Change the brightness, as a brightness key would
+ */
+void perturb() {
+    auto w = world();
+    std::lock_guard<std::mutex> lock(w->mutex);
+    w->brightness = w->simulation.uniform(0, 100);
+}
+
+/**
+ * @class MockBackend
+ * @brief Brightness backend answering from a World
+ */
+class MockBackend : public DisplayBackend {
+public:
+    MockBackend() : world_(world()) {}
+
+    int brightness() override {
+        if (!world_->simulation.call()) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(world_->mutex);
+        return world_->brightness;
+    }
+
+    bool set_brightness(int percent) override {
+        if (!world_->simulation.call()) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(world_->mutex);
+        world_->brightness = percent;
+        return true;
+    }
+
+private:
+    std::shared_ptr<World> world_;
+};
+
+}
+
+std::unique_ptr<DisplayBackend> DisplayBackend::create_mock() {
+    Core::Backend::start_storm("display", perturb);
+    return std::make_unique<MockBackend>();
+}
+
+} // namespace Display
@@ -7,13 +7,26 @@
  */
 
 #include "DisplayTab.hpp"
-#include <iostream> // for std::cout
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/TabModule.hpp"
+#include "core/Staging.hpp"
+#include "core/WarmCache.hpp"
 #include <iomanip>  // for std::setprecision
 #include <sstream>  // for std::stringstream
 
 namespace Display
 {
 
+    namespace
+    {
+        /// Counts gammastep invocations
+        const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+
+        /// Warm cache section holding the last brightness
+        const char *const kCacheSection = "display";
+    }
+
     /**
      * @brief Constructor for the display tab
      *
@@ -132,12 +145,16 @@ namespace Display
         manager_->set_update_callback([this](int value)
                                       { on_brightness_changed(value); });
 
-        // Update initial icon and label values
-        update_brightness_icon(manager_->get_brightness());
+        // Update initial icon and label values, from the last run if known
+        update_brightness_icon(static_cast<int>(brightness_scale_.get_value()));
         update_bluelight_icon(static_cast<int>(bluelight_scale_.get_value()));
+        show_cached_state();
 
         show_all_children();
-        std::cout << "Display tab loaded!" << std::endl;
+        UC_LOG_DEBUG(Display, "Display tab loaded!");
+
+        // Read the live brightness off the main thread
+        refresh();
     }
 
     /**
@@ -145,6 +162,53 @@ namespace Display
      */
     DisplayTab::~DisplayTab() = default;
 
+    /**
+     * @brief Re-read the brightness after an outside change
+     *
+     * brightnessctl runs on the hydration thread. Moves the slider without
+     * writing the value back.
+     */
+    void DisplayTab::refresh()
+    {
+        auto manager = manager_;
+        Core::Staging::hydrate(
+            *this, [manager]()
+            { return manager->get_brightness(); },
+            [this](int value)
+            {
+                on_brightness_changed(value);
+                remember_state(value);
+            });
+    }
+
+    /**
+     * @brief Show the brightness saved by the last run, marked as stale
+     */
+    void DisplayTab::show_cached_state()
+    {
+        Core::WarmCache::Reader reader;
+        std::int32_t value = 0;
+        if (!Core::WarmCache::read(kCacheSection, reader) || !reader.i32(value) || value < 0 || value > 100)
+        {
+            return;
+        }
+        on_brightness_changed(value);
+        brightness_frame_.get_style_context()->add_class("stale");
+    }
+
+    /**
+     * @brief Save the live brightness to the warm cache and clear the stale marker
+     * @param value The brightness just read (0-100)
+     */
+    void DisplayTab::remember_state(int value)
+    {
+        brightness_frame_.get_style_context()->remove_class("stale");
+
+        Core::WarmCache::Writer writer;
+        writer.i32(value);
+        Core::WarmCache::store(kCacheSection, writer.take());
+    }
+
     /**
      * @brief Handler for brightness changes from the display manager
      * @param value The new brightness value (0-100)
@@ -201,6 +265,7 @@ namespace Display
 
         // Execute gammastep to change the color temperature
         std::string cmd = "gammastep -O " + std::to_string(temp) + " &";
+        Core::Metrics::increment(spawn_counter);
         std::system(cmd.c_str());
 
         // Update the icon and label
@@ -247,3 +312,6 @@ namespace Display
     }
 
 } // namespace Display
+
+/// Factory looked up when libuc-display.so is loaded
+UC_TAB_MODULE("display", Display::DisplayTab);
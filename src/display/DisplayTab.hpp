@@ -39,6 +39,11 @@ public:
      */
     virtual ~DisplayTab();
 
+    /**
+     * @brief Re-read the brightness after an outside change
+     */
+    void refresh();
+
 private:
     /**
      * @brief Handler for brightness changes from the display manager
@@ -48,6 +53,17 @@ private:
      */
     void on_brightness_changed(int value);
 
+    /**
+     * @brief Show the brightness saved by the last run, marked as stale
+     */
+    void show_cached_state();
+
+    /**
+     * @brief Save the live brightness to the warm cache and clear the stale marker
+     * @param value The brightness just read (0-100)
+     */
+    void remember_state(int value);
+
     /**
      * @brief Handler for brightness slider changes
      *
@@ -8,6 +8,23 @@
 
 #include <gtkmm.h>
 #include <iostream>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/Trace.hpp"
+#include "core/SelfTest.hpp"
+#include "core/StallDetector.hpp"
+#include "core/Wakeups.hpp"
+#include "core/Activity.hpp"
+#include "core/WarmCache.hpp"
+#include "core/Staging.hpp"
+#include "core/UsageHistory.hpp"
+#include "core/Modules.hpp"
+#include "core/Assets.hpp"
+#include "core/Hyprland.hpp"
+#include "core/Shutdown.hpp"
+#include "core/Config.hpp"
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <map>
 #include <cstdlib>
@@ -18,14 +35,47 @@
 #include <glibmm/optiongroup.h>
 #include <glibmm/optionentry.h>
 #include <glibmm/dispatcher.h>
-#include "volume/VolumeTab.hpp"
-#include "wifi/WifiTab.hpp"
-#include "bluetooth/BluetoothTab.hpp"
-#include "display/DisplayTab.hpp"
-#include "power/PowerTab.hpp"
+#include <glib-unix.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <vector>
 #include "settings/SettingsWindow.hpp"
 #include "settings/TabSettings.hpp"
-#include "core/Settings.hpp"
+#include "cli/Cli.hpp"
+#include "cli/ControlServer.hpp"
+
+namespace
+{
+    /// Time taken to construct a tab and put it into the notebook
+    const Core::Metrics::Id tab_create_histogram = Core::Metrics::histogram("tab.create");
+    /// Tabs built ahead of a predicted visit
+    const Core::Metrics::Id preload_counter = Core::Metrics::counter("tab.preloads");
+    /// Predicted tabs the user then visited
+    const Core::Metrics::Id preload_hit_counter = Core::Metrics::counter("tab.preload_hits");
+    /// Predicted tabs not built because the memory cap was reached
+    const Core::Metrics::Id preload_capped_counter = Core::Metrics::counter("tab.preloads_capped");
+    /// Tabs torn down after going unvisited
+    const Core::Metrics::Id eviction_counter = Core::Metrics::counter("tab.evictions");
+    /// Resident memory right before and after the last eviction, in KiB
+    const Core::Metrics::Id rss_before_evict_gauge = Core::Metrics::gauge("memory.before_evict_kb");
+    const Core::Metrics::Id rss_after_evict_gauge = Core::Metrics::gauge("memory.after_evict_kb");
+
+    /**
+     * @brief Resident set size of this process
+     * @return Size in KiB, or 0 if unknown
+     */
+    std::size_t resident_memory_kb()
+    {
+        std::ifstream statm("/proc/self/statm");
+        std::size_t pages = 0;
+        std::size_t resident = 0;
+        if (!(statm >> pages >> resident))
+        {
+            return 0;
+        }
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+    }
+}
 
 /**
  * @class MainWindow
@@ -43,12 +93,17 @@ public:
      * @param initial_tab Tab ID to select on startup (empty for default)
      * @param minimal_mode Whether to hide the tab bar
 better_control.py     * @param floating_mode Whether to make the window float on tiling window managers
+     * @param resident Whether closing the window only hides it (--daemon)
      */
-    MainWindow(const std::string &initial_tab = "", bool minimal_mode = false, bool floating_mode = false)
+    MainWindow(const std::string &initial_tab = "", bool minimal_mode = false, bool floating_mode = false, bool resident = false)
     {
+        Core::Trace::Span span("MainWindow::MainWindow", "startup");
+
         initial_tab_ = initial_tab;
         minimal_mode_ = minimal_mode;
+        resident_ = resident;
         prevent_auto_loading_ = !initial_tab_.empty();
+        read_tunables();
         set_title("Ultimate Control");
         set_default_size(800, 600);
 
@@ -63,23 +118,21 @@ better_control.py     * @param floating_mode Whether to make the window float on
             set_type_hint(Gdk::WINDOW_TYPE_HINT_NORMAL);
         }
 
-        // Check if running under Hyprland
-        const char *hyprland_signature = getenv("HYPRLAND_INSTANCE_SIGNATURE");
-        if (hyprland_signature != nullptr)
+        // Under Hyprland, set the floating rule over its IPC socket; the
+        // reply is not waited for
+        if (Core::Hyprland::available())
         {
-            std::string cmd;
-
+            apply_window_rule(floating_mode);
             if (floating_mode)
             {
-                // Add a rule to make the window float
-                cmd = "hyprctl --batch 'keyword windowrule float,class:^(ultimate-control)$'";
-            }
-            else
-            {
-                // Remove any existing floating rule
-                cmd = "hyprctl --batch 'keyword windowrulev2 unset,class:^(ultimate-control)$'";
+                // Reloading the Hyprland config drops rules set at runtime
+                Core::Hyprland::on_event([this](const std::string &event, const std::string &)
+                                         {
+                    if (event == "configreloaded")
+                    {
+                        apply_window_rule(true);
+                    } });
             }
-            std::system(cmd.c_str());
         }
 
         // Load global CSS for the application
@@ -94,7 +147,13 @@ better_control.py     * @param floating_mode Whether to make the window float on
         vbox_.pack_start(notebook_, Gtk::PACK_EXPAND_WIDGET);
 
         // Load tab configuration from settings
-        tab_settings_ = std::make_shared<Settings::TabSettings>();
+        {
+            Core::Trace::Span settings_span("TabSettings", "startup");
+            tab_settings_ = std::make_shared<Settings::TabSettings>();
+        }
+
+        // Pace tab construction by this window's frame clock
+        Core::Staging::attach(*this);
 
         // Connect to tab switch signal for lazy loading
         notebook_.signal_switch_page().connect(sigc::mem_fun(*this, &MainWindow::on_tab_switch));
@@ -102,30 +161,79 @@ better_control.py     * @param floating_mode Whether to make the window float on
         // Create tab placeholders
         create_tabs();
 
+        // Follow edits to settings.conf, from this process or another one
+        for (const char *key : {"general.preload_tabs", "general.preload_memory_mb", "general.evict_after_min"})
+        {
+            Core::Config::subscribe(key, sigc::mem_fun(*this, &MainWindow::read_tunables));
+        }
+        Core::Config::subscribe("tabs.order", sigc::mem_fun(*this, &MainWindow::schedule_tab_settings));
+        for (const auto &tab : tab_settings_->get_all_tabs())
+        {
+            Core::Config::subscribe("tabs.enabled." + tab.id, sigc::mem_fun(*this, &MainWindow::schedule_tab_settings));
+        }
+
         // Create settings button on the right side of the notebook
         create_settings_button();
 
-        // Handle window close event with quick exit to avoid hanging
-        signal_delete_event().connect([](GdkEventAny *event) -> bool
+        // Handle window close event with a bounded exit to avoid hanging
+        signal_delete_event().connect([this](GdkEventAny *event) -> bool
                                       {
-                                          std::quick_exit(0); // Force immediate exit without cleanup
-                                          return true;        // Prevent the default handler from running
+                                          if (resident_)
+                                          {
+                                              hide(); // Stay resident for the next activation
+                                              return true;
+                                          }
+                                          quit();
+                                          return true; // Prevent the default handler from running
                                       });
 
         // Handle keybinds to close window
-        signal_key_press_event().connect([](GdkEventKey *event) -> bool
+        signal_key_press_event().connect([this](GdkEventKey *event) -> bool
                                          {
             if (event->keyval == 'q' || event->keyval == 'Q') {
-                if (event->state & GDK_SHIFT_MASK) {
-                    std::cout << "Application closed" << std::endl;
-                    std::quick_exit(0);
-                } else {
-                    std::cout << "Application closed" << std::endl;
-                    std::quick_exit(0);
+                if (resident_ && !(event->state & GDK_SHIFT_MASK)) {
+                    UC_LOG_INFO(App, "Window hidden");
+                    hide();
+                    return true;
                 }
+                quit();
             }
             return false; });
 
+        // Give memory back while resident and hidden for a long time
+        if (resident_)
+        {
+            signal_hide().connect([this]()
+                                  { release_timer_ = Core::Wakeups::timeout_once(
+                                        sigc::mem_fun(*this, &MainWindow::release_memory), kReleaseAfterMs); });
+            signal_show().connect([this]()
+                                  { release_timer_.disconnect(); });
+        }
+
+        // Suspend background work and animations while hidden or unfocused
+        signal_map_event().connect([](GdkEventAny *) -> bool
+                                   {
+            Core::Activity::set_visible(true);
+            return false; });
+        signal_unmap_event().connect([](GdkEventAny *) -> bool
+                                     {
+            Core::Activity::set_visible(false);
+            return false; });
+        signal_focus_in_event().connect([](GdkEventFocus *) -> bool
+                                        {
+            Core::Activity::set_focused(true);
+            return false; });
+        signal_focus_out_event().connect([](GdkEventFocus *) -> bool
+                                         {
+            Core::Activity::set_focused(false);
+            return false; });
+
+        // Record every frame when tracing
+        if (Core::Trace::enabled())
+        {
+            signal_realize().connect(sigc::mem_fun(*this, &MainWindow::connect_frame_tracing));
+        }
+
         // Show all children
         show_all_children();
 
@@ -136,64 +244,100 @@ better_control.py     * @param floating_mode Whether to make the window float on
         }
     }
 
+    /**
+     * @brief Hide the window at once, then save state and exit
+     *
+     * Destructors are skipped: tab managers may still be in use by their
+     * worker threads. State is saved by the flush hooks instead, within
+     * Core::Shutdown::kDeadlineMs.
+     */
+    void quit()
+    {
+        UC_LOG_INFO(App, "Application closed");
+        hide();
+        Gdk::Display::get_default()->flush(); // Unmap before flushing
+        Core::Shutdown::exit(0);
+    }
+
+    /**
+     * @brief Tell Hyprland whether this window floats
+     * @param floating Add the floating rule if true, remove it otherwise
+     */
+    void apply_window_rule(bool floating)
+    {
+        if (floating)
+        {
+            Core::Hyprland::batch({"keyword windowrule float,class:^(ultimate-control)$"});
+        }
+        else
+        {
+            // Remove any existing floating rule
+            Core::Hyprland::batch({"keyword windowrulev2 unset,class:^(ultimate-control)$"});
+        }
+    }
+
     /**
      * @brief Load global CSS for the application
      *
-     * Loads CSS from the style.css file and applies it to the application.
+     * Applies the stylesheet compiled into the executable, plus the user's
+     * override if there is one (see Core::Assets).
      */
     void load_global_css()
     {
-        try
-        {
-            // Create a CSS provider
-            css_provider_ = Gtk::CssProvider::create();
+        Core::Assets::apply_css(Gdk::Screen::get_default());
+    }
 
-            // Try to load CSS from file - use absolute path for reliability
-            std::string css_path = "/home/felipe/Documents/Github/ultimate-control/src/css/style.css";
-            if (std::ifstream(css_path).good())
-            {
-                css_provider_->load_from_path(css_path);
-                std::cout << "Loaded CSS from " << css_path << std::endl;
-            }
-            else
-            {
-                // Try relative path as fallback
-                css_path = "src/css/style.css";
-                if (std::ifstream(css_path).good())
-                {
-                    css_provider_->load_from_path(css_path);
-                    std::cout << "Loaded CSS from " << css_path << std::endl;
-                }
-                else
-                {
-                    std::cerr << "CSS file not found at any path" << std::endl;
-
-                    // As a fallback, load CSS directly from string
-                    const std::string css_content =
-                        ".tab-content {"
-                        "    transition: opacity 200ms ease-in-out;"
-                        "}"
-                        ".tab-content.animate-in {"
-                        "    opacity: 0;"
-                        "}"
-                        ".tab-content.animate-out {"
-                        "    opacity: 0;"
-                        "}";
-
-                    css_provider_->load_from_data(css_content);
-                    std::cout << "Loaded CSS from inline string" << std::endl;
-                }
-            }
+    /**
+     * @brief Bring the window to the front, optionally on a given tab
+     * @param tab_id The ID of the tab to show (empty to keep the current one)
+     *
+     * Used for command lines forwarded from later launches to a running instance.
+     */
+    void show_tab(const std::string &tab_id)
+    {
+        if (!tab_id.empty())
+        {
+            switch_to_tab(tab_id);
+        }
+        present();
+    }
 
-            // Apply the CSS to the application
-            auto screen = Gdk::Screen::get_default();
-            Gtk::StyleContext::add_provider_for_screen(
-                screen, css_provider_, GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+    /**
+     * @brief Bring a built tab up to date after an outside change
+     * @param subsystem The subsystem that changed; matches the tab ID
+     *
+     * Called for changes made through the control socket. Tabs that are not
+     * built yet read fresh state when they are, so they are skipped.
+     */
+    void refresh_tab(const std::string &subsystem)
+    {
+        auto it = tab_widgets_.find(subsystem);
+        if (it == tab_widgets_.end() || !it->second.loaded)
+        {
+            return;
         }
-        catch (const Glib::Error &ex)
+
+        Core::Modules::refresh(subsystem, it->second.widget);
+    }
+
+    /**
+     * @brief Build every enabled tab while the window is still hidden
+     *
+     * Used by --daemon so managers are constructed and backends probed
+     * before the first activation. One tab is built per idle callback to
+     * keep the main loop responsive.
+     */
+    void preload_tabs()
+    {
+        std::vector<std::string> pending;
+        for (const auto &[id, info] : tab_widgets_)
         {
-            std::cerr << "Error loading CSS: " << ex.what() << std::endl;
+            if (!info.loaded && !info.loading)
+            {
+                pending.push_back(id);
+            }
         }
+        preload_next(std::move(pending));
     }
 
     /**
@@ -233,7 +377,7 @@ better_control.py     * @param floating_mode Whether to make the window float on
                         current_widget->get_style_context()->add_class("animate-out");
 
                         // Remove the animation class after the transition completes
-                        Glib::signal_timeout().connect_once([current_widget]()
+                        Core::Activity::animate([current_widget]()
                                                             {
                             if (current_widget)
                             {
@@ -266,11 +410,11 @@ better_control.py     * @param floating_mode Whether to make the window float on
                     widget->get_style_context()->add_class("animate-in");
 
                     // Remove the animation class after a short delay
-                    Glib::signal_timeout().connect_once([widget]()
+                    Core::Activity::animate([widget]()
                                                         {
                         if (widget)
                         {
-                            std::cout << "Starting direct tab switch animation" << std::endl;
+                            UC_LOG_TRACE(App, "Starting direct tab switch animation");
                             widget->get_style_context()->remove_class("animate-in");
                             // Ensure opacity is set to 1
                             widget->set_opacity(1);
@@ -320,7 +464,7 @@ better_control.py     * @param floating_mode Whether to make the window float on
             }
             catch (const Glib::Error &ex)
             {
-                std::cerr << "Error loading CSS: " << ex.what() << std::endl;
+                UC_LOG_ERROR(App, "Error loading CSS: " << ex.what());
             }
         }
 
@@ -381,8 +525,8 @@ better_control.py     * @param floating_mode Whether to make the window float on
                 });
 
                 settings_window_->set_settings_changed_callback([this]() {
-                    std::cout << "Settings changed, restart required" << std::endl;
-                    std::quick_exit(42);
+                    UC_LOG_INFO(App, "Settings changed, applying");
+                    apply_tab_settings();
                 });
             }
 
@@ -405,47 +549,168 @@ private:
         }
         tab_widgets_.clear();
 
+        Core::Trace::Span span("create_tabs", "startup");
+
         // Get tab order from settings
         auto tab_order = tab_settings_->get_tab_order();
 
-        // If we have an initial tab specified, make sure it's enabled
-        if (!initial_tab_.empty())
-        {
-            tab_settings_->set_tab_enabled(initial_tab_, true);
-        }
         for (const auto &tab_id : tab_order)
         {
-            if (!tab_settings_->is_tab_enabled(tab_id))
+            // A tab asked for on the command line is shown even if disabled,
+            // without changing the saved settings
+            if (!tab_settings_->is_tab_enabled(tab_id) && tab_id != initial_tab_)
             {
                 continue; // Skip disabled tabs
             }
 
-            // Create a placeholder for lazy loading
-            auto placeholder = Gtk::make_managed<Gtk::Box>();
-            placeholder->set_size_request(100, 100);
+            add_placeholder_tab(tab_id);
+        }
+    }
 
-            // Add the tab with appropriate icon and label
-            if (tab_id == "volume")
-            {
-                add_tab(tab_id, placeholder, "audio-volume-high-symbolic", "Volume");
-            }
-            else if (tab_id == "wifi")
+    /**
+     * @brief Append an unbuilt tab to the notebook
+     * @param tab_id ID of the tab
+     *
+     * The placeholder is replaced with the tab's content when the tab is
+     * first selected.
+     */
+    void add_placeholder_tab(const std::string &tab_id)
+    {
+        // Create a placeholder for lazy loading
+        auto placeholder = Gtk::make_managed<Gtk::Box>();
+        placeholder->set_size_request(100, 100);
+
+        // Add the tab with appropriate icon and label
+        if (tab_id == "volume")
+        {
+            add_tab(tab_id, placeholder, "audio-volume-high-symbolic", "Volume");
+        }
+        else if (tab_id == "wifi")
+        {
+            add_tab(tab_id, placeholder, "network-wireless-symbolic", "WiFi");
+        }
+        else if (tab_id == "bluetooth")
+        {
+            add_tab(tab_id, placeholder, "bluetooth-active-symbolic", "Bluetooth");
+        }
+        else if (tab_id == "display")
+        {
+            add_tab(tab_id, placeholder, "video-display-symbolic", "Display");
+        }
+        else if (tab_id == "power")
+        {
+            add_tab(tab_id, placeholder, "system-shutdown-symbolic", "Power");
+        }
+    }
+
+    /**
+     * @brief Read the preloading and eviction settings
+     */
+    void read_tunables()
+    {
+        preload_enabled_ = Core::Config::get_bool("general.preload_tabs", true);
+        preload_limit_kb_ = static_cast<std::size_t>(Core::Config::get_int("general.preload_memory_mb", 200)) * 1024;
+        evict_after_us_ = Core::Config::get_int("general.evict_after_min", 10) * 60 * 1000 * 1000;
+    }
+
+    /**
+     * @brief Apply tab settings once the current batch of changes is done
+     *
+     * Saving the tab settings changes several keys at once; they are
+     * applied together from an idle callback.
+     */
+    void schedule_tab_settings()
+    {
+        if (!tab_settings_pending_.connected())
+        {
+            tab_settings_pending_ = Core::Wakeups::idle_cancellable(sigc::mem_fun(*this, &MainWindow::apply_tab_settings));
+        }
+    }
+
+    /**
+     * @brief Bring the notebook in line with the saved tab settings
+     *
+     * Called after the tab settings were saved, here or by editing
+     * settings.conf. Disabled tabs are removed, newly enabled tabs are
+     * added as placeholders and every page is moved to its configured
+     * position. Tabs that stay enabled keep their widgets and managers,
+     * built or not. A removed tab's manager is destroyed without waiting
+     * for its worker threads; they finish on their own and drop their
+     * results.
+     */
+    void apply_tab_settings()
+    {
+        Core::Trace::Span span("apply_tab_settings", "settings");
+        tab_settings_pending_.disconnect();
+        tab_settings_->load();
+
+        std::vector<std::string> wanted;
+        for (const auto &tab_id : tab_settings_->get_tab_order())
+        {
+            if (tab_settings_->is_tab_enabled(tab_id))
             {
-                add_tab(tab_id, placeholder, "network-wireless-symbolic", "WiFi");
+                wanted.push_back(tab_id);
             }
-            else if (tab_id == "bluetooth")
+        }
+
+        // Pages switch while they are removed and moved; none of those is a visit
+        rebuilding_ = true;
+        speculation_.disconnect();
+
+        std::vector<std::string> removed;
+        for (const auto &[id, info] : tab_widgets_)
+        {
+            if (std::find(wanted.begin(), wanted.end(), id) == wanted.end())
             {
-                add_tab(tab_id, placeholder, "bluetooth-active-symbolic", "Bluetooth");
+                removed.push_back(id);
             }
-            else if (tab_id == "display")
+        }
+        for (const auto &id : removed)
+        {
+            // Destroys the tab and its manager if it was built
+            notebook_.remove_page(*tab_widgets_[id].widget);
+            std::lock_guard<std::mutex> lock(tab_mutex_);
+            tab_widgets_.erase(id);
+            tab_loaded_dispatchers_.erase(id);
+            tab_load_errors_.erase(id);
+        }
+
+        int position = 0;
+        for (const auto &id : wanted)
+        {
+            auto it = tab_widgets_.find(id);
+            if (it == tab_widgets_.end())
             {
-                add_tab(tab_id, placeholder, "video-display-symbolic", "Display");
+                add_placeholder_tab(id);
+                it = tab_widgets_.find(id);
+                if (it == tab_widgets_.end())
+                {
+                    continue; // Unknown tab ID in the settings file
+                }
+                it->second.widget->show();
             }
-            else if (tab_id == "power")
+            notebook_.reorder_child(*it->second.widget, position++);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(tab_mutex_);
+            for (auto &[id, info] : tab_widgets_)
             {
-                add_tab(tab_id, placeholder, "system-shutdown-symbolic", "Power");
+                info.page_num = notebook_.page_num(*info.widget);
             }
         }
+        rebuilding_ = false;
+
+        UC_LOG_INFO(App, "Tab settings applied: " << removed.size() << " removed, "
+                                                  << tab_widgets_.size() << " shown");
+
+        // The selected page may now be an unbuilt one
+        const int current = notebook_.get_current_page();
+        if (current >= 0)
+        {
+            on_tab_switch(notebook_.get_nth_page(current), static_cast<guint>(current));
+        }
+        schedule_eviction();
     }
 
     /**
@@ -525,6 +790,7 @@ private:
         // Create a dispatcher for this tab
         tab_loaded_dispatchers_[id].connect([this, id]()
                                             { on_tab_loaded(id); });
+        Core::Wakeups::track(tab_loaded_dispatchers_[id]);
     }
 
     /**
@@ -540,11 +806,17 @@ private:
     {
         // Guard against recursive calls that can happen during tab loading
         static bool loading = false;
-        if (loading)
+        if (loading || rebuilding_)
         {
             return;
         }
 
+        // The user moved first: drop pending predictions, and count the
+        // visit once the page stays selected
+        speculation_.disconnect();
+        visit_timer_.disconnect();
+        visit_timer_ = Core::Wakeups::timeout_once(sigc::mem_fun(*this, &MainWindow::on_visit_settled), kVisitSettleMs);
+
         // Apply animation to the current tab if it's already loaded
         int current_page = notebook_.get_current_page();
         if (current_page >= 0 && current_page != static_cast<int>(page_num))
@@ -570,7 +842,7 @@ private:
                     current_widget->get_style_context()->add_class("animate-out");
 
                     // Remove the animation class after the transition completes
-                    Glib::signal_timeout().connect_once([current_widget]()
+                    Core::Activity::animate([current_widget]()
                                                         {
                         if (current_widget)
                         {
@@ -616,34 +888,22 @@ private:
         }
 
         // If we found a tab to load, load it
-        if (!tab_id_to_load.empty())
+        if (!tab_id_to_load.empty() && tab_widgets_[tab_id_to_load].evicted)
         {
-            // Set loading flag to prevent recursive calls
+            // The module is loaded and the tab paints its warm-cache state
+            // in its constructor, so rebuild it in this frame rather than
+            // showing a spinner in place of the state it had
             loading = true;
-
-            // Special handling for power tab - load it immediately without delay
-            if (tab_id_to_load == "power")
-            {
-                // Show loading indicator and start async loading immediately
-                show_loading_indicator(tab_id_to_load, page_num);
-                load_tab_content_async(tab_id_to_load, page_num);
-            }
-            else
-            {
-                // Use a single-shot timer to delay loading slightly for other tabs
-                // This prevents UI freezes and GTK+ rendering issues during tab switching
-                Glib::signal_timeout().connect_once([this, tab_id_to_load, page_num]()
-                                                    {
-                    // Show loading indicator and start async loading
-                    show_loading_indicator(tab_id_to_load, page_num);
-                    load_tab_content_async(tab_id_to_load, page_num); }, 50);
-            }
-
-            // Reset loading flag after a short delay
-            Glib::signal_timeout().connect_once([]()
-                                                {
-                // Use a new lambda to avoid capturing the static variable
-                loading = false; }, 100);
+            create_tab_content(tab_id_to_load, page_num);
+            loading = false;
+        }
+        else if (!tab_id_to_load.empty())
+        {
+            // Replacing the page below switches pages again; ignore those
+            loading = true;
+            show_loading_indicator(tab_id_to_load, page_num);
+            load_tab_content_async(tab_id_to_load, page_num);
+            loading = false;
         }
         else
         {
@@ -672,11 +932,11 @@ private:
                     new_widget->get_style_context()->add_class("animate-in");
 
                     // Remove the animation class after a short delay
-                    Glib::signal_timeout().connect_once([new_widget]()
+                    Core::Activity::animate([new_widget]()
                                                         {
                         if (new_widget)
                         {
-                            std::cout << "Starting tab switch animation" << std::endl;
+                            UC_LOG_TRACE(App, "Starting tab switch animation");
                             new_widget->get_style_context()->remove_class("animate-in");
                             // Ensure opacity is set to 1
                             new_widget->set_opacity(1);
@@ -807,12 +1067,12 @@ private:
         }
         catch (const std::exception &e)
         {
-            std::cerr << "Error showing loading indicator for tab " << id << ": " << e.what() << std::endl;
+            UC_LOG_WARN(App, "Error showing loading indicator for tab " << id << ": " << e.what());
             tab_widgets_[id].loading = false;
         }
         catch (...)
         {
-            std::cerr << "Unknown error showing loading indicator for tab " << id << std::endl;
+            UC_LOG_WARN(App, "Unknown error showing loading indicator for tab " << id);
             tab_widgets_[id].loading = false;
         }
     }
@@ -822,38 +1082,30 @@ private:
      * @param id ID of the tab to load
      * @param page_num Page number of the tab
      *
-     * Uses a timeout to keep the UI responsive during loading
+     * The tab skeleton is built as a frame step (see Core::Staging), so it
+     * appears in the next frame; before the window is first shown it is
+     * built at once and appears in the first frame. Tabs then hydrate
+     * their models off-thread.
      */
     void load_tab_content_async(const std::string &id, int page_num)
     {
+        Core::Trace::Span span("load_tab_content_async", "tab", id);
+
         // Check if already loaded or loading
         {
             std::lock_guard<std::mutex> lock(tab_mutex_);
-            if (tab_widgets_[id].loaded || (tab_widgets_.find(id) == tab_widgets_.end()))
+            auto it = tab_widgets_.find(id);
+            if (it == tab_widgets_.end() || it->second.loaded)
             {
                 return;
             }
         }
 
-        // Special handling for power tab - load it with minimal delay
-        if (id == "power")
-        {
-            // Schedule content creation with minimal delay for power tab
-            Glib::signal_timeout().connect_once([this, id, page_num]()
-                                                {
-                // Create the actual tab content
-                create_tab_content(id, page_num); }, 10); // Very short delay for power tab
-        }
-        else
-        {
-            // Schedule content creation with a short delay for other tabs
-            // This keeps the UI responsive and allows the loading indicator to appear
-            Glib::signal_timeout().connect_once([this, id, page_num]()
-                                                {
-                // This runs in the main thread after a short delay
-                // Create the actual tab content
-                create_tab_content(id, page_num); }, 100); // Standard delay for other tabs
-        }
+        const std::int64_t scheduled_us = Core::Trace::now_us();
+        Core::Staging::step(*this, [this, id, page_num, scheduled_us]()
+                            {
+            Core::Trace::complete("tab.load_delay", "tab", scheduled_us, Core::Trace::now_us() - scheduled_us, id);
+            create_tab_content(id, page_num); });
     }
 
     /**
@@ -861,15 +1113,19 @@ private:
      * @param id ID of the tab to create content for
      * @param page_num Page number of the tab
      *
+     * @param select Whether to select the tab; false when building it ahead
+     *               of a predicted visit
+     *
      * Creates the appropriate tab widget based on the tab ID
      * and replaces the loading indicator with it
      */
-    void create_tab_content(const std::string &id, int page_num)
+    void create_tab_content(const std::string &id, int page_num, bool select = true)
     {
         // Check if already loaded
         {
             std::lock_guard<std::mutex> lock(tab_mutex_);
-            if (tab_widgets_[id].loaded || (tab_widgets_.find(id) == tab_widgets_.end()))
+            auto it = tab_widgets_.find(id);
+            if (it == tab_widgets_.end() || it->second.loaded)
             {
                 return;
             }
@@ -877,6 +1133,9 @@ private:
 
         try
         {
+            Core::Trace::Span span("create_tab_content", "tab", id);
+            Core::Metrics::ScopedTimer timer(tab_create_histogram);
+
             // Create the actual tab content
             Gtk::Widget *content = nullptr;
             std::string icon_name;
@@ -884,31 +1143,26 @@ private:
 
             if (id == "volume")
             {
-                content = Gtk::make_managed<Volume::VolumeTab>();
                 icon_name = "audio-volume-high-symbolic";
                 label_text = "Volume";
             }
             else if (id == "wifi")
             {
-                content = Gtk::make_managed<Wifi::WifiTab>();
                 icon_name = "network-wireless-symbolic";
                 label_text = "WiFi";
             }
             else if (id == "bluetooth")
             {
-                content = Gtk::make_managed<Bluetooth::BluetoothTab>();
                 icon_name = "bluetooth-active-symbolic";
                 label_text = "Bluetooth";
             }
             else if (id == "display")
             {
-                content = Gtk::make_managed<Display::DisplayTab>();
                 icon_name = "video-display-symbolic";
                 label_text = "Display";
             }
             else if (id == "power")
             {
-                content = Gtk::make_managed<Power::PowerTab>();
                 icon_name = "system-shutdown-symbolic";
                 label_text = "Power";
             }
@@ -921,6 +1175,9 @@ private:
                 return;
             }
 
+            // Loads libuc-<id>.so on first use
+            content = Core::Modules::create(id);
+
             // Get the current page number for this tab
             int current_page_num;
             {
@@ -938,9 +1195,13 @@ private:
             content->set_name("tab-" + id);
             content->get_style_context()->add_class("tab-content");
 
-            // Force the widget to have opacity 0 initially
-            content->set_opacity(0);
-            content->get_style_context()->add_class("animate-in");
+            // Force the widget to have opacity 0 initially; a tab built in
+            // the background animates in when it is switched to instead
+            if (select)
+            {
+                content->set_opacity(0);
+                content->get_style_context()->add_class("animate-in");
+            }
 
             // Insert the new content
             int new_page_num = notebook_.insert_page(*content, *event_box, current_page_num);
@@ -955,42 +1216,49 @@ private:
                 tab_widgets_[id].page_num = new_page_num;
                 tab_widgets_[id].loaded = true;
                 tab_widgets_[id].loading = false;
+                tab_widgets_[id].speculative = !select;
+                tab_widgets_[id].evicted = false;
+                tab_widgets_[id].last_visit_us = Core::Trace::now_us();
             }
+            schedule_eviction();
 
             // Only switch to the tab if we're not already on it
-            if (notebook_.get_current_page() != new_page_num)
+            if (select && notebook_.get_current_page() != new_page_num)
             {
                 notebook_.set_current_page(new_page_num);
             }
 
             // Start animation after a short delay to ensure the tab is visible
-            Glib::signal_timeout().connect_once([content]()
-                                                {
-                std::cout << "Starting tab animation" << std::endl;
-                // Remove the animate-in class to trigger the transition
-                content->get_style_context()->remove_class("animate-in");
-                // Ensure opacity is set to 1
-                content->set_opacity(1); }, 50);
+            if (select)
+            {
+                Core::Activity::animate([content]()
+                                        {
+                    UC_LOG_TRACE(App, "Starting tab animation");
+                    // Remove the animate-in class to trigger the transition
+                    content->get_style_context()->remove_class("animate-in");
+                    // Ensure opacity is set to 1
+                    content->set_opacity(1); }, 50);
+            }
 
             // Notify that the tab has been loaded
             tab_loaded_dispatchers_[id].emit();
 
             // Log successful tab loading
-            std::cout << "Tab " << id << " loaded and selected successfully" << std::endl;
+            UC_LOG_DEBUG(App, "Tab " << id << " loaded and selected successfully");
         }
         catch (const std::exception &e)
         {
             std::lock_guard<std::mutex> lock(tab_mutex_);
             tab_widgets_[id].loading = false;
             tab_load_errors_[id] = e.what();
-            std::cerr << "Error creating tab " << id << ": " << e.what() << std::endl;
+            UC_LOG_ERROR(App, "Error creating tab " << id << ": " << e.what());
         }
         catch (...)
         {
             std::lock_guard<std::mutex> lock(tab_mutex_);
             tab_widgets_[id].loading = false;
             tab_load_errors_[id] = "Unknown error";
-            std::cerr << "Unknown error creating tab " << id << std::endl;
+            UC_LOG_ERROR(App, "Unknown error creating tab " << id);
         }
     }
 
@@ -1003,7 +1271,292 @@ private:
      */
     void on_tab_loaded(const std::string &id)
     {
-        std::cout << "Tab " << id << " loaded successfully" << std::endl;
+        UC_LOG_DEBUG(App, "Tab " << id << " loaded successfully");
+    }
+
+    /**
+     * @brief Build the first pending tab and schedule the rest
+     * @param pending IDs of the tabs still to build
+     *
+     * Tabs are built without being selected, so no switch_page handlers
+     * run and the visible page never changes.
+     */
+    void preload_next(std::vector<std::string> pending)
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+
+        std::string id = pending.back();
+        pending.pop_back();
+        Core::Wakeups::idle_once([this, id, pending]()
+                                 {
+            // Skip tabs built meanwhile, e.g. by a forwarded -w
+            auto it = tab_widgets_.find(id);
+            if (it != tab_widgets_.end() && !it->second.loaded && !it->second.loading)
+            {
+                create_tab_content(id, it->second.page_num, false);
+            }
+            preload_next(pending); });
+    }
+
+    /**
+     * @brief Count a visit once a tab stayed selected, then predict the next
+     *
+     * Called kVisitSettleMs after the last page switch, so pages selected
+     * only while tabs are being replaced are not counted. The tabs most
+     * likely to be opened next are then built in idle time.
+     */
+    void on_visit_settled()
+    {
+        std::string id;
+        for (const auto &[tab_id, info] : tab_widgets_)
+        {
+            if (info.page_num == notebook_.get_current_page())
+            {
+                id = tab_id;
+                break;
+            }
+        }
+        if (id.empty())
+        {
+            return;
+        }
+
+        // The tab left behind was in use until now
+        const std::int64_t now = Core::Trace::now_us();
+        auto left = tab_widgets_.find(visited_tab_);
+        if (left != tab_widgets_.end())
+        {
+            left->second.last_visit_us = now;
+        }
+        visited_tab_ = id;
+
+        TabInfo &visited = tab_widgets_[id];
+        visited.last_visit_us = now;
+        if (visited.speculative)
+        {
+            visited.speculative = false;
+            Core::Metrics::increment(preload_hit_counter);
+        }
+        Core::UsageHistory::record_visit(id);
+        schedule_eviction();
+
+        // --daemon already builds every tab
+        if (!preload_enabled_ || resident_)
+        {
+            return;
+        }
+
+        std::vector<std::string> pending;
+        for (const auto &next : Core::UsageHistory::predict(id, kSpeculativeTabs))
+        {
+            auto it = tab_widgets_.find(next);
+            if (it != tab_widgets_.end() && !it->second.loaded && !it->second.loading)
+            {
+                pending.push_back(next);
+            }
+        }
+        std::reverse(pending.begin(), pending.end()); // Most likely last, taken first
+        speculate_next(std::move(pending));
+    }
+
+    /**
+     * @brief Build the most likely pending tab in idle time, then the rest
+     * @param pending Predicted tabs still to build, most likely last
+     *
+     * Stops at the memory cap. Cancelled by the next page switch through
+     * speculation_; a tab already being built is finished.
+     */
+    void speculate_next(std::vector<std::string> pending)
+    {
+        if (pending.empty())
+        {
+            return;
+        }
+
+        speculation_ = Core::Wakeups::idle_cancellable([this, pending]()
+                                                       {
+            std::vector<std::string> rest = pending;
+            std::string id = rest.back();
+            rest.pop_back();
+
+            auto it = tab_widgets_.find(id);
+            if (it != tab_widgets_.end() && !it->second.loaded && !it->second.loading)
+            {
+                if (resident_memory_kb() > preload_limit_kb_)
+                {
+                    UC_LOG_DEBUG(App, "Not preloading tab " << id << ": memory cap reached");
+                    Core::Metrics::increment(preload_capped_counter);
+                    return;
+                }
+                UC_LOG_DEBUG(App, "Preloading tab " << id);
+                Core::Metrics::increment(preload_counter);
+                create_tab_content(id, it->second.page_num, false);
+            }
+            speculate_next(std::move(rest)); });
+    }
+
+    /**
+     * @brief Arm the eviction timer for the tab that goes stale first
+     *
+     * Every built tab except the selected one expires evict_after_us_ after
+     * its last visit.
+     */
+    void schedule_eviction()
+    {
+        eviction_timer_.disconnect();
+        if (evict_after_us_ <= 0)
+        {
+            return;
+        }
+
+        std::int64_t next_expiry = -1;
+        for (const auto &[id, info] : tab_widgets_)
+        {
+            if (info.loaded && info.page_num != notebook_.get_current_page())
+            {
+                const std::int64_t expiry = info.last_visit_us + evict_after_us_;
+                if (next_expiry < 0 || expiry < next_expiry)
+                {
+                    next_expiry = expiry;
+                }
+            }
+        }
+        if (next_expiry < 0)
+        {
+            return;
+        }
+
+        // A very long idle timeout must not wrap to a short one
+        const std::int64_t delay_ms = std::min<std::int64_t>(
+            std::max<std::int64_t>(0, (next_expiry - Core::Trace::now_us()) / 1000) + 1,
+            std::numeric_limits<unsigned int>::max());
+        eviction_timer_ = Core::Wakeups::timeout_once(sigc::mem_fun(*this, &MainWindow::evict_idle_tabs),
+                                                      static_cast<unsigned int>(delay_ms));
+    }
+
+    /**
+     * @brief Tear down every built tab left unvisited for too long
+     *
+     * Each tab is replaced by a placeholder, destroying its widgets and its
+     * manager. Tabs keep their last state in the warm cache, so switching
+     * back paints that state in the first frame while the tab is rebuilt.
+     * Resident memory before and after is published as gauges.
+     */
+    void evict_idle_tabs()
+    {
+        const std::int64_t now = Core::Trace::now_us();
+        std::vector<std::string> expired;
+        for (const auto &[id, info] : tab_widgets_)
+        {
+            if (info.loaded && info.page_num != notebook_.get_current_page() &&
+                now - info.last_visit_us >= evict_after_us_)
+            {
+                expired.push_back(id);
+            }
+        }
+
+        if (!expired.empty())
+        {
+            const std::size_t before_kb = resident_memory_kb();
+            for (const auto &id : expired)
+            {
+                evict_tab(id);
+            }
+            malloc_trim(0);
+            const std::size_t after_kb = resident_memory_kb();
+
+            Core::Metrics::increment(eviction_counter, expired.size());
+            Core::Metrics::set(rss_before_evict_gauge, static_cast<std::int64_t>(before_kb));
+            Core::Metrics::set(rss_after_evict_gauge, static_cast<std::int64_t>(after_kb));
+            UC_LOG_INFO(App, "Evicted " << expired.size() << " unvisited tabs, resident memory "
+                                        << before_kb << " KiB -> " << after_kb << " KiB");
+        }
+        schedule_eviction();
+    }
+
+    /**
+     * @brief Replace a built, unselected tab with a placeholder
+     * @param id ID of the tab
+     *
+     * The placeholder is never shown: switching back rebuilds the tab in
+     * the same frame, from its warm cache section.
+     */
+    void evict_tab(const std::string &id)
+    {
+        TabInfo &info = tab_widgets_[id];
+        Gtk::Widget *label = notebook_.get_tab_label(*info.widget);
+        auto *event_box = dynamic_cast<Gtk::EventBox *>(label);
+        if (event_box == nullptr)
+        {
+            return;
+        }
+
+        // Keep the label across the page swap; the notebook drops its reference
+        event_box->reference();
+        notebook_.remove_page(info.page_num);
+
+        auto placeholder = Gtk::make_managed<Gtk::Box>();
+        placeholder->set_size_request(100, 100);
+        placeholder->show();
+        info.page_num = notebook_.insert_page(*placeholder, *event_box, info.page_num);
+        event_box->unreference();
+
+        info.widget = placeholder;
+        info.loaded = false;
+        info.speculative = false;
+        info.evicted = true;
+        UC_LOG_DEBUG(App, "Tab " << id << " evicted");
+    }
+
+    /**
+     * @brief Release memory after the resident window stayed hidden
+     *
+     * Destroys the settings dialog and returns freed heap pages to the
+     * kernel. Tab contents are left to the eviction timer.
+     */
+    void release_memory()
+    {
+        UC_LOG_INFO(App, "Window hidden for " << kReleaseAfterMs / 1000 << " s, releasing memory");
+        settings_window_.reset();
+        malloc_trim(0);
+    }
+
+    /**
+     * @brief Hook the frame clock so every frame is recorded in the trace
+     *
+     * Called on realize, when the window's frame clock becomes available.
+     */
+    void connect_frame_tracing()
+    {
+        GdkFrameClock *clock = gtk_widget_get_frame_clock(GTK_WIDGET(gobj()));
+        if (clock == nullptr)
+        {
+            return;
+        }
+        g_signal_connect(clock, "before-paint", G_CALLBACK(&MainWindow::on_frame_before_paint), this);
+        g_signal_connect(clock, "after-paint", G_CALLBACK(&MainWindow::on_frame_after_paint), this);
+    }
+
+    /**
+     * @brief Frame clock callback marking the start of a frame
+     */
+    static void on_frame_before_paint(GdkFrameClock * /*clock*/, gpointer user_data)
+    {
+        static_cast<MainWindow *>(user_data)->frame_start_us_ = Core::Trace::now_us();
+    }
+
+    /**
+     * @brief Frame clock callback recording the finished frame
+     */
+    static void on_frame_after_paint(GdkFrameClock *clock, gpointer user_data)
+    {
+        auto *self = static_cast<MainWindow *>(user_data);
+        Core::Trace::complete("frame", "frame", self->frame_start_us_,
+                              Core::Trace::now_us() - self->frame_start_us_,
+                              std::to_string(gdk_frame_clock_get_frame_counter(clock)));
     }
 
 private:
@@ -1013,6 +1566,26 @@ private:
     std::string initial_tab_;
     bool prevent_auto_loading_ = false;
     bool minimal_mode_ = false;
+    bool resident_ = false;
+
+    /// How long a page must stay selected to count as a visit
+    static constexpr unsigned int kVisitSettleMs = 300;
+    /// How many predicted tabs to build ahead of a visit
+    static constexpr std::size_t kSpeculativeTabs = 2;
+    bool preload_enabled_ = true;      ///< Whether predicted tabs are built ahead
+    std::size_t preload_limit_kb_ = 0; ///< No preloading above this resident size
+    sigc::connection visit_timer_;     ///< Pending on_visit_settled()
+    sigc::connection speculation_;     ///< Pending speculative build
+    std::string visited_tab_;          ///< Tab counted by the last on_visit_settled()
+    std::int64_t evict_after_us_ = 0;  ///< Unvisited time before a tab is evicted, 0 for never
+    sigc::connection eviction_timer_;  ///< Pending evict_idle_tabs()
+    bool rebuilding_ = false;          ///< apply_tab_settings() is moving pages
+    /// Pending apply_tab_settings() after a settings change
+    sigc::connection tab_settings_pending_;
+
+    /// How long the resident window must stay hidden before memory is released
+    static constexpr unsigned int kReleaseAfterMs = 5 * 60 * 1000;
+    sigc::connection release_timer_;
 
     // Tracks tab widgets and their loading state
     struct TabInfo
@@ -1020,7 +1593,10 @@ private:
         Gtk::Widget *widget;
         int page_num;
         bool loaded;
-        bool loading; // Indicates if the tab is currently being loaded
+        bool loading;                   // Indicates if the tab is currently being loaded
+        bool speculative = false;       // Built ahead of a predicted visit, not visited yet
+        bool evicted = false;           // Torn down by evict_tab(); rebuilt without a spinner
+        std::int64_t last_visit_us = 0; // When the tab was last left or built (Trace clock)
     };
     std::map<std::string, TabInfo> tab_widgets_;
 
@@ -1032,8 +1608,186 @@ private:
     // Settings window
     std::unique_ptr<Settings::SettingsWindow> settings_window_;
 
-    // CSS provider for global styles
-    Glib::RefPtr<Gtk::CssProvider> css_provider_;
+    // Start of the frame currently being painted (tracing only)
+    std::int64_t frame_start_us_ = 0;
+};
+
+/**
+ * @brief Print the metrics table to stderr
+ *
+ * Registered as an exit handler when --stats is given. The window exits
+ * through Core::Shutdown::exit(), which ends in std::quick_exit, so it is
+ * registered for both exit paths.
+ */
+static void print_stats()
+{
+    std::cerr << Core::Metrics::to_text();
+}
+
+/**
+ * @brief SIGUSR1 handler that dumps the metrics as JSON
+ * @param user_data Unused
+ * @return G_SOURCE_CONTINUE to keep the handler installed
+ *
+ * Runs on the main loop (via g_unix_signal_add), so it is safe to do
+ * regular file I/O here. The dump goes to $XDG_RUNTIME_DIR when available.
+ */
+static gboolean on_stats_signal(gpointer /*user_data*/)
+{
+    const char *runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+    std::string path = std::string(runtime_dir ? runtime_dir : "/tmp") +
+                       "/ultimate-control-stats-" + std::to_string(getpid()) + ".json";
+
+    if (Core::Metrics::dump_json(path))
+    {
+        UC_LOG_INFO(App, "Wrote metrics to " << path);
+    }
+    else
+    {
+        UC_LOG_WARN(App, "Failed to write metrics to " << path);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @struct WindowOptions
+ * @brief Command-line options that choose how the window is shown
+ *
+ * These are parsed from every command line the primary instance receives,
+ * including the ones forwarded from later launches (`ultimate-control -w`
+ * while a --daemon instance is running).
+ */
+struct WindowOptions
+{
+    bool volume = false;
+    bool wifi = false;
+    bool bluetooth = false;
+    bool display = false;
+    bool power = false;
+    bool settings = false;
+    bool minimal = false;
+    bool floating = false;
+
+    /**
+     * @brief Register the window options in an option group
+     * @param group The group to add the entries to
+     */
+    void add_to(Glib::OptionGroup &group)
+    {
+        Glib::OptionEntry volume_entry;
+        volume_entry.set_long_name("volume");
+        volume_entry.set_short_name('v');
+        volume_entry.set_description("Start with the Volume tab selected");
+        group.add_entry(volume_entry, volume);
+
+        Glib::OptionEntry wifi_entry;
+        wifi_entry.set_long_name("wifi");
+        wifi_entry.set_short_name('w');
+        wifi_entry.set_description("Start with the WiFi tab selected");
+        group.add_entry(wifi_entry, wifi);
+
+        Glib::OptionEntry bluetooth_entry;
+        bluetooth_entry.set_long_name("bluetooth");
+        bluetooth_entry.set_short_name('b');
+        bluetooth_entry.set_description("Start with the Bluetooth tab selected");
+        group.add_entry(bluetooth_entry, bluetooth);
+
+        Glib::OptionEntry display_entry;
+        display_entry.set_long_name("display");
+        display_entry.set_short_name('d');
+        display_entry.set_description("Start with the Display tab selected");
+        group.add_entry(display_entry, display);
+
+        Glib::OptionEntry power_entry;
+        power_entry.set_long_name("power");
+        power_entry.set_short_name('p');
+        power_entry.set_description("Start with the Power tab selected");
+        group.add_entry(power_entry, power);
+
+        Glib::OptionEntry settings_entry;
+        settings_entry.set_long_name("settings");
+        settings_entry.set_short_name('s');
+        settings_entry.set_description("Start with the Settings tab selected");
+        group.add_entry(settings_entry, settings);
+
+        Glib::OptionEntry minimal_entry;
+        minimal_entry.set_long_name("minimal");
+        minimal_entry.set_short_name('m');
+        minimal_entry.set_description("Start in minimal mode with notebook tabs hidden");
+        group.add_entry(minimal_entry, minimal);
+
+        Glib::OptionEntry floating_entry;
+        floating_entry.set_long_name("float");
+        floating_entry.set_short_name('f');
+        floating_entry.set_description("Start as a floating window on tiling window managers");
+        group.add_entry(floating_entry, floating);
+    }
+
+    /**
+     * @brief Parse the window options out of a forwarded command line
+     * @param command_line The command line received by the primary instance
+     * @return True if the command line was parsed successfully
+     *
+     * Options that are not window options (--log-level, --daemon, ...) only
+     * apply to the launching process and are ignored here.
+     */
+    bool parse(const Glib::RefPtr<Gio::ApplicationCommandLine> &command_line)
+    {
+        Glib::OptionContext context;
+        Glib::OptionGroup group("options", "Application Options", "Application options");
+        add_to(group);
+        context.set_main_group(group);
+        context.set_help_enabled(false);
+        context.set_ignore_unknown_options(true);
+
+        int argc = 0;
+        char **argv = command_line->get_arguments(argc);
+        bool ok = true;
+        try
+        {
+            context.parse(argc, argv);
+        }
+        catch (const Glib::Error &error)
+        {
+            UC_LOG_WARN(App, "Error parsing forwarded command line: " << error.what());
+            ok = false;
+        }
+        g_strfreev(argv);
+        return ok;
+    }
+
+    /**
+     * @brief Tab to show, based on the selected options
+     * @return The tab ID, or an empty string for the default tab
+     */
+    std::string initial_tab() const
+    {
+        if (volume)
+        {
+            return "volume";
+        }
+        if (wifi)
+        {
+            return "wifi";
+        }
+        if (bluetooth)
+        {
+            return "bluetooth";
+        }
+        if (display)
+        {
+            return "display";
+        }
+        if (power)
+        {
+            return "power";
+        }
+        if (settings)
+        {
+            return "settings";
+        }
+        return "";
+    }
 };
 
 /**
@@ -1044,75 +1798,92 @@ private:
  */
 int main(int argc, char *argv[])
 {
+    // `ultimate-control get|set ...` answers from the core library and exits
+    // before any GTK, display or session-bus setup
+    if (Cli::wants_cli(argc, argv))
+    {
+        return Cli::run(argc, argv);
+    }
+
     // Set up command-line option parsing
     Glib::OptionContext context;
     Glib::OptionGroup group("options", "Application Options", "Application options");
 
     // Variables to store command-line option values
-    bool volume_opt = false;
-    bool wifi_opt = false;
-    bool bluetooth_opt = false;
-    bool display_opt = false;
-    bool power_opt = false;
-    bool settings_opt = false;
-    bool minimal_opt = false;
-    bool floating_opt = false;
+    WindowOptions window_opts;
+    bool daemon_opt = false;
+    Glib::ustring log_level_opt;
+    Glib::ustring log_file_opt;
+    bool stats_opt = false;
+    std::string trace_opt;
+    bool debug_stalls_opt = false;
+    int check_stalls_opt = 0;
+    bool audit_wakeups_opt = false;
+    int self_test_idle_opt = 0;
 
     // Define the command-line option entries
-    Glib::OptionEntry volume_entry;
-    volume_entry.set_long_name("volume");
-    volume_entry.set_short_name('v');
-    volume_entry.set_description("Start with the Volume tab selected");
-    group.add_entry(volume_entry, volume_opt);
-
-    Glib::OptionEntry wifi_entry;
-    wifi_entry.set_long_name("wifi");
-    wifi_entry.set_short_name('w');
-    wifi_entry.set_description("Start with the WiFi tab selected");
-    group.add_entry(wifi_entry, wifi_opt);
-
-    Glib::OptionEntry bluetooth_entry;
-    bluetooth_entry.set_long_name("bluetooth");
-    bluetooth_entry.set_short_name('b');
-    bluetooth_entry.set_description("Start with the Bluetooth tab selected");
-    group.add_entry(bluetooth_entry, bluetooth_opt);
-
-    Glib::OptionEntry display_entry;
-    display_entry.set_long_name("display");
-    display_entry.set_short_name('d');
-    display_entry.set_description("Start with the Display tab selected");
-    group.add_entry(display_entry, display_opt);
-
-    Glib::OptionEntry power_entry;
-    power_entry.set_long_name("power");
-    power_entry.set_short_name('p');
-    power_entry.set_description("Start with the Power tab selected");
-    group.add_entry(power_entry, power_opt);
-
-    Glib::OptionEntry settings_entry;
-    settings_entry.set_long_name("settings");
-    settings_entry.set_short_name('s');
-    settings_entry.set_description("Start with the Settings tab selected");
-    group.add_entry(settings_entry, settings_opt);
-
-    Glib::OptionEntry minimal_entry;
-    minimal_entry.set_long_name("minimal");
-    minimal_entry.set_short_name('m');
-    minimal_entry.set_description("Start in minimal mode with notebook tabs hidden");
-    group.add_entry(minimal_entry, minimal_opt);
-
-    Glib::OptionEntry floating_entry;
-    floating_entry.set_long_name("float");
-    floating_entry.set_short_name('f');
-    floating_entry.set_description("Start as a floating window on tiling window managers");
-    group.add_entry(floating_entry, floating_opt);
+    window_opts.add_to(group);
+
+    Glib::OptionEntry daemon_entry;
+    daemon_entry.set_long_name("daemon");
+    daemon_entry.set_description("Stay resident without a window; later launches show it instantly");
+    group.add_entry(daemon_entry, daemon_opt);
+
+    Glib::OptionEntry log_level_entry;
+    log_level_entry.set_long_name("log-level");
+    log_level_entry.set_arg_description("LEVEL");
+    log_level_entry.set_description("Minimum log level: trace, debug, info, warn, error or off (default: warn)");
+    group.add_entry(log_level_entry, log_level_opt);
+
+    Glib::OptionEntry log_file_entry;
+    log_file_entry.set_long_name("log-file");
+    log_file_entry.set_arg_description("FILE");
+    log_file_entry.set_description("Append log output to FILE instead of journald/stderr");
+    group.add_entry(log_file_entry, log_file_opt);
+
+    Glib::OptionEntry stats_entry;
+    stats_entry.set_long_name("stats");
+    stats_entry.set_description("Print counters and latency histograms on exit");
+    group.add_entry(stats_entry, stats_opt);
+
+    Glib::OptionEntry trace_entry;
+    trace_entry.set_long_name("trace");
+    trace_entry.set_arg_description("FILE");
+    trace_entry.set_description("Write a Chrome trace-event JSON file (open in Perfetto) on exit");
+    group.add_entry_filename(trace_entry, trace_opt);
+
+    Glib::OptionEntry debug_stalls_entry;
+    debug_stalls_entry.set_long_name("debug-stalls");
+    debug_stalls_entry.set_description("Report main-loop iterations longer than 16/50/100 ms");
+    group.add_entry(debug_stalls_entry, debug_stalls_opt);
+
+    Glib::OptionEntry check_stalls_entry;
+    check_stalls_entry.set_long_name("check-stalls");
+    check_stalls_entry.set_arg_description("SECONDS");
+    check_stalls_entry.set_description("Build every tab, run for SECONDS and exit 1 if the main loop stalled for 100 ms or more");
+    group.add_entry(check_stalls_entry, check_stalls_opt);
+
+    Glib::OptionEntry audit_wakeups_entry;
+    audit_wakeups_entry.set_long_name("audit-wakeups");
+    audit_wakeups_entry.set_description("Count main-loop wakeups by cause (timer or file descriptor) for --stats");
+    group.add_entry(audit_wakeups_entry, audit_wakeups_opt);
+
+    Glib::OptionEntry self_test_idle_entry;
+    self_test_idle_entry.set_long_name("self-test-idle");
+    self_test_idle_entry.set_arg_description("SECONDS");
+    self_test_idle_entry.set_description("Hide the window for SECONDS and exit 1 if any timer woke the main loop");
+    group.add_entry(self_test_idle_entry, self_test_idle_opt);
 
     // Add the option group to the parsing context
     context.set_main_group(group);
 
+    // Parse a copy of argv: the original is forwarded to a running instance
+    std::vector<char *> parse_argv(argv, argv + argc);
+    int parse_argc = argc;
+    char **parse_args = parse_argv.data();
     try
     {
-        context.parse(argc, argv);
+        context.parse(parse_argc, parse_args);
     }
     catch (const Glib::Error &error)
     {
@@ -1120,46 +1891,160 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    // Determine which tab to show initially based on command-line options
-    std::string initial_tab;
-    if (volume_opt)
-    {
-        initial_tab = "volume";
-    }
-    else if (wifi_opt)
+    // Start the logger before anything else produces output
+    Core::Log::Level log_level = Core::Log::Level::Warn;
+    if (!log_level_opt.empty() && !Core::Log::parse_level(log_level_opt, log_level))
     {
-        initial_tab = "wifi";
+        std::cerr << "Unknown log level: " << log_level_opt << std::endl;
+        return 1;
     }
-    else if (bluetooth_opt)
+    if (log_file_opt.empty())
     {
-        initial_tab = "bluetooth";
+        Core::Log::init(log_level);
     }
-    else if (display_opt)
+    else
     {
-        initial_tab = "display";
+        Core::Log::init(log_level, Core::Log::Sink::File, log_file_opt);
     }
-    else if (power_opt)
+
+    if (!trace_opt.empty())
     {
-        initial_tab = "power";
+        Core::Trace::start(trace_opt);
+        Core::Trace::set_thread_name("main");
     }
-    else if (settings_opt)
+
+    if (stats_opt)
     {
-        initial_tab = "settings";
+        std::atexit(print_stats);
+        std::at_quick_exit(print_stats);
     }
 
-    // Check if floating mode should be enabled from settings
-    // Command-line option takes precedence over settings
-    if (!floating_opt)
+    // Initialize GTK application with unique identifier. Later launches find
+    // this instance on the session bus and forward their command line to it.
+    auto app = Gtk::Application::create("com.felipefma.ultimatecontrol", Gio::APPLICATION_HANDLES_COMMAND_LINE);
+    std::unique_ptr<MainWindow> window;
+    std::unique_ptr<Cli::ControlServer> control_server;
+
+    // Set by a self-check (--check-stalls, --self-test-idle) to become the exit status
+    int self_test_status = -1;
+    auto finish_self_test = [&](int status)
     {
-        floating_opt = Core::get_setting("floating", "0") == "1";
-    }
+        self_test_status = status;
+        app->quit();
+    };
+
+    // Only the primary instance gets here
+    app->signal_startup().connect([&]()
+                                  {
+        // Dump metrics as JSON on SIGUSR1
+        g_unix_signal_add(SIGUSR1, on_stats_signal, nullptr);
+
+        // Watch the main loop before building the window so slow constructors are reported
+        if (debug_stalls_opt || check_stalls_opt > 0)
+        {
+            Core::StallDetector::start();
+        }
+
+        // Classify every poll() wakeup so idle CPU usage can be attributed
+        if (audit_wakeups_opt || self_test_idle_opt > 0)
+        {
+            Core::Wakeups::enable_audit();
+        }
+
+        // Map the state saved by the last run so tabs can paint it at once;
+        // pending writes land on disk however the process ends
+        Core::WarmCache::load();
+        Core::Shutdown::add_flush([]() { Core::WarmCache::flush(); });
+        std::atexit(&Core::Shutdown::flush);
 
-    // Initialize GTK application with unique identifier
-    auto app = Gtk::Application::create(argc, argv, "com.felipefma.ultimatecontrol");
+        // Apply edits to settings.conf while running
+        Core::Config::watch();
+
+        // Serve get/set/subscribe on $XDG_RUNTIME_DIR/ultimate-control.sock
+        control_server = std::make_unique<Cli::ControlServer>();
+        std::string control_error;
+        if (control_server->start(control_error))
+        {
+            control_server->signal_changed().connect([&window](const std::string &subsystem)
+                                                     {
+                if (window)
+                {
+                    window->refresh_tab(subsystem);
+                } });
+        }
+        else
+        {
+            UC_LOG_WARN(App, "Control socket disabled: " << control_error);
+            control_server.reset();
+        }
+
+        if (daemon_opt)
+        {
+            // Keep running with no visible window
+            app->hold();
+            UC_LOG_INFO(App, "Running as resident daemon");
+        } });
+
+    // Runs in the primary instance for its own command line and for every
+    // command line forwarded from a later launch
+    app->signal_command_line().connect([&](const Glib::RefPtr<Gio::ApplicationCommandLine> &command_line) -> int
+                                       {
+        WindowOptions opts;
+        if (!opts.parse(command_line))
+        {
+            return 1;
+        }
+        const std::string tab = opts.initial_tab();
+
+        if (!window)
+        {
+            // Check if floating mode should be enabled from settings
+            // Command-line option takes precedence over settings
+            bool floating = opts.floating || Core::Config::get_bool("general.floating", false);
+
+            // Create the main window with the initial tab, minimal mode, and floating mode settings
+            window = std::make_unique<MainWindow>(tab, opts.minimal, floating, daemon_opt);
+            app->add_window(*window);
+
+            if (check_stalls_opt > 0)
+            {
+                // Build every tab so slow constructors are caught as well
+                window->preload_tabs();
+                window->present();
+                Core::SelfTest::check_stalls(static_cast<unsigned int>(check_stalls_opt), finish_self_test);
+                return 0;
+            }
+            if (self_test_idle_opt > 0)
+            {
+                // Show the window, let startup work finish, then leave it hidden
+                window->present();
+                Core::Wakeups::timeout_once([&window, &finish_self_test, self_test_idle_opt]()
+                                            {
+                    window->hide();
+                    Core::SelfTest::expect_idle(static_cast<unsigned int>(self_test_idle_opt), finish_self_test); },
+                                            2000);
+                return 0;
+            }
+
+            if (daemon_opt && !command_line->is_remote())
+            {
+                // Build the tabs now so the first activation is instant
+                window->preload_tabs();
+                if (tab.empty())
+                {
+                    return 0;
+                }
+            }
+            window->present();
+            return 0;
+        }
 
-    // Create the main window with the initial tab, minimal mode, and floating mode settings
-    MainWindow window(initial_tab, minimal_opt, floating_opt);
+        UC_LOG_DEBUG(App, "Activated by forwarded command line" << (tab.empty() ? "" : ", tab " + tab));
+        window->show_tab(tab);
+        return 0; },
+                                       false);
 
-    // Run the application
-    return app->run(window);
+    // Run the application; in a secondary instance this only forwards argv
+    int status = app->run(argc, argv);
+    return self_test_status >= 0 ? self_test_status : status;
 }
@@ -0,0 +1,129 @@
+/**
+ * @file PowerBackend.cpp
+ * @brief powerprofilesctl implementation of the power backend
+ *
+ * This file implements the system PowerBackend, which runs the configured
+ * power commands through the shell and manages profiles with the
+ * powerprofilesctl utility, and the runtime choice of backend.
+ */
+
+#include "PowerBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Metrics.hpp"
+#include <cstdlib>   // for std::system
+#include <cstdio>    // for popen, pclose
+#include <array>     // for std::array
+
+namespace Power {
+
+namespace {
+/// Counts every power command and powerprofilesctl invocation
+const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+
+/**
+ * @class ProfilesctlBackend
+ * @brief Power backend running a process for every operation
+ */
+class ProfilesctlBackend : public PowerBackend {
+public:
+    bool run(const std::string& command) override {
+        Core::Metrics::increment(spawn_counter);
+        return std::system(command.c_str()) == 0;
+    }
+
+    /**
+     * @brief Parse the output of "powerprofilesctl list"
+     */
+    std::vector<std::string> list_profiles() override {
+        std::vector<std::string> profiles;           // List to store profile names
+        std::string cmd = "powerprofilesctl list";   // Command to list profiles
+        std::array<char, 2048> buffer;               // Buffer for command output
+        std::string result;                          // Complete command output
+
+        // Execute the command and read its output
+        Core::Metrics::increment(spawn_counter);
+        FILE* pipe = popen(cmd.c_str(), "r");
+        if (!pipe) return profiles;  // Return empty list if command fails
+
+        // Read all output into the result string
+        while (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
+            result += buffer.data();
+        }
+        pclose(pipe);
+
+        // Parse the output line by line
+        size_t pos = 0;
+        while ((pos = result.find('\n')) != std::string::npos) {
+            std::string line = result.substr(0, pos);  // Extract one line
+            result.erase(0, pos + 1);                  // Remove processed line
+
+            // Remove leading/trailing whitespace from the line
+            line.erase(0, line.find_first_not_of(" \t"));
+            line.erase(line.find_last_not_of(" \t") + 1);
+
+            // Skip empty lines
+            if (line.empty()) continue;
+
+            // If line starts with '*' (current profile), remove the asterisk
+            if (line[0] == '*') {
+                line = line.substr(1);  // Remove the asterisk
+                line.erase(0, line.find_first_not_of(" \t"));  // Remove whitespace after asterisk
+            }
+
+            // If line ends with ':', it's a profile name (format: "profile_name:")
+            if (!line.empty() && line.back() == ':') {
+                line.pop_back();  // Remove the colon
+
+                // Clean up the profile name
+                line.erase(0, line.find_first_not_of(" \t"));
+                line.erase(line.find_last_not_of(" \t") + 1);
+
+                // Add non-empty profile names to the list
+                if (!line.empty()) {
+                    profiles.push_back(line);
+                }
+            }
+        }
+        return profiles;
+    }
+
+    std::string current_profile() override {
+        std::string cmd = "powerprofilesctl get";  // Command to get current profile
+        std::array<char, 128> buffer;               // Buffer for command output
+        std::string result;                         // Result string
+
+        // Execute the command and read its output
+        Core::Metrics::increment(spawn_counter);
+        FILE* pipe = popen(cmd.c_str(), "r");
+        if (!pipe) return "";  // Return empty string if command fails
+
+        // Read the first line of output (should contain the profile name)
+        if (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
+            result = buffer.data();
+        }
+        pclose(pipe);
+
+        // Remove trailing newline from the result
+        if (!result.empty() && result.back() == '\n') {
+            result.pop_back();
+        }
+        return result;
+    }
+
+    bool set_profile(const std::string& profile) override {
+        std::string cmd = "powerprofilesctl set " + profile;
+        Core::Metrics::increment(spawn_counter);
+        return std::system(cmd.c_str()) == 0;
+    }
+};
+}
+
+std::unique_ptr<PowerBackend> PowerBackend::create() {
+    return Core::Backend::mock() ? create_mock() : create_system();
+}
+
+std::unique_ptr<PowerBackend> PowerBackend::create_system() {
+    return std::make_unique<ProfilesctlBackend>();
+}
+
+} // namespace Power
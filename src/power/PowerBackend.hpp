@@ -0,0 +1,68 @@
+/**
+ * @file PowerBackend.hpp
+ * @brief Power backend interface for Ultimate Control
+ *
+ * This file defines the PowerBackend interface which PowerManager uses to
+ * run power commands and manage power profiles, so the powerprofilesctl
+ * backend can be swapped for an in-process mock at runtime (see
+ * Core::Backend).
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Power {
+
+/**
+ * @class PowerBackend
+ * @brief Runs power commands and reads and changes power profiles
+ *
+ * Implementations must be safe to call from worker threads.
+ */
+class PowerBackend {
+public:
+    virtual ~PowerBackend() = default;
+
+    /**
+     * @brief Run a configured power command (shutdown, reboot, ...)
+     * @param command Shell command line
+     * @return false if the command failed
+     */
+    virtual bool run(const std::string& command) = 0;
+
+    /**
+     * @brief Names of the available power profiles; empty on failure
+     */
+    virtual std::vector<std::string> list_profiles() = 0;
+
+    /**
+     * @brief Name of the active power profile; empty on failure
+     */
+    virtual std::string current_profile() = 0;
+
+    /**
+     * @brief Switch to another power profile
+     * @return false if the change failed
+     */
+    virtual bool set_profile(const std::string& profile) = 0;
+
+    /**
+     * @brief The backend selected by Core::Backend
+     */
+    static std::unique_ptr<PowerBackend> create();
+
+    /**
+     * @brief Backend running the commands and powerprofilesctl
+     */
+    static std::unique_ptr<PowerBackend> create_system();
+
+    /**
+     * @brief Simulated profiles; commands are only logged
+     */
+    static std::unique_ptr<PowerBackend> create_mock();
+};
+
+} // namespace Power
@@ -21,13 +21,16 @@
  */
 namespace Power {
 
+class PowerBackend;
+
 /**
  * @class PowerManager
  * @brief Manages system power operations and power profiles
  *
  * Provides functionality for system power operations (shutdown, reboot, etc.)
  * and power profile management. Uses the PowerSettings class to retrieve
- * configured commands for power operations.
+ * configured commands for power operations, and a PowerBackend to run
+ * them and to manage profiles.
  */
 class PowerManager {
 public:
@@ -122,6 +125,7 @@ public:
 private:
     Callback callback_;                          ///< Callback function for update notifications
     std::shared_ptr<PowerSettings> settings_;    ///< Power settings object
+    std::unique_ptr<PowerBackend> backend_;      ///< Runs commands and manages profiles
 
     /**
      * @brief Notify listeners of power operations
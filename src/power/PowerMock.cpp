@@ -0,0 +1,108 @@
+/**
+ * @file PowerMock.cpp
+ * @brief Simulated power profiles for tests and benchmarks
+ *
+ * Power commands are logged and never run, so a mock session cannot shut
+ * the machine down.
+ */
+
+#include "PowerBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include <algorithm> // for std::find
+#include <mutex>     // for std::mutex
+
+namespace Power {
+
+namespace {
+
+/**
+ * @struct World
+ * @brief Profiles shared by every mock backend built from the same options
+ */
+struct World {
+    explicit World(std::uint64_t gen) : generation(gen), simulation("power") {}
+
+    const std::uint64_t generation;
+    Core::Backend::Simulation simulation;
+    std::mutex mutex; ///< Guards current
+    const std::vector<std::string> profiles = {"power-saver", "balanced", "performance"};
+    std::string current = "balanced";
+};
+
+/**
+ * @brief The profiles for the current options, rebuilt when they change
+ */
+std::shared_ptr<World> world() {
+    static std::mutex mutex;
+    static std::shared_ptr<World> current;
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::uint64_t generation = Core::Backend::generation();
+    if (!current || current->generation != generation) {
+        current = std::make_shared<World>(generation);
+    }
+    return current;
+}
+
+/**
+ * @brief Switch to a random profile, as power-profiles-daemon does on low battery
+ */
+void perturb() {
+    auto w = world();
+    std::lock_guard<std::mutex> lock(w->mutex);
+    w->current = w->profiles[static_cast<std::size_t>(
+        w->simulation.uniform(0, static_cast<int>(w->profiles.size()) - 1))];
+}
+
+/**
+ * @class MockBackend
+ * @brief Power backend answering from a World
+ */
+class MockBackend : public PowerBackend {
+public:
+    MockBackend() : world_(world()) {}
+
+    bool run(const std::string& command) override {
+        UC_LOG_INFO(Power, "Mock backend: not running '" << command << "'");
+        return world_->simulation.call();
+    }
+
+    std::vector<std::string> list_profiles() override {
+        if (!world_->simulation.call()) {
+            return {};
+        }
+        return world_->profiles;
+    }
+
+    std::string current_profile() override {
+        if (!world_->simulation.call()) {
+            return "";
+        }
+        std::lock_guard<std::mutex> lock(world_->mutex);
+        return world_->current;
+    }
+
+    bool set_profile(const std::string& profile) override {
+        if (!world_->simulation.call()) {
+            return false;
+        }
+        if (std::find(world_->profiles.begin(), world_->profiles.end(), profile) == world_->profiles.end()) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(world_->mutex);
+        world_->current = profile;
+        return true;
+    }
+
+private:
+    std::shared_ptr<World> world_;
+};
+
+}
+
+std::unique_ptr<PowerBackend> PowerBackend::create_mock() {
+    Core::Backend::start_storm("power", perturb);
+    return std::make_unique<MockBackend>();
+}
+
+} // namespace Power
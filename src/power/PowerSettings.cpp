@@ -8,33 +8,25 @@
  */
 
 #include "PowerSettings.hpp"
-#include <fstream>    // for std::ifstream, std::ofstream
-#include <iostream>   // for std::cerr
-#include <sys/stat.h> // for mkdir
-#include <sys/types.h>
+#include "core/Config.hpp"
 
 namespace Power
 {
 
+    namespace
+    {
+        const std::string kCommandPrefix = "power.command.";
+        const std::string kKeybindPrefix = "power.keybind.";
+    }
+
     /**
      * @brief Constructor for the power settings manager
      *
-     * Initializes default power commands and loads any existing settings
-     * from the configuration file.
+     * Initializes default power commands and loads any stored settings
+     * from Core::Config.
      */
     PowerSettings::PowerSettings()
     {
-        // Determine the configuration file path based on the user's home directory
-        const char *home_dir = getenv("HOME");
-        if (home_dir)
-        {
-            config_path_ = std::string(home_dir) + "/.config/ultimate-control/power.conf";
-        }
-        else
-        {
-            config_path_ = "/tmp/ultimate-control-power.conf";
-        }
-
         // Initialize default commands for power actions
         commands_["shutdown"] = "systemctl poweroff";
         commands_["reboot"] = "systemctl reboot";
@@ -49,7 +41,7 @@ namespace Power
         keybinds_["hibernate"] = "H";
         keybinds_["lock"] = "L";
 
-        // Load any existing settings from the configuration file
+        // Load any stored settings over the defaults
         load();
     }
 
@@ -124,115 +116,41 @@ namespace Power
     }
 
     /**
-     * @brief Load settings from the configuration file
+     * @brief Load settings from Core::Config
      *
-     * Reads power settings from the configuration file. If the file
-     * doesn't exist or can't be read, default settings are used.
+     * Stored commands and keybinds replace the defaults; actions that are
+     * not stored keep theirs.
      */
     void PowerSettings::load()
     {
-        // Try to open the configuration file
-        std::ifstream infile(config_path_);
-        if (!infile.is_open())
+        for (const auto &key : Core::Config::keys(kCommandPrefix))
         {
-            // File doesn't exist or can't be opened, use defaults
-            return;
+            commands_[key.substr(kCommandPrefix.size())] = Core::Config::get_string(key);
         }
-
-        // Read the file line by line
-        std::string line;
-        while (std::getline(infile, line))
+        for (const auto &key : Core::Config::keys(kKeybindPrefix))
         {
-            // Skip empty lines and comment lines (starting with #)
-            if (line.empty() || line[0] == '#')
-            {
-                continue;
-            }
-
-            // Find the delimiter between key and value (format: "key=value")
-            size_t delimiter_pos = line.find('=');
-            if (delimiter_pos == std::string::npos)
-            {
-                // Skip lines without a delimiter
-                continue;
-            }
-
-            // Extract the key and value
-            std::string key = line.substr(0, delimiter_pos);
-            std::string value = line.substr(delimiter_pos + 1);
-
-            // Store keybinds and commands separately
-            if (key.rfind("keybind_", 0) == 0)
-            {
-                // key starts with "keybind_"
-                std::string action = key.substr(8); // after "keybind_"
-                keybinds_[action] = value;
-            }
-            else
-            {
-                commands_[key] = value;
-            }
+            keybinds_[key.substr(kKeybindPrefix.size())] = Core::Config::get_string(key);
         }
     }
 
     /**
      * @brief Save settings to the configuration file
      *
-     * Writes the current power settings to the configuration file.
-     * Creates the configuration directory if it doesn't exist.
+     * Stores the current power settings in Core::Config, which writes
+
+     * the file shortly after, off the UI thread.
      */
     void PowerSettings::save() const
     {
-        // Make sure the configuration directory exists
-        ensure_config_dir();
-
-        // Try to open the configuration file for writing
-        std::ofstream outfile(config_path_);
-        if (!outfile.is_open())
-        {
-            std::cerr << "Failed to save power settings to " << config_path_ << std::endl;
-            return;
-        }
-
-        // Write a header comment to the file
-        outfile << "# Ultimate Control Power Settings\n";
-
-        // Write each command as a key-value pair
         for (const auto &pair : commands_)
         {
-            outfile << pair.first << "=" << pair.second << "\n";
+            Core::Config::set(kCommandPrefix + pair.first, pair.second);
         }
-
-        // Write each keybind as a key-value pair with "keybind_" prefix
         for (const auto &pair : keybinds_)
         {
-            outfile << "keybind_" << pair.first << "=" << pair.second << "\n";
-        }
-    }
-
-    /**
-     * @brief Create the configuration directory if it doesn't exist
-     *
-     * Creates all directories in the path to the configuration file
-     * if they don't already exist.
-     */
-    void PowerSettings::ensure_config_dir() const
-    {
-        // Extract the directory path from the configuration file path
-        std::string dir_path;
-        size_t last_slash = config_path_.find_last_of('/');
-        if (last_slash != std::string::npos)
-        {
-            dir_path = config_path_.substr(0, last_slash); // Get everything before the last slash
-        }
-
-        // Create the directory if it's not empty
-        if (!dir_path.empty())
-        {
-            // Create directory with parent directories using mkdir -p
-            std::string cmd = "mkdir -p " + dir_path;
-            std::system(cmd.c_str());
+            Core::Config::set(kKeybindPrefix + pair.first, pair.second);
         }
+        Core::Config::save();
     }
 
 } // namespace Power
\ No newline at end of file
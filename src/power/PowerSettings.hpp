@@ -25,7 +25,7 @@ namespace Power
      *
      * Provides functionality for loading, saving, and accessing power-related
      * settings such as commands for shutdown, reboot, suspend, etc.
-     * Settings are persisted to a configuration file.
+     * Settings are persisted through Core::Config.
      */
     class PowerSettings
     {
@@ -33,8 +33,8 @@ namespace Power
         /**
          * @brief Constructor
          *
-         * Initializes default power commands and loads any existing settings
-         * from the configuration file.
+         * Initializes default power commands and loads any stored settings
+         * from Core::Config.
          */
         PowerSettings();
 
@@ -84,18 +84,18 @@ namespace Power
         void set_keybind(const std::string &action, const std::string &keybind);
 
         /**
-         * @brief Load settings from the configuration file
+         * @brief Load settings from Core::Config
          *
-         * Reads power settings from the configuration file. If the file
-         * doesn't exist or can't be read, default settings are used.
+         * Actions that are not stored keep their default command and keybind.
          */
         void load();
 
         /**
          * @brief Save settings to the configuration file
          *
-         * Writes the current power settings to the configuration file.
-         * Creates the configuration directory if it doesn't exist.
+         * Stores the current power settings in Core::Config, which writes
+
+         * the file shortly after, off the UI thread.
          */
         void save() const;
 
@@ -111,15 +111,6 @@ namespace Power
         void set_show_keybind_hints(bool show) { show_keybind_hints_ = show; }
 
     private:
-        /**
-         * @brief Create the configuration directory if it doesn't exist
-         *
-         * Creates all directories in the path to the configuration file
-         * if they don't already exist.
-         */
-        void ensure_config_dir() const;
-
-        std::string config_path_;                     ///< Path to the configuration file
         std::map<std::string, std::string> commands_; ///< Map of action names to command strings
         std::map<std::string, std::string> keybinds_; ///< Map of action names to keybind strings
         bool show_keybind_hints_ = true;              ///< Whether to show keybind hints on buttons
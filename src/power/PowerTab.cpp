@@ -8,11 +8,26 @@
  */
 
 #include "PowerTab.hpp"
-#include <iostream>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/TabModule.hpp"
+#include "core/Staging.hpp"
+#include "core/WarmCache.hpp"
+#include <algorithm> // for std::find
+#include <utility>   // for std::pair
 
 namespace Power
 {
 
+    namespace
+    {
+        /// Counts lock command invocations
+        const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+
+        /// Warm cache section holding the profile list and active profile
+        const char *const kCacheSection = "power";
+    }
+
     /**
      * @brief Constructor for the power tab
      *
@@ -81,6 +96,7 @@ namespace Power
                         else if (gdk_keyval_to_unicode(event->keyval) == 'l' ||
                                  gdk_keyval_to_unicode(event->keyval) == 'L') {
                             if (settings->get_keybind("lock") == "L") {
+                                Core::Metrics::increment(spawn_counter);
                                 std::system(manager_->get_settings()->get_command("lock").c_str());
                                 return true;
                             }
@@ -118,7 +134,10 @@ namespace Power
         main_box_.pack_start(profiles_frame_, Gtk::PACK_SHRINK);
 
         show_all_children();
-        std::cout << "Power tab loaded!" << std::endl;
+        UC_LOG_DEBUG(Power, "Power tab loaded!");
+
+        // Query the live profiles off the main thread
+        refresh();
     }
 
     /**
@@ -126,6 +145,110 @@ namespace Power
      */
     PowerTab::~PowerTab() = default;
 
+    /**
+     * @brief Re-read the profile list and the active profile
+     *
+     * Used after startup and after an outside change. powerprofilesctl
+     * runs on the hydration thread; the selection is not written back.
+     */
+    void PowerTab::refresh()
+    {
+        using Profiles = std::pair<std::vector<std::string>, std::string>;
+        auto manager = manager_;
+        Core::Staging::hydrate(
+            *this, [manager]()
+            { return Profiles(manager->list_power_profiles(), manager->get_current_power_profile()); },
+            [this](const Profiles &result)
+            {
+                populate_profiles(result.first, result.second);
+                remember_state(result.first, result.second);
+            });
+    }
+
+    /**
+     * @brief Fill the profile dropdown without applying the selection
+     * @param profiles Available profiles
+     * @param current The profile to select
+     *
+     * Blocks the combo's change handler so the profile isn't written back.
+     */
+    void PowerTab::populate_profiles(const std::vector<std::string> &profiles, const std::string &current)
+    {
+        profile_changed_connection_.block();
+        profile_combo_.remove_all();
+        for (const auto &profile : profiles)
+        {
+            profile_combo_.append(profile);
+        }
+
+        // Set the currently active profile in the dropdown
+        if (!profiles.empty())
+        {
+            profile_combo_.set_sensitive(true);
+            if (std::find(profiles.begin(), profiles.end(), current) != profiles.end())
+            {
+                profile_combo_.set_active_text(current);
+            }
+            else
+            {
+                profile_combo_.set_active(0);
+            }
+        }
+        else
+        {
+            profile_combo_.set_sensitive(false);
+        }
+        profile_changed_connection_.unblock();
+    }
+
+    /**
+     * @brief Show the profiles saved by the last run, marked as stale
+     */
+    void PowerTab::show_cached_state()
+    {
+        Core::WarmCache::Reader reader;
+        std::string current;
+        std::uint32_t count = 0;
+        if (!Core::WarmCache::read(kCacheSection, reader) || !reader.str(current) || !reader.u32(count))
+        {
+            return;
+        }
+
+        std::vector<std::string> profiles;
+        for (std::uint32_t i = 0; i < count && reader.ok(); ++i)
+        {
+            std::string profile;
+            reader.str(profile);
+            profiles.push_back(profile);
+        }
+        if (!reader.ok())
+        {
+            return;
+        }
+
+        populate_profiles(profiles, current);
+        profiles_frame_.get_style_context()->add_class("stale");
+    }
+
+    /**
+     * @brief Save the live profiles to the warm cache and clear the stale marker
+     * @param profiles Available profiles
+     * @param current The active profile
+     */
+    void PowerTab::remember_state(const std::vector<std::string> &profiles, const std::string &current)
+    {
+        profiles_frame_.get_style_context()->remove_class("stale");
+
+        Core::WarmCache::Writer writer;
+        writer.str(current);
+        writer.u32(static_cast<std::uint32_t>(profiles.size()));
+        for (const auto &profile : profiles)
+        {
+            writer.str(profile);
+        }
+        Core::WarmCache::store(kCacheSection, writer.take());
+    }
+
     /**
      * @brief Create the system power section
      *
@@ -313,7 +436,9 @@ namespace Power
         lock_button_.set_always_show_image(true);
         lock_button_.set_tooltip_text("Lock the screen");
         lock_button_.signal_clicked().connect([this]()
-                                              { std::system(manager_->get_settings()->get_command("lock").c_str()); });
+                                              {
+                                                  Core::Metrics::increment(spawn_counter);
+                                                  std::system(manager_->get_settings()->get_command("lock").c_str()); });
         // Prevent tab navigation
         lock_button_.property_can_default() = false;
         lock_button_.property_can_focus() = false;
@@ -374,48 +499,18 @@ namespace Power
         profile_combo_.set_hexpand(true);
         profile_combo_.set_can_focus(false); // Prevent tab navigation to this dropdown
 
-        // Populate the dropdown with available power profiles
-        auto profiles = manager_->list_power_profiles();
-        profile_combo_.remove_all();
-        for (const auto &profile : profiles)
-        {
-            profile_combo_.append(profile);
-        }
-
-        // Set the currently active profile in the dropdown
-        if (!profiles.empty())
-        {
-            profile_combo_.set_sensitive(true);
-
-            auto current = manager_->get_current_power_profile();
-            bool found = false;
-            for (const auto &profile : profiles)
-            {
-                if (profile == current)
-                {
-                    profile_combo_.set_active_text(profile);
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-            {
-                profile_combo_.set_active(0);
-            }
-        }
-        else
-        {
-            profile_combo_.set_sensitive(false);
-        }
-
         // Connect the change signal to update the power profile
-        profile_combo_.signal_changed().connect([this]()
+        profile_changed_connection_ = profile_combo_.signal_changed().connect([this]()
                                                 {
         auto selected = profile_combo_.get_active_text();
         if (!selected.empty()) {
             manager_->set_power_profile(selected);
         } });
 
+        // Start from the last run's profiles; refresh() replaces them
+        profile_combo_.set_sensitive(false);
+        show_cached_state();
+
         // Add the dropdown to the content container
         profiles_content_box_.pack_start(profile_combo_, Gtk::PACK_SHRINK);
 
@@ -630,3 +725,6 @@ namespace Power
     }
 
 } // namespace Power
+
+/// Factory looked up when libuc-power.so is loaded
+UC_TAB_MODULE("power", Power::PowerTab);
@@ -13,6 +13,8 @@
 #include "PowerManager.hpp"
 #include "PowerSettingsDialog.hpp"
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * @namespace Power
@@ -43,6 +45,11 @@ namespace Power
          */
         virtual ~PowerTab();
 
+        /**
+         * @brief Re-read the profile list and the active profile
+         */
+        void refresh();
+
     private:
         /**
          * @brief Accelerator group for keyboard shortcuts (user-configurable)
@@ -72,6 +79,25 @@ namespace Power
          */
         void create_power_profiles_section();
 
+        /**
+         * @brief Fill the profile dropdown without applying the selection
+         * @param profiles Available profiles
+         * @param current The profile to select
+         */
+        void populate_profiles(const std::vector<std::string> &profiles, const std::string &current);
+
+        /**
+         * @brief Show the profiles saved by the last run, marked as stale
+         */
+        void show_cached_state();
+
+        /**
+         * @brief Save the live profiles to the warm cache and clear the stale marker
+         * @param profiles Available profiles
+         * @param current The active profile
+         */
+        void remember_state(const std::vector<std::string> &profiles, const std::string &current);
+
         /**
          * @brief Handler for settings button clicks
          *
@@ -147,6 +173,7 @@ namespace Power
         Gtk::Label profiles_label_;       ///< Label for the power profiles section
         Gtk::Box profiles_content_box_;   ///< Container for power profiles content
         Gtk::ComboBoxText profile_combo_; ///< Dropdown for selecting power profiles
+        sigc::connection profile_changed_connection_; ///< Applies the profile picked in profile_combo_
     };
 
 } // namespace Power
@@ -7,14 +7,8 @@
  */
 
 #include "SettingsTab.hpp"
-#include "../core/Settings.hpp" // for Core::get_setting
-#include <iostream>
-#include <cstdlib>  // for std::exit
-#include <unistd.h> // for execl
-#include <limits.h> // for PATH_MAX
-#include <errno.h>  // for errno
-#include <string.h> // for strerror
-#include <fstream>  // for std::ifstream, std::ofstream
+#include "core/Config.hpp"
+#include "core/Log.hpp"
 
 namespace Settings
 {
@@ -70,7 +64,7 @@ namespace Settings
         update_tab_list();
 
         show_all_children();
-        std::cout << "Settings tab loaded!" << std::endl;
+        UC_LOG_DEBUG(Settings, "Settings tab loaded!");
     }
 
     /**
@@ -119,7 +113,7 @@ namespace Settings
         floating_check_.set_margin_start(8);
         floating_check_.set_margin_top(3);
         floating_check_.set_margin_bottom(3);
-        floating_check_.set_active(Core::get_setting("floating", "0") == "1");
+        floating_check_.set_active(Core::Config::get_bool("general.floating", false));
         floating_check_.set_can_focus(false); // Prevent tab navigation to this checkbox
 
         // Add a tooltip with more information
@@ -356,7 +350,8 @@ namespace Settings
     /**
      * @brief Handler for save button clicks
      *
-     * Saves the settings and restarts the application to apply changes.
+     * Saves the settings and notifies the settings changed callback, which
+     * applies tab changes without restarting.
      */
     void SettingsTab::on_save_clicked()
     {
@@ -365,65 +360,14 @@ namespace Settings
         settings_->save();
 
         // Save general settings to disk
-        std::string config_path = "/home/felipe/.config/ultimate-control/general.conf";
-        std::ofstream outfile(config_path);
-        if (outfile.is_open())
-        {
-            // Read existing settings first
-            std::map<std::string, std::string> settings;
-            std::ifstream infile(config_path);
-            if (infile.is_open())
-            {
-                std::string key, value;
-                while (infile >> key >> value)
-                {
-                    settings[key] = value;
-                }
-                infile.close();
-            }
+        Core::Config::set("general.floating", floating_check_.get_active());
+        Core::Config::save();
 
-            // Update with new floating setting
-            settings["floating"] = floating_check_.get_active() ? "1" : "0";
-
-            // Write all settings back
-            for (const auto &pair : settings)
-            {
-                outfile << pair.first << " " << pair.second << "\n";
-            }
-            outfile.close();
-        }
-
-        // Show a message dialog informing the user about the restart
-        Gtk::MessageDialog dialog(*dynamic_cast<Gtk::Window *>(get_toplevel()),
-                                  "Settings saved. The application will now restart to apply changes.",
-                                  false, Gtk::MESSAGE_INFO, Gtk::BUTTONS_OK, true);
-        dialog.run();
-
-        // Get the absolute path to the current executable for restart
-        char exe_path[PATH_MAX];
-        ssize_t len = readlink("/proc/self/exe", exe_path, sizeof(exe_path) - 1);
-        if (len != -1)
-        {
-            exe_path[len] = '\0';
-
-            // Log the restart attempt
-            std::cout << "Restarting application: " << exe_path << std::endl;
-
-            // Use execl to replace the current process with a new instance
-            // This is cleaner than using system() as it doesn't create a new process hierarchy
-            execl(exe_path, exe_path, nullptr);
-
-            // If execl fails (which it shouldn't if we reach this point), log the error
-            std::cerr << "Failed to restart application: " << strerror(errno) << std::endl;
-        }
-        else
+        // The main window applies tab changes in place
+        if (settings_changed_callback_)
         {
-            std::cerr << "Failed to get executable path: " << strerror(errno) << std::endl;
+            settings_changed_callback_();
         }
-
-        // As a fallback if we can't restart automatically,
-        // exit the application so the user can restart it manually
-        std::exit(0);
     }
 
     /**
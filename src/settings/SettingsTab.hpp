@@ -26,7 +26,7 @@ namespace Settings {
  *
  * Provides a user interface for configuring application settings,
  * including tab visibility and order. Changes are saved to a
- * configuration file and can trigger application restart.
+ * configuration file and applied to the main window in place.
  */
 class SettingsTab : public Gtk::Box {
 public:
@@ -112,7 +112,7 @@ private:
     /**
      * @brief Handler for save button clicks
      *
-     * Saves the settings and restarts the application to apply changes.
+     * Saves the settings and notifies the settings changed callback.
      */
     void on_save_clicked();
 
@@ -7,13 +7,11 @@
  */
 
 #include "SettingsWindow.hpp"
-#include <iostream>
-#include <fstream>
-#include <map>
-#include <cstdlib>
-#include <vector>
-#include <glibmm/base64.h>           // For base64 decoding
-#include <giomm/memoryinputstream.h> // For memory input stream
+#include "core/Assets.hpp"
+#include "core/Config.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/Wakeups.hpp"
 
 namespace Settings
 {
@@ -34,7 +32,8 @@ namespace Settings
           general_header_box_(Gtk::ORIENTATION_HORIZONTAL, 8),    // General header with 8px spacing
           tab_order_box_(Gtk::ORIENTATION_VERTICAL, 8),           // Tab order section with 8px spacing
           tab_order_header_box_(Gtk::ORIENTATION_HORIZONTAL, 8),  // Tab order header with 8px spacing
-          tab_list_box_(Gtk::ORIENTATION_VERTICAL, 5)             // Tab list with 5px spacing
+          tab_list_box_(Gtk::ORIENTATION_VERTICAL, 5),            // Tab list with 5px spacing
+          debug_box_(Gtk::ORIENTATION_VERTICAL, 8)                // Diagnostics section with 8px spacing
     {
         // Set up the dialog properties
         set_default_size(500, 400);
@@ -63,6 +62,9 @@ namespace Settings
         // Create the tab order configuration section
         create_tab_order_section();
 
+        // Create the hidden diagnostics section
+        create_debug_section();
+
         // Get the action area to customize the button layout
         Gtk::ButtonBox *action_area = get_action_area();
         action_area->set_layout(Gtk::BUTTONBOX_EDGE); // Use EDGE layout for proper spacing
@@ -129,7 +131,21 @@ namespace Settings
         update_tab_list();
 
         show_all_children();
-        std::cout << "Settings window created!" << std::endl;
+
+        // Ctrl+Shift+D reveals the diagnostics section
+        signal_key_press_event().connect(sigc::mem_fun(*this, &SettingsWindow::on_dialog_key_press), false);
+
+        // The dialog is reused; show what is stored now, not what was
+        // stored when it was built, so saving never undoes outside edits
+        signal_show().connect(sigc::mem_fun(*this, &SettingsWindow::reload_settings));
+        Core::Config::subscribe("general.floating", sigc::mem_fun(*this, &SettingsWindow::reload_floating));
+        Core::Config::subscribe("tabs.order", sigc::mem_fun(*this, &SettingsWindow::schedule_reload));
+        for (const auto &tab : settings_->get_all_tabs())
+        {
+            Core::Config::subscribe("tabs.enabled." + tab.id, sigc::mem_fun(*this, &SettingsWindow::schedule_reload));
+        }
+
+        UC_LOG_DEBUG(Settings, "Settings window created!");
     }
 
     /**
@@ -137,6 +153,49 @@ namespace Settings
      */
     SettingsWindow::~SettingsWindow() = default;
 
+    /**
+     * @brief Re-read the tab and general settings from Core::Config
+     *
+     * Called when the dialog is shown.
+     */
+    void SettingsWindow::reload_settings()
+    {
+        reload_floating();
+        reload_tab_list();
+    }
+
+    /**
+     * @brief Show the stored floating mode, dropping an unsaved toggle
+     */
+    void SettingsWindow::reload_floating()
+    {
+        floating_check_.set_active(Core::Config::get_bool("general.floating", false));
+    }
+
+    /**
+     * @brief Re-read the tab order and visibility and rebuild the list
+     */
+    void SettingsWindow::reload_tab_list()
+    {
+        reload_pending_.disconnect();
+        settings_->load();
+        update_tab_list();
+    }
+
+    /**
+     * @brief Rebuild the tab list once after a burst of tab key changes
+     *
+     * A reload of settings.conf notifies every changed key, and so does
+     * each of our own saves; the list is rebuilt once, in idle time.
+     */
+    void SettingsWindow::schedule_reload()
+    {
+        if (!reload_pending_.connected())
+        {
+            reload_pending_ = Core::Wakeups::idle_cancellable(sigc::mem_fun(*this, &SettingsWindow::reload_tab_list));
+        }
+    }
+
     /**
      * @brief Set the callback for settings changes
      * @param callback Function to call when settings are changed
@@ -206,28 +265,7 @@ namespace Settings
         floating_check_.set_margin_bottom(3);
         floating_check_.set_can_focus(false); // Prevent tab navigation to this checkbox
 
-        // Check if floating mode is enabled in settings
-        bool floating_enabled = false;
-        if (getenv("HOME"))
-        {
-            std::string config_path = std::string(getenv("HOME")) + "/.config/ultimate-control/general.conf";
-
-            std::ifstream config_file(config_path);
-            if (config_file.is_open())
-            {
-                std::string line;
-                while (std::getline(config_file, line))
-                {
-                    if (line.find("floating 1") != std::string::npos)
-                    {
-                        floating_enabled = true;
-                        break;
-                    }
-                }
-                config_file.close();
-            }
-        }
-        floating_check_.set_active(floating_enabled);
+        floating_check_.set_active(Core::Config::get_bool("general.floating", false));
 
         // About button is now added to the action area
 
@@ -243,6 +281,78 @@ namespace Settings
         content_box_.pack_start(general_settings_frame_, Gtk::PACK_SHRINK);
     }
 
+    /**
+     * @brief Create the hidden diagnostics section
+     *
+     * Creates a frame showing counters and latency histograms from the
+     * metrics registry. The frame is excluded from show_all_children() and
+     * only appears when toggled with Ctrl+Shift+D.
+     */
+    void SettingsWindow::create_debug_section()
+    {
+        debug_frame_.set_label("Diagnostics");
+        debug_frame_.set_shadow_type(Gtk::SHADOW_ETCHED_IN);
+        debug_frame_.set_margin_top(10);
+
+        debug_box_.set_margin_start(10);
+        debug_box_.set_margin_end(10);
+        debug_box_.set_margin_top(10);
+        debug_box_.set_margin_bottom(10);
+
+        // Monospace, selectable text so the numbers line up and can be copied
+        debug_label_.set_halign(Gtk::ALIGN_START);
+        debug_label_.set_selectable(true);
+        debug_label_.set_can_focus(false);
+
+        debug_refresh_button_.set_label("Refresh");
+        debug_refresh_button_.set_halign(Gtk::ALIGN_START);
+        debug_refresh_button_.set_can_focus(false);
+        debug_refresh_button_.signal_clicked().connect(sigc::mem_fun(*this, &SettingsWindow::refresh_debug_section));
+
+        debug_box_.pack_start(debug_label_, Gtk::PACK_SHRINK);
+        debug_box_.pack_start(debug_refresh_button_, Gtk::PACK_SHRINK);
+        debug_frame_.add(debug_box_);
+        debug_frame_.show_all_children();
+        debug_frame_.set_no_show_all(true);
+
+        content_box_.pack_start(debug_frame_, Gtk::PACK_SHRINK);
+    }
+
+    /**
+     * @brief Refresh the diagnostics section with a new metrics snapshot
+     */
+    void SettingsWindow::refresh_debug_section()
+    {
+        debug_label_.set_markup("<tt>" + Glib::Markup::escape_text(Core::Metrics::to_text()) + "</tt>");
+    }
+
+    /**
+     * @brief Handler for key presses on the dialog
+     * @param event The key event
+     * @return true if the event was handled, false otherwise
+     *
+     * Toggles the diagnostics section on Ctrl+Shift+D.
+     */
+    bool SettingsWindow::on_dialog_key_press(GdkEventKey *event)
+    {
+        const guint modifiers = event->state & gtk_accelerator_get_default_mod_mask();
+        if (modifiers == (GDK_CONTROL_MASK | GDK_SHIFT_MASK) &&
+            (event->keyval == GDK_KEY_D || event->keyval == GDK_KEY_d))
+        {
+            if (debug_frame_.get_visible())
+            {
+                debug_frame_.hide();
+            }
+            else
+            {
+                refresh_debug_section();
+                debug_frame_.show();
+            }
+            return true;
+        }
+        return false;
+    }
+
     /**
      * @brief Create the tab order configuration section
      *
@@ -461,7 +571,7 @@ namespace Settings
      * @param response_id The ID of the response (e.g., RESPONSE_CANCEL, RESPONSE_APPLY)
      *
      * Handles the dialog response signals. If RESPONSE_APPLY, saves the settings
-     * and restarts the application to apply changes. Otherwise, just closes the dialog.
+     * and notifies the settings changed callback. Otherwise, just closes the dialog.
      */
     void SettingsWindow::on_response(int response_id)
     {
@@ -471,33 +581,8 @@ namespace Settings
             settings_->save();
 
             // Save general settings to disk
-            std::string config_path = "/home/felipe/.config/ultimate-control/general.conf";
-            std::ofstream outfile(config_path);
-            if (outfile.is_open())
-            {
-                // Read existing settings first
-                std::map<std::string, std::string> settings;
-                std::ifstream infile(config_path);
-                if (infile.is_open())
-                {
-                    std::string key, value;
-                    while (infile >> key >> value)
-                    {
-                        settings[key] = value;
-                    }
-                    infile.close();
-                }
-
-                // Update with new floating setting
-                settings["floating"] = floating_check_.get_active() ? "1" : "0";
-
-                // Write all settings back
-                for (const auto &pair : settings)
-                {
-                    outfile << pair.first << " " << pair.second << "\n";
-                }
-                outfile.close();
-            }
+            Core::Config::set("general.floating", floating_check_.get_active());
+            Core::Config::save();
 
             // Notify that settings have changed
             if (settings_changed_callback_)
@@ -510,10 +595,6 @@ namespace Settings
         hide();
     }
 
-    // Base64 encoded SVG logo with theme-neutral colors
-    static const std::string LOGO_SVG_BASE64 =
-        "PHN2ZyB2aWV3Qm94PSIwIDAgMzAwIDMwMCIgeG1sbnM9Imh0dHA6Ly93d3cudzMub3JnLzIwMDAvc3ZnIj4KICA8IS0tIEVuZ3JlbmFnZW0gY29tIGZvcm1hdG8gdHJhZGljaW9uYWwgZSB0cmFwZXrDs2lkZXMgcGFyYSBvcyBkZW50ZXMgLS0+CiAgPGcgdHJhbnNmb3JtPSJ0cmFuc2xhdGUoMTUwLCAxNTApIj4KICAgIDwhLS0gQmFzZSBjaXJjdWxhciBkYSBlbmdyZW5hZ2VtIC0tPgogICAgPGNpcmNsZSBjeD0iMCIgY3k9IjAiIHI9Ijc1IiBmaWxsPSIjMWIxYjFiIiBzdHJva2U9IiMyYTJhMmEiIHN0cm9rZS13aWR0aD0iMiIvPgoKICAgIDwhLS0gRGVudGVzIGRhIGVuZ3JlbmFnZW0gLSAxNiBkZW50ZXMgdHJhcGV6b2lkYWlzIG1haXMgcmVhbGlzdGFzIC0tPgogICAgPGcgZmlsbD0iIzFiMWIxYiIgc3Ryb2tlPSIjMmEyYTJhIiBzdHJva2Utd2lkdGg9IjEuNSI+CiAgICAgIDwhLS0gRGVudGUgMSAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDApIi8+CiAgICAgIDwhLS0gRGVudGUgMiAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDIyLjUpIi8+CiAgICAgIDwhLS0gRGVudGUgMyAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDQ1KSIvPgogICAgICA8IS0tIERlbnRlIDQgLS0+CiAgICAgIDxwYXRoIGQ9Ik0gLTEwLDAgTCAtMTAsLTc1IEwgLTI1LC05MCBMIC00MCwtNzUgTCAtNDAsMCBaIiB0cmFuc2Zvcm09InJvdGF0ZSg2Ny41KSIvPgogICAgICA8IS0tIERlbnRlIDUgLS0+CiAgICAgIDxwYXRoIGQ9Ik0gLTEwLDAgTCAtMTAsLTc1IEwgLTI1LC05MCBMIC00MCwtNzUgTCAtNDAsMCBaIiB0cmFuc2Zvcm09InJvdGF0ZSg5MCkiLz4KICAgICAgPCEtLSBEZW50ZSA2IC0tPgogICAgICA8cGF0aCBkPSJNIC0xMCwwIEwgLTEwLC03NSBMIC0yNSwtOTAgTCAtNDAsLTc1IEwgLTQwLDAgWiIgdHJhbnNmb3JtPSJyb3RhdGUoMTEyLjUpIi8+CiAgICAgIDwhLS0gRGVudGUgNyAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDEzNSkiLz4KICAgICAgPCEtLSBEZW50ZSA4IC0tPgogICAgICA8cGF0aCBkPSJNIC0xMCwwIEwgLTEwLC03NSBMIC0yNSwtOTAgTCAtNDAsLTc1IEwgLTQwLDAgWiIgdHJhbnNmb3JtPSJyb3RhdGUoMTU3LjUpIi8+CiAgICAgIDwhLS0gRGVudGUgOSAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDE4MCkiLz4KICAgICAgPCEtLSBEZW50ZSAxMCAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDIwMi41KSIvPgogICAgICA8IS0tIERlbnRlIDExIC0tPgogICAgICA8cGF0aCBkPSJNIC0xMCwwIEwgLTEwLC03NSBMIC0yNSwtOTAgTCAtNDAsLTc1IEwgLTQwLDAgWiIgdHJhbnNmb3JtPSJyb3RhdGUoMjI1KSIvPgogICAgICA8IS0tIERlbnRlIDEyIC0tPgogICAgICA8cGF0aCBkPSJNIC0xMCwwIEwgLTEwLC03NSBMIC0yNSwtOTAgTCAtNDAsLTc1IEwgLTQwLDAgWiIgdHJhbnNmb3JtPSJyb3RhdGUoMjQ3LjUpIi8+CiAgICAgIDwhLS0gRGVudGUgMTMgLS0+CiAgICAgIDxwYXRoIGQ9Ik0gLTEwLDAgTCAtMTAsLTc1IEwgLTI1LC05MCBMIC00MCwtNzUgTCAtNDAsMCBaIiB0cmFuc2Zvcm09InJvdGF0ZSgyNzApIi8+CiAgICAgIDwhLS0gRGVudGUgMTQgLS0+CiAgICAgIDxwYXRoIGQ9Ik0gLTEwLDAgTCAtMTAsLTc1IEwgLTI1LC05MCBMIC00MCwtNzUgTCAtNDAsMCBaIiB0cmFuc2Zvcm09InJvdGF0ZSgyOTIuNSkiLz4KICAgICAgPCEtLSBEZW50ZSAxNSAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDMxNSkiLz4KICAgICAgPCEtLSBEZW50ZSAxNiAtLT4KICAgICAgPHBhdGggZD0iTSAtMTAsMCBMIC0xMCwtNzUgTCAtMjUsLTkwIEwgLTQwLC03NSBMIC00MCwwIFoiIHRyYW5zZm9ybT0icm90YXRlKDMzNy41KSIvPgogICAgPC9nPgoKICAgIDwhLS0gQW5lbCBpbnRlcm5vIHBhcmEgZGFyIHByb2Z1bmRpZGFkZSAtLT4KICAgIDxjaXJjbGUgY3g9IjAiIGN5PSIwIiByPSI2MCIgZmlsbD0iIzJhMmEyYSIgc3Ryb2tlPSIjMmEyYTJhIiBzdHJva2Utd2lkdGg9IjEuNSIvPgogIDwvZz4KCiAgPCEtLSBMZXRyYSBVIChhenVsIG5ldXRybykgLS0+CiAgPHBhdGggZD0iTTEyNSwxMjAgTDEyNSwxNzAgUTEyNSwxODUgMTQwLDE4NSBMMTYwLDE4NSBRMTc1LDE4NSAxNzUsMTcwIEwxNzUsMTIwIiBmaWxsPSJub25lIiBzdHJva2U9IiM0Mjg1RjQiIHN0cm9rZS13aWR0aD0iMTUiIHN0cm9rZS1saW5lY2FwPSJyb3VuZCIgc3Ryb2tlLWxpbmVqb2luPSJyb3VuZCIvPgoKICA8IS0tIExldHJhIEMgKHZlcm1lbGhvIG5ldXRybykgLS0+CiAgPHBhdGggZD0iTTE2MCwxMzAgUTE2MCwxMTUgMTUwLDExNSBRMTQwLDExNSAxNDAsMTMwIEwxNDAsMTYwIFExNDAsMTc1IDE1MCwxNzUgUTE2MCwxNzUgMTYwLDE2MCIgZmlsbD0ibm9uZSIgc3Ryb2tlPSIjREI0NDM3IiBzdHJva2Utd2lkdGg9IjE1IiBzdHJva2UtbGluZWNhcD0icm91bmQiIHN0cm9rZS1saW5lam9pbj0icm91bmQiLz4KCiAgPCEtLSBCdXJhY28gY2VudHJhbCBjb20gYXBhcsOqbmNpYSBtZXTDoWxpY2EgLS0+CiAgPGNpcmNsZSBjeD0iMTUwIiBjeT0iMTUwIiByPSIxNSIgZmlsbD0iI2UwZTBlMCIgc3Ryb2tlPSIjMmEyYTJhIiBzdHJva2Utd2lkdGg9IjIiLz4KICA8Y2lyY2xlIGN4PSIxNTAiIGN5PSIxNTAiIHI9IjciIGZpbGw9IiNhMGEwYTAiLz4KPC9zdmc+Cg==";
-
     /**
      * @brief Create and open the about dialog
      *
@@ -536,27 +617,14 @@ namespace Settings
         about_dialog.set_copyright("Made with ❤️ by Felipe Avelar");
         about_dialog.set_license_type(Gtk::LICENSE_GPL_3_0);
 
-        // Load the logo from embedded base64 string
-        try
+        // The logo is compiled into the executable and decoded once
+        Glib::RefPtr<Gdk::Pixbuf> logo = Core::Assets::image("logo.svg", 200);
+        if (logo)
         {
-            // Decode the base64 SVG data
-            std::string svg_data = Glib::Base64::decode(LOGO_SVG_BASE64);
-
-            // Create a stream from the decoded data
-            Glib::RefPtr<Gio::MemoryInputStream> stream =
-                Gio::MemoryInputStream::create();
-            stream->add_data(svg_data);
-
-            // Load the SVG from the memory stream
-            Glib::RefPtr<Gdk::Pixbuf> logo =
-                Gdk::Pixbuf::create_from_stream_at_scale(stream, 200, 200, true);
-
-            // Set the logo
             about_dialog.set_logo(logo);
         }
-        catch (const Glib::Error &ex)
+        else
         {
-            std::cerr << "Error loading embedded logo: " << ex.what() << std::endl;
             // Fallback to a default icon if loading fails
             about_dialog.set_logo_icon_name("help-about");
         }
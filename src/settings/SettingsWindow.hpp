@@ -27,7 +27,7 @@ namespace Settings
      *
      * Provides a user interface for configuring application settings,
      * including tab visibility and order. Changes are saved to a
-     * configuration file and can trigger application restart.
+     * configuration file and applied to the main window in place.
      * Implemented as a modal dialog that blocks interaction with the parent window.
      */
     class SettingsWindow : public Gtk::Dialog
@@ -92,6 +92,28 @@ namespace Settings
          */
         void create_tab_order_section();
 
+        /**
+         * @brief Create the hidden diagnostics section
+         *
+         * Creates a frame showing the metrics registry. It stays hidden until
+         * toggled with Ctrl+Shift+D.
+         */
+        void create_debug_section();
+
+        /**
+         * @brief Refresh the diagnostics section with a new metrics snapshot
+         */
+        void refresh_debug_section();
+
+        /**
+         * @brief Handler for key presses on the dialog
+         * @param event The key event
+         * @return true if the event was handled, false otherwise
+         *
+         * Toggles the diagnostics section on Ctrl+Shift+D.
+         */
+        bool on_dialog_key_press(GdkEventKey *event);
+
         /**
          * @brief Update the tab list display
          *
@@ -99,6 +121,26 @@ namespace Settings
          */
         void update_tab_list();
 
+        /**
+         * @brief Re-read the tab and general settings from Core::Config
+         */
+        void reload_settings();
+
+        /**
+         * @brief Show the stored floating mode
+         */
+        void reload_floating();
+
+        /**
+         * @brief Re-read the tab order and visibility and rebuild the list
+         */
+        void reload_tab_list();
+
+        /**
+         * @brief Rebuild the tab list once after a burst of tab key changes
+         */
+        void schedule_reload();
+
         /**
          * @brief Handler for move up button clicks
          *
@@ -126,12 +168,13 @@ namespace Settings
          * @param response_id The ID of the response (e.g., RESPONSE_CANCEL, RESPONSE_APPLY)
          *
          * Handles the dialog response signals. If RESPONSE_APPLY, saves the settings
-         * and restarts the application to apply changes. Otherwise, just closes the dialog.
+         * and notifies the settings changed callback. Otherwise, just closes the dialog.
          */
         void on_response(int response_id);
 
         std::shared_ptr<TabSettings> settings_;             ///< Tab settings manager
         SettingsChangedCallback settings_changed_callback_; ///< Callback for settings changes
+        sigc::connection reload_pending_;                   ///< Pending reload_settings() after a change
 
         // Main containers
         Gtk::Box main_box_;                   ///< Main vertical box for all settings
@@ -156,6 +199,12 @@ namespace Settings
         // Tab list
         Gtk::Box tab_list_box_; ///< Container for tab rows
 
+        // Diagnostics section (hidden unless toggled)
+        Gtk::Frame debug_frame_;           ///< Frame around the diagnostics section
+        Gtk::Box debug_box_;               ///< Container for diagnostics components
+        Gtk::Label debug_label_;           ///< Monospace label showing the metrics snapshot
+        Gtk::Button debug_refresh_button_; ///< Button to take a new snapshot
+
         /**
          * @struct TabRow
          * @brief Represents a row in the tab list
@@ -4,16 +4,14 @@
  *
  * This file implements the TabSettings class which provides functionality
  * for managing tab order, visibility, and other tab-related settings.
- * Settings are persisted to a configuration file.
+ * Settings are stored in Core::Config under "tabs.order" and
+ * "tabs.enabled.<id>".
  */
 
 #include "TabSettings.hpp"
-#include <fstream>
-#include <iostream>
+#include "core/Config.hpp"
 #include <sstream>
 #include <algorithm>
-#include <sys/stat.h>
-#include <sys/types.h>
 
 namespace Settings
 {
@@ -26,19 +24,6 @@ namespace Settings
      */
     TabSettings::TabSettings()
     {
-        // Determine the configuration file path based on the user's home directory
-        const char *home_dir = getenv("HOME");
-        if (home_dir)
-        {
-            config_path_ = std::string(home_dir) + "/.config/ultimate-control/taborder.json";
-        }
-        else
-        {
-            config_path_ = "/tmp/ultimate-control-taborder.json";
-        }
-
-        // Configuration path is now set
-
         // Initialize default tab information (ID, name, icon, enabled state)
         tab_info_["volume"] = {"volume", "Volume", "audio-volume-high-symbolic", true};
         tab_info_["wifi"] = {"wifi", "WiFi", "network-wireless-symbolic", true};
@@ -47,67 +32,10 @@ namespace Settings
         tab_info_["power"] = {"power", "Power", "system-shutdown-symbolic", true};
         tab_info_["settings"] = {"settings", "Settings", "preferences-system-symbolic", true};
 
-        // Set default tab display order
-        tab_order_ = {"volume", "wifi", "bluetooth", "display", "power", "settings"};
-
-        // Set all tabs to be enabled by default
-        for (const auto &tab : tab_info_)
-        {
-            tab_enabled_[tab.first] = true;
-        }
-
-        // Load any existing settings from the configuration file
+        // Load any existing settings over the defaults
         load();
     }
 
-    /**
-     * @brief Destructor for the tab settings manager
-     *
-     * Saves settings to the configuration file before destruction.
-     */
-    TabSettings::~TabSettings()
-    {
-        save();
-    }
-
-    /**
-     * @brief Create the configuration directory if it doesn't exist
-     *
-     * Creates all directories in the path to the configuration file
-     * if they don't already exist.
-     */
-    void TabSettings::ensure_config_dir() const
-    {
-        std::string dir_path = config_path_.substr(0, config_path_.find_last_of('/'));
-
-        // Parse and create each directory in the path recursively
-        std::string current_path;
-        std::istringstream path_stream(dir_path);
-        std::string path_part;
-
-        while (std::getline(path_stream, path_part, '/'))
-        {
-            if (path_part.empty())
-            {
-                current_path = "/";
-                continue;
-            }
-
-            current_path += path_part + "/";
-
-            struct stat info;
-            if (stat(current_path.c_str(), &info) != 0)
-            {
-                // Directory doesn't exist, create it
-                if (mkdir(current_path.c_str(), 0755) != 0)
-                {
-                    std::cerr << "Failed to create directory: " << current_path << std::endl;
-                    return;
-                }
-            }
-        }
-    }
-
     /**
      * @brief Load settings from the configuration file
      *
@@ -116,52 +44,36 @@ namespace Settings
      */
     void TabSettings::load()
     {
-        std::ifstream infile(config_path_);
-        if (!infile.is_open())
+        // Start from the defaults so keys removed from the file revert
+        tab_order_ = {"volume", "wifi", "bluetooth", "display", "power", "settings"};
+        tab_enabled_.clear();
+        for (const auto &tab : tab_info_)
         {
-            // File doesn't exist or can't be opened, use defaults
-            return;
+            tab_enabled_[tab.first] = true;
         }
-        std::string line;
-        while (std::getline(infile, line))
-        {
-            // Skip empty lines and comment lines (starting with #)
-            if (line.empty() || line[0] == '#')
-            {
-                continue;
-            }
-
-            size_t delimiter_pos = line.find('=');
-            if (delimiter_pos == std::string::npos)
-            {
-                continue;
-            }
 
-            std::string key = line.substr(0, delimiter_pos);
-            std::string value = line.substr(delimiter_pos + 1);
+        // Parse comma-separated list of tab IDs for the display order
+        const std::string order = Core::Config::get_string("tabs.order");
+        if (!order.empty())
+        {
+            tab_order_.clear();
+            std::istringstream order_stream(order);
+            std::string tab_id;
 
-            if (key == "tab_order")
+            while (std::getline(order_stream, tab_id, ','))
             {
-                // Parse comma-separated list of tab IDs for the display order
-                tab_order_.clear();
-                std::istringstream order_stream(value);
-                std::string tab_id;
-
-                while (std::getline(order_stream, tab_id, ','))
+                if (!tab_id.empty())
                 {
-                    if (!tab_id.empty())
-                    {
-                        tab_order_.push_back(tab_id);
-                    }
+                    tab_order_.push_back(tab_id);
                 }
             }
-            else if (key.substr(0, 4) == "tab_")
-            {
-                // Parse individual tab enabled/disabled state
-                std::string tab_id = key.substr(4);
-                bool enabled = (value == "1" || value == "true");
-                tab_enabled_[tab_id] = enabled;
-            }
+        }
+
+        // Individual tab enabled/disabled state
+        const std::string prefix = "tabs.enabled.";
+        for (const auto &key : Core::Config::keys(prefix))
+        {
+            tab_enabled_[key.substr(prefix.size())] = Core::Config::get_bool(key, true);
         }
 
         // Ensure all known tabs are included in the order list (append any missing ones)
@@ -177,40 +89,25 @@ namespace Settings
     /**
      * @brief Save settings to the configuration file
      *
-     * Writes the current tab settings to the configuration file.
-     * Creates the configuration directory if it doesn't exist.
+     * Stores the current tab settings in Core::Config, which writes the
+     * file shortly after, off the UI thread.
      */
     void TabSettings::save() const
     {
-        ensure_config_dir();
-
-        std::ofstream outfile(config_path_);
-        if (!outfile.is_open())
-        {
-            std::cerr << "Failed to save tab settings to " << config_path_ << std::endl;
-            return;
-        }
-
-        // Write a header comment to the file
-        outfile << "# Ultimate Control Tab Settings\n";
-
-        // Write the tab order as a comma-separated list
-        outfile << "tab_order=";
+        // Store the tab order as a comma-separated list
+        std::string order;
         for (size_t i = 0; i < tab_order_.size(); ++i)
         {
-            outfile << tab_order_[i];
-            if (i < tab_order_.size() - 1)
-            {
-                outfile << ",";
-            }
+            order += (i > 0 ? "," : "") + tab_order_[i];
         }
-        outfile << "\n";
+        Core::Config::set("tabs.order", order);
 
-        // Write each tab's enabled/disabled state
+        // Store each tab's enabled/disabled state
         for (const auto &tab : tab_enabled_)
         {
-            outfile << "tab_" << tab.first << "=" << (tab.second ? "1" : "0") << "\n";
+            Core::Config::set("tabs.enabled." + tab.first, tab.second);
         }
+        Core::Config::save();
     }
 
     /**
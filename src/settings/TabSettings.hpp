@@ -4,7 +4,7 @@
  *
  * This file defines the TabSettings class which provides functionality
  * for managing tab order, visibility, and other tab-related settings.
- * Settings are persisted to a configuration file.
+ * Settings are persisted through Core::Config.
  */
 
 #pragma once
@@ -39,39 +39,33 @@ struct TabInfo {
  * @brief Manages tab configuration settings
  *
  * Provides functionality for loading, saving, and accessing tab settings
- * such as tab order and visibility. Settings are persisted to a
- * configuration file in the user's home directory.
+ * such as tab order and visibility. Edits stay in this object until
+ * save() stores them in Core::Config, which writes settings.conf.
  */
 class TabSettings {
 public:
     /**
      * @brief Constructor
      *
-     * Initializes default tab settings and loads any existing settings
-     * from the configuration file.
+     * Initializes default tab settings and loads any stored settings
+     * from Core::Config.
      */
     TabSettings();
 
     /**
-     * @brief Destructor
+     * @brief Load settings from Core::Config
      *
-     * Saves settings to the configuration file before destruction.
-     */
-    ~TabSettings();
-
-    /**
-     * @brief Load settings from the configuration file
-     *
-     * Reads tab settings from the configuration file. If the file
-     * doesn't exist or can't be read, default settings are used.
+     * Replaces any unsaved edits. Settings that are not stored keep
+     * their defaults.
      */
     void load();
 
     /**
      * @brief Save settings to the configuration file
      *
-     * Writes the current tab settings to the configuration file.
-     * Creates the configuration directory if it doesn't exist.
+     * Stores the current tab settings in Core::Config, which writes
+
+     * the file shortly after, off the UI thread.
      */
     void save() const;
 
@@ -140,15 +134,6 @@ public:
     bool move_tab_down(const std::string& tab_id);
 
 private:
-    /**
-     * @brief Create the configuration directory if it doesn't exist
-     *
-     * Creates all directories in the path to the configuration file
-     * if they don't already exist.
-     */
-    void ensure_config_dir() const;
-
-    std::string config_path_;                  ///< Path to the configuration file
     std::vector<std::string> tab_order_;        ///< Ordered list of tab IDs
     std::map<std::string, bool> tab_enabled_;   ///< Map of tab IDs to enabled state
     std::map<std::string, TabInfo> tab_info_;   ///< Map of tab IDs to tab information
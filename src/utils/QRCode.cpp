@@ -8,7 +8,8 @@
  */
 
 #include "QRCode.hpp"
-#include <iostream>
+#include "QrRaster.hpp"
+#include "core/Log.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -59,7 +60,7 @@ bool QRCode::encode(const std::string& data) {
 
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Error encoding QR code: " << e.what() << std::endl;
+        UC_LOG_WARN(Utils, "Error encoding QR code: " << e.what());
         return false;
     }
 }
@@ -109,15 +110,14 @@ void QRCode::draw(const Cairo::RefPtr<Cairo::Context>& cr, double x, double y, d
     // Move to the starting position for drawing
     cr->translate(x, y);
 
-    // Draw each module (black squares for true values)
+    // One path for every run of dark modules, filled once: no seams
+    // between neighbouring modules and one rasterisation per draw
     for (int row = 0; row < qrSize; row++) {
-        for (int col = 0; col < qrSize; col++) {
-            if (getModule(col, row)) {
-                cr->rectangle(col * moduleSize, row * moduleSize, moduleSize, moduleSize);
-                cr->fill();
-            }
+        for (const auto& [col, length] : QrRaster::dark_runs(*qrCode_, row)) {
+            cr->rectangle(col * moduleSize, row * moduleSize, length * moduleSize, moduleSize);
         }
     }
+    cr->fill();
 
     // Restore the original state of the Cairo context
     cr->restore();
@@ -140,31 +140,25 @@ Glib::RefPtr<Gdk::Pixbuf> QRCode::toPixbuf(int size, const Gdk::RGBA& foreground
     int moduleSize = size / qrSize;
     int actualSize = moduleSize * qrSize;
 
-    // Create a Cairo surface to draw the QR code on
-    auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32, actualSize, actualSize);
-    auto cr = Cairo::Context::create(surface);
-
-    // Fill the background with the specified color
-    cr->set_source_rgba(background.get_red(), background.get_green(),
-                       background.get_blue(), background.get_alpha());
-    cr->paint();
-
-    // Set the foreground color for the QR code modules
-    cr->set_source_rgba(foreground.get_red(), foreground.get_green(),
-                       foreground.get_blue(), foreground.get_alpha());
-
-    // Draw each module of the QR code as a rectangle
-    for (int row = 0; row < qrSize; row++) {
-        for (int col = 0; col < qrSize; col++) {
-            if (getModule(col, row)) {
-                cr->rectangle(col * moduleSize, row * moduleSize, moduleSize, moduleSize);
-                cr->fill();
-            }
-        }
+    if (moduleSize < 1) {
+        return Glib::RefPtr<Gdk::Pixbuf>();
     }
 
-    // Convert the Cairo surface to a Gdk::Pixbuf for use with GTK widgets
-    return Gdk::Pixbuf::create(surface, 0, 0, actualSize, actualSize);
+    // Render straight into the Pixbuf's own pixels; nothing is converted or copied
+    auto pixbuf = Gdk::Pixbuf::create(Gdk::COLORSPACE_RGB, true, 8, actualSize, actualSize);
+    auto to_bytes = [](const Gdk::RGBA& color, guint8* out) {
+        out[0] = static_cast<guint8>(std::lround(color.get_red() * 255));
+        out[1] = static_cast<guint8>(std::lround(color.get_green() * 255));
+        out[2] = static_cast<guint8>(std::lround(color.get_blue() * 255));
+        out[3] = static_cast<guint8>(std::lround(color.get_alpha() * 255));
+    };
+    guint8 dark[4];
+    guint8 light[4];
+    to_bytes(foreground, dark);
+    to_bytes(background, light);
+    QrRaster::render(*qrCode_, moduleSize, pixbuf->get_pixels(), static_cast<std::size_t>(pixbuf->get_rowstride()),
+                     4, dark, light);
+    return pixbuf;
 }
 
 /**
@@ -110,7 +110,8 @@ public:
      * @param size Size of the QR code in pixels
      *
      * Draws the QR code to the specified Cairo context at the given position and size.
-     * The current source color of the context is used for the modules.
+     * The current source color of the context is used for the modules, which
+     * are added to one path and filled once.
      */
     void draw(const Cairo::RefPtr<Cairo::Context>& cr, double x, double y, double size) const;
 
@@ -123,6 +124,9 @@ public:
      *
      * Creates a Gdk::Pixbuf containing the rendered QR code with the specified
      * foreground and background colors. The Pixbuf can be used with GTK+ widgets.
+     * It has an alpha channel, and its side is @p size rounded down to a whole
+     * number of pixels per module; a null pointer is returned if @p size is
+     * smaller than the symbol.
      */
     Glib::RefPtr<Gdk::Pixbuf> toPixbuf(int size, const Gdk::RGBA& foreground = Gdk::RGBA("black"),
                                        const Gdk::RGBA& background = Gdk::RGBA("white")) const;
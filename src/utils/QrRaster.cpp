@@ -0,0 +1,81 @@
+/**
+ * @file QrRaster.cpp
+ * @brief Implementation of the QR code scanline rasteriser
+ */
+
+#include "QrRaster.hpp"
+#include <algorithm> // for std::all_of, std::min
+#include <cstring>   // for std::memcpy, std::memset
+
+namespace Utils {
+
+namespace {
+
+/**
+ * @brief Fill count pixels with copies of one pixel
+ */
+void fill_pixels(std::uint8_t *out, const std::uint8_t *pixel, int channels, std::size_t count)
+{
+    const std::size_t bytes = count * static_cast<std::size_t>(channels);
+    if (std::all_of(pixel, pixel + channels, [pixel](std::uint8_t b) { return b == pixel[0]; })) {
+        std::memset(out, pixel[0], bytes); // Grey or A8: one memset for the whole run
+        return;
+    }
+    // Write one pixel, then keep doubling what is written
+    std::memcpy(out, pixel, static_cast<std::size_t>(channels));
+    for (std::size_t done = static_cast<std::size_t>(channels); done < bytes;) {
+        const std::size_t chunk = std::min(done, bytes - done);
+        std::memcpy(out + done, out, chunk);
+        done += chunk;
+    }
+}
+
+} // namespace
+
+void QrRaster::render(const qrcodegen::QrCode &qr, int scale, std::uint8_t *pixels, std::size_t rowstride,
+                      int channels, const std::uint8_t *dark, const std::uint8_t *light)
+{
+    const int size = qr.getSize();
+    const std::size_t module_bytes = static_cast<std::size_t>(scale) * static_cast<std::size_t>(channels);
+    const std::size_t line_bytes = static_cast<std::size_t>(size) * module_bytes;
+
+    for (int y = 0; y < size; ++y) {
+        std::uint8_t *line = pixels + static_cast<std::size_t>(y) * static_cast<std::size_t>(scale) * rowstride;
+
+        // Expand the module row into the first pixel row, one run at a time
+        for (int x = 0; x < size;) {
+            const bool is_dark = qr.getModule(x, y);
+            int end = x + 1;
+            while (end < size && qr.getModule(end, y) == is_dark) {
+                ++end;
+            }
+            fill_pixels(line + static_cast<std::size_t>(x) * module_bytes, is_dark ? dark : light, channels,
+                        static_cast<std::size_t>(end - x) * static_cast<std::size_t>(scale));
+            x = end;
+        }
+
+        for (int dy = 1; dy < scale; ++dy) {
+            std::memcpy(line + static_cast<std::size_t>(dy) * rowstride, line, line_bytes);
+        }
+    }
+}
+
+std::vector<std::pair<int, int>> QrRaster::dark_runs(const qrcodegen::QrCode &qr, int row)
+{
+    std::vector<std::pair<int, int>> runs;
+    const int size = qr.getSize();
+    for (int x = 0; x < size; ++x) {
+        if (!qr.getModule(x, row)) {
+            continue;
+        }
+        int end = x + 1;
+        while (end < size && qr.getModule(end, row)) {
+            ++end;
+        }
+        runs.emplace_back(x, end - x);
+        x = end;
+    }
+    return runs;
+}
+
+} // namespace Utils
@@ -0,0 +1,56 @@
+/**
+ * @file QrRaster.hpp
+ * @brief Scanline rasteriser for QR codes
+ *
+ * This file defines the QrRaster class which turns an encoded QR code into
+ * pixels a row of modules at a time, for PNG export, Pixbufs and Cairo.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "qrcodegen/qrcodegen.hpp"
+
+/**
+ * @namespace Utils
+ * @brief Contains utility functions and classes
+ */
+namespace Utils {
+
+/**
+ * @class QrRaster
+ * @brief Renders QR modules by runs instead of one pixel or rectangle at a time
+ *
+ * Each module row is expanded once into a scanline, with runs of equal
+ * modules filled by memset (or by doubling copies for multi-byte pixels
+ * whose bytes differ), and that scanline is copied to the other scale - 1
+ * pixel rows. Needs no GTK and is safe to call from any thread.
+ */
+class QrRaster {
+public:
+    /**
+     * @brief Draw a QR code into a pixel buffer, without a quiet zone
+     * @param qr Encoded symbol
+     * @param scale Pixels per module side, at least 1
+     * @param pixels Top-left pixel; qr.getSize() * scale rows of @p rowstride bytes
+     * @param rowstride Bytes from one pixel row to the next
+     * @param channels Bytes per pixel, 1 to 4
+     * @param dark Bytes of a dark pixel, @p channels long
+     * @param light Bytes of a light pixel, @p channels long
+     */
+    static void render(const qrcodegen::QrCode &qr, int scale, std::uint8_t *pixels, std::size_t rowstride,
+                       int channels, const std::uint8_t *dark, const std::uint8_t *light);
+
+    /**
+     * @brief Runs of dark modules in one row
+     * @param qr Encoded symbol
+     * @param row Module row
+     * @return (first column, length) pairs, left to right
+     */
+    static std::vector<std::pair<int, int>> dark_runs(const qrcodegen::QrCode &qr, int row);
+};
+
+} // namespace Utils
@@ -28,11 +28,14 @@
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include "qrcodegen.hpp"
 
 using std::int8_t;
 using std::uint8_t;
+using std::uint64_t;
 using std::size_t;
 using std::vector;
 
@@ -158,7 +161,7 @@ QrSegment QrSegment::makeEci(long assignVal) {
 }
 
 
-QrSegment::QrSegment(const Mode &md, int numCh, const std::vector<bool> &dt) :
+QrSegment::QrSegment(const Mode &md, int numCh, const BitBuffer &dt) :
 		mode(&md),
 		numChars(numCh),
 		data(dt) {
@@ -167,7 +170,7 @@ QrSegment::QrSegment(const Mode &md, int numCh, const std::vector<bool> &dt) :
 }
 
 
-QrSegment::QrSegment(const Mode &md, int numCh, std::vector<bool> &&dt) :
+QrSegment::QrSegment(const Mode &md, int numCh, BitBuffer &&dt) :
 		mode(&md),
 		numChars(numCh),
 		data(std::move(dt)) {
@@ -176,6 +179,16 @@ QrSegment::QrSegment(const Mode &md, int numCh, std::vector<bool> &&dt) :
 }
 
 
+QrSegment::QrSegment(const Mode &md, int numCh, const std::vector<bool> &dt) :
+		mode(&md),
+		numChars(numCh) {
+	if (numCh < 0)
+		throw std::domain_error("Invalid value");
+	for (bool bit : dt)
+		data.appendBits(bit ? 1 : 0, 1);
+}
+
+
 int QrSegment::getTotalBits(const vector<QrSegment> &segs, int version) {
 	int result = 0;
 	for (const QrSegment &seg : segs) {
@@ -222,7 +235,7 @@ int QrSegment::getNumChars() const {
 }
 
 
-const std::vector<bool> &QrSegment::getData() const {
+const BitBuffer &QrSegment::getData() const {
 	return data;
 }
 
@@ -233,6 +246,76 @@ const char *QrSegment::ALPHANUMERIC_CHARSET = "0123456789ABCDEFGHIJKLMNOPQRSTUVW
 
 /*---- Class QrCode ----*/
 
+namespace {
+
+// Exponentials and logarithms of the generator 0x02 in GF(2^8/0x11D). exp is
+// doubled so that exp[log[x] + log[y]] needs no reduction modulo 255.
+struct GfTables {
+	uint8_t exp[510];
+	uint8_t log[256];
+};
+
+constexpr GfTables makeGfTables() {
+	GfTables tables{};
+	int x = 1;
+	for (int i = 0; i < 255; i++) {
+		tables.exp[i] = static_cast<uint8_t>(x);
+		tables.exp[i + 255] = static_cast<uint8_t>(x);
+		tables.log[x] = static_cast<uint8_t>(i);
+		x <<= 1;
+		if (x & 0x100)
+			x ^= 0x11D;
+	}
+	return tables;
+}
+
+constexpr GfTables GF_TABLES = makeGfTables();
+
+
+// A row or column of up to 177 modules for penalty scoring; module i is bit i % 64 of word i / 64.
+using Line = std::array<uint64_t,3>;
+
+Line andLines(const Line &a, const Line &b) {
+	return {a[0] & b[0], a[1] & b[1], a[2] & b[2]};
+}
+
+Line xorLines(const Line &a, const Line &b) {
+	return {a[0] ^ b[0], a[1] ^ b[1], a[2] ^ b[2]};
+}
+
+Line notLine(const Line &a) {
+	return {~a[0], ~a[1], ~a[2]};
+}
+
+// Module i of the result is module i + n of the input, for 1 <= n <= 63.
+Line shiftDown(const Line &a, int n) {
+	return {a[0] >> n | a[1] << (64 - n), a[1] >> n | a[2] << (64 - n), a[2] >> n};
+}
+
+// Module i of the result is module i - 1 of the input; module 0 is light.
+Line shiftUp1(const Line &a) {
+	return {a[0] << 1, a[1] << 1 | a[0] >> 63, a[2] << 1 | a[1] >> 63};
+}
+
+// Modules 0 to n - 1 set, for 0 <= n <= 192.
+Line lowBits(int n) {
+	Line result{};
+	for (size_t w = 0; w < 3; w++, n -= 64) {
+		if (n >= 64)
+			result[w] = ~uint64_t(0);
+		else if (n > 0)
+			result[w] = (uint64_t(1) << n) - 1;
+	}
+	return result;
+}
+
+int popcount(const Line &a) {
+	return __builtin_popcountll(a[0]) + __builtin_popcountll(a[1]) + __builtin_popcountll(a[2]);
+}
+
+}
+
+
 int QrCode::getFormatBits(Ecc ecl) {
 	switch (ecl) {
 		case Ecc::LOW     :  return 1;
@@ -292,7 +375,7 @@ QrCode QrCode::encodeSegments(const vector<QrSegment> &segs, Ecc ecl,
 	for (const QrSegment &seg : segs) {
 		bb.appendBits(static_cast<uint32_t>(seg.getMode().getModeBits()), 4);
 		bb.appendBits(static_cast<uint32_t>(seg.getNumChars()), seg.getMode().numCharCountBits(version));
-		bb.insert(bb.end(), seg.getData().begin(), seg.getData().end());
+		bb.appendData(seg.getData());
 	}
 	assert(bb.size() == static_cast<unsigned int>(dataUsedBits));
 	
@@ -308,9 +391,7 @@ QrCode QrCode::encodeSegments(const vector<QrSegment> &segs, Ecc ecl,
 		bb.appendBits(padByte, 8);
 	
 	// Pack bits into bytes in big endian
-	vector<uint8_t> dataCodewords(bb.size() / 8);
-	for (size_t i = 0; i < bb.size(); i++)
-		dataCodewords.at(i >> 3) |= (bb.at(i) ? 1 : 0) << (7 - (i & 7));
+	vector<uint8_t> dataCodewords = bb.getBytes();
 	
 	// Create the QR Code object
 	return QrCode(version, ecl, dataCodewords, mask);
@@ -326,9 +407,11 @@ QrCode::QrCode(int ver, Ecc ecl, const vector<uint8_t> &dataCodewords, int msk)
 	if (msk < -1 || msk > 7)
 		throw std::domain_error("Mask value out of range");
 	size = ver * 4 + 17;
-	size_t sz = static_cast<size_t>(size);
-	modules    = vector<vector<bool> >(sz, vector<bool>(sz));  // Initially all light
-	isFunction = vector<vector<bool> >(sz, vector<bool>(sz));
+	mask = msk;  // Set for real below; initialized so the trial copies are well-defined
+	rowWords = (size + 63) / 64;
+	size_t words = static_cast<size_t>(size) * static_cast<size_t>(rowWords);
+	modules    = vector<uint64_t>(words);  // Initially all light
+	isFunction = vector<uint64_t>(words);
 	
 	// Compute ECC, draw modules
 	drawFunctionPatterns();
@@ -337,16 +420,34 @@ QrCode::QrCode(int ver, Ecc ecl, const vector<uint8_t> &dataCodewords, int msk)
 	
 	// Do masking
 	if (msk == -1) {  // Automatically choose best mask
+		// Each mask is scored on its own copy of the grid, so large symbols can score them in parallel
+		long penalties[8];
+		auto score = [this, &penalties](int i) {
+			QrCode trial(*this);
+			trial.applyMask(i);
+			trial.drawFormatBits(i);
+			penalties[i] = trial.getPenaltyScore();
+		};
+		int scored = 0;  // Masks below this are scored by a thread or already done
+		if (version >= PARALLEL_MASK_MIN_VERSION && std::thread::hardware_concurrency() > 1) {
+			vector<std::thread> threads;
+			try {
+				for (; scored < 8; scored++)
+					threads.emplace_back(score, scored);
+			} catch (const std::system_error &) {
+				// Out of threads: the masks not handed out are scored below
+			}
+			for (std::thread &thread : threads)
+				thread.join();
+		}
+		for (int i = scored; i < 8; i++)
+			score(i);
 		long minPenalty = LONG_MAX;
 		for (int i = 0; i < 8; i++) {
-			applyMask(i);
-			drawFormatBits(i);
-			long penalty = getPenaltyScore();
-			if (penalty < minPenalty) {
+			if (penalties[i] < minPenalty) {
 				msk = i;
-				minPenalty = penalty;
+				minPenalty = penalties[i];
 			}
-			applyMask(i);  // Undoes the mask due to XOR
 		}
 	}
 	assert(0 <= msk && msk <= 7);
@@ -483,15 +584,29 @@ void QrCode::drawAlignmentPattern(int x, int y) {
 
 
 void QrCode::setFunctionModule(int x, int y, bool isDark) {
-	size_t ux = static_cast<size_t>(x);
-	size_t uy = static_cast<size_t>(y);
-	modules   .at(uy).at(ux) = isDark;
-	isFunction.at(uy).at(ux) = true;
+	setModule(x, y, isDark);
+	isFunction.at(static_cast<size_t>(y * rowWords + (x >> 6))) |= uint64_t(1) << (x & 63);
 }
 
 
 bool QrCode::module(int x, int y) const {
-	return modules.at(static_cast<size_t>(y)).at(static_cast<size_t>(x));
+	assert(0 <= x && x < size && 0 <= y && y < size);
+	return ((modules[static_cast<size_t>(y * rowWords + (x >> 6))] >> (x & 63)) & 1) != 0;
+}
+
+
+void QrCode::setModule(int x, int y, bool isDark) {
+	if (x < 0 || x >= size || y < 0 || y >= size)
+		throw std::out_of_range("Module out of range");
+	uint64_t &word = modules[static_cast<size_t>(y * rowWords + (x >> 6))];
+	uint64_t bit = uint64_t(1) << (x & 63);
+	word = isDark ? word | bit : word & ~bit;
+}
+
+
+bool QrCode::isFunctionModule(int x, int y) const {
+	assert(0 <= x && x < size && 0 <= y && y < size);
+	return ((isFunction[static_cast<size_t>(y * rowWords + (x >> 6))] >> (x & 63)) & 1) != 0;
 }
 
 
@@ -544,11 +659,11 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
 			right = 5;
 		for (int vert = 0; vert < size; vert++) {  // Vertical counter
 			for (int j = 0; j < 2; j++) {
-				size_t x = static_cast<size_t>(right - j);  // Actual x coordinate
+				int x = right - j;  // Actual x coordinate
 				bool upward = ((right + 1) & 2) == 0;
-				size_t y = static_cast<size_t>(upward ? size - 1 - vert : vert);  // Actual y coordinate
-				if (!isFunction.at(y).at(x) && i < data.size() * 8) {
-					modules.at(y).at(x) = getBit(data.at(i >> 3), 7 - static_cast<int>(i & 7));
+				int y = upward ? size - 1 - vert : vert;  // Actual y coordinate
+				if (!isFunctionModule(x, y) && i < data.size() * 8) {
+					setModule(x, y, getBit(data[i >> 3], 7 - static_cast<int>(i & 7)));
 					i++;
 				}
 				// If this QR Code has any remainder bits (0 to 7), they were assigned as
@@ -563,22 +678,28 @@ void QrCode::drawCodewords(const vector<uint8_t> &data) {
 void QrCode::applyMask(int msk) {
 	if (msk < 0 || msk > 7)
 		throw std::domain_error("Mask value out of range");
-	size_t sz = static_cast<size_t>(size);
-	for (size_t y = 0; y < sz; y++) {
-		for (size_t x = 0; x < sz; x++) {
-			bool invert;
-			switch (msk) {
-				case 0:  invert = (x + y) % 2 == 0;                    break;
-				case 1:  invert = y % 2 == 0;                          break;
-				case 2:  invert = x % 3 == 0;                          break;
-				case 3:  invert = (x + y) % 3 == 0;                    break;
-				case 4:  invert = (x / 3 + y / 2) % 2 == 0;            break;
-				case 5:  invert = x * y % 2 + x * y % 3 == 0;          break;
-				case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0;    break;
-				case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
-				default:  throw std::logic_error("Unreachable");
+	for (size_t y = 0; y < static_cast<size_t>(size); y++) {
+		// Build the row's pattern a word at a time, then flip the non-function modules in it at once
+		for (size_t w = 0; w < static_cast<size_t>(rowWords); w++) {
+			uint64_t pattern = 0;
+			size_t end = std::min(static_cast<size_t>(size), w * 64 + 64);
+			for (size_t x = w * 64; x < end; x++) {
+				bool invert;
+				switch (msk) {
+					case 0:  invert = (x + y) % 2 == 0;                    break;
+					case 1:  invert = y % 2 == 0;                          break;
+					case 2:  invert = x % 3 == 0;                          break;
+					case 3:  invert = (x + y) % 3 == 0;                    break;
+					case 4:  invert = (x / 3 + y / 2) % 2 == 0;            break;
+					case 5:  invert = x * y % 2 + x * y % 3 == 0;          break;
+					case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0;    break;
+					case 7:  invert = ((x + y) % 2 + x * y % 3) % 2 == 0;  break;
+					default:  throw std::logic_error("Unreachable");
+				}
+				pattern |= static_cast<uint64_t>(invert) << (x & 63);
 			}
-			modules.at(y).at(x) = modules.at(y).at(x) ^ (invert & !isFunction.at(y).at(x));
+			size_t index = y * static_cast<size_t>(rowWords) + w;
+			modules[index] ^= pattern & ~isFunction[index];
 		}
 	}
 }
@@ -586,71 +707,50 @@ void QrCode::applyMask(int msk) {
 
 long QrCode::getPenaltyScore() const {
 	long result = 0;
+	size_t sz = static_cast<size_t>(size);
 	
-	// Adjacent modules in row having same color, and finder-like patterns
-	for (int y = 0; y < size; y++) {
-		bool runColor = false;
-		int runX = 0;
-		std::array<int,7> runHistory = {};
-		for (int x = 0; x < size; x++) {
-			if (module(x, y) == runColor) {
-				runX++;
-				if (runX == 5)
-					result += PENALTY_N1;
-				else if (runX > 5)
-					result++;
-			} else {
-				finderPenaltyAddHistory(runX, runHistory);
-				if (!runColor)
-					result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-				runColor = module(x, y);
-				runX = 1;
-			}
-		}
-		result += finderPenaltyTerminateAndCount(runColor, runX, runHistory) * PENALTY_N3;
-	}
-	// Adjacent modules in column having same color, and finder-like patterns
-	for (int x = 0; x < size; x++) {
-		bool runColor = false;
-		int runY = 0;
-		std::array<int,7> runHistory = {};
-		for (int y = 0; y < size; y++) {
-			if (module(x, y) == runColor) {
-				runY++;
-				if (runY == 5)
-					result += PENALTY_N1;
-				else if (runY > 5)
-					result++;
-			} else {
-				finderPenaltyAddHistory(runY, runHistory);
-				if (!runColor)
-					result += finderPenaltyCountPatterns(runHistory) * PENALTY_N3;
-				runColor = module(x, y);
-				runY = 1;
+	// Rows are the grid as stored; columns are its transpose, built from the dark modules
+	vector<Line> rows(sz), cols(sz);
+	for (size_t y = 0; y < sz; y++) {
+		for (size_t w = 0; w < static_cast<size_t>(rowWords); w++) {
+			uint64_t word = modules[y * static_cast<size_t>(rowWords) + w];
+			rows[y][w] = word;
+			for (; word != 0; word &= word - 1) {
+				size_t x = w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+				cols[x][y >> 6] |= uint64_t(1) << (y & 63);
 			}
 		}
-		result += finderPenaltyTerminateAndCount(runColor, runY, runHistory) * PENALTY_N3;
 	}
 	
-	// 2*2 blocks of modules having same color
-	for (int y = 0; y < size - 1; y++) {
-		for (int x = 0; x < size - 1; x++) {
-			bool  color = module(x, y);
-			if (  color == module(x + 1, y) &&
-			      color == module(x, y + 1) &&
-			      color == module(x + 1, y + 1))
-				result += PENALTY_N2;
+	const Line pairs = lowBits(size - 1);  // Positions that have a next module in the line
+	for (const vector<Line> *lines : {&rows, &cols}) {
+		Line previousSame{};
+		for (size_t i = 0; i < sz; i++) {
+			const Line &line = (*lines)[i];
+			
+			// Adjacent modules in the line having same color: a run of length n >= 5
+			// has n - 4 windows of 5 equal modules, and one of them starts the run
+			Line same = andLines(notLine(xorLines(line, shiftDown(line, 1))), pairs);
+			Line five = andLines(andLines(same, shiftDown(same, 1)), andLines(shiftDown(same, 2), shiftDown(same, 3)));
+			Line runStarts = andLines(five, notLine(shiftUp1(five)));
+			result += popcount(five) + (PENALTY_N1 - 1) * popcount(runStarts);
+			
+			// Finder-like patterns
+			result += finderPenaltyCountLine(line) * PENALTY_N3;
+			
+			// 2*2 blocks of modules having same color, counted once, on rows
+			if (lines == &rows && i > 0) {
+				Line block = andLines(andLines(same, previousSame), notLine(xorLines(line, (*lines)[i - 1])));
+				result += popcount(andLines(block, pairs)) * PENALTY_N2;
+			}
+			previousSame = same;
 		}
 	}
 	
 	// Balance of dark and light modules
 	int dark = 0;
-	for (const vector<bool> &row : modules) {
-		for (bool color : row) {
-			if (color)
-				dark++;
-		}
-	}
+	for (uint64_t word : modules)
+		dark += __builtin_popcountll(word);
 	int total = size * size;  // Note that size is odd, so dark/total != 1/2
 	// Compute the smallest integer k >= 0 such that (45-5k)% <= dark/total <= (55+5k)%
 	int k = static_cast<int>((std::abs(dark * 20L - total * 10L) + total - 1) / total) - 1;
@@ -724,27 +824,54 @@ vector<uint8_t> QrCode::reedSolomonComputeDivisor(int degree) {
 
 
 vector<uint8_t> QrCode::reedSolomonComputeRemainder(const vector<uint8_t> &data, const vector<uint8_t> &divisor) {
-	vector<uint8_t> result(divisor.size());
+	// Take the divisor's logarithms once; each step is then one table lookup per coefficient
+	size_t n = divisor.size();
+	vector<int> divisorLog(n);
+	for (size_t i = 0; i < n; i++)
+		divisorLog[i] = divisor[i] == 0 ? -1 : GF_TABLES.log[divisor[i]];
+	
+	vector<uint8_t> result(n);
 	for (uint8_t b : data) {  // Polynomial division
-		uint8_t factor = b ^ result.at(0);
-		result.erase(result.begin());
-		result.push_back(0);
-		for (size_t i = 0; i < result.size(); i++)
-			result.at(i) ^= reedSolomonMultiply(divisor.at(i), factor);
+		uint8_t factor = b ^ result[0];
+		std::copy(result.begin() + 1, result.end(), result.begin());
+		result[n - 1] = 0;
+		if (factor == 0)
+			continue;
+		int factorLog = GF_TABLES.log[factor];
+		for (size_t i = 0; i < n; i++) {
+			if (divisorLog[i] >= 0)
+				result[i] ^= GF_TABLES.exp[divisorLog[i] + factorLog];
+		}
 	}
 	return result;
 }
 
 
 uint8_t QrCode::reedSolomonMultiply(uint8_t x, uint8_t y) {
-	// Russian peasant multiplication
-	int z = 0;
-	for (int i = 7; i >= 0; i--) {
-		z = (z << 1) ^ ((z >> 7) * 0x11D);
-		z ^= ((y >> i) & 1) * x;
+	if (x == 0 || y == 0)
+		return 0;
+	return GF_TABLES.exp[GF_TABLES.log[x] + GF_TABLES.log[y]];
+}
+
+
+int QrCode::finderPenaltyCountLine(const std::array<uint64_t,3> &line) const {
+	// Modules where the color changes; module 0 counts as a change if it is dark
+	Line changes = andLines(xorLines(line, shiftUp1(line)), lowBits(size));
+	bool runColor = false;
+	int runStart = 0;
+	int result = 0;
+	std::array<int,7> runHistory = {};
+	for (int w = 0; w < 3; w++) {
+		for (uint64_t word = changes[static_cast<size_t>(w)]; word != 0; word &= word - 1) {
+			int position = w * 64 + __builtin_ctzll(word);
+			finderPenaltyAddHistory(position - runStart, runHistory);
+			if (!runColor)
+				result += finderPenaltyCountPatterns(runHistory);
+			runColor = !runColor;
+			runStart = position;
+		}
 	}
-	assert(z >> 8 == 0);
-	return static_cast<uint8_t>(z);
+	return result + finderPenaltyTerminateAndCount(runColor, size - runStart, runHistory);
 }
 
 
@@ -788,6 +915,8 @@ const int QrCode::PENALTY_N2 =  3;
 const int QrCode::PENALTY_N3 = 40;
 const int QrCode::PENALTY_N4 = 10;
 
+const int QrCode::PARALLEL_MASK_MIN_VERSION = 20;
+
 
 const int8_t QrCode::ECC_CODEWORDS_PER_BLOCK[4][41] = {
 	// Version: (note that index 0 is for padding, and is set to an illegal value)
@@ -816,14 +945,55 @@ data_too_long::data_too_long(const std::string &msg) :
 /*---- Class BitBuffer ----*/
 
 BitBuffer::BitBuffer()
-	: std::vector<bool>() {}
+	: bitLength(0) {}
 
 
 void BitBuffer::appendBits(std::uint32_t val, int len) {
 	if (len < 0 || len > 31 || val >> len != 0)
 		throw std::domain_error("Value out of range");
-	for (int i = len - 1; i >= 0; i--)  // Append bit by bit
-		this->push_back(((val >> i) & 1) != 0);
+	if (len > 0)
+		appendAligned(static_cast<uint64_t>(val) << (64 - len), len);
+}
+
+
+void BitBuffer::appendData(const BitBuffer &other) {
+	for (size_t i = 0; i < other.words.size(); i++) {
+		size_t remaining = other.bitLength - i * 64;
+		appendAligned(other.words[i], static_cast<int>(std::min<size_t>(remaining, 64)));
+	}
+}
+
+
+size_t BitBuffer::size() const {
+	return bitLength;
+}
+
+
+bool BitBuffer::getBit(size_t index) const {
+	return ((words.at(index >> 6) >> (63 - (index & 63))) & 1) != 0;
+}
+
+
+vector<uint8_t> BitBuffer::getBytes() const {
+	if (bitLength % 8 != 0)
+		throw std::domain_error("Length is not a multiple of 8");
+	vector<uint8_t> result(bitLength / 8);
+	for (size_t i = 0; i < result.size(); i++)
+		result[i] = static_cast<uint8_t>(words[i >> 3] >> (56 - 8 * (i & 7)));
+	return result;
+}
+
+
+void BitBuffer::appendAligned(uint64_t bits, int len) {
+	int used = static_cast<int>(bitLength & 63);  // Bits already in the last word
+	if (used == 0)
+		words.push_back(bits);
+	else {
+		words.back() |= bits >> used;
+		if (len > 64 - used)
+			words.push_back(bits << (64 - used));
+	}
+	bitLength += static_cast<size_t>(len);
 }
 
 }
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
@@ -32,6 +33,61 @@
 
 namespace qrcodegen {
 
+/* 
+ * An appendable sequence of bits (0s and 1s). Mainly used by QrSegment.
+ * Bits are packed into 64-bit words, first bit in the most significant
+ * position, so appending a field or another buffer costs a few shifts
+ * rather than one operation per bit.
+ */
+class BitBuffer final {
+	
+	/*---- Constructor ----*/
+	
+	// Creates an empty bit buffer (length 0).
+	public: BitBuffer();
+	
+	
+	
+	/*---- Methods ----*/
+	
+	// Appends the given number of low-order bits of the given value
+	// to this buffer. Requires 0 <= len <= 31 and val < 2^len.
+	public: void appendBits(std::uint32_t val, int len);
+	
+	
+	// Appends all bits of the given buffer to this buffer.
+	public: void appendData(const BitBuffer &other);
+	
+	
+	// Returns the number of bits in this buffer.
+	public: std::size_t size() const;
+	
+	
+	// Returns the bit at the given index, which must be less than size().
+	public: bool getBit(std::size_t index) const;
+	
+	
+	// Returns the bits packed into bytes in big endian. Requires size() to be a multiple of 8.
+	public: std::vector<std::uint8_t> getBytes() const;
+	
+	
+	// Appends the len (1 to 64) most significant bits of the given word; the other bits must be 0.
+	private: void appendAligned(std::uint64_t bits, int len);
+	
+	
+	
+	/*---- Fields ----*/
+	
+	// The bits, first bit in the most significant position of words[0]. Unused trailing bits are 0.
+	private: std::vector<std::uint64_t> words;
+	
+	// The number of bits in this buffer.
+	private: std::size_t bitLength;
+	
+};
+
+
+
 /* 
  * A segment of character/binary/control data in a QR Code symbol.
  * Instances of this class are immutable.
@@ -160,7 +216,7 @@ class QrSegment final {
 	private: int numChars;
 	
 	/* The data bits of this segment. Accessed through getData(). */
-	private: std::vector<bool> data;
+	private: BitBuffer data;
 	
 	
 	/*---- Constructors (low level) ----*/
@@ -170,7 +226,7 @@ class QrSegment final {
 	 * The character count (numCh) must agree with the mode and the bit buffer length,
 	 * but the constraint isn't checked. The given bit buffer is copied and stored.
 	 */
-	public: QrSegment(const Mode &md, int numCh, const std::vector<bool> &dt);
+	public: QrSegment(const Mode &md, int numCh, const BitBuffer &dt);
 	
 	
 	/* 
@@ -178,7 +234,14 @@ class QrSegment final {
 	 * The character count (numCh) must agree with the mode and the bit buffer length,
 	 * but the constraint isn't checked. The given bit buffer is moved and stored.
 	 */
-	public: QrSegment(const Mode &md, int numCh, std::vector<bool> &&dt);
+	public: QrSegment(const Mode &md, int numCh, BitBuffer &&dt);
+	
+	
+	/* 
+	 * Creates a new QR Code segment with the given attributes and data bits,
+	 * which are packed into a bit buffer. Kept for callers of the original API.
+	 */
+	public: QrSegment(const Mode &md, int numCh, const std::vector<bool> &dt);
 	
 	
 	/*---- Methods ----*/
@@ -198,7 +261,7 @@ class QrSegment final {
 	/* 
 	 * Returns the data bits of this segment.
 	 */
-	public: const std::vector<bool> &getData() const;
+	public: const BitBuffer &getData() const;
 	
 	
 	// (Package-private) Calculates the number of bits needed to encode the given segments at
@@ -312,14 +375,19 @@ class QrCode final {
 	 * the resulting object still has a mask value between 0 and 7. */
 	private: int mask;
 	
-	// Private grids of modules/pixels, with dimensions of size*size:
+	// Private grids of modules/pixels, with dimensions of size*size. Each is a flat
+	// array of rows of rowWords 64-bit words; module (x, y) is bit x % 64 of word
+	// y * rowWords + x / 64. Bits past the right edge of a row are always 0.
 	
-	// The modules of this QR Code (false = light, true = dark).
+	/* The number of 64-bit words per grid row, between 1 and 3 (inclusive). */
+	private: int rowWords;
+	
+	// The modules of this QR Code (0 = light, 1 = dark).
 	// Immutable after constructor finishes. Accessed through getModule().
-	private: std::vector<std::vector<bool> > modules;
+	private: std::vector<std::uint64_t> modules;
 	
 	// Indicates function modules that are not subjected to masking. Discarded when constructor finishes.
-	private: std::vector<std::vector<bool> > isFunction;
+	private: std::vector<std::uint64_t> isFunction;
 	
 	
 	
@@ -405,6 +473,14 @@ class QrCode final {
 	private: bool module(int x, int y) const;
 	
 	
+	// Sets the color of a module without marking it. Coordinates must be in bounds.
+	private: void setModule(int x, int y, bool isDark);
+	
+	
+	// Returns whether the module at the given coordinates, which must be in range, is a function module.
+	private: bool isFunctionModule(int x, int y) const;
+	
+	
 	/*---- Private helper methods for constructor: Codewords and masking ----*/
 	
 	// Returns a new byte string representing the given data with the appropriate error correction
@@ -427,6 +503,7 @@ class QrCode final {
 	
 	// Calculates and returns the penalty score based on state of this QR Code's current modules.
 	// This is used by the automatic mask choice algorithm to find the mask pattern that yields the lowest score.
+	// Runs, 2*2 blocks and balance are counted on row and column bitboards with shifts and popcounts.
 	private: long getPenaltyScore() const;
 	
 	
@@ -461,10 +538,15 @@ class QrCode final {
 	
 	
 	// Returns the product of the two given field elements modulo GF(2^8/0x11D).
-	// All inputs are valid. This could be implemented as a 256*256 lookup table.
+	// All inputs are valid. Uses compile-time log/antilog tables.
 	private: static std::uint8_t reedSolomonMultiply(std::uint8_t x, std::uint8_t y);
 	
 	
+	// Returns the number of finder-like patterns in one row or column, given as a bitboard with
+	// module i at bit i % 64 of word i / 64. Walks the line run by run. A helper function for getPenaltyScore().
+	private: int finderPenaltyCountLine(const std::array<std::uint64_t,3> &line) const;
+	
+	
 	// Can only be called immediately after a light run is added, and
 	// returns either 0, 1, or 2. A helper function for getPenaltyScore().
 	private: int finderPenaltyCountPatterns(const std::array<int,7> &runHistory) const;
@@ -497,6 +579,10 @@ class QrCode final {
 	private: static const int PENALTY_N3;
 	private: static const int PENALTY_N4;
 	
+	// Automatic masking scores the 8 masks on parallel threads from this version up, if
+	// there is more than one CPU. Below it, starting the threads costs more than scoring.
+	private: static const int PARALLEL_MASK_MIN_VERSION;
+	
 	
 	private: static const std::int8_t ECC_CODEWORDS_PER_BLOCK[4][41];
 	private: static const std::int8_t NUM_ERROR_CORRECTION_BLOCKS[4][41];
@@ -524,26 +610,4 @@ class data_too_long : public std::length_error {
 	
 };
 
-
-
-/* 
- * An appendable sequence of bits (0s and 1s). Mainly used by QrSegment.
- */
-class BitBuffer final : public std::vector<bool> {
-	
-	/*---- Constructor ----*/
-	
-	// Creates an empty bit buffer (length 0).
-	public: BitBuffer();
-	
-	
-	
-	/*---- Method ----*/
-	
-	// Appends the given number of low-order bits of the given value
-	// to this buffer. Requires 0 <= len <= 31 and val < 2^len.
-	public: void appendBits(std::uint32_t val, int len);
-	
-};
-
 }
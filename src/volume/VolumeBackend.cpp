@@ -0,0 +1,352 @@
+/**
+ * @file VolumeBackend.cpp
+ * @brief PulseAudio implementation of the audio backend
+ *
+ * This file implements the system VolumeBackend on top of PulseAudio's
+ * command-line interface (pactl), and the runtime choice of backend.
+ */
+
+#include "VolumeBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Volume
+{
+
+    namespace
+    {
+        /// Counts every pactl invocation
+        const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+
+        /**
+         * @class PactlBackend
+         * @brief Audio backend running pactl for every operation
+         */
+        class PactlBackend : public VolumeBackend
+        {
+        public:
+            /**
+             * @brief List available audio devices
+             * @return Sinks followed by sources; partial if pactl cannot be run
+             *
+             * Uses pactl to scan for available audio sinks and sources.
+             */
+            VolumeManager::SinkList list_devices() override
+            {
+                VolumeManager::SinkList sinks;
+
+                // Use pactl to list audio output devices (sinks)
+                std::string cmd = "pactl list sinks short";
+                std::array<char, 4096> buffer;
+                std::string result;
+
+                Core::Metrics::increment(spawn_counter);
+                FILE *pipe = popen(cmd.c_str(), "r");
+                if (!pipe)
+                {
+                    UC_LOG_WARN(Volume, "Failed to run pactl command");
+                    return sinks;
+                }
+                while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    result += buffer.data();
+                }
+                pclose(pipe);
+
+                // Parse output lines to extract sink information
+                size_t pos = 0;
+                while ((pos = result.find('\n')) != std::string::npos)
+                {
+                    std::string line = result.substr(0, pos);
+                    result.erase(0, pos + 1);
+
+                    auto tokens = split(line, '\t');
+                    if (tokens.size() >= 2)
+                    {
+                        AudioSink sink;
+                        sink.name = tokens[1];
+
+                        // Query human-friendly description for better display
+                        std::string desc_cmd = "pactl list sinks | grep -A10 'Name: " + sink.name + "' | grep 'Description:' | head -1 | cut -d':' -f2-";
+                        std::array<char, 512> desc_buffer;
+                        std::string desc_result;
+                        Core::Metrics::increment(spawn_counter);
+                        FILE *desc_pipe = popen(desc_cmd.c_str(), "r");
+                        if (desc_pipe)
+                        {
+                            if (fgets(desc_buffer.data(), desc_buffer.size(), desc_pipe) != nullptr)
+                            {
+                                desc_result = desc_buffer.data();
+                            }
+                            pclose(desc_pipe);
+                        }
+                        // Trim whitespace from the description
+                        desc_result.erase(0, desc_result.find_first_not_of(" \t\n\r"));
+                        desc_result.erase(desc_result.find_last_not_of(" \t\n\r") + 1);
+
+                        sink.description = desc_result.empty() ? sink.name : desc_result;
+                        sink.volume = get_sink_volume(sink.name);
+                        sink.muted = is_sink_muted(sink.name);
+                        sink.is_default = is_default_sink(sink.name);
+                        sinks.push_back(sink);
+                    }
+                }
+
+                // Use pactl to list audio input devices (sources)
+                cmd = "pactl list sources short";
+                result.clear();
+
+                Core::Metrics::increment(spawn_counter);
+                pipe = popen(cmd.c_str(), "r");
+                if (!pipe)
+                {
+                    UC_LOG_WARN(Volume, "Failed to run pactl command for sources");
+                    return sinks;
+                }
+                while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    result += buffer.data();
+                }
+                pclose(pipe);
+
+                pos = 0;
+                while ((pos = result.find('\n')) != std::string::npos)
+                {
+                    std::string line = result.substr(0, pos);
+                    result.erase(0, pos + 1);
+
+                    auto tokens = split(line, '\t');
+                    if (tokens.size() >= 2)
+                    {
+                        AudioSink source;
+                        source.name = tokens[1];
+
+                        std::string desc_cmd = "pactl list sources | grep -A10 'Name: " + source.name + "' | grep 'Description:' | head -1 | cut -d':' -f2-";
+                        std::array<char, 512> desc_buffer;
+                        std::string desc_result;
+                        Core::Metrics::increment(spawn_counter);
+                        FILE *desc_pipe = popen(desc_cmd.c_str(), "r");
+                        if (desc_pipe)
+                        {
+                            if (fgets(desc_buffer.data(), desc_buffer.size(), desc_pipe) != nullptr)
+                            {
+                                desc_result = desc_buffer.data();
+                            }
+                            pclose(desc_pipe);
+                        }
+                        desc_result.erase(0, desc_result.find_first_not_of(" \t\n\r"));
+                        desc_result.erase(desc_result.find_last_not_of(" \t\n\r") + 1);
+
+                        source.description = desc_result.empty() ? source.name : desc_result;
+                        source.volume = get_source_volume(source.name);
+                        source.muted = is_source_muted(source.name);
+                        source.is_default = is_default_source(source.name);
+                        sinks.push_back(source);
+                    }
+                }
+
+                return sinks;
+            }
+
+            /**
+             * @brief Set the volume level for an audio device
+             *
+             * Detects whether the device is a sink or source and uses the
+             * appropriate pactl command.
+             */
+            bool set_volume(const std::string &name, int volume) override
+            {
+                std::string cmd = is_source(name) ? "pactl set-source-volume " : "pactl set-sink-volume ";
+                cmd += name + " " + std::to_string(volume) + "%";
+                return run(cmd);
+            }
+
+            /**
+             * @brief Toggle the mute state of an audio device
+             */
+            bool toggle_mute(const std::string &name) override
+            {
+                std::string cmd = is_source(name) ? "pactl set-source-mute " : "pactl set-sink-mute ";
+                cmd += name + " toggle";
+                return run(cmd);
+            }
+
+            /**
+             * @brief Set a device as the default for its type (input or output)
+             */
+            bool set_default(const std::string &name) override
+            {
+                std::string cmd = is_source(name) ? "pactl set-default-source " : "pactl set-default-sink ";
+                cmd += name;
+                return run(cmd);
+            }
+
+        private:
+            /**
+             * @brief Whether a device name refers to an input device
+             */
+            static bool is_source(const std::string &name)
+            {
+                return name.find("input") != std::string::npos || name.find("source") != std::string::npos;
+            }
+
+            /**
+             * @brief Run a pactl command
+             * @return true if it exited with status 0
+             */
+            static bool run(const std::string &cmd)
+            {
+                Core::Metrics::increment(spawn_counter);
+                return std::system(cmd.c_str()) == 0;
+            }
+
+            /**
+             * @brief Split a string by a delimiter character
+             * @param s The string to split
+             * @param delimiter The character to split on
+             * @return A vector of substrings
+             */
+            static std::vector<std::string> split(const std::string &s, char delimiter)
+            {
+                std::vector<std::string> tokens;
+                std::string token;
+                for (char c : s)
+                {
+                    if (c == delimiter)
+                    {
+                        tokens.push_back(token);
+                        token.clear();
+                    }
+                    else
+                    {
+                        token += c;
+                    }
+                }
+                tokens.push_back(token);
+                return tokens;
+            }
+
+            /**
+             * @brief Read the first line a shell command prints
+             * @return The line, or an empty string if the command could not be run
+             */
+            static std::string first_line(const std::string &cmd)
+            {
+                std::array<char, 128> buffer;
+                std::string result;
+
+                Core::Metrics::increment(spawn_counter);
+                FILE *pipe = popen(cmd.c_str(), "r");
+                if (!pipe)
+                    return result;
+                if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    result = buffer.data();
+                }
+                pclose(pipe);
+                return result;
+            }
+
+            /**
+             * @brief Parse a percentage such as "40%"
+             * @return The value, or 0 if @p text is not a number
+             */
+            static int parse_percent(const std::string &text)
+            {
+                try
+                {
+                    return std::stoi(text);
+                }
+                catch (...)
+                {
+                    return 0;
+                }
+            }
+
+            /**
+             * @brief Trim whitespace from both ends
+             */
+            static std::string trim(std::string text)
+            {
+                text.erase(0, text.find_first_not_of(" \t\n\r"));
+                text.erase(text.find_last_not_of(" \t\n\r") + 1);
+                return text;
+            }
+
+            /**
+             * @brief Get the current volume level of an audio output device
+             * @param sink_name The name of the sink to query
+             * @return The volume level as a percentage (0-100)
+             */
+            static int get_sink_volume(const std::string &sink_name)
+            {
+                return parse_percent(first_line("pactl get-sink-volume " + sink_name + " | grep -oP '\\d+%' | head -1"));
+            }
+
+            /**
+             * @brief Get the current volume level of an audio input device
+             * @param source_name The name of the source to query
+             * @return The volume level as a percentage (0-100)
+             */
+            static int get_source_volume(const std::string &source_name)
+            {
+                return parse_percent(first_line("pactl get-source-volume " + source_name + " | grep -oP '\\d+%' | head -1"));
+            }
+
+            /**
+             * @brief Check if an audio input device is muted
+             * @param source_name The name of the source to query
+             * @return true if the source is muted, false otherwise
+             */
+            static bool is_source_muted(const std::string &source_name)
+            {
+                return first_line("pactl get-source-mute " + source_name).find("yes") != std::string::npos;
+            }
+
+            /**
+             * @brief Check if an audio output device is muted
+             * @param sink_name The name of the sink to query
+             * @return true if the sink is muted, false otherwise
+             */
+            static bool is_sink_muted(const std::string &sink_name)
+            {
+                return first_line("pactl get-sink-mute " + sink_name).find("yes") != std::string::npos;
+            }
+
+            /**
+             * @brief Check if an audio output device is the default sink
+             * @param sink_name The name of the sink to query
+             * @return true if the sink is the default, false otherwise
+             */
+            static bool is_default_sink(const std::string &sink_name)
+            {
+                return trim(first_line("pactl info | grep 'Default Sink' | cut -d':' -f2")) == sink_name;
+            }
+
+            /**
+             * @brief Check if an audio input device is the default source
+             * @param source_name The name of the source to query
+             * @return true if the source is the default, false otherwise
+             */
+            static bool is_default_source(const std::string &source_name)
+            {
+                return trim(first_line("pactl info | grep 'Default Source' | cut -d':' -f2")) == source_name;
+            }
+        };
+    } // namespace
+
+    std::unique_ptr<VolumeBackend> VolumeBackend::create()
+    {
+        return Core::Backend::mock() ? create_mock() : create_system();
+    }
+
+    std::unique_ptr<VolumeBackend> VolumeBackend::create_system()
+    {
+        return std::make_unique<PactlBackend>();
+    }
+
+} // namespace Volume
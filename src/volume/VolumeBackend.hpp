@@ -0,0 +1,72 @@
+/**
+ * @file VolumeBackend.hpp
+ * @brief Audio backend interface for Ultimate Control
+ *
+ * This file defines the VolumeBackend interface which VolumeManager uses
+ * for every read and change of audio devices, so the PulseAudio backend
+ * can be swapped for an in-process mock at runtime (see Core::Backend).
+ */
+
+#pragma once
+
+#include "VolumeManager.hpp"
+#include <memory>
+#include <string>
+
+namespace Volume
+{
+
+    /**
+     * @class VolumeBackend
+     * @brief Lists and changes audio devices
+     *
+     * Implementations must be safe to call from worker threads.
+     */
+    class VolumeBackend
+    {
+    public:
+        virtual ~VolumeBackend() = default;
+
+        /**
+         * @brief List audio devices
+         * @return Sinks followed by sources; partial or empty on failure
+         */
+        virtual VolumeManager::SinkList list_devices() = 0;
+
+        /**
+         * @brief Set the volume of a device
+         * @param name Device name
+         * @param volume Volume level, already clamped to 0-100
+         * @return false if the change failed
+         */
+        virtual bool set_volume(const std::string &name, int volume) = 0;
+
+        /**
+         * @brief Toggle the mute state of a device
+         * @return false if the change failed
+         */
+        virtual bool toggle_mute(const std::string &name) = 0;
+
+        /**
+         * @brief Make a device the default for its direction
+         * @return false if the change failed
+         */
+        virtual bool set_default(const std::string &name) = 0;
+
+        /**
+         * @brief The backend selected by Core::Backend
+         */
+        static std::unique_ptr<VolumeBackend> create();
+
+        /**
+         * @brief Backend driving PulseAudio/PipeWire through pactl
+         */
+        static std::unique_ptr<VolumeBackend> create_system();
+
+        /**
+         * @brief Simulated devices; see Core::Backend::MockOptions
+         */
+        static std::unique_ptr<VolumeBackend> create_mock();
+    };
+
+} // namespace Volume
@@ -8,187 +8,100 @@
  */
 
 #include "VolumeManager.hpp"
-#include <iostream>
+#include "VolumeBackend.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/Wakeups.hpp"
 #include <algorithm>
-#include <cstdlib>
-#include <cstdio>
 #include <memory>
-#include <array>
 #include <thread>
-#include <future>
-#include <gtkmm.h>
 
 namespace Volume
 {
 
+    namespace
+    {
+        const Core::Metrics::Id refresh_histogram = Core::Metrics::histogram("volume.refresh");
+        const Core::Metrics::Id set_volume_histogram = Core::Metrics::histogram("volume.set_volume");
+        const Core::Metrics::Id toggle_mute_histogram = Core::Metrics::histogram("volume.toggle_mute");
+        const Core::Metrics::Id set_default_histogram = Core::Metrics::histogram("volume.set_default");
+    }
+
     /**
      * @class VolumeManager::Impl
      * @brief Private implementation of the VolumeManager class
      *
-     * This class implements the actual audio device management functionality using
-     * PulseAudio's command-line interface (pactl).
+     * Keeps the device list and callbacks; every read and change of the
+     * devices goes through a VolumeBackend (pactl, or a mock). Shared with
+     * worker threads, which may outlive the VolumeManager.
      */
-    class VolumeManager::Impl
+    class VolumeManager::Impl : public std::enable_shared_from_this<VolumeManager::Impl>
     {
     public:
         /**
          * @brief Constructor for the implementation class
          */
-        Impl() = default;
+        Impl() : backend_(VolumeBackend::create()) {}
 
         /**
          * @brief Destructor for the implementation class
          */
         ~Impl() = default;
 
+        /**
+         * @brief Drop the callbacks once the VolumeManager is gone
+         *
+         * Work still running on a worker thread finishes without
+         * refreshing or notifying anyone.
+         */
+        void detach()
+        {
+            detached_ = true;
+            update_callback_ = nullptr;
+        }
+
         /**
          * @brief Scan for available audio devices
          *
-         * Uses pactl to scan for available audio sinks and sources.
-         * Populates the sinks_ vector with the results.
-         * Calls the update callback when finished if one is registered.
+         * Stores the result of query_sinks() and calls the update callback
+         * if one is registered.
          */
         void refresh_sinks()
         {
-            sinks_.clear();
-
-            // Use pactl to list audio output devices (sinks)
-            std::string cmd = "pactl list sinks short";
-            std::array<char, 4096> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-            {
-                std::cerr << "Failed to run pactl command\n";
-                return;
-            }
-            while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result += buffer.data();
-            }
-            pclose(pipe);
-
-            // Parse output lines to extract sink information
-            size_t pos = 0;
-            while ((pos = result.find('\n')) != std::string::npos)
-            {
-                std::string line = result.substr(0, pos);
-                result.erase(0, pos + 1);
-
-                auto tokens = split(line, '\t');
-                if (tokens.size() >= 2)
-                {
-                    AudioSink sink;
-                    sink.name = tokens[1];
-
-                    // Query human-friendly description for better display
-                    std::string desc_cmd = "pactl list sinks | grep -A10 'Name: " + sink.name + "' | grep 'Description:' | head -1 | cut -d':' -f2-";
-                    std::array<char, 512> desc_buffer;
-                    std::string desc_result;
-                    FILE *desc_pipe = popen(desc_cmd.c_str(), "r");
-                    if (desc_pipe)
-                    {
-                        if (fgets(desc_buffer.data(), desc_buffer.size(), desc_pipe) != nullptr)
-                        {
-                            desc_result = desc_buffer.data();
-                        }
-                        pclose(desc_pipe);
-                    }
-                    // Trim whitespace from the description
-                    desc_result.erase(0, desc_result.find_first_not_of(" \t\n\r"));
-                    desc_result.erase(desc_result.find_last_not_of(" \t\n\r") + 1);
-
-                    sink.description = desc_result.empty() ? sink.name : desc_result;
-                    sink.volume = get_sink_volume(sink.name);
-                    sink.muted = is_sink_muted(sink.name);
-                    sink.is_default = is_default_sink(sink.name);
-                    sinks_.push_back(sink);
-                }
-            }
-
-            // Use pactl to list audio input devices (sources)
-            cmd = "pactl list sources short";
-            result.clear();
-
-            pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-            {
-                std::cerr << "Failed to run pactl command for sources\n";
-                return;
-            }
-            while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result += buffer.data();
-            }
-            pclose(pipe);
-
-            pos = 0;
-            while ((pos = result.find('\n')) != std::string::npos)
-            {
-                std::string line = result.substr(0, pos);
-                result.erase(0, pos + 1);
-
-                auto tokens = split(line, '\t');
-                if (tokens.size() >= 2)
-                {
-                    AudioSink source;
-                    source.name = tokens[1];
-
-                    std::string desc_cmd = "pactl list sources | grep -A10 'Name: " + source.name + "' | grep 'Description:' | head -1 | cut -d':' -f2-";
-                    std::array<char, 512> desc_buffer;
-                    std::string desc_result;
-                    FILE *desc_pipe = popen(desc_cmd.c_str(), "r");
-                    if (desc_pipe)
-                    {
-                        if (fgets(desc_buffer.data(), desc_buffer.size(), desc_pipe) != nullptr)
-                        {
-                            desc_result = desc_buffer.data();
-                        }
-                        pclose(desc_pipe);
-                    }
-                    desc_result.erase(0, desc_result.find_first_not_of(" \t\n\r"));
-                    desc_result.erase(desc_result.find_last_not_of(" \t\n\r") + 1);
-
-                    source.description = desc_result.empty() ? source.name : desc_result;
-                    source.volume = get_source_volume(source.name);
-                    source.muted = is_source_muted(source.name);
-                    source.is_default = is_default_source(source.name);
-                    sinks_.push_back(source);
-                }
-            }
-
+            sinks_ = query_sinks();
             if (update_callback_)
             {
                 update_callback_(sinks_);
             }
         }
 
+        /**
+         * @brief List available audio devices
+         * @return Sinks followed by sources; partial if the backend fails
+         *
+         * Touches no member state, so it may run on a worker thread.
+         */
+        VolumeManager::SinkList query_sinks()
+        {
+            Core::Metrics::ScopedTimer timer(refresh_histogram);
+            return backend_->list_devices();
+        }
+
         /**
          * @brief Set the volume level for an audio device
          * @param sink_name The name of the device to adjust
          * @param volume The volume level to set (0-100)
          *
          * Sets the volume of the specified audio device. The volume is clamped
-         * to the range 0-100. Detects whether the device is a sink or source
-         * and uses the appropriate pactl command.
+         * to the range 0-100.
          */
         void set_volume(const std::string &sink_name, int volume)
         {
+            Core::Metrics::ScopedTimer timer(set_volume_histogram);
             int vol = std::max(0, std::min(100, volume));
-            std::string cmd;
-            if (sink_name.find("input") != std::string::npos || sink_name.find("source") != std::string::npos)
+            if (!backend_->set_volume(sink_name, vol))
             {
-                cmd = "pactl set-source-volume " + sink_name + " " + std::to_string(vol) + "%";
-            }
-            else
-            {
-                cmd = "pactl set-sink-volume " + sink_name + " " + std::to_string(vol) + "%";
-            }
-            int ret = std::system(cmd.c_str());
-            if (ret != 0)
-            {
-                std::cerr << "Failed to set volume for " << sink_name << std::endl;
+                UC_LOG_WARN(Volume, "Failed to set volume for " << sink_name);
             }
             // Note: We don't refresh sinks immediately to avoid widget destruction during slider drag
         }
@@ -196,25 +109,13 @@ namespace Volume
         /**
          * @brief Toggle the mute state of an audio device
          * @param sink_name The name of the device to toggle
-         *
-         * Toggles the mute state of the specified audio device. Detects whether
-         * the device is a sink or source and uses the appropriate pactl command.
          */
         void toggle_mute(const std::string &sink_name)
         {
-            std::string cmd;
-            if (sink_name.find("input") != std::string::npos || sink_name.find("source") != std::string::npos)
-            {
-                cmd = "pactl set-source-mute " + sink_name + " toggle";
-            }
-            else
+            Core::Metrics::ScopedTimer timer(toggle_mute_histogram);
+            if (!backend_->toggle_mute(sink_name))
             {
-                cmd = "pactl set-sink-mute " + sink_name + " toggle";
-            }
-            int ret = std::system(cmd.c_str());
-            if (ret != 0)
-            {
-                std::cerr << "Failed to toggle mute for " << sink_name << std::endl;
+                UC_LOG_WARN(Volume, "Failed to toggle mute for " << sink_name);
             }
             // Note: We don't refresh sinks immediately to avoid widget destruction during toggle
         }
@@ -237,223 +138,30 @@ namespace Volume
         void set_default_device(const std::string &sink_name)
         {
             // Create a new thread to handle the default device change
-            std::thread([this, sink_name]()
+            std::thread([self = shared_from_this(), sink_name]()
                         {
-                std::string cmd;
-                if (sink_name.find("input") != std::string::npos || sink_name.find("source") != std::string::npos)
+                Core::Metrics::ScopedTimer timer(set_default_histogram);
+                if (!self->backend_->set_default(sink_name))
                 {
-                    cmd = "pactl set-default-source " + sink_name;
-                }
-                else
-                {
-                    cmd = "pactl set-default-sink " + sink_name;
-                }
-
-                int ret = std::system(cmd.c_str());
-                if (ret != 0)
-                {
-                    std::cerr << "Failed to set default device for " << sink_name << std::endl;
+                    UC_LOG_WARN(Volume, "Failed to set default device for " << sink_name);
                 }
 
                 // Schedule the refresh on the main thread using Glib::idle
                 // This ensures UI updates happen safely from the main thread
-                Glib::signal_idle().connect_once([this]() {
-                    refresh_sinks();
+                Core::Wakeups::idle_once([self]() {
+                    if (!self->detached_)
+                    {
+                        self->refresh_sinks();
+                    }
                 }); })
                 .detach(); // Detach the thread so it runs independently
         }
 
     private:
+        std::unique_ptr<VolumeBackend> backend_;
         std::vector<AudioSink> sinks_;
         VolumeManager::SinkUpdateCallback update_callback_;
-
-        /**
-         * @brief Split a string by a delimiter character
-         * @param s The string to split
-         * @param delimiter The character to split on
-         * @return A vector of substrings
-         */
-        static std::vector<std::string> split(const std::string &s, char delimiter)
-        {
-            std::vector<std::string> tokens;
-            std::string token;
-            for (char c : s)
-            {
-                if (c == delimiter)
-                {
-                    tokens.push_back(token);
-                    token.clear();
-                }
-                else
-                {
-                    token += c;
-                }
-            }
-            tokens.push_back(token);
-            return tokens;
-        }
-
-        /**
-         * @brief Get the current volume level of an audio output device
-         * @param sink_name The name of the sink to query
-         * @return The volume level as a percentage (0-100)
-         */
-        int get_sink_volume(const std::string &sink_name)
-        {
-            std::string cmd = "pactl get-sink-volume " + sink_name + " | grep -oP '\\d+%' | head -1";
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return 0;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result = buffer.data();
-            }
-            pclose(pipe);
-
-            try
-            {
-                int percent = std::stoi(result);
-                return percent;
-            }
-            catch (...)
-            {
-                return 0;
-            }
-        }
-
-        /**
-         * @brief Get the current volume level of an audio input device
-         * @param source_name The name of the source to query
-         * @return The volume level as a percentage (0-100)
-         */
-        int get_source_volume(const std::string &source_name)
-        {
-            std::string cmd = "pactl get-source-volume " + source_name + " | grep -oP '\\d+%' | head -1";
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return 0;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result = buffer.data();
-            }
-            pclose(pipe);
-
-            try
-            {
-                int percent = std::stoi(result);
-                return percent;
-            }
-            catch (...)
-            {
-                return 0;
-            }
-        }
-
-        /**
-         * @brief Check if an audio input device is muted
-         * @param source_name The name of the source to query
-         * @return true if the source is muted, false otherwise
-         */
-        bool is_source_muted(const std::string &source_name)
-        {
-            std::string cmd = "pactl get-source-mute " + source_name;
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return false;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result = buffer.data();
-            }
-            pclose(pipe);
-
-            return result.find("yes") != std::string::npos;
-        }
-
-        /**
-         * @brief Check if an audio output device is muted
-         * @param sink_name The name of the sink to query
-         * @return true if the sink is muted, false otherwise
-         */
-        bool is_sink_muted(const std::string &sink_name)
-        {
-            std::string cmd = "pactl get-sink-mute " + sink_name;
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return false;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result = buffer.data();
-            }
-            pclose(pipe);
-
-            return result.find("yes") != std::string::npos;
-        }
-
-        /**
-         * @brief Check if an audio output device is the default sink
-         * @param sink_name The name of the sink to query
-         * @return true if the sink is the default, false otherwise
-         */
-        bool is_default_sink(const std::string &sink_name)
-        {
-            std::string cmd = "pactl info | grep 'Default Sink' | cut -d':' -f2";
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return false;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result = buffer.data();
-            }
-            pclose(pipe);
-
-            // Trim whitespace
-            result.erase(0, result.find_first_not_of(" \t\n\r"));
-            result.erase(result.find_last_not_of(" \t\n\r") + 1);
-
-            return result == sink_name;
-        }
-
-        /**
-         * @brief Check if an audio input device is the default source
-         * @param source_name The name of the source to query
-         * @return true if the source is the default, false otherwise
-         */
-        bool is_default_source(const std::string &source_name)
-        {
-            std::string cmd = "pactl info | grep 'Default Source' | cut -d':' -f2";
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return false;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result = buffer.data();
-            }
-            pclose(pipe);
-
-            // Trim whitespace
-            result.erase(0, result.find_first_not_of(" \t\n\r"));
-            result.erase(result.find_last_not_of(" \t\n\r") + 1);
-
-            return result == source_name;
-        }
+        bool detached_ = false; ///< Set by detach(); main thread only
     };
 
     /**
@@ -461,14 +169,18 @@ namespace Volume
      *
      * Creates the implementation object using the PIMPL idiom.
      */
-    VolumeManager::VolumeManager() : impl_(std::make_unique<Impl>()) {}
+    VolumeManager::VolumeManager() : impl_(std::make_shared<Impl>()) {}
 
     /**
      * @brief Destructor for VolumeManager
      *
-     * Default implementation is sufficient since impl_ is a unique_ptr.
+     * Detaches the implementation; a default-device change still in
+     * flight keeps it alive until it finishes.
      */
-    VolumeManager::~VolumeManager() = default;
+    VolumeManager::~VolumeManager()
+    {
+        impl_->detach();
+    }
 
     /**
      * @brief Scan for available audio devices
@@ -480,6 +192,17 @@ namespace Volume
         impl_->refresh_sinks();
     }
 
+    /**
+     * @brief List available audio devices without notifying
+     * @return The devices found
+     *
+     * Delegates to the implementation class.
+     */
+    VolumeManager::SinkList VolumeManager::query_sinks() const
+    {
+        return impl_->query_sinks();
+    }
+
     /**
      * @brief Set the volume level for an audio device
      * @param sink_name The name of the device to adjust
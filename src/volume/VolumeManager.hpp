@@ -40,7 +40,7 @@ namespace Volume
      *
      * Provides an interface for listing audio devices, controlling their volume,
      * and toggling their mute state. Uses PulseAudio via its command-line
-     * interface (pactl) for all operations.
+     * interface (pactl), or a mock chosen by Core::Backend (see VolumeBackend).
      */
     class VolumeManager
     {
@@ -68,6 +68,15 @@ namespace Volume
          */
         void refresh_sinks();
 
+        /**
+         * @brief List available audio devices without notifying
+         * @return Sinks followed by sources
+         *
+         * Does not update the manager's state or call the update callback,
+         * so it is safe to call from a worker thread.
+         */
+        SinkList query_sinks() const;
+
         /**
          * @brief Set the volume level for an audio device
          * @param sink_name The name of the device to adjust
@@ -105,7 +114,7 @@ namespace Volume
 
     private:
         class Impl;                  ///< Forward declaration of implementation class
-        std::unique_ptr<Impl> impl_; ///< Pointer to implementation (PIMPL idiom)
+        std::shared_ptr<Impl> impl_; ///< Pointer to implementation, shared with worker threads
     };
 
 } // namespace Volume
@@ -0,0 +1,181 @@
+/**
+ * @file VolumeMock.cpp
+ * @brief Simulated audio devices for tests and benchmarks
+ */
+
+#include "VolumeBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include <algorithm> // for std::find_if
+#include <mutex>     // for std::mutex
+
+namespace Volume
+{
+
+    namespace
+    {
+        /**
+         * @struct World
+         * @brief Devices shared by every mock backend built from the same options
+         */
+        struct World
+        {
+            explicit World(std::uint64_t gen) : generation(gen), simulation("volume")
+            {
+                // Half outputs, half inputs; names follow PulseAudio's so the
+                // sink/source heuristics of the managers and the CLI apply
+                const std::size_t count = simulation.options().devices;
+                const std::size_t sinks = count - count / 2;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const bool output = i < sinks;
+                    const std::size_t index = output ? i : i - sinks;
+                    AudioSink device;
+                    device.name = std::string(output ? "alsa_output" : "alsa_input") + ".mock-" + std::to_string(index) + ".analog-stereo";
+                    device.description = std::string(output ? "Mock Output " : "Mock Input ") + std::to_string(index);
+                    device.volume = simulation.uniform(0, 100);
+                    device.muted = simulation.chance(0.1);
+                    device.is_default = index == 0;
+                    devices.push_back(device);
+                }
+            }
+
+            const std::uint64_t generation;
+            Core::Backend::Simulation simulation;
+            std::mutex mutex; ///< Guards devices
+            VolumeManager::SinkList devices;
+        };
+
+        /**
+         * @brief The devices for the current options, rebuilt when they change
+         */
+        std::shared_ptr<World> world()
+        {
+            static std::mutex mutex;
+            static std::shared_ptr<World> current;
+            std::lock_guard<std::mutex> lock(mutex);
+            const std::uint64_t generation = Core::Backend::generation();
+            if (!current || current->generation != generation)
+            {
+                current = std::make_shared<World>(generation);
+            }
+            return current;
+        }
+
+        bool is_source(const std::string &name)
+        {
+            return name.find("input") != std::string::npos;
+        }
+
+        /**
+         * @brief Change one random device, as another client would
+         */
+        void perturb()
+        {
+            auto w = world();
+            std::lock_guard<std::mutex> lock(w->mutex);
+            if (w->devices.empty())
+            {
+                return;
+            }
+            auto &device = w->devices[static_cast<std::size_t>(w->simulation.uniform(0, static_cast<int>(w->devices.size()) - 1))];
+            if (w->simulation.chance(0.125))
+            {
+                device.muted = !device.muted;
+            }
+            else
+            {
+                device.volume = w->simulation.uniform(0, 100);
+            }
+        }
+
+        /**
+         * @class MockBackend
+         * @brief Audio backend answering from a World
+         */
+        class MockBackend : public VolumeBackend
+        {
+        public:
+            MockBackend() : world_(world()) {}
+
+            VolumeManager::SinkList list_devices() override
+            {
+                if (!world_->simulation.call())
+                {
+                    UC_LOG_DEBUG(Volume, "Mock device list failed");
+                    return {};
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                return world_->devices;
+            }
+
+            bool set_volume(const std::string &name, int volume) override
+            {
+                return change(name, [volume](AudioSink &device)
+                              { device.volume = volume; });
+            }
+
+            bool toggle_mute(const std::string &name) override
+            {
+                return change(name, [](AudioSink &device)
+                              { device.muted = !device.muted; });
+            }
+
+            bool set_default(const std::string &name) override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                auto &devices = world_->devices;
+                if (std::find_if(devices.begin(), devices.end(), [&name](const AudioSink &device)
+                                 { return device.name == name; }) == devices.end())
+                {
+                    return false;
+                }
+                for (auto &device : devices)
+                {
+                    if (is_source(device.name) == is_source(name))
+                    {
+                        device.is_default = device.name == name;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            /**
+             * @brief Apply a change to one device after a simulated call
+             * @return false if the call failed or the device does not exist
+             */
+            template <typename Change>
+            bool change(const std::string &name, Change apply)
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                for (auto &device : world_->devices)
+                {
+                    if (device.name == name)
+                    {
+                        apply(device);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::shared_ptr<World> world_;
+        };
+    } // namespace
+
+    std::unique_ptr<VolumeBackend> VolumeBackend::create_mock()
+    {
+        Core::Backend::start_storm("volume", perturb);
+        return std::make_unique<MockBackend>();
+    }
+
+} // namespace Volume
@@ -8,9 +8,6 @@
 
 #pragma once
 
-#include <string>
-#include <map>
-
 namespace Volume {
 
 /**
@@ -19,17 +16,10 @@ namespace Volume {
  *
  * Provides functionality for loading, saving, and accessing
  * volume-related settings such as default volume levels.
- * Settings are persisted to a configuration file.
+ * Settings live in Core::Config under "volume.".
  */
 class VolumeSettings {
 public:
-    /**
-     * @brief Constructor
-     *
-     * Initializes the settings manager and loads existing settings.
-     */
-    VolumeSettings();
-
     /**
      * @brief Destructor
      *
@@ -37,18 +27,10 @@ public:
      */
     ~VolumeSettings();
 
-    /**
-     * @brief Load settings from the configuration file
-     *
-     * Reads settings from the configuration file and populates
-     * the settings map. If the file doesn't exist, uses defaults.
-     */
-    void load();
-
     /**
      * @brief Save settings to the configuration file
      *
-     * Writes the current settings to the configuration file.
+     * Has the settings file written shortly after, off the UI thread.
      */
     void save() const;
 
@@ -67,10 +49,6 @@ public:
      * Sets the default volume level used for new devices.
      */
     void set_default_volume(int volume);
-
-private:
-    std::map<std::string, int> settings_;  ///< Map of setting names to values
-    std::string config_path_;              ///< Path to the configuration file
 };
 
 } // namespace Volume
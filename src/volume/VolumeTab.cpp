@@ -7,16 +7,30 @@
  */
 
 #include "VolumeTab.hpp"
-#include <iostream>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/TabModule.hpp"
+#include "core/Staging.hpp"
+#include "core/Trace.hpp"
+#include "core/WarmCache.hpp"
 
 namespace Volume
 {
 
+    namespace
+    {
+        const Core::Metrics::Id reconcile_counter = Core::Metrics::counter("reconciles");
+        const Core::Metrics::Id reconcile_histogram = Core::Metrics::histogram("volume.reconcile");
+
+        /// Warm cache section holding the device list
+        const char *const kCacheSection = "volume";
+    }
+
     /**
      * @brief Constructor for the volume tab
      *
      * Initializes the volume manager, creates the UI components,
-     * and performs an initial device scan.
+     * and starts an initial device scan off the main thread.
      */
     VolumeTab::VolumeTab()
         : manager_(std::make_shared<VolumeManager>()), // Create volume manager
@@ -66,13 +80,18 @@ namespace Volume
 
         // Register callback for audio device list updates
         manager_->set_update_callback([this](const std::vector<AudioSink> &sinks)
-                                      { update_sink_list(sinks); });
+                                      {
+            update_sink_list(sinks);
+            remember_state(sinks); });
 
-        // Perform initial scan for audio devices
-        manager_->refresh_sinks();
+        // Paint the devices from the last run in the first frame
+        show_cached_state();
+
+        // Query the live devices off the main thread
+        refresh();
 
         show_all_children();
-        std::cout << "Volume tab loaded!" << std::endl;
+        UC_LOG_DEBUG(Volume, "Volume tab loaded!");
     }
 
     /**
@@ -80,6 +99,82 @@ namespace Volume
      */
     VolumeTab::~VolumeTab() = default;
 
+    /**
+     * @brief Re-read the device list after an outside change
+     *
+     * pactl runs on the hydration thread; the rows are rebuilt on the main
+     * thread when it answers.
+     */
+    void VolumeTab::refresh()
+    {
+        auto manager = manager_;
+        Core::Staging::hydrate(
+            *this, [manager]()
+            { return manager->query_sinks(); },
+            [this](const std::vector<AudioSink> &sinks)
+            {
+                update_sink_list(sinks);
+                remember_state(sinks);
+            });
+    }
+
+    /**
+     * @brief Show the devices saved by the last run, marked as stale
+     *
+     * The stale style stays until the live query reports back.
+     */
+    void VolumeTab::show_cached_state()
+    {
+        Core::WarmCache::Reader reader;
+        std::uint32_t count = 0;
+        if (!Core::WarmCache::read(kCacheSection, reader) || !reader.u32(count))
+        {
+            return;
+        }
+
+        std::vector<AudioSink> sinks;
+        for (std::uint32_t i = 0; i < count && reader.ok(); ++i)
+        {
+            AudioSink sink;
+            std::int32_t volume = 0;
+            reader.str(sink.name);
+            reader.str(sink.description);
+            reader.i32(volume);
+            reader.boolean(sink.muted);
+            reader.boolean(sink.is_default);
+            sink.volume = volume;
+            sinks.push_back(sink);
+        }
+        if (!reader.ok())
+        {
+            return;
+        }
+
+        update_sink_list(sinks);
+        notebook_.get_style_context()->add_class("stale");
+    }
+
+    /**
+     * @brief Save live devices to the warm cache and clear the stale marker
+     * @param sinks The devices just reported by the manager
+     */
+    void VolumeTab::remember_state(const std::vector<AudioSink> &sinks)
+    {
+        notebook_.get_style_context()->remove_class("stale");
+
+        Core::WarmCache::Writer writer;
+        writer.u32(static_cast<std::uint32_t>(sinks.size()));
+        for (const auto &sink : sinks)
+        {
+            writer.str(sink.name);
+            writer.str(sink.description);
+            writer.i32(sink.volume);
+            writer.boolean(sink.muted);
+            writer.boolean(sink.is_default);
+        }
+        Core::WarmCache::store(kCacheSection, writer.take());
+    }
+
     /**
      * @brief Update the list of displayed audio devices
      * @param sinks Vector of AudioSink objects to display
@@ -90,21 +185,33 @@ namespace Volume
      */
     void VolumeTab::update_sink_list(const std::vector<AudioSink> &sinks)
     {
-        // Remove and clear all existing output device widgets
-        for (auto &widget : output_widgets_)
-        {
-            output_box_.remove(*widget);
-        }
-        output_widgets_.clear();
+        Core::Metrics::increment(reconcile_counter);
+        const unsigned int generation = ++list_generation_;
+        const std::int64_t start_us = Core::Trace::now_us();
 
-        // Remove and clear all existing input device widgets
-        for (auto &widget : input_widgets_)
-        {
-            input_box_.remove(*widget);
-        }
-        input_widgets_.clear();
+        // Clear in the first step so the old rows stay up until new ones land
+        Core::Staging::step(*this, [this, generation]()
+                            {
+            if (generation != list_generation_)
+            {
+                return;
+            }
+
+            // Remove and clear all existing output device widgets
+            for (auto &widget : output_widgets_)
+            {
+                output_box_.remove(*widget);
+            }
+            output_widgets_.clear();
 
-        // Create new widgets for each audio device
+            // Remove and clear all existing input device widgets
+            for (auto &widget : input_widgets_)
+            {
+                input_box_.remove(*widget);
+            }
+            input_widgets_.clear(); });
+
+        // Create one widget per frame step for each audio device
         for (const auto &sink : sinks)
         {
             // Skip monitor devices (virtual loopback devices)
@@ -112,26 +219,43 @@ namespace Volume
             {
                 continue;
             }
-            // Create a widget for this audio device
-            auto widget = std::make_unique<VolumeWidget>(sink, manager_);
 
-            // Add to either input or output tab based on device type
-            if (sink.name.find("input") != std::string::npos || sink.name.find("source") != std::string::npos)
-            {
-                // This is an input device (microphone, line-in, etc.)
-                input_box_.pack_start(*widget, Gtk::PACK_SHRINK);
-                input_widgets_.push_back(std::move(widget));
-            }
-            else
-            {
-                // This is an output device (speakers, headphones, etc.)
-                output_box_.pack_start(*widget, Gtk::PACK_SHRINK);
-                output_widgets_.push_back(std::move(widget));
-            }
+            Core::Staging::step(*this, [this, sink, generation]()
+                                {
+                if (generation != list_generation_)
+                {
+                    return;
+                }
+
+                // Create a widget for this audio device
+                auto widget = std::make_unique<VolumeWidget>(sink, manager_);
+                widget->show_all();
+
+                // Add to either input or output tab based on device type
+                if (sink.name.find("input") != std::string::npos || sink.name.find("source") != std::string::npos)
+                {
+                    // This is an input device (microphone, line-in, etc.)
+                    input_box_.pack_start(*widget, Gtk::PACK_SHRINK);
+                    input_widgets_.push_back(std::move(widget));
+                }
+                else
+                {
+                    // This is an output device (speakers, headphones, etc.)
+                    output_box_.pack_start(*widget, Gtk::PACK_SHRINK);
+                    output_widgets_.push_back(std::move(widget));
+                } });
         }
 
-        // Make sure all new widgets are visible
-        show_all_children();
+        // Time from the update to its last row
+        Core::Staging::step(*this, [this, generation, start_us]()
+                            {
+            if (generation == list_generation_)
+            {
+                Core::Metrics::record_us(reconcile_histogram, static_cast<std::uint64_t>(Core::Trace::now_us() - start_us));
+            } });
     }
 
 } // namespace Volume
+
+/// Factory looked up when libuc-volume.so is loaded
+UC_TAB_MODULE("volume", Volume::VolumeTab);
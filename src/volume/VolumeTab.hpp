@@ -40,6 +40,14 @@ public:
      */
     virtual ~VolumeTab();
 
+    /**
+     * @brief Re-read the device list after an outside change
+     *
+     * Called when the control socket changed a volume, so the sliders
+     * match without waiting for the next user interaction.
+     */
+    void refresh();
+
 private:
     /**
      * @brief Update the list of displayed audio devices
@@ -47,10 +55,22 @@ private:
      *
      * Clears the current list of volume widgets and creates new ones
      * for each audio device in the provided vector. Separates devices
-     * into input and output categories.
+     * into input and output categories. Rows are added in frame steps
+     * (see Core::Staging).
      */
     void update_sink_list(const std::vector<AudioSink>& sinks);
 
+    /**
+     * @brief Show the devices saved by the last run, marked as stale
+     */
+    void show_cached_state();
+
+    /**
+     * @brief Save live devices to the warm cache and clear the stale marker
+     * @param sinks The devices just reported by the manager
+     */
+    void remember_state(const std::vector<AudioSink>& sinks);
+
     std::shared_ptr<VolumeManager> manager_;  ///< Volume manager for audio device operations
 
     Gtk::Notebook notebook_;  ///< Notebook widget for input/output tabs
@@ -59,6 +79,7 @@ private:
 
     std::vector<std::unique_ptr<VolumeWidget>> output_widgets_;  ///< List of output device widgets
     std::vector<std::unique_ptr<VolumeWidget>> input_widgets_;   ///< List of input device widgets
+    unsigned int list_generation_ = 0;                           ///< Bumped per list update; older queued rows are skipped
 };
 
 } // namespace Volume
@@ -7,10 +7,16 @@
  */
 
 #include "VolumeWidget.hpp"
+#include "core/Metrics.hpp"
 
 namespace Volume
 {
 
+    namespace
+    {
+        const Core::Metrics::Id widget_counter = Core::Metrics::counter("widgets.created");
+    }
+
     /**
      * @brief Constructor for the volume widget
      * @param sink The audio device to display
@@ -33,6 +39,8 @@ namespace Volume
           mute_button_(),
           default_check_("Set as default")
     {
+        Core::Metrics::increment(widget_counter);
+
         // Set up the main container with margins for better spacing
         set_margin_start(10);
         set_margin_end(10);
@@ -0,0 +1,428 @@
+/**
+ * @file WifiBackend.cpp
+ * @brief NetworkManager implementation of the WiFi backend
+ *
+ * This file implements the system WifiBackend on top of NetworkManager's
+ * command-line interface (nmcli), and the runtime choice of backend.
+ */
+
+#include "WifiBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+namespace Wifi
+{
+
+    namespace
+    {
+        /// Counts every nmcli invocation
+        const Core::Metrics::Id spawn_counter = Core::Metrics::counter("subprocess.spawns");
+
+        /**
+         * @class NmcliBackend
+         * @brief WiFi backend running nmcli for every operation
+         */
+        class NmcliBackend : public WifiBackend
+        {
+        public:
+            /**
+             * @brief Scan for available WiFi networks
+             *
+             * Lists networks with nmcli, then marks the ones with a saved
+             * connection profile.
+             */
+            WifiManager::NetworkList scan() override
+            {
+                WifiManager::NetworkList networks;
+                std::string cmd = "nmcli -t -f IN-USE,SSID,SIGNAL,SECURITY device wifi list";
+                std::array<char, 4096> buffer;
+                std::string result;
+
+                Core::Metrics::increment(spawn_counter);
+                FILE *pipe = popen(cmd.c_str(), "r");
+                if (!pipe)
+                {
+                    UC_LOG_WARN(Wifi, "Failed to run nmcli");
+                    return networks;
+                }
+                while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    result += buffer.data();
+                }
+                pclose(pipe);
+
+                // Parse the scan results
+                size_t pos = 0;
+                while ((pos = result.find('\n')) != std::string::npos)
+                {
+                    std::string line = result.substr(0, pos);
+                    result.erase(0, pos + 1);
+
+                    auto tokens = split(line, ':');
+                    if (tokens.size() >= 4)
+                    {
+                        Network net;
+                        net.connected = (tokens[0] == "*");
+                        net.ssid = tokens[1];
+                        net.bssid = ""; // We don't have BSSID in this command
+                        try
+                        {
+                            // Parse the signal strength percentage from nmcli output
+                            net.signal_strength = std::stoi(tokens[2]);
+                        }
+                        catch (...)
+                        {
+                            net.signal_strength = 0;
+                        }
+                        net.secured = (tokens[3] != "--" && !tokens[3].empty());
+                        networks.push_back(net);
+                    }
+                }
+
+                // One lookup for all rows instead of a password query per network
+                std::set<std::string> saved = saved_connections();
+                for (auto &net : networks)
+                {
+                    net.saved = saved.count(net.ssid) > 0;
+                }
+                return networks;
+            }
+
+            /**
+             * @brief Query the state of the WiFi radio with nmcli
+             */
+            bool radio_enabled() override
+            {
+                return trim(first_line("nmcli radio wifi")) == "enabled";
+            }
+
+            bool set_radio(bool enabled) override
+            {
+                std::string cmd = enabled ? "nmcli radio wifi on" : "nmcli radio wifi off";
+                Core::Metrics::increment(spawn_counter);
+                return std::system(cmd.c_str()) == 0;
+            }
+
+            bool disconnect() override
+            {
+                // Get the WiFi interface to disconnect
+                std::string wifi_interface = get_wifi_interface();
+                if (wifi_interface.empty())
+                {
+                    UC_LOG_ERROR(Wifi, "Error: No WiFi interface found");
+                    return false;
+                }
+
+                std::string cmd = "nmcli device disconnect " + wifi_interface;
+                Core::Metrics::increment(spawn_counter);
+                std::system(cmd.c_str());
+                return true;
+            }
+
+            /**
+             * @brief Remove saved credentials for a WiFi network
+             *
+             * Finds and deletes all connection profiles associated with the specified SSID.
+             * Also cleans up any temporary connections that might have been created.
+             */
+            bool forget(const std::string &ssid) override
+            {
+                // Get a list of all connection profiles from NetworkManager
+                std::string cmd = "nmcli -t -f NAME,UUID,TYPE connection show";
+                std::array<char, 4096> buffer;
+                std::string result;
+
+                Core::Metrics::increment(spawn_counter);
+                FILE *pipe = popen(cmd.c_str(), "r");
+                if (!pipe)
+                {
+                    UC_LOG_WARN(Wifi, "Failed to run nmcli to find connections");
+                    return false;
+                }
+
+                while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    result += buffer.data();
+                }
+                pclose(pipe);
+
+                // Parse the output to find all WiFi connection profiles
+                size_t pos = 0;
+                std::vector<std::pair<std::string, std::string>> wifi_connections; // name, uuid pairs
+
+                while ((pos = result.find('\n')) != std::string::npos)
+                {
+                    std::string line = result.substr(0, pos);
+                    result.erase(0, pos + 1);
+
+                    auto tokens = split(line, ':');
+                    if (tokens.size() >= 3 && tokens[2] == "802-11-wireless")
+                    {
+                        wifi_connections.push_back({tokens[0], tokens[1]});
+                    }
+                }
+
+                // Check each WiFi connection profile to see if it matches our target SSID
+                bool deleted_any = false;
+
+                for (const auto &conn : wifi_connections)
+                {
+                    // Get the SSID associated with this connection profile
+                    std::string conn_ssid = trim(first_line("nmcli -g 802-11-wireless.ssid connection show " + conn.second + " 2>/dev/null"));
+
+                    // If this connection profile matches our target SSID, delete it
+                    if (conn_ssid == ssid)
+                    {
+                        std::string delete_cmd = "nmcli connection delete " + conn.second;
+                        UC_LOG_DEBUG(Wifi, "Deleting connection '" << conn.first << "' (UUID: " << conn.second << ") for SSID: " << ssid);
+                        Core::Metrics::increment(spawn_counter);
+                        std::system(delete_cmd.c_str());
+                        deleted_any = true;
+                    }
+                }
+
+                // If no matching profiles were found, try deleting by connection name as a fallback
+                if (!deleted_any)
+                {
+                    std::string delete_cmd = "nmcli connection delete \"" + ssid + "\" 2>/dev/null || true";
+                    Core::Metrics::increment(spawn_counter);
+                    std::system(delete_cmd.c_str());
+                }
+
+                // Clean up any temporary connections that might have been created by nmcli
+                std::string cleanup_cmd = "nmcli -t -f NAME connection show | grep \"temp-conn-\" | xargs -r -n1 nmcli connection delete 2>/dev/null || true";
+                Core::Metrics::increment(spawn_counter);
+                std::system(cleanup_cmd.c_str());
+                return true;
+            }
+
+            /**
+             * @brief Connect to a WiFi network
+             *
+             * First tries to connect using saved credentials. If that fails,
+             * creates a new connection profile with the provided credentials.
+             */
+            bool connect(const std::string &ssid, const std::string &password,
+                         const std::string &security_type) override
+            {
+                // Try to connect using an existing saved connection profile first
+                std::string saved_cmd = "nmcli con up \"" + ssid + "\" 2>/dev/null";
+                Core::Metrics::increment(spawn_counter);
+                if (std::system(saved_cmd.c_str()) == 0)
+                {
+                    UC_LOG_INFO(Wifi, "Successfully connected to saved network: " << ssid);
+                    return true;
+                }
+
+                // If no saved connection exists or connection failed, create a new connection profile
+                std::string cmd;
+                if (!password.empty() && !security_type.empty())
+                {
+                    // For secured networks, create a detailed connection profile with security settings
+                    std::string wifi_interface = get_wifi_interface();
+                    if (wifi_interface.empty())
+                    {
+                        UC_LOG_ERROR(Wifi, "Error: No WiFi interface found");
+                        return false;
+                    }
+
+                    // Use the SSID as the connection profile name
+                    std::string conn_name = ssid;
+
+                    // Delete any existing connection with the same name to avoid conflicts
+                    std::string delete_cmd = "nmcli con delete \"" + conn_name + "\" 2>/dev/null || true";
+                    Core::Metrics::increment(spawn_counter);
+                    std::system(delete_cmd.c_str());
+
+                    // Create a new connection profile with the correct security settings
+                    cmd = "nmcli con add type wifi con-name \"" + conn_name + "\" ifname " + wifi_interface +
+                          " ssid \"" + ssid + "\" && " +
+                          "nmcli con modify \"" + conn_name + "\" wifi-sec.key-mgmt " + security_type + " && " +
+                          "nmcli con modify \"" + conn_name + "\" wifi-sec.psk \"" + password + "\" && " +
+                          "nmcli con up \"" + conn_name + "\"";
+                }
+                else
+                {
+                    // For open networks or when security type isn't specified, use the simpler connection method
+                    cmd = "nmcli dev wifi connect \"" + ssid + "\"";
+                    if (!password.empty())
+                    {
+                        cmd += " password \"" + password + "\"";
+                    }
+                }
+
+                Core::Metrics::increment(spawn_counter);
+                if (std::system(cmd.c_str()) != 0)
+                {
+                    UC_LOG_WARN(Wifi, "Failed to connect to " << ssid);
+                    return false;
+                }
+                UC_LOG_INFO(Wifi, "Successfully connected to " << ssid);
+                return true;
+            }
+
+            std::string password(const std::string &ssid) override
+            {
+                std::string command = "nmcli -s -g 802-11-wireless-security.psk connection show \"" + ssid + "\"";
+
+                Core::Metrics::increment(spawn_counter);
+                FILE *fp = popen(command.c_str(), "r");
+                if (!fp)
+                {
+                    UC_LOG_WARN(Wifi, "Failed to run command: " << command);
+                    return "";
+                }
+
+                char result[1024];
+                std::string password = "";
+                while (fgets(result, sizeof(result), fp) != NULL)
+                {
+                    password += result;
+                }
+
+                pclose(fp);
+
+                if (!password.empty() && password.back() == '\n')
+                {
+                    password.pop_back();
+                }
+
+                return password;
+            }
+
+            /**
+             * @brief Check if any ethernet device is connected and active
+             */
+            bool ethernet_connected() override
+            {
+                // If we got any output, ethernet is connected
+                return !first_line("nmcli -t -f TYPE,STATE device | grep ethernet:connected").empty();
+            }
+
+        private:
+            /**
+             * @brief Read the first line a shell command prints
+             * @return The line, or an empty string if the command could not be run
+             */
+            static std::string first_line(const std::string &cmd)
+            {
+                std::array<char, 4096> buffer;
+                std::string result;
+
+                Core::Metrics::increment(spawn_counter);
+                FILE *pipe = popen(cmd.c_str(), "r");
+                if (!pipe)
+                    return result;
+                if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    result = buffer.data();
+                }
+                pclose(pipe);
+                return result;
+            }
+
+            /**
+             * @brief Trim whitespace from both ends
+             */
+            static std::string trim(std::string text)
+            {
+                text.erase(0, text.find_first_not_of(" \t\n\r"));
+                text.erase(text.find_last_not_of(" \t\n\r") + 1);
+                return text;
+            }
+
+            /**
+             * @brief Get the name of the WiFi interface
+             * @return The name of the WiFi interface (e.g., wlan0)
+             *
+             * Uses nmcli to find the WiFi interface, excluding p2p interfaces.
+             */
+            static std::string get_wifi_interface()
+            {
+                return trim(first_line("nmcli device status | grep wifi | grep -v p2p | awk '{print $1}'"));
+            }
+
+            /**
+             * @brief Names of the saved WiFi connection profiles
+             * @return Profile names; NetworkManager names them after the SSID
+             */
+            static std::set<std::string> saved_connections()
+            {
+                std::set<std::string> names;
+                Core::Metrics::increment(spawn_counter);
+                FILE *pipe = popen("nmcli -t -f NAME,TYPE connection show", "r");
+                if (!pipe)
+                {
+                    return names;
+                }
+
+                std::array<char, 512> buffer;
+                while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+                {
+                    // Terse output escapes ':' inside the name as "\:"
+                    std::string line = buffer.data();
+                    line.erase(line.find_last_not_of("\n") + 1);
+                    std::size_t colon = line.rfind(':');
+                    if (colon == std::string::npos || line.compare(colon + 1, std::string::npos, "802-11-wireless") != 0)
+                    {
+                        continue;
+                    }
+                    std::string name;
+                    for (std::size_t i = 0; i < colon; ++i)
+                    {
+                        if (line[i] == '\\' && i + 1 < colon)
+                        {
+                            ++i;
+                        }
+                        name += line[i];
+                    }
+                    names.insert(name);
+                }
+                pclose(pipe);
+                return names;
+            }
+
+            /**
+             * @brief Split a string by a delimiter character
+             * @param s The string to split
+             * @param delimiter The character to split on
+             * @return A vector of substrings
+             */
+            static std::vector<std::string> split(const std::string &s, char delimiter)
+            {
+                std::vector<std::string> tokens;
+                std::string token;
+                for (char c : s)
+                {
+                    if (c == delimiter)
+                    {
+                        tokens.push_back(token);
+                        token.clear();
+                    }
+                    else
+                    {
+                        token += c;
+                    }
+                }
+                tokens.push_back(token);
+                return tokens;
+            }
+        };
+    } // namespace
+
+    std::unique_ptr<WifiBackend> WifiBackend::create()
+    {
+        return Core::Backend::mock() ? create_mock() : create_system();
+    }
+
+    std::unique_ptr<WifiBackend> WifiBackend::create_system()
+    {
+        return std::make_unique<NmcliBackend>();
+    }
+
+} // namespace Wifi
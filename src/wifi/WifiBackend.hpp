@@ -0,0 +1,97 @@
+/**
+ * @file WifiBackend.hpp
+ * @brief WiFi backend interface for Ultimate Control
+ *
+ * This file defines the WifiBackend interface which WifiManager uses for
+ * every query and change of the WiFi radio and its connections, so the
+ * NetworkManager backend can be swapped for an in-process mock at runtime
+ * (see Core::Backend).
+ */
+
+#pragma once
+
+#include "WifiManager.hpp"
+#include <memory>
+#include <string>
+
+namespace Wifi
+{
+
+    /**
+     * @class WifiBackend
+     * @brief Scans, switches the radio and manages connections
+     *
+     * Implementations must be safe to call from worker threads.
+     */
+    class WifiBackend
+    {
+    public:
+        virtual ~WifiBackend() = default;
+
+        /**
+         * @brief List visible networks
+         * @return Networks with their saved flags; empty on failure
+         */
+        virtual WifiManager::NetworkList scan() = 0;
+
+        /**
+         * @brief Whether the WiFi radio is on
+         */
+        virtual bool radio_enabled() = 0;
+
+        /**
+         * @brief Switch the WiFi radio on or off
+         * @return false if the change failed
+         */
+        virtual bool set_radio(bool enabled) = 0;
+
+        /**
+         * @brief Disconnect from the current network
+         * @return false if there is no WiFi interface to disconnect
+         */
+        virtual bool disconnect() = 0;
+
+        /**
+         * @brief Delete every saved profile of a network
+         * @return false if the profiles could not be listed
+         */
+        virtual bool forget(const std::string &ssid) = 0;
+
+        /**
+         * @brief Connect to a network, using a saved profile if there is one
+         * @param ssid Network name
+         * @param password Password; empty for open networks
+         * @param security_type Key management, e.g. "wpa-psk"
+         * @return true once connected
+         */
+        virtual bool connect(const std::string &ssid, const std::string &password,
+                             const std::string &security_type) = 0;
+
+        /**
+         * @brief Saved password of a network
+         * @return The password, or an empty string
+         */
+        virtual std::string password(const std::string &ssid) = 0;
+
+        /**
+         * @brief Whether a wired connection is active
+         */
+        virtual bool ethernet_connected() = 0;
+
+        /**
+         * @brief The backend selected by Core::Backend
+         */
+        static std::unique_ptr<WifiBackend> create();
+
+        /**
+         * @brief Backend driving NetworkManager through nmcli
+         */
+        static std::unique_ptr<WifiBackend> create_system();
+
+        /**
+         * @brief Simulated access points; see Core::Backend::MockOptions
+         */
+        static std::unique_ptr<WifiBackend> create_mock();
+    };
+
+} // namespace Wifi
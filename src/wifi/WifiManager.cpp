@@ -8,61 +8,59 @@
  */
 
 #include "WifiManager.hpp"
-#include "utils/QRCode.hpp"
+#include "WifiBackend.hpp"
+#include "utils/qrcodegen/qrcodegen.hpp"
+#include "utils/QrRaster.hpp"
 #include <filesystem>
-#include <iostream>
-#include <cstdlib>
-#include <cstdio>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/Wakeups.hpp"
 #include <memory>
-#include <array>
 #include <algorithm>
 #include <ctime>
+#include <gdk-pixbuf/gdk-pixbuf.h>
 
 namespace Wifi
 {
 
+    namespace
+    {
+        const Core::Metrics::Id scan_histogram = Core::Metrics::histogram("wifi.scan");
+        const Core::Metrics::Id connect_histogram = Core::Metrics::histogram("wifi.connect");
+        const Core::Metrics::Id get_password_histogram = Core::Metrics::histogram("wifi.get_password");
+        const Core::Metrics::Id qr_code_histogram = Core::Metrics::histogram("wifi.qr_code");
+    }
+
     /**
      * @class WifiManager::Impl
      * @brief Private implementation of the WifiManager class
      *
-     * This class implements the actual WiFi management functionality using
-     * NetworkManager's command-line interface (nmcli).
+     * Keeps the network list, radio state, worker threads and callbacks;
+     * every query and change goes through a WifiBackend (nmcli, or a mock).
      */
-    class WifiManager::Impl
+    class WifiManager::Impl : public std::enable_shared_from_this<WifiManager::Impl>
     {
     public:
         /**
          * @brief Constructor for the implementation class
          *
-         * Initializes the WiFi state by checking if WiFi is currently enabled
+         * The radio state is read on first use, not here.
          */
-        Impl() : wifi_enabled_(check_wifi_enabled()), scan_thread_(nullptr), connect_thread_(nullptr)
-        {
-            // Initialize the dispatcher for thread-safe UI updates
-            scan_dispatcher_.connect([this]()
-                                     {
-            // This runs in the main thread
-            if (update_callback_) {
-                update_callback_(networks_);
-            } });
-
-            // Initialize the dispatcher for connection results
-            connect_dispatcher_.connect([this]()
-                                        {
-            // This runs in the main thread
-            if (connect_callback_) {
-                connect_callback_(connect_success_, connect_ssid_);
-                // Clear the callback after it's been called
-                connect_callback_ = nullptr;
-            } });
-        }
-        ~Impl()
-        {
-            // Clean up any running scan thread
-            stop_scan_thread();
+        Impl() : backend_(WifiBackend::create()) {}
 
-            // Clean up any running connect thread
-            stop_connect_thread();
+        /**
+         * @brief Drop the callbacks once the WifiManager is gone
+         *
+         * Scan and connect threads hold their own reference and may still
+         * be running; their results are discarded instead of reaching a
+         * destroyed tab, and the main thread never waits for them.
+         */
+        void detach()
+        {
+            detached_ = true;
+            update_callback_ = nullptr;
+            state_callback_ = nullptr;
+            connect_callback_ = nullptr;
         }
 
         /**
@@ -75,7 +73,7 @@ namespace Wifi
          */
         void scan_networks()
         {
-            if (!wifi_enabled_)
+            if (!is_wifi_enabled())
             {
                 std::lock_guard<std::mutex> lock(networks_mutex_);
                 networks_.clear();
@@ -102,11 +100,11 @@ namespace Wifi
          *
          * Starts a new thread to scan for networks without blocking the UI.
          * When the scan is complete, the update callback will be called
-         * on the main thread using the dispatcher.
+         * on the main thread from an idle callback.
          */
         void scan_networks_async()
         {
-            if (!wifi_enabled_)
+            if (!is_wifi_enabled())
             {
                 std::lock_guard<std::mutex> lock(networks_mutex_);
                 networks_.clear();
@@ -117,20 +115,20 @@ namespace Wifi
                 return;
             }
 
-            // Stop any existing scan thread
-            stop_scan_thread();
-
-            // Start a new scan thread
-            scan_thread_ = std::make_unique<std::thread>([this]()
-                                                         {
+            // Start a new scan thread; it keeps this object alive
+            std::thread([self = shared_from_this()]()
+                        {
             // Perform the scan in the background thread
-            perform_scan();
-
-            // Notify the main thread that the scan is complete
-            scan_dispatcher_.emit(); });
+            std::vector<Network> networks = self->perform_scan();
 
-            // Detach the thread so it can continue running after this function returns
-            scan_thread_->detach();
+            // Notify the main thread with this scan's result; networks_ may
+            // already be rewritten by an overlapping scan
+            Core::Wakeups::idle_once([self, networks]() {
+                if (!self->detached_ && self->update_callback_) {
+                    self->update_callback_(networks);
+                }
+            }); })
+                .detach();
         }
 
         /**
@@ -138,91 +136,41 @@ namespace Wifi
          *
          * Common implementation used by both synchronous and asynchronous scanning.
          * Populates the networks_ vector with the scan results.
+         *
+         * @return A copy of the scan results, for use without networks_mutex_
          */
-        void perform_scan()
+        std::vector<Network> perform_scan()
         {
+            Core::Metrics::ScopedTimer timer(scan_histogram);
+
             // Clear the networks list before scanning
             {
                 std::lock_guard<std::mutex> lock(networks_mutex_);
                 networks_.clear();
             }
 
-            std::string cmd = "nmcli -t -f IN-USE,SSID,SIGNAL,SECURITY device wifi list";
-            std::array<char, 4096> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-            {
-                std::cerr << "Failed to run nmcli\n";
-                return;
-            }
-            while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result += buffer.data();
-            }
-            pclose(pipe);
-
-            // Parse the scan results
-            std::vector<Network> new_networks;
-            size_t pos = 0;
-            while ((pos = result.find('\n')) != std::string::npos)
-            {
-                std::string line = result.substr(0, pos);
-                result.erase(0, pos + 1);
-
-                auto tokens = split(line, ':');
-                if (tokens.size() >= 4)
-                {
-                    Network net;
-                    net.connected = (tokens[0] == "*");
-                    net.ssid = tokens[1];
-                    net.bssid = ""; // We don't have BSSID in this command
-                    try
-                    {
-                        // Parse the signal strength percentage from nmcli output
-                        int signal = std::stoi(tokens[2]);
-
-                        // Store the signal strength in the network object
-                        net.signal_strength = signal;
-                    }
-                    catch (...)
-                    {
-                        net.signal_strength = 0;
-                    }
-                    net.secured = (tokens[3] != "--" && !tokens[3].empty());
-                    new_networks.push_back(net);
-                }
-            }
+            std::vector<Network> new_networks = backend_->scan();
 
             // Update the networks list with the scan results
-            {
-                std::lock_guard<std::mutex> lock(networks_mutex_);
-                networks_ = std::move(new_networks);
-            }
+            std::lock_guard<std::mutex> lock(networks_mutex_);
+            networks_ = new_networks;
+            return new_networks;
         }
 
         /**
          * @brief Disconnect from the current WiFi network
          *
-         * Disconnects from the currently connected WiFi network using nmcli.
+         * Disconnects from the currently connected WiFi network.
          * Rescans networks after disconnecting.
          */
         void disconnect()
         {
-            // Get the WiFi interface to disconnect
-            std::string wifi_interface = get_wifi_interface();
-            if (wifi_interface.empty())
+            UC_LOG_INFO(Wifi, "Disconnecting from WiFi...");
+            if (!backend_->disconnect())
             {
-                std::cerr << "Error: No WiFi interface found" << std::endl;
                 return;
             }
 
-            // Disconnect from the current WiFi network
-            std::string cmd = "nmcli device disconnect " + wifi_interface;
-            std::cout << "Disconnecting from WiFi..." << std::endl;
-            std::system(cmd.c_str());
-
             // Update network list after disconnecting (asynchronously)
             scan_networks_async();
         }
@@ -231,108 +179,35 @@ namespace Wifi
          * @brief Remove saved credentials for a WiFi network
          * @param ssid The SSID of the network to forget
          *
-         * Finds and deletes all connection profiles associated with the specified SSID.
-         * Also cleans up any temporary connections that might have been created.
+         * Deletes all connection profiles associated with the specified SSID.
          * Rescans networks after forgetting.
          */
         void forget_network(const std::string &ssid)
         {
-            std::cout << "Forgetting network: " << ssid << std::endl;
+            UC_LOG_INFO(Wifi, "Forgetting network: " << ssid);
 
-            // Get a list of all connection profiles from NetworkManager
-            std::string cmd = "nmcli -t -f NAME,UUID,TYPE connection show";
-            std::array<char, 4096> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
+            if (!backend_->forget(ssid))
             {
-                std::cerr << "Failed to run nmcli to find connections" << std::endl;
                 return;
             }
 
-            while (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-            {
-                result += buffer.data();
-            }
-            pclose(pipe);
-
-            // Parse the output to find all WiFi connection profiles
-            size_t pos = 0;
-            std::vector<std::pair<std::string, std::string>> wifi_connections; // name, uuid pairs
-
-            while ((pos = result.find('\n')) != std::string::npos)
-            {
-                std::string line = result.substr(0, pos);
-                result.erase(0, pos + 1);
-
-                auto tokens = split(line, ':');
-                if (tokens.size() >= 3 && tokens[2] == "802-11-wireless")
-                {
-                    wifi_connections.push_back({tokens[0], tokens[1]});
-                }
-            }
-
-            // Check each WiFi connection profile to see if it matches our target SSID
-            bool deleted_any = false;
-
-            for (const auto &conn : wifi_connections)
-            {
-                // Get the SSID associated with this connection profile
-                std::string check_cmd = "nmcli -g 802-11-wireless.ssid connection show " + conn.second + " 2>/dev/null";
-                FILE *check_pipe = popen(check_cmd.c_str(), "r");
-                if (!check_pipe)
-                    continue;
-
-                std::string conn_ssid;
-                if (fgets(buffer.data(), buffer.size(), check_pipe) != nullptr)
-                {
-                    conn_ssid = buffer.data();
-                    // Trim whitespace from the SSID
-                    conn_ssid.erase(0, conn_ssid.find_first_not_of(" \t\n\r"));
-                    conn_ssid.erase(conn_ssid.find_last_not_of(" \t\n\r") + 1);
-                }
-                pclose(check_pipe);
-
-                // If this connection profile matches our target SSID, delete it
-                if (conn_ssid == ssid)
-                {
-                    std::string delete_cmd = "nmcli connection delete " + conn.second;
-                    std::cout << "Deleting connection '" << conn.first << "' (UUID: " << conn.second << ") for SSID: " << ssid << std::endl;
-                    std::system(delete_cmd.c_str());
-                    deleted_any = true;
-                }
-            }
-
-            // If no matching profiles were found, try deleting by connection name as a fallback
-            if (!deleted_any)
-            {
-                std::string delete_cmd = "nmcli connection delete \"" + ssid + "\" 2>/dev/null || true";
-                std::system(delete_cmd.c_str());
-            }
-
-            // Clean up any temporary connections that might have been created by nmcli
-            std::string cleanup_cmd = "nmcli -t -f NAME connection show | grep \"temp-conn-\" | xargs -r -n1 nmcli connection delete 2>/dev/null || true";
-            std::system(cleanup_cmd.c_str());
-
-            std::cout << "Network forgotten: " << ssid << std::endl;
+            UC_LOG_INFO(Wifi, "Network forgotten: " << ssid);
             scan_networks_async();
         }
 
         /**
          * @brief Enable the WiFi radio
          *
-         * Turns on the WiFi radio using nmcli.
+         * Turns on the WiFi radio.
          * Updates the internal state and calls the state callback if registered.
          * Scans for networks asynchronously after enabling WiFi.
          */
         void enable_wifi()
         {
-            std::string cmd = "nmcli radio wifi on";
-            int ret = std::system(cmd.c_str());
-            if (ret == 0)
+            if (backend_->set_radio(true))
             {
                 wifi_enabled_ = true;
+                wifi_known_ = true;
                 if (state_callback_)
                 {
                     state_callback_(wifi_enabled_);
@@ -345,26 +220,28 @@ namespace Wifi
         /**
          * @brief Disable the WiFi radio
          *
-         * Turns off the WiFi radio using nmcli.
+         * Turns off the WiFi radio.
          * Updates the internal state and calls the state callback if registered.
          * Clears the network list after disabling WiFi.
          */
         void disable_wifi()
         {
-            std::string cmd = "nmcli radio wifi off";
-            int ret = std::system(cmd.c_str());
-            if (ret == 0)
+            if (backend_->set_radio(false))
             {
                 wifi_enabled_ = false;
+                wifi_known_ = true;
                 if (state_callback_)
                 {
                     state_callback_(wifi_enabled_);
                 }
                 // Clear network list since WiFi is now disabled
-                networks_.clear();
+                {
+                    std::lock_guard<std::mutex> lock(networks_mutex_);
+                    networks_.clear();
+                }
                 if (update_callback_)
                 {
-                    update_callback_(networks_);
+                    update_callback_(std::vector<Network>());
                 }
             }
         }
@@ -372,38 +249,70 @@ namespace Wifi
         /**
          * @brief Check if WiFi is currently enabled
          * @return true if WiFi is enabled, false otherwise
+         *
+         * The radio is queried on first use unless apply_wifi_state()
+         * already recorded its state.
          */
         bool is_wifi_enabled() const
         {
+            if (!wifi_known_)
+            {
+                wifi_enabled_ = check_wifi_enabled();
+                wifi_known_ = true;
+            }
             return wifi_enabled_;
         }
 
         /**
-         * @brief Query the system to determine if WiFi is enabled
-         * @return true if WiFi is enabled, false otherwise
+         * @brief Record the radio state
+         * @param enabled Whether the WiFi radio is on
          *
-         * Uses nmcli to check the current state of the WiFi radio.
+         * Notifies the state callback if the state changed or was not
+         * known before.
          */
-        bool check_wifi_enabled()
+        void apply_wifi_state(bool enabled)
         {
-            std::string cmd = "nmcli radio wifi";
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return false;
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+            bool changed = !wifi_known_ || enabled != wifi_enabled_;
+            wifi_enabled_ = enabled;
+            wifi_known_ = true;
+            if (changed && state_callback_)
             {
-                result = buffer.data();
+                state_callback_(wifi_enabled_);
             }
-            pclose(pipe);
+        }
 
-            // Trim whitespace from the result
-            result.erase(0, result.find_first_not_of(" \t\n\r"));
-            result.erase(result.find_last_not_of(" \t\n\r") + 1);
+        /**
+         * @brief Re-read the radio state after an outside change
+         *
+         * Notifies the state callback if the radio was switched behind our
+         * back, then rescans so the network list reflects the new state.
+         */
+        void refresh_state()
+        {
+            apply_wifi_state(check_wifi_enabled());
+            if (wifi_enabled_)
+            {
+                scan_networks_async();
+            }
+        }
+
+        /**
+         * @brief Query the system to determine if WiFi is enabled
+         * @return true if WiFi is enabled, false otherwise
+         *
+         * Touches no member state, so it may run on a worker thread.
+         */
+        bool check_wifi_enabled() const
+        {
+            return backend_->radio_enabled();
+        }
 
-            return result == "enabled";
+        /**
+         * @brief The backend every query and change goes through
+         */
+        WifiBackend &backend() const
+        {
+            return *backend_;
         }
 
         /**
@@ -449,99 +358,43 @@ namespace Wifi
                            const std::string &security_type, ConnectionCallback callback);
 
     private:
+        std::unique_ptr<WifiBackend> backend_;
         std::vector<Network> networks_;
         std::mutex networks_mutex_;
         WifiManager::UpdateCallback update_callback_;
         WifiManager::StateCallback state_callback_;
-        bool wifi_enabled_;
-        std::unique_ptr<std::thread> scan_thread_;
-        Glib::Dispatcher scan_dispatcher_;
-
-        /**
-         * @brief Stop the current scan thread if one is running
-         */
-        void stop_scan_thread()
-        {
-            if (scan_thread_ && scan_thread_->joinable())
-            {
-                scan_thread_->join();
-            }
-            scan_thread_.reset();
-        }
+        mutable bool wifi_enabled_ = false; ///< Radio state, valid once wifi_known_ is set
+        mutable bool wifi_known_ = false;   ///< Whether the radio state was read or applied
+        bool detached_ = false; ///< Set by detach(); main thread only
 
         /**
-         * @brief Stop the connect thread if it's running
-         *
-         * Joins the connect thread if it's joinable and resets the pointer.
+         * @brief Deliver a connection result on the main thread
+         * @param success Whether the connection attempt succeeded
+         * @param rescan Whether to rescan networks afterwards
          */
-        void stop_connect_thread()
+        void on_connect_done(bool success, bool rescan)
         {
-            if (connect_thread_ && connect_thread_->joinable())
+            if (detached_)
             {
-                connect_thread_->join();
+                return;
             }
-            connect_thread_.reset();
-        }
-
-        /**
-         * @brief Get the name of the WiFi interface
-         * @return The name of the WiFi interface (e.g., wlan0)
-         *
-         * Uses nmcli to find the WiFi interface, excluding p2p interfaces.
-         */
-        std::string get_wifi_interface()
-        {
-            std::string cmd = "nmcli device status | grep wifi | grep -v p2p | awk '{print $1}'";
-            std::array<char, 128> buffer;
-            std::string result;
-
-            FILE *pipe = popen(cmd.c_str(), "r");
-            if (!pipe)
-                return "";
-            if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
+            if (connect_callback_)
             {
-                result = buffer.data();
+                ConnectionCallback callback = connect_callback_;
+                // Clear the callback before it's called
+                connect_callback_ = nullptr;
+                callback(success, connect_ssid_);
             }
-            pclose(pipe);
-
-            // Trim whitespace from the interface name
-            result.erase(0, result.find_first_not_of(" \t\n\r"));
-            result.erase(result.find_last_not_of(" \t\n\r") + 1);
-
-            return result;
-        }
-
-        /**
-         * @brief Split a string by a delimiter character
-         * @param s The string to split
-         * @param delimiter The character to split on
-         * @return A vector of substrings
-         */
-        static std::vector<std::string> split(const std::string &s, char delimiter)
-        {
-            std::vector<std::string> tokens;
-            std::string token;
-            for (char c : s)
+            // Update network list after connecting, here rather than on
+            // the worker so the callbacks only ever run on the main thread
+            if (rescan)
             {
-                if (c == delimiter)
-                {
-                    tokens.push_back(token);
-                    token.clear();
-                }
-                else
-                {
-                    token += c;
-                }
+                scan_networks_async();
             }
-            tokens.push_back(token);
-            return tokens;
         }
 
         // Additional member variables for connection
-        std::unique_ptr<std::thread> connect_thread_;   ///< Thread for asynchronous connection
-        Glib::Dispatcher connect_dispatcher_;           ///< Dispatcher for connection results
         ConnectionCallback connect_callback_ = nullptr; ///< Callback for connection results
-        bool connect_success_ = false;                  ///< Whether the last connection attempt was successful
         std::string connect_ssid_;                      ///< SSID of the network being connected to
     };
 
@@ -550,14 +403,18 @@ namespace Wifi
      *
      * Creates the implementation object using the PIMPL idiom.
      */
-    WifiManager::WifiManager() : impl_(std::make_unique<Impl>()) {}
+    WifiManager::WifiManager() : impl_(std::make_shared<Impl>()) {}
 
     /**
      * @brief Destructor for WifiManager
      *
-     * Default implementation is sufficient since impl_ is a unique_ptr.
+     * Detaches the implementation without waiting; a scan or connect
+     * still in flight keeps it alive until it finishes.
      */
-    WifiManager::~WifiManager() = default;
+    WifiManager::~WifiManager()
+    {
+        impl_->detach();
+    }
 
     /**
      * @brief Scan for available WiFi networks
@@ -636,6 +493,30 @@ namespace Wifi
         return impl_->is_wifi_enabled();
     }
 
+    /**
+     * @brief Read the radio state without recording it
+     */
+    bool WifiManager::query_wifi_enabled() const
+    {
+        return impl_->check_wifi_enabled();
+    }
+
+    /**
+     * @brief Record a radio state read with query_wifi_enabled()
+     */
+    void WifiManager::apply_wifi_state(bool enabled)
+    {
+        impl_->apply_wifi_state(enabled);
+    }
+
+    /**
+     * @brief Re-read the radio state and rescan
+     */
+    void WifiManager::refresh_state()
+    {
+        impl_->refresh_state();
+    }
+
     /**
      * @brief Set the callback for network list updates
      * @param cb The callback function to be called when the network list changes
@@ -673,14 +554,11 @@ namespace Wifi
         connect_callback_ = callback;
         connect_ssid_ = ssid;
 
-        // Stop any existing connect thread
-        stop_connect_thread();
-
-        // Start a new connect thread
-        connect_thread_ = std::make_unique<std::thread>([this, ssid, password, security_type]()
-                                                        {
-            // First check if we're already connected to this network to avoid unnecessary operations
-            bool already_connected = false;
+        // First check if we're already connected to this network to avoid
+        // unnecessary operations; scan threads may be rewriting networks_
+        bool already_connected = false;
+        {
+            std::lock_guard<std::mutex> lock(networks_mutex_);
             for (const auto &net : networks_)
             {
                 if (net.ssid == ssid && net.connected)
@@ -689,159 +567,48 @@ namespace Wifi
                     break;
                 }
             }
+        }
 
-            if (already_connected)
-            {
-                std::cout << "Already connected to " << ssid << std::endl;
-                connect_success_ = true;
-                connect_dispatcher_.emit();
-                return;
-            }
-
-            std::cout << "Connecting to WiFi network: " << ssid << "..." << std::endl;
-
-            // Try to connect using an existing saved connection profile first
-            std::string saved_cmd = "nmcli con up \"" + ssid + "\" 2>/dev/null";
-            int saved_result = std::system(saved_cmd.c_str());
+        // Start a new connect thread; it keeps this object alive
+        std::thread([self = shared_from_this(), ssid, password, security_type, already_connected]()
+                    {
+            Core::Metrics::ScopedTimer timer(connect_histogram);
 
-            if (saved_result == 0)
+            if (already_connected)
             {
-                std::cout << "Successfully connected to saved network: " << ssid << std::endl;
-                connect_success_ = true;
-                connect_dispatcher_.emit();
-                scan_networks_async();
+                UC_LOG_INFO(Wifi, "Already connected to " << ssid);
+                Core::Wakeups::idle_once([self]() { self->on_connect_done(true, false); });
                 return;
             }
 
-            // If no saved connection exists or connection failed, create a new connection profile
-            bool success = false;
+            UC_LOG_INFO(Wifi, "Connecting to WiFi network: " << ssid << "...");
 
-            // For secured networks, create a detailed connection profile with security settings
-            if (!password.empty() && !security_type.empty())
-            {
-                // Get the WiFi interface name (e.g., wlan0, wlp3s0)
-                std::string wifi_interface = get_wifi_interface();
-                if (wifi_interface.empty())
-                {
-                    std::cerr << "Error: No WiFi interface found" << std::endl;
-                    connect_success_ = false;
-                    connect_dispatcher_.emit();
-                    return;
-                }
-
-                // Use the SSID as the connection profile name
-                std::string conn_name = ssid;
-
-                // Delete any existing connection with the same name to avoid conflicts
-                std::string delete_cmd = "nmcli con delete \"" + conn_name + "\" 2>/dev/null || true";
-                std::system(delete_cmd.c_str());
-
-                // Create a new connection profile with the correct security settings
-                std::string create_cmd = "nmcli con add type wifi con-name \"" + conn_name + "\" ifname " + wifi_interface +
-                                         " ssid \"" + ssid + "\" && " +
-                                         "nmcli con modify \"" + conn_name + "\" wifi-sec.key-mgmt " + security_type + " && " +
-                                         "nmcli con modify \"" + conn_name + "\" wifi-sec.psk \"" + password + "\" && " +
-                                         "nmcli con up \"" + conn_name + "\"";
-
-                int result = std::system(create_cmd.c_str());
-
-                if (result == 0)
-                {
-                    std::cout << "Successfully connected to " << ssid << std::endl;
-                    success = true;
-                }
-                else
-                {
-                    std::cerr << "Failed to connect to " << ssid << std::endl;
-                }
-            }
-            else
-            {
-                // For open networks or when security type isn't specified, use the simpler connection method
-                std::string cmd = "nmcli dev wifi connect \"" + ssid + "\"";
-                if (!password.empty())
-                {
-                    cmd += " password \"" + password + "\"";
-                }
-
-                int result = std::system(cmd.c_str());
-
-                if (result == 0)
-                {
-                    std::cout << "Successfully connected to " << ssid << std::endl;
-                    success = true;
-                }
-                else
-                {
-                    std::cerr << "Failed to connect to " << ssid << std::endl;
-                }
-            }
-
-            connect_success_ = success;
-            connect_dispatcher_.emit();
-            scan_networks_async(); });
-
-        // Detach the thread so it can continue running after this function returns
-        connect_thread_->detach();
+            bool success = self->backend_->connect(ssid, password, security_type);
+            Core::Wakeups::idle_once([self, success]() { self->on_connect_done(success, true); }); })
+            .detach();
     }
 
     std::string WifiManager::get_password(const std::string &ssid)
     {
-        std::string command = "nmcli -s -g 802-11-wireless-security.psk connection show \"" + ssid + "\"";
-
-        FILE *fp = popen(command.c_str(), "r");
-        if (!fp)
-        {
-            std::cerr << "Failed to run command: " << command << std::endl;
-            return "";
-        }
-
-        char result[1024];
-        std::string password = "";
-        while (fgets(result, sizeof(result), fp) != NULL)
-        {
-            password += result;
-        }
-
-        fclose(fp);
-
-        if (!password.empty() && password.back() == '\n')
-        {
-            password.pop_back();
-        }
-
-        return password;
+        Core::Metrics::ScopedTimer timer(get_password_histogram);
+        return impl_->backend().password(ssid);
     }
 
     /**
      * @brief Check if ethernet is connected
      * @return true if ethernet is connected, false otherwise
      *
-     * Uses nmcli to check if any ethernet device is connected and active.
+     * Asks the backend whether any ethernet device is connected and active.
      */
     bool WifiManager::is_ethernet_connected() const
     {
-        std::string cmd = "nmcli -t -f TYPE,STATE device | grep ethernet:connected";
-        std::array<char, 128> buffer;
-        std::string result;
-
-        FILE *pipe = popen(cmd.c_str(), "r");
-        if (!pipe)
-            return false;
-
-        bool connected = false;
-        if (fgets(buffer.data(), buffer.size(), pipe) != nullptr)
-        {
-            // If we got any output, ethernet is connected
-            connected = true;
-        }
-        pclose(pipe);
-
-        return connected;
+        return impl_->backend().ethernet_connected();
     }
 
     std::string WifiManager::generate_qr_code(const std::string &ssid, const std::string &password, const std::string &security)
     {
+        Core::Metrics::ScopedTimer timer(qr_code_histogram);
+
         // tmp dir for the image
         std::filesystem::path temp_dir = "/tmp/ultimate-control";
         std::filesystem::create_directories(temp_dir);
@@ -852,15 +619,14 @@ namespace Wifi
         {
             if (std::filesystem::exists(qr_code_path))
             {
-                std::cout << "Found QR code for " << ssid << " at " << qr_code_path << std::endl;
+                UC_LOG_TRACE(Wifi, "Found QR code for " << ssid << " at " << qr_code_path);
                 return qr_code_path.string();
             }
 
             std::string security_type = (security == "none" || security == "None") ? "nopass" : "WPA";
             std::string wifi_string = "WIFI:T:" + security_type + ";S:" + ssid + ";P:" + password + ";;";
 
-            Utils::QRCode qr;
-            qr.encode(wifi_string);
+            auto qr = qrcodegen::QrCode::encodeText(wifi_string.c_str(), qrcodegen::QrCode::Ecc::MEDIUM);
 
             int module_count = qr.getSize();
             int scale = 7;
@@ -871,39 +637,24 @@ namespace Wifi
             guchar *pixels = gdk_pixbuf_get_pixels(pixbuf);
             int rowstride = gdk_pixbuf_get_rowstride(pixbuf);
 
-            // Fill the image with qr code modules
-            for (int y = 0; y < module_count; ++y)
-            {
-                for (int x = 0; x < module_count; ++x)
-                {
-                    bool dark = qr.getModule(x, y);
-                    guchar color = dark ? 0 : 255;
-                    for (int dy = 0; dy < scale; ++dy)
-                    {
-                        for (int dx = 0; dx < scale; ++dx)
-                        {
-                            int px = x * scale + dx;
-                            int py = y * scale + dy;
-                            guchar *p = pixels + py * rowstride + px * 3;
-                            p[0] = p[1] = p[2] = color;
-                        }
-                    }
-                }
-            }
+            // Fill the image with qr code modules, a scanline per module row
+            static const guchar dark[3] = {0, 0, 0};
+            static const guchar light[3] = {255, 255, 255};
+            Utils::QrRaster::render(qr, scale, pixels, static_cast<std::size_t>(rowstride), 3, dark, light);
 
             // Save the image to tmp dir
             gdk_pixbuf_save(pixbuf, qr_code_path.c_str(), "png", nullptr, nullptr);
             g_object_unref(pixbuf);
 
-            std::cout << "Generated QR code for " << ssid << " at " << qr_code_path << std::endl;
+            UC_LOG_DEBUG(Wifi, "Generated QR code for " << ssid << " at " << qr_code_path);
             return qr_code_path.string();
         }
         catch (const std::exception &e)
         {
-            std::cerr << "Failed to generate QR code for " << ssid << ": " << e.what() << std::endl;
+            UC_LOG_WARN(Wifi, "Failed to generate QR code for " << ssid << ": " << e.what());
 
-            // Return error image path
-            return std::filesystem::absolute("src/css/error.png").string();
+            // The caller shows the bundled error image
+            return "";
         }
     }
 
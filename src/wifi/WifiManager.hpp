@@ -16,7 +16,6 @@
 #include <thread>
 #include <mutex>
 #include <glibmm/dispatcher.h>
-#include "utils/QRCode.hpp"
 
 /**
  * @namespace Wifi
@@ -36,6 +35,7 @@ namespace Wifi
         int signal_strength; ///< Signal strength as a percentage (0-100)
         bool connected;      ///< Whether the device is currently connected to this network
         bool secured;        ///< Whether the network uses encryption (requires password)
+        bool saved = false;  ///< Whether NetworkManager has a saved connection for it
     };
 
     /**
@@ -44,7 +44,7 @@ namespace Wifi
      *
      * Provides an interface for scanning available networks, connecting to networks,
      * and managing saved connections. Uses NetworkManager via its command-line
-     * interface (nmcli) for all operations.
+     * interface (nmcli), or a mock chosen by Core::Backend (see WifiBackend).
      */
     class WifiManager
     {
@@ -132,9 +132,37 @@ namespace Wifi
         /**
          * @brief Check if WiFi is currently enabled
          * @return true if WiFi is enabled, false otherwise
+         *
+         * Reads the radio state on first use unless apply_wifi_state()
+         * already recorded it.
          */
         bool is_wifi_enabled() const;
 
+        /**
+         * @brief Read the WiFi radio state without recording it
+         * @return true if the radio is on
+         *
+         * Safe to call from a worker thread; pass the result to
+         * apply_wifi_state() on the main thread.
+         */
+        bool query_wifi_enabled() const;
+
+        /**
+         * @brief Record a radio state read with query_wifi_enabled()
+         * @param enabled Whether the radio is on
+         *
+         * Calls the state callback if the state changed or was not known yet.
+         */
+        void apply_wifi_state(bool enabled);
+
+        /**
+         * @brief Re-read the WiFi radio state and rescan
+         *
+         * For changes made outside this manager (the control socket, nmcli).
+         * Calls the state callback if the radio state changed.
+         */
+        void refresh_state();
+
         /**
          * @brief Set the callback for network list updates
          * @param cb The callback function to be called when the network list changes
@@ -163,17 +191,24 @@ namespace Wifi
          * @brief Check if ethernet is connected
          * @return true if ethernet is connected, false otherwise
          *
-         * Uses nmcli to check if any ethernet device is connected and active.
+         * Asks the backend whether any ethernet device is connected and active.
          */
         bool is_ethernet_connected() const;
 
         std::string get_password(const std::string &ssid);
 
+        /**
+         * @brief Render the join QR code of a network to a PNG file
+         * @param ssid Network name
+         * @param password Network password
+         * @param security Authentication type, "WPA" or "nopass"
+         * @return Path of the image, or an empty string if it could not be made
+         */
         std::string generate_qr_code(const std::string &ssid, const std::string &password, const std::string &security);
 
     private:
         class Impl;                  ///< Forward declaration of implementation class
-        std::unique_ptr<Impl> impl_; ///< Pointer to implementation (PIMPL idiom)
+        std::shared_ptr<Impl> impl_; ///< Pointer to implementation, shared with worker threads
     };
 
 } // namespace Wifi
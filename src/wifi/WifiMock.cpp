@@ -0,0 +1,230 @@
+/**
+ * @file WifiMock.cpp
+ * @brief Simulated access points for tests and benchmarks
+ */
+
+#include "WifiBackend.hpp"
+#include "core/Backend.hpp"
+#include "core/Log.hpp"
+#include <map>   // for std::map
+#include <mutex> // for std::mutex
+
+namespace Wifi
+{
+
+    namespace
+    {
+        /**
+         * @struct World
+         * @brief Radio, access points and saved profiles shared by every mock backend
+         */
+        struct World
+        {
+            explicit World(std::uint64_t gen) : generation(gen), simulation("wifi")
+            {
+                const std::size_t count = simulation.options().devices;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    Network net;
+                    net.ssid = "mock-ap-" + std::to_string(i);
+                    net.signal_strength = simulation.uniform(5, 100);
+                    net.secured = i == 0 || simulation.chance(0.75);
+                    net.saved = i == 0 || simulation.chance(0.1);
+                    net.connected = i == 0;
+                    if (net.saved)
+                    {
+                        passwords[net.ssid] = net.secured ? "password-" + std::to_string(i) : "";
+                    }
+                    networks.push_back(net);
+                }
+            }
+
+            const std::uint64_t generation;
+            Core::Backend::Simulation simulation;
+            std::mutex mutex; ///< Guards the members below
+            bool radio = true;
+            WifiManager::NetworkList networks;
+            std::map<std::string, std::string> passwords; ///< Saved profiles by SSID
+        };
+
+        /**
+         * @brief The environment for the current options, rebuilt when they change
+         */
+        std::shared_ptr<World> world()
+        {
+            static std::mutex mutex;
+            static std::shared_ptr<World> current;
+            std::lock_guard<std::mutex> lock(mutex);
+            const std::uint64_t generation = Core::Backend::generation();
+            if (!current || current->generation != generation)
+            {
+                current = std::make_shared<World>(generation);
+            }
+            return current;
+        }
+
+        /**
+         * @brief Change the signal of one random access point
+         */
+        void perturb()
+        {
+            auto w = world();
+            std::lock_guard<std::mutex> lock(w->mutex);
+            if (w->networks.empty())
+            {
+                return;
+            }
+            auto &net = w->networks[static_cast<std::size_t>(w->simulation.uniform(0, static_cast<int>(w->networks.size()) - 1))];
+            net.signal_strength = w->simulation.uniform(5, 100);
+        }
+
+        /**
+         * @class MockBackend
+         * @brief WiFi backend answering from a World
+         */
+        class MockBackend : public WifiBackend
+        {
+        public:
+            MockBackend() : world_(world()) {}
+
+            WifiManager::NetworkList scan() override
+            {
+                if (!world_->simulation.call())
+                {
+                    UC_LOG_DEBUG(Wifi, "Mock scan failed");
+                    return {};
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                return world_->radio ? world_->networks : WifiManager::NetworkList();
+            }
+
+            bool radio_enabled() override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                return world_->radio;
+            }
+
+            bool set_radio(bool enabled) override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                world_->radio = enabled;
+                if (!enabled)
+                {
+                    set_connected("");
+                }
+                return true;
+            }
+
+            bool disconnect() override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                set_connected("");
+                return true;
+            }
+
+            bool forget(const std::string &ssid) override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                world_->passwords.erase(ssid);
+                for (auto &net : world_->networks)
+                {
+                    if (net.ssid == ssid)
+                    {
+                        net.saved = false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Connect if the network is in range and saved, open or given a password
+             */
+            bool connect(const std::string &ssid, const std::string &password,
+                         const std::string &) override
+            {
+                if (!world_->simulation.call())
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                if (!world_->radio)
+                {
+                    return false;
+                }
+                for (auto &net : world_->networks)
+                {
+                    if (net.ssid != ssid)
+                    {
+                        continue;
+                    }
+                    if (!net.saved && net.secured && password.empty())
+                    {
+                        return false;
+                    }
+                    if (!net.saved || !password.empty())
+                    {
+                        world_->passwords[ssid] = password;
+                        net.saved = true;
+                    }
+                    set_connected(ssid);
+                    return true;
+                }
+                return false;
+            }
+
+            std::string password(const std::string &ssid) override
+            {
+                if (!world_->simulation.call())
+                {
+                    return "";
+                }
+                std::lock_guard<std::mutex> lock(world_->mutex);
+                auto it = world_->passwords.find(ssid);
+                return it != world_->passwords.end() ? it->second : "";
+            }
+
+            bool ethernet_connected() override
+            {
+                world_->simulation.call();
+                return false; // The mock has no wired devices
+            }
+
+        private:
+            /**
+             * @brief Mark one network connected and every other one not; world_->mutex must be held
+             */
+            void set_connected(const std::string &ssid)
+            {
+                for (auto &net : world_->networks)
+                {
+                    net.connected = !ssid.empty() && net.ssid == ssid;
+                }
+            }
+
+            std::shared_ptr<World> world_;
+        };
+    } // namespace
+
+    std::unique_ptr<WifiBackend> WifiBackend::create_mock()
+    {
+        Core::Backend::start_storm("wifi", perturb);
+        return std::make_unique<MockBackend>();
+    }
+
+} // namespace Wifi
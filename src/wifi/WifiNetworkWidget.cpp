@@ -12,11 +12,18 @@
 #include <gtkmm/messagedialog.h>
 #include <gtkmm/spinner.h>
 #include <glibmm/thread.h>
-#include <iostream>
+#include "core/Assets.hpp"
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
 
 namespace Wifi
 {
 
+    namespace
+    {
+        const Core::Metrics::Id widget_counter = Core::Metrics::counter("widgets.created");
+    }
+
     /**
      * @brief Constructor for the WiFi network widget
      * @param network The network to display
@@ -38,6 +45,8 @@ namespace Wifi
           forget_button_(),
           share_button_()
     {
+        Core::Metrics::increment(widget_counter);
+
         // Set up the main container with margins for better spacing
         set_margin_top(5);
         set_margin_bottom(5);
@@ -98,8 +107,8 @@ namespace Wifi
         // Add buttons to the controls box
         controls_box_.pack_start(connect_button_, Gtk::PACK_SHRINK);
 
-        // Only show the forget and share buttons if the network is saved (i.e., password is available)
-        if (!manager_->get_password(network.ssid).empty())
+        // Only show the forget and share buttons if the network is saved
+        if (network.saved)
         {
             controls_box_.pack_start(forget_button_, Gtk::PACK_SHRINK);
             controls_box_.pack_start(share_button_, Gtk::PACK_SHRINK);
@@ -114,7 +123,7 @@ namespace Wifi
         connect_button_.signal_clicked().connect(sigc::mem_fun(*this, &WifiNetworkWidget::on_connect_clicked));
 
         // Only connect the forget button handler if the button is shown (for saved networks)
-        if (!manager_->get_password(network.ssid).empty())
+        if (network.saved)
         {
             forget_button_.signal_clicked().connect(sigc::mem_fun(*this, &WifiNetworkWidget::on_forget_clicked));
         }
@@ -245,7 +254,7 @@ namespace Wifi
             connect_button_.show_all_children();
 
             // First try to connect with empty password - this will use saved credentials if available
-            std::cout << "Trying to connect to " << target_ssid << " using saved credentials..." << std::endl;
+            UC_LOG_DEBUG(Wifi, "Trying to connect to " << target_ssid << " using saved credentials...");
 
             // Connect asynchronously to avoid freezing the UI
             manager_->connect_async(target_ssid, "", security_type,
@@ -350,7 +359,7 @@ namespace Wifi
                                                 std::string password = entry->get_text();
 
                                                 // Log connection attempt
-                                                std::cout << "Connecting to " << target_ssid << " with password..." << std::endl;
+                                                UC_LOG_DEBUG(Wifi, "Connecting to " << target_ssid << " with password...");
 
                                                 // Disable the connect button and show a spinner while connecting
                                                 connect_button_.set_sensitive(false);
@@ -490,11 +499,18 @@ namespace Wifi
         qr_button->get_style_context()->add_class("qr_image_holder");
         qr_box->pack_start(*qr_button, Gtk::PACK_SHRINK, 0);
 
+        Gtk::Image *qr_image = nullptr;
         if (!qr_path.empty())
         {
-            Gtk::Image *qr_image = Gtk::manage(new Gtk::Image(qr_path));
+            qr_image = Gtk::manage(new Gtk::Image(qr_path));
+        }
+        else if (auto error_image = Core::Assets::image("error.png"))
+        {
+            qr_image = Gtk::manage(new Gtk::Image(error_image));
+        }
+        if (qr_image)
+        {
             qr_image->set_pixel_size(84);
-
             qr_button->add(*qr_image);
         }
 
@@ -7,16 +7,42 @@
  */
 
 #include "WifiTab.hpp"
-#include <iostream>
+#include "core/Log.hpp"
+#include "core/Metrics.hpp"
+#include "core/TabModule.hpp"
+#include "core/Activity.hpp"
+#include "core/Staging.hpp"
+#include "core/Trace.hpp"
+#include "core/Wakeups.hpp"
+#include "core/WarmCache.hpp"
 
 namespace Wifi
 {
 
+    namespace
+    {
+        const Core::Metrics::Id reconcile_counter = Core::Metrics::counter("reconciles");
+        const Core::Metrics::Id reconcile_histogram = Core::Metrics::histogram("wifi.reconcile");
+
+        /// Warm cache section holding the last scan result
+        const char *const kCacheSection = "wifi";
+
+        /**
+         * @struct LinkState
+         * @brief Radio and ethernet state read on the hydration thread
+         */
+        struct LinkState
+        {
+            bool wifi_enabled = false;
+            bool ethernet_connected = false;
+        };
+    }
+
     /**
      * @brief Constructor for the WiFi tab
      *
      * Initializes the WiFi manager and creates the UI components.
-     * Does not perform an initial network scan to improve loading time.
+     * Radio state and the network list are read off the main thread.
      */
     WifiTab::WifiTab()
         : manager_(std::make_shared<WifiManager>()), // Create WiFi manager
@@ -56,7 +82,7 @@ namespace Wifi
         // Set up the WiFi toggle switch with labels and initial state
         Gtk::Label *toggle_label = Gtk::manage(new Gtk::Label("WiFi:"));
         wifi_status_label_.set_text("Enabled");
-        wifi_switch_.set_active(manager_->is_wifi_enabled());
+        wifi_switch_.set_active(true);
         wifi_switch_.set_tooltip_text("Enable/Disable WiFi");
         wifi_switch_.set_can_focus(false); // Prevent tab navigation to this switch
 
@@ -68,7 +94,7 @@ namespace Wifi
         scan_button_.set_image_from_icon_name("view-refresh-symbolic", Gtk::ICON_SIZE_BUTTON);
         scan_button_.set_label("Scan");
         scan_button_.set_always_show_image(true);
-        scan_button_.set_sensitive(manager_->is_wifi_enabled());
+        scan_button_.set_sensitive(false); // Until the radio state is known
         scan_button_.set_can_focus(false); // Prevent tab navigation to this button
 
         // Add toggle box and scan button to the controls container
@@ -118,42 +144,40 @@ namespace Wifi
         manager_->scan_networks_async();
 
         // Re-enable the scan button after a short delay (2 seconds)
-        Glib::signal_timeout().connect_once([this]() {
+        Core::Wakeups::timeout_once(sigc::track_obj([this]() {
             scan_button_.set_sensitive(true);
             scan_button_.set_label("Scan");
             // Update ethernet status when scan completes
             update_ethernet_status();
-        }, 2000); });
+        }, *this), 2000); });
 
         // Connect WiFi switch toggle handler
-        wifi_switch_.property_active().signal_changed().connect(sigc::mem_fun(*this, &WifiTab::on_wifi_switch_toggled));
+        wifi_switch_connection_ = wifi_switch_.property_active().signal_changed().connect(sigc::mem_fun(*this, &WifiTab::on_wifi_switch_toggled));
 
         // Register callback for network list updates from the WiFi manager
         manager_->set_update_callback([this](const std::vector<Network> &networks)
-                                      { update_network_list(networks); });
+                                      {
+            update_network_list(networks);
+            remember_state(networks); });
 
         // Register callback for WiFi state changes from the WiFi manager
         manager_->set_state_callback([this](bool enabled)
                                      { update_wifi_state(enabled); });
 
-        // Initialize UI based on current WiFi state
-        update_wifi_state(manager_->is_wifi_enabled());
-
-        // Initialize ethernet status
-        update_ethernet_status();
-
         // Show a loading message initially instead of scanning immediately
         loading_label_ = Gtk::manage(new Gtk::Label("Loading networks..."));
         loading_label_->set_margin_top(20);
         loading_label_->set_margin_bottom(20);
         container_.pack_start(*loading_label_, Gtk::PACK_SHRINK);
 
+        // Replace it with the last run's networks until the scan completes
+        show_cached_state();
+
         show_all_children();
-        std::cout << "WiFi tab loaded!" << std::endl;
+        UC_LOG_DEBUG(Wifi, "WiFi tab loaded!");
 
-        // Schedule a delayed scan after the tab is visible
-        Glib::signal_timeout().connect_once(
-            sigc::mem_fun(*this, &WifiTab::perform_delayed_scan), 100);
+        // Read radio and ethernet state off the main thread, then scan
+        refresh();
     }
 
     /**
@@ -161,6 +185,42 @@ namespace Wifi
      */
     WifiTab::~WifiTab() = default;
 
+    /**
+     * @brief Re-read radio, network and ethernet state after an outside change
+     *
+     * nmcli runs on the hydration thread. The state callback updates the
+     * switch if the radio was toggled; the scan that follows updates the
+     * network list.
+     */
+    void WifiTab::refresh()
+    {
+        auto manager = manager_;
+        Core::Staging::hydrate(
+            *this, [manager]()
+            {
+                LinkState state;
+                state.wifi_enabled = manager->query_wifi_enabled();
+                state.ethernet_connected = manager->is_ethernet_connected();
+                return state; },
+            [this](const LinkState &state)
+            {
+                manager_->apply_wifi_state(state.wifi_enabled);
+                show_ethernet_status(state.ethernet_connected);
+                if (!state.wifi_enabled)
+                {
+                    update_network_list({}); // Drop cached rows
+                }
+                else if (!initial_scan_performed_)
+                {
+                    perform_initial_scan();
+                }
+                else
+                {
+                    manager_->scan_networks_async();
+                }
+            });
+    }
+
     /**
      * @brief Update the UI based on WiFi state
      * @param enabled Whether WiFi is enabled
@@ -170,8 +230,10 @@ namespace Wifi
      */
     void WifiTab::update_wifi_state(bool enabled)
     {
-        // Update switch, label, and button state
+        // Update switch, label, and button state without toggling the radio
+        wifi_switch_connection_.block();
         wifi_switch_.set_active(enabled);
+        wifi_switch_connection_.unblock();
         wifi_status_label_.set_text(enabled ? "Enabled" : "Disabled");
         scan_button_.set_sensitive(enabled);
 
@@ -189,44 +251,46 @@ namespace Wifi
     /**
      * @brief Update the ethernet connection status display
      *
-     * Checks if ethernet is connected and updates the status message and icon accordingly.
+     * Checks on the hydration thread if ethernet is connected, then updates
+     * the status message and icon accordingly.
      */
     void WifiTab::update_ethernet_status()
     {
-        // Check Ethernet status asynchronously to avoid UI freezing
-        Glib::Thread::create(
-            [this]()
+        auto manager = manager_;
+        Core::Staging::hydrate(
+            *this, [manager]()
+            { return manager->is_ethernet_connected(); },
+            [this](bool connected)
+            { show_ethernet_status(connected); });
+    }
+
+    /**
+     * @brief Show or hide the ethernet status line
+     * @param connected Whether an ethernet device is connected
+     */
+    void WifiTab::show_ethernet_status(bool connected)
+    {
+        if (connected)
+        {
+            // Only add the ethernet box to the UI if it's not already there
+            if (!ethernet_box_added_)
             {
-                bool ethernet_connected = manager_->is_ethernet_connected();
-
-                // Use Glib::signal_idle to update UI from the main thread
-                Glib::signal_idle().connect_once(
-                    [this, ethernet_connected]()
-                    {
-                        if (ethernet_connected)
-                        {
-                            // Only add the ethernet box to the UI if it's not already there
-                            if (!ethernet_box_added_)
-                            {
-                                // Add ethernet box after the separator but before the network list
-                                main_box_->pack_start(*ethernet_box_, Gtk::PACK_SHRINK);
-                                main_box_->reorder_child(*ethernet_box_, 2); // Position after header and separator
-                                ethernet_box_->show_all();
-                                ethernet_box_added_ = true;
-                            }
-                        }
-                        else
-                        {
-                            // Remove ethernet box from UI if it was previously added
-                            if (ethernet_box_added_)
-                            {
-                                main_box_->remove(*ethernet_box_);
-                                ethernet_box_added_ = false;
-                            }
-                        }
-                    });
-            },
-            false); // non-joinable thread
+                // Add ethernet box after the separator but before the network list
+                main_box_->pack_start(*ethernet_box_, Gtk::PACK_SHRINK);
+                main_box_->reorder_child(*ethernet_box_, 2); // Position after header and separator
+                ethernet_box_->show_all();
+                ethernet_box_added_ = true;
+            }
+        }
+        else
+        {
+            // Remove ethernet box from UI if it was previously added
+            if (ethernet_box_added_)
+            {
+                main_box_->remove(*ethernet_box_);
+                ethernet_box_added_ = false;
+            }
+        }
     }
 
     /**
@@ -252,87 +316,179 @@ namespace Wifi
         }
 
         // Re-enable the switch after a short delay (1 second)
-        Glib::signal_timeout().connect_once([this]()
-                                            { wifi_switch_.set_sensitive(true); }, 1000);
+        Core::Wakeups::timeout_once(sigc::track_obj([this]()
+                                            { wifi_switch_.set_sensitive(true); }, *this), 1000);
     }
 
     /**
-     * @brief Update the list of displayed WiFi networks
-     * @param networks Vector of Network objects to display
+     * @brief Show the networks saved by the last run, marked as stale
      *
-     * Clears the current list of network widgets and creates new ones
-     * for each network in the provided vector.
+     * The first scan replaces them, or clears them if the radio is off.
      */
-    void WifiTab::update_network_list(const std::vector<Network> &networks)
+    void WifiTab::show_cached_state()
     {
-        // Remove all existing network widgets
-        for (auto &widget : widgets_)
+        Core::WarmCache::Reader reader;
+        std::uint32_t count = 0;
+        if (!Core::WarmCache::read(kCacheSection, reader) || !reader.u32(count))
         {
-            container_.remove(*widget);
+            return;
         }
-        widgets_.clear();
 
-        // Remove the loading label if it exists
-        if (loading_label_ != nullptr)
+        std::vector<Network> networks;
+        for (std::uint32_t i = 0; i < count && reader.ok(); ++i)
         {
-            container_.remove(*loading_label_);
-            loading_label_ = nullptr;
+            Network net;
+            std::int32_t signal = 0;
+            reader.str(net.ssid);
+            reader.str(net.bssid);
+            reader.i32(signal);
+            reader.boolean(net.connected);
+            reader.boolean(net.secured);
+            reader.boolean(net.saved);
+            net.signal_strength = signal;
+            networks.push_back(net);
         }
-
-        // Remove the "no networks" label if it exists
-        if (no_networks_label_ != nullptr)
+        if (!reader.ok() || networks.empty())
         {
-            container_.remove(*no_networks_label_);
-            no_networks_label_ = nullptr;
+            return;
         }
 
-        // If WiFi is enabled but no networks were found, show a message
-        if (networks.empty() && manager_->is_wifi_enabled())
+        update_network_list(networks);
+        container_.get_style_context()->add_class("stale");
+    }
+
+    /**
+     * @brief Save live networks to the warm cache and clear the stale marker
+     * @param networks The networks just reported by the manager
+     */
+    void WifiTab::remember_state(const std::vector<Network> &networks)
+    {
+        container_.get_style_context()->remove_class("stale");
+
+        Core::WarmCache::Writer writer;
+        writer.u32(static_cast<std::uint32_t>(networks.size()));
+        for (const auto &net : networks)
         {
-            no_networks_label_ = Gtk::manage(new Gtk::Label("No wireless networks found"));
-            no_networks_label_->set_margin_top(20);
-            no_networks_label_->set_margin_bottom(20);
-            container_.pack_start(*no_networks_label_, Gtk::PACK_SHRINK);
+            writer.str(net.ssid);
+            writer.str(net.bssid);
+            writer.i32(net.signal_strength);
+            writer.boolean(net.connected);
+            writer.boolean(net.secured);
+            writer.boolean(net.saved);
         }
-        else
-        { // Create widgets for each detected network
-            // Keep the connected wifi at the top, then sort by signal strength
-            std::vector<Network> sorted_networks = networks;
-            std::sort(sorted_networks.begin(), sorted_networks.end(), [](const Network &a, const Network &b)
-                      {
-                // Always prioritize connected networks
-                if(a.connected != b.connected)
-                    return a.connected;
-                // For non-connected networks, sort by signal strength (higher first)
-                return a.signal_strength > b.signal_strength; });
-            for (const auto &net : sorted_networks)
+        Core::WarmCache::store(kCacheSection, writer.take());
+    }
+
+    /**
+     * @brief Update the list of displayed WiFi networks
+     * @param networks Vector of Network objects to display
+     *
+     * Clears the current list of network widgets and creates new ones
+     * for each network in the provided vector.
+     */
+    void WifiTab::update_network_list(const std::vector<Network> &networks)
+    {
+        Core::Metrics::increment(reconcile_counter);
+        const unsigned int generation = ++list_generation_;
+        const std::int64_t start_us = Core::Trace::now_us();
+
+        // Keep the connected wifi at the top, then sort by signal strength
+        std::vector<Network> sorted_networks = networks;
+        std::sort(sorted_networks.begin(), sorted_networks.end(), [](const Network &a, const Network &b)
+                  {
+            // Always prioritize connected networks
+            if(a.connected != b.connected)
+                return a.connected;
+            // For non-connected networks, sort by signal strength (higher first)
+            return a.signal_strength > b.signal_strength; });
+
+        // Clear in the first step so the old rows stay up until new ones land
+        const bool empty = networks.empty();
+        Core::Staging::step(*this, [this, generation, empty]()
+                            {
+            if (generation != list_generation_)
+            {
+                return;
+            }
+
+            // Remove all existing network widgets
+            for (auto &widget : widgets_)
             {
+                container_.remove(*widget);
+            }
+            widgets_.clear();
+
+            // Remove the loading label if it exists
+            if (loading_label_ != nullptr)
+            {
+                container_.remove(*loading_label_);
+                loading_label_ = nullptr;
+            }
+
+            // Remove the "no networks" label if it exists
+            if (no_networks_label_ != nullptr)
+            {
+                container_.remove(*no_networks_label_);
+                no_networks_label_ = nullptr;
+            }
+
+            // If WiFi is enabled but no networks were found, show a message
+            if (empty && wifi_switch_.get_active())
+            {
+                no_networks_label_ = Gtk::manage(new Gtk::Label("No wireless networks found"));
+                no_networks_label_->set_margin_top(20);
+                no_networks_label_->set_margin_bottom(20);
+                container_.pack_start(*no_networks_label_, Gtk::PACK_SHRINK);
+                no_networks_label_->show();
+            } });
+
+        // Create one widget per frame step for each detected network
+        for (const auto &net : sorted_networks)
+        {
+            Core::Staging::step(*this, [this, net, generation]()
+                                {
+                if (generation != list_generation_)
+                {
+                    return;
+                }
                 auto widget = std::make_unique<WifiNetworkWidget>(net, manager_);
                 container_.pack_start(*widget, Gtk::PACK_SHRINK);
-                widgets_.push_back(std::move(widget));
-            }
+                widget->show_all();
+                widgets_.push_back(std::move(widget)); });
         }
 
+        // Time from the update to its last row
+        Core::Staging::step(*this, [this, generation, start_us]()
+                            {
+            if (generation == list_generation_)
+            {
+                Core::Metrics::record_us(reconcile_histogram, static_cast<std::uint64_t>(Core::Trace::now_us() - start_us));
+            } });
+
         // Update ethernet status when network list is refreshed
         update_ethernet_status();
-
-        show_all_children();
     }
 
     /**
-     * @brief Perform a delayed network scan
+     * @brief Perform the first network scan
      *
-     * Called after the tab is fully loaded and visible to the user.
-     * Delays the scan by a short time to ensure UI responsiveness.
-     * Uses asynchronous scanning to prevent UI freezing.
+     * Called once the radio state is known. Waits until the window is
+     * active and scans asynchronously to prevent UI freezing.
      */
-    void WifiTab::perform_delayed_scan()
+    void WifiTab::perform_initial_scan()
     {
         if (initial_scan_performed_)
         {
             return; // Prevent duplicate scans
         }
 
+        // Don't scan while the window is hidden or unfocused
+        if (!Core::Activity::is_active())
+        {
+            Core::Activity::when_active(sigc::mem_fun(*this, &WifiTab::perform_initial_scan));
+            return;
+        }
+
         initial_scan_performed_ = true;
 
         if (manager_->is_wifi_enabled())
@@ -345,13 +501,16 @@ namespace Wifi
             manager_->scan_networks_async();
 
             // Re-enable the scan button after a short delay
-            Glib::signal_timeout().connect_once([this]()
+            Core::Wakeups::timeout_once(sigc::track_obj([this]()
                                                 {
             scan_button_.set_sensitive(true);
             scan_button_.set_label("Scan");
             // Update ethernet status
-            update_ethernet_status(); }, 2000);
+            update_ethernet_status(); }, *this), 2000);
         }
     }
 
 } // namespace Wifi
+
+/// Factory looked up when libuc-wifi.so is loaded
+UC_TAB_MODULE("wifi", Wifi::WifiTab);
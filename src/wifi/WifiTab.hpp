@@ -42,16 +42,33 @@ namespace Wifi
          */
         virtual ~WifiTab();
 
+        /**
+         * @brief Re-read radio, network and ethernet state after an outside change
+         */
+        void refresh();
+
     private:
         /**
          * @brief Update the list of displayed WiFi networks
          * @param networks Vector of Network objects to display
          *
          * Clears the current list of network widgets and creates new ones
-         * for each network in the provided vector.
+         * for each network in the provided vector. Rows are added in frame
+         * steps (see Core::Staging).
          */
         void update_network_list(const std::vector<Network> &networks);
 
+        /**
+         * @brief Show the networks saved by the last run, marked as stale
+         */
+        void show_cached_state();
+
+        /**
+         * @brief Save live networks to the warm cache and clear the stale marker
+         * @param networks The networks just reported by the manager
+         */
+        void remember_state(const std::vector<Network> &networks);
+
         /**
          * @brief Update the UI based on WiFi state
          * @param enabled Whether WiFi is enabled
@@ -68,6 +85,12 @@ namespace Wifi
          */
         void update_ethernet_status();
 
+        /**
+         * @brief Show or hide the ethernet status line
+         * @param connected Whether an ethernet device is connected
+         */
+        void show_ethernet_status(bool connected);
+
         /**
          * @brief Handler for WiFi switch toggle events
          *
@@ -76,17 +99,17 @@ namespace Wifi
         void on_wifi_switch_toggled();
 
         /**
-         * @brief Perform a delayed network scan
+         * @brief Perform the first network scan
          *
-         * Called after the tab is fully loaded and visible to the user.
-         * Delays the scan by a short time to ensure UI responsiveness.
+         * Called once hydration has read the radio state and it is on.
          */
-        void perform_delayed_scan();
+        void perform_initial_scan();
 
         std::shared_ptr<WifiManager> manager_;                    ///< WiFi manager for network operations
         Gtk::Box container_;                                      ///< Container for network widgets
         Gtk::Button scan_button_;                                 ///< Button to trigger network scanning
         Gtk::Switch wifi_switch_;                                 ///< Switch to enable/disable WiFi
+        sigc::connection wifi_switch_connection_;                 ///< Applies wifi_switch_ changes to the radio
         Gtk::Label wifi_status_label_;                            ///< Label showing WiFi status (Enabled/Disabled)
         Gtk::Image wifi_status_icon_;                             ///< Icon showing WiFi status
         Gtk::Label ethernet_status_label_;                        ///< Label showing ethernet connection status
@@ -98,6 +121,7 @@ namespace Wifi
         bool initial_scan_performed_ = false;                     ///< Flag to track if initial scan has been done
         Gtk::Label *loading_label_ = nullptr;                     ///< Loading message shown before networks are loaded
         Gtk::Label *no_networks_label_ = nullptr;                 ///< Label shown when no networks are found
+        unsigned int list_generation_ = 0;                        ///< Bumped per list update; older queued rows are skipped
     };
 
 } // namespace Wifi
@@ -0,0 +1,104 @@
+/**
+ * @file ConfigTest.cpp
+ * @brief Core::Config keeps a pending local edit across an outside write
+ *
+ * set() and save() start the quiet period; another program then rewrites
+ * settings.conf before our write lands. After the inotify reload both the
+ * local and the outside setting must be in memory and in the file.
+ *
+ * Run by ctest with XDG_CONFIG_HOME and HOME pointing at a scratch
+ * directory. Exits 0 on success, 1 on failure and 77 (skipped) if the
+ * machine was too slow to write inside the quiet period.
+ */
+
+#include "core/Config.hpp"
+#include <chrono>        // for std::chrono::steady_clock
+#include <cstdio>        // for std::remove
+#include <fstream>       // for std::ifstream, std::ofstream
+#include <iostream>      // for std::cerr
+#include <sstream>       // for std::ostringstream
+#include <thread>        // for std::this_thread::sleep_for
+#include <glibmm/init.h> // for Glib::init
+#include <glibmm/main.h> // for Glib::MainContext
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string &what)
+{
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+std::string read_file(const std::string &path)
+{
+    std::ifstream in(path);
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+/**
+ * @brief Run the main loop until @p done returns true or @p timeout passes
+ */
+template <typename Done>
+bool iterate_until(Done done, std::chrono::milliseconds timeout)
+{
+    auto context = Glib::MainContext::get_default();
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        while (context->iteration(false)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    Glib::init();
+    const std::string path = Core::Config::path();
+    if (path.empty()) {
+        std::cerr << "No configuration directory" << std::endl;
+        return 1;
+    }
+    std::remove(path.c_str());
+
+    // Creates the directory and starts the inotify watch
+    Core::Config::watch();
+
+    Core::Config::set("test.local", "ours");
+    Core::Config::save();
+
+    // Another program edits the file inside the quiet period
+    if (read_file(path).find("test.local") != std::string::npos) {
+        std::cerr << "SKIP: the debounced write landed before the outside edit" << std::endl;
+        return 77;
+    }
+    {
+        std::ofstream out(path);
+        out << "# Written by another program\ntest.external=theirs\n";
+    }
+
+    const bool reloaded = iterate_until([]() { return Core::Config::get_string("test.external") == "theirs"; },
+                                        std::chrono::milliseconds(5000));
+    check(reloaded, "the outside edit is reloaded");
+    check(Core::Config::get_string("test.local") == "ours", "the local edit survives the reload");
+
+    // The pending write stores both
+    Core::Config::flush();
+    const std::string contents = read_file(path);
+    check(contents.find("test.local=ours") != std::string::npos, "the local edit is written");
+    check(contents.find("test.external=theirs") != std::string::npos, "the outside edit is written");
+
+    std::cerr << (failures == 0 ? "PASS" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}